@@ -0,0 +1,13 @@
+//
+// ColumnView.h
+//
+// Forward for the ColumnView class header.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+#include "Poco/Data/Data.h"
+#include "Poco/SQL/ColumnView.h"
@@ -0,0 +1,13 @@
+//
+// StatementCache.h
+//
+// Forward for the StatementCache class header.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+#include "Poco/Data/Data.h"
+#include "Poco/SQL/StatementCache.h"
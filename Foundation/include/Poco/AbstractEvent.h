@@ -21,9 +21,11 @@
 #include "Poco/Foundation.h"
 #include "Poco/SingletonHolder.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/CopyOnWritePtr.h"
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveMethod.h"
 #include "Poco/Mutex.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -147,6 +149,21 @@ class AbstractEvent
 	/// Working with PriorityDelegate's as similar to working with BasicEvent.
 	/// Instead of delegate(), the priorityDelegate() function must be used
 	/// to create the PriorityDelegate.
+	///
+	/// The list of delegates is kept in an immutable snapshot of the
+	/// TStrategy (see CopyOnWritePtr). Adding or removing a delegate
+	/// copies the strategy and publishes the modified copy, while
+	/// notify() only acquires a reference to the current snapshot,
+	/// without taking a lock or copying the strategy. Events are
+	/// therefore best suited for delegates that are registered
+	/// rarely but notified often.
+	///
+	/// Notifying an event that has never had a delegate costs a
+	/// single atomic load. Otherwise, acquiring and releasing the
+	/// reference takes a few atomic read-modify-write operations on
+	/// counters shared by all threads notifying the event (see
+	/// CopyOnWritePtr), so heavily concurrent notifications of the
+	/// same event still contend for these cache lines.
 {
 public:
 	typedef TDelegate* DelegateHandle;
@@ -160,9 +177,9 @@ public:
 
 	AbstractEvent(const TStrategy& strat):
 		_executeAsync(this, &AbstractEvent::executeAsyncImpl),
-		_strategy(strat),
 		_enabled(true)
 	{
+		_strategy.store(new StrategySnapshot(strat));
 	}
 
 	virtual ~AbstractEvent()
@@ -175,7 +192,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().add(aDelegate);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -184,7 +203,10 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().remove(aDelegate);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -196,7 +218,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		StrategyPtr pStrategy = copyStrategy();
+		DelegateHandle delegateHandle = pStrategy->value().add(aDelegate);
+		_strategy.store(pStrategy.duplicate());
+		return delegateHandle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -206,7 +231,10 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().remove(delegateHandle);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	void operator () (const void* pSender, TArgs& args)
@@ -232,15 +260,13 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
 		if (!_enabled) return;
 
 		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		// the snapshot is never modified, and stays alive
+		// until we release it
+		StrategyPtr pStrategy = _strategy.load();
+		if (pStrategy) pStrategy->value().notify(pSender, args);
 	}
 
 	bool hasDelegates() const
@@ -262,18 +288,10 @@ public:
 		/// the execution is aborted and the exception is propagated to the caller.
 	{
 		NotifyAsyncParams params(pSender, args);
-		{
-			typename TMutex::ScopedLock lock(_mutex);
-
-			// thread-safeness:
-			// copy should be faster and safer than blocking until
-			// execution ends
-			// make a copy of the strategy here to guarantee that
-			// between notifyAsync and the execution of the method no changes can occur
-
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
-			params.enabled  = _enabled;
-		}
+		// the snapshot guarantees that between notifyAsync and
+		// the execution of the method no changes can occur
+		params.ptrStrat = _strategy.load();
+		params.enabled  = _enabled;
 		ActiveResult<TArgs> result = _executeAsync(params);
 		return result;
 	}
@@ -281,7 +299,6 @@ public:
 	void enable()
 		/// Enables the event.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
 	}
 
@@ -289,14 +306,12 @@ public:
 		/// Disables the event. notify and notifyAsnyc will be ignored,
 		/// but adding/removing delegates is still allowed.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
 	}
 
 	bool isEnabled() const
 		/// Returns true if event is enabled.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		return _enabled;
 	}
 
@@ -304,20 +319,26 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().clear();
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		StrategyPtr pStrategy = _strategy.load();
+		return !pStrategy || pStrategy->value().empty();
 	}
 
 protected:
+	typedef typename CopyOnWritePtr<TStrategy>::Snapshot StrategySnapshot;
+	typedef typename CopyOnWritePtr<TStrategy>::Ptr StrategyPtr;
+
 	struct NotifyAsyncParams
 	{
-		SharedPtr<TStrategy> ptrStrat;
+		StrategyPtr ptrStrat;
 		const void* pSender;
 		TArgs       args;
 		bool        enabled;
@@ -339,14 +360,26 @@ protected:
 
 		NotifyAsyncParams params = par;
 		TArgs retArgs(params.args);
-		params.ptrStrat->notify(params.pSender, retArgs);
+		if (params.ptrStrat) params.ptrStrat->value().notify(params.pSender, retArgs);
 		return retArgs;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	StrategyPtr copyStrategy() const
+		/// Returns a copy of the current strategy, which can be
+		/// modified and published. Must be called with the mutex
+		/// locked, which serializes all modifications.
+	{
+		StrategySnapshot* pCurrent = _strategy.get();
+		if (pCurrent)
+			return new StrategySnapshot(pCurrent->value());
+		else
+			return new StrategySnapshot;
+	}
+
+	CopyOnWritePtr<TStrategy> _strategy; /// The strategy used to notify observers. Empty until the first delegate is added.
+	std::atomic<bool>         _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                                     /// but it is possible to change the observers.
+	mutable TMutex _mutex;               /// Serializes modifications of the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -368,9 +401,9 @@ public:
 
 	AbstractEvent(const TStrategy& strat):
 		_executeAsync(this, &AbstractEvent::executeAsyncImpl),
-		_strategy(strat),
 		_enabled(true)
 	{
+		_strategy.store(new StrategySnapshot(strat));
 	}
 
 	virtual ~AbstractEvent()
@@ -383,7 +416,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().add(aDelegate);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -392,7 +427,10 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().remove(aDelegate);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -404,7 +442,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		StrategyPtr pStrategy = copyStrategy();
+		DelegateHandle delegateHandle = pStrategy->value().add(aDelegate);
+		_strategy.store(pStrategy.duplicate());
+		return delegateHandle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -414,7 +455,10 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().remove(delegateHandle);
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	void operator () (const void* pSender)
@@ -440,16 +484,13 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-
 		if (!_enabled) return;
 
 		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		// the snapshot is never modified, and stays alive
+		// until we release it
+		StrategyPtr pStrategy = _strategy.load();
+		if (pStrategy) pStrategy->value().notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -465,18 +506,10 @@ public:
 		/// the execution is aborted and the exception is propagated to the caller.
 	{
 		NotifyAsyncParams params(pSender);
-		{
-			typename TMutex::ScopedLock lock(_mutex);
-
-			// thread-safeness:
-			// copy should be faster and safer than blocking until
-			// execution ends
-			// make a copy of the strategy here to guarantee that
-			// between notifyAsync and the execution of the method no changes can occur
-
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
-			params.enabled  = _enabled;
-		}
+		// the snapshot guarantees that between notifyAsync and
+		// the execution of the method no changes can occur
+		params.ptrStrat = _strategy.load();
+		params.enabled  = _enabled;
 		ActiveResult<void> result = _executeAsync(params);
 		return result;
 	}
@@ -484,7 +517,6 @@ public:
 	void enable()
 		/// Enables the event.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
 	}
 
@@ -492,13 +524,11 @@ public:
 		/// Disables the event. notify and notifyAsnyc will be ignored,
 		/// but adding/removing delegates is still allowed.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
 	}
 
 	bool isEnabled() const
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		return _enabled;
 	}
 
@@ -506,20 +536,26 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		if (_strategy.empty()) return;
+		StrategyPtr pStrategy = copyStrategy();
+		pStrategy->value().clear();
+		_strategy.store(pStrategy.duplicate());
 	}
 
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		StrategyPtr pStrategy = _strategy.load();
+		return !pStrategy || pStrategy->value().empty();
 	}
 
 protected:
+	typedef typename CopyOnWritePtr<TStrategy>::Snapshot StrategySnapshot;
+	typedef typename CopyOnWritePtr<TStrategy>::Ptr StrategyPtr;
+
 	struct NotifyAsyncParams
 	{
-		SharedPtr<TStrategy> ptrStrat;
+		StrategyPtr ptrStrat;
 		const void* pSender;
 		bool        enabled;
 
@@ -539,14 +575,26 @@ protected:
 		}
 
 		NotifyAsyncParams params = par;
-		params.ptrStrat->notify(params.pSender);
+		if (params.ptrStrat) params.ptrStrat->value().notify(params.pSender);
 		return;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	StrategyPtr copyStrategy() const
+		/// Returns a copy of the current strategy, which can be
+		/// modified and published. Must be called with the mutex
+		/// locked, which serializes all modifications.
+	{
+		StrategySnapshot* pCurrent = _strategy.get();
+		if (pCurrent)
+			return new StrategySnapshot(pCurrent->value());
+		else
+			return new StrategySnapshot;
+	}
+
+	CopyOnWritePtr<TStrategy> _strategy; /// The strategy used to notify observers. Empty until the first delegate is added.
+	std::atomic<bool>         _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                                     /// but it is possible to change the observers.
+	mutable TMutex _mutex;               /// Serializes modifications of the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
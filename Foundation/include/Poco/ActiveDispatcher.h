@@ -24,11 +24,17 @@
 #include "Poco/ActiveStarter.h"
 #include "Poco/ActiveRunnable.h"
 #include "Poco/NotificationQueue.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
 
 
 namespace Poco {
 
 
+class WorkStealingExecutor;
+
+
 class Foundation_API ActiveDispatcher: protected Runnable
 	/// This class is used to implement an active object
 	/// with strictly serialized method execution.
@@ -69,6 +75,11 @@ class Foundation_API ActiveDispatcher: protected Runnable
 	/// inherits from ActiveDispatcher, and that the ActiveMethod
 	/// template for exampleActiveMethod has an additional parameter,
 	/// specifying the specialized ActiveStarter for ActiveDispatcher.
+	///
+	/// Instead of using its own thread, an ActiveDispatcher can also
+	/// run its methods on a WorkStealingExecutor. Methods are still
+	/// executed one at a time, in the order they were started, but
+	/// no thread is occupied while the dispatcher has nothing to do.
 {
 public:
 	ActiveDispatcher();
@@ -78,6 +89,11 @@ public:
 		/// Creates the ActiveDispatcher and sets
 		/// the priority of its thread.
 
+	explicit ActiveDispatcher(WorkStealingExecutor& executor);
+		/// Creates the ActiveDispatcher, which runs its
+		/// methods on the given WorkStealingExecutor.
+		/// The executor must outlive the ActiveDispatcher.
+
 	virtual ~ActiveDispatcher();
 		/// Destroys the ActiveDispatcher.
 
@@ -90,10 +106,18 @@ public:
 protected:
 	void run();
 	void stop();
+	void drain();
+		/// Runs the queued methods on the WorkStealingExecutor,
+		/// until the queue is empty.
 
 private:
 	Thread            _thread;
 	NotificationQueue _queue;
+	WorkStealingExecutor* _pExecutor;
+	RunnableAdapter<ActiveDispatcher> _drainer;
+	bool              _draining;
+	FastMutex         _drainMutex;
+	Event             _drained;
 };
 
 
@@ -0,0 +1,164 @@
+//
+// AsyncFileChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncFileChannel
+//
+// Definition of the AsyncFileChannel class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_AsyncFileChannel_INCLUDED
+#define Foundation_AsyncFileChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FileChannel.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
+#include <atomic>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API AsyncFileChannel: public FileChannel, public Runnable
+	/// A FileChannel that writes messages to the log file in
+	/// a separate thread, in batches.
+	///
+	/// log() only copies the message's text into a lock-free list
+	/// and returns; it never waits for the file or for other
+	/// threads logging messages. A background thread collects all
+	/// pending messages and writes them with a single call to
+	/// writev() on platforms supporting it, or a single write
+	/// otherwise.
+	///
+	/// Pending messages are written at the latest after the flush
+	/// interval (property "flushInterval", in milliseconds) has
+	/// elapsed, or as soon as "batchSize" messages are pending.
+	/// A flush interval of 0 writes messages as soon as possible.
+	///
+	/// If messages are logged faster than they can be written,
+	/// at most "maxPending" messages are kept in memory. Beyond
+	/// that, log() either waits until the background thread has
+	/// written the pending messages ("overflow" set to "block", the
+	/// default), or discards the message ("overflow" set to "drop").
+	/// With many threads logging at the same time, the limit may be
+	/// exceeded by up to one message per thread.
+	///
+	/// Log file rotation, archiving and purging, which are
+	/// configured as for FileChannel, are done by the background
+	/// thread, so they do not block threads logging messages.
+	/// Whether the log file must be rotated is checked before
+	/// each batch is written.
+	///
+	/// Closing or destroying the channel writes all pending
+	/// messages.
+{
+public:
+	typedef AutoPtr<AsyncFileChannel> Ptr;
+
+	enum
+	{
+		DEFAULT_FLUSH_INTERVAL = 100, /// milliseconds
+		DEFAULT_BATCH_SIZE     = 1024,
+		DEFAULT_MAX_PENDING    = 65536
+	};
+
+	AsyncFileChannel();
+		/// Creates the AsyncFileChannel.
+
+	AsyncFileChannel(const std::string& path);
+		/// Creates the AsyncFileChannel for a file with the given path.
+
+	void open();
+		/// Opens the AsyncFileChannel and starts the
+		/// background thread.
+
+	void close();
+		/// Writes all pending messages, stops the background
+		/// thread and closes the AsyncFileChannel.
+
+	void log(const Message& msg);
+		/// Queues the given message for writing to the file.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets the property with the given name.
+		///
+		/// In addition to the properties supported by FileChannel,
+		/// the following properties are supported:
+		///   * flushInterval: The maximum time in milliseconds a
+		///                    message stays in memory before it is
+		///                    written. Defaults to 100.
+		///   * batchSize:     The number of pending messages that
+		///                    causes them to be written before the
+		///                    flush interval has elapsed.
+		///                    Defaults to 1024.
+		///   * maxPending:    The maximum number of messages not yet
+		///                    written, or 0 for no limit.
+		///                    Defaults to 65536.
+		///   * overflow:      What log() does if maxPending messages
+		///                    are pending: "block" waits until they
+		///                    have been written, "drop" discards the
+		///                    message. Defaults to "block".
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_BATCHSIZE;
+	static const std::string PROP_MAXPENDING;
+	static const std::string PROP_OVERFLOW;
+
+protected:
+	~AsyncFileChannel();
+	void run();
+
+private:
+	struct Entry
+	{
+		explicit Entry(const std::string& rText):
+			text(rText),
+			pNext(0)
+		{
+		}
+
+		std::string text;
+		Entry*      pNext;
+	};
+
+	bool waitForSpace(std::size_t maxPending);
+	void writePending();
+	static void destroy(Entry* pEntry);
+
+	std::atomic<Entry*>      _pHead;     /// the most recently logged message first
+	std::atomic<std::size_t> _pending;
+	std::atomic<long>        _flushInterval;
+	std::atomic<std::size_t> _batchSize;
+	std::atomic<std::size_t> _maxPending;
+	std::atomic<bool>        _dropOnOverflow;
+	std::atomic<bool>        _running;
+	std::atomic<bool>        _stop;
+	std::vector<std::string> _lines;
+	Thread                   _thread;
+	Event                    _wakeUp;
+	Event                    _written;
+	FastMutex                _threadMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AsyncFileChannel_INCLUDED
@@ -0,0 +1,146 @@
+//
+// BinaryLogChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogChannel class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogChannel_INCLUDED
+#define Foundation_BinaryLogChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Mutex.h"
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogChannel: public Channel
+	/// A Channel that writes messages to a file in a compact
+	/// binary format, without formatting them.
+	///
+	/// All fields of the message (source, text, priority, time,
+	/// process and thread identifiers, thread name, source file
+	/// and line) as well as all message parameters are written.
+	/// The messages can be read back with a BinaryLogReader, and
+	/// formatted later with any Formatter.
+	///
+	/// Writing a message in binary format is considerably cheaper
+	/// than formatting it, and the binary log is usually smaller
+	/// than the formatted one.
+	///
+	/// A binary log file starts with a header consisting of the
+	/// four characters "PBLG" followed by the format version, a
+	/// 32-bit unsigned integer. Every message is written as a
+	/// record, consisting of its length in bytes as a 32-bit
+	/// unsigned integer, followed by:
+	///
+	///   * time:       64-bit signed integer (microseconds since the epoch)
+	///   * priority:   8-bit unsigned integer
+	///   * pid:        7-bit encoded integer
+	///   * tid:        7-bit encoded integer
+	///   * OS tid:     7-bit encoded integer
+	///   * line:       7-bit encoded integer
+	///   * source:     string
+	///   * text:       string
+	///   * thread:     string
+	///   * file:       string (empty if no source file is set)
+	///   * parameters: 7-bit encoded count, followed by the name
+	///                 and value of each parameter, as strings
+	///
+	/// All integers are in little endian byte order. Strings are
+	/// written as their 7-bit encoded length, followed by their
+	/// characters. 7-bit encoded integers and strings use the
+	/// same encoding as BinaryWriter.
+	///
+	/// The length prefix allows a reader to skip records written
+	/// by a future version of this class, which may append
+	/// additional fields to the record.
+{
+public:
+	typedef AutoPtr<BinaryLogChannel> Ptr;
+
+	enum
+	{
+		FORMAT_VERSION = 1
+	};
+
+	BinaryLogChannel();
+		/// Creates the BinaryLogChannel.
+
+	BinaryLogChannel(const std::string& path);
+		/// Creates the BinaryLogChannel for a file with the given path.
+
+	void open();
+		/// Opens the BinaryLogChannel and creates the log file
+		/// if necessary. The header is written to a new or
+		/// empty log file.
+
+	void close();
+		/// Closes the BinaryLogChannel.
+
+	void log(const Message& msg);
+		/// Writes the given message to the file.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets the property with the given name.
+		///
+		/// The following properties are supported:
+		///   * path:  The log file's path.
+		///   * flush: Whether every record is immediately written
+		///            to the file ("true", the default), or
+		///            buffered ("false").
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+		/// See setProperty() for a description of the supported
+		/// properties.
+
+	const std::string& path() const;
+		/// Returns the log file's path.
+
+	static const std::string PROP_PATH;
+	static const std::string PROP_FLUSH;
+
+	static const char MAGIC[4];
+		/// The first four characters of a binary log file.
+
+protected:
+	~BinaryLogChannel();
+
+private:
+	void encode(const Message& msg);
+
+	std::string   _path;
+	bool          _flush;
+	std::ostream* _pStream;
+	std::string   _record;
+	FastMutex     _mutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& BinaryLogChannel::path() const
+{
+	return _path;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogChannel_INCLUDED
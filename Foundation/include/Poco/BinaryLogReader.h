@@ -0,0 +1,121 @@
+//
+// BinaryLogReader.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogReader class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogReader_INCLUDED
+#define Foundation_BinaryLogReader_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Message.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <set>
+
+
+namespace Poco {
+
+
+class Formatter;
+class Channel;
+
+
+class Foundation_API BinaryLogReader
+	/// BinaryLogReader reads the messages written by a
+	/// BinaryLogChannel from a stream.
+	///
+	/// The messages can be formatted with any Formatter, or
+	/// passed on to any Channel, to convert a binary log
+	/// into a text log.
+	///
+	/// Example:
+	///
+	///     Poco::FileInputStream istr("app.blog");
+	///     Poco::BinaryLogReader reader(istr);
+	///     Poco::AutoPtr<Poco::PatternFormatter> pFormatter(new Poco::PatternFormatter("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t"));
+	///     reader.format(*pFormatter, std::cout);
+{
+public:
+	enum
+	{
+		DEFAULT_MAX_RECORD_SIZE = 16*1024*1024
+	};
+
+	BinaryLogReader(std::istream& istr, std::size_t maxRecordSize = DEFAULT_MAX_RECORD_SIZE);
+		/// Creates the BinaryLogReader for the given stream, which
+		/// must have been opened in binary mode.
+		///
+		/// Records larger than maxRecordSize bytes are considered
+		/// damaged, so that a corrupted length does not make the
+		/// reader allocate an arbitrary amount of memory.
+
+	~BinaryLogReader();
+		/// Destroys the BinaryLogReader.
+
+	bool read(Message& msg);
+		/// Reads the next message from the stream. Returns false if
+		/// the end of the stream has been reached.
+		///
+		/// The source file of the message remains valid as long as
+		/// the BinaryLogReader exists.
+		///
+		/// Throws a DataFormatException if the stream does not contain
+		/// a binary log, or if a record is incomplete, damaged or
+		/// larger than the maximum record size.
+
+	std::size_t format(Formatter& formatter, std::ostream& ostr);
+		/// Reads all remaining messages, formats them with the given
+		/// Formatter and writes them to the given stream, each followed
+		/// by a newline. Returns the number of messages read.
+
+	std::size_t replay(Channel& channel);
+		/// Reads all remaining messages and logs them to the given
+		/// Channel. Returns the number of messages read.
+
+	UInt32 version() const;
+		/// Returns the format version of the binary log, or
+		/// zero if no message has been read yet.
+
+private:
+	BinaryLogReader();
+	BinaryLogReader(const BinaryLogReader&);
+	BinaryLogReader& operator = (const BinaryLogReader&);
+
+	bool readHeader();
+	const char* sourceFile(const std::string& file);
+
+	std::istream&         _istr;
+	std::size_t           _maxRecordSize;
+	UInt32                _version;
+	std::string           _record;
+	std::string           _string;
+	std::set<std::string> _sourceFiles;
+};
+
+
+//
+// inlines
+//
+inline UInt32 BinaryLogReader::version() const
+{
+	return _version;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogReader_INCLUDED
@@ -0,0 +1,227 @@
+//
+// BoundedNotificationQueue.h
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Definition of the BoundedNotificationQueue class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BoundedNotificationQueue_INCLUDED
+#define Foundation_BoundedNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API BoundedNotificationQueue
+	/// A BoundedNotificationQueue is a NotificationQueue with a
+	/// fixed capacity, for passing large numbers of notifications
+	/// from many producer threads to many consumer threads.
+	///
+	/// The queue is a lock-free ring buffer (see "Bounded MPMC queue"
+	/// by Dmitry Vyukov). Every slot carries a sequence number, so that
+	/// producers and consumers only contend on a single atomic position
+	/// counter each, and never on a mutex. Batches of notifications can
+	/// be enqueued and dequeued with a single atomic operation.
+	///
+	/// Consumer threads only block in waitDequeueNotification() if
+	/// the queue is empty, and producer threads only block in
+	/// enqueueNotification() if the queue is full. Blocked threads
+	/// wait on a futex on Linux, and on a condition variable on other
+	/// platforms. As long as no thread is blocked, no system call is
+	/// made to enqueue or dequeue a notification.
+	///
+	/// Unlike NotificationQueue, a BoundedNotificationQueue does not
+	/// support urgent notifications or removing a notification
+	/// from the queue.
+	///
+	/// The recommended sequence to shut down a queue with worker
+	/// threads is the same as for NotificationQueue.
+{
+public:
+	typedef std::vector<Notification::Ptr> NotificationVec;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 1024
+	};
+
+	explicit BoundedNotificationQueue(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the BoundedNotificationQueue with the given capacity,
+		/// which is rounded up to the next power of two.
+
+	~BoundedNotificationQueue();
+		/// Destroys the BoundedNotificationQueue, releasing all
+		/// notifications still in the queue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is full,
+		/// waits until a notification has been dequeued.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification, long milliseconds = 0);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is full,
+		/// waits up to the given time for a notification to be
+		/// dequeued.
+		///
+		/// Returns true if the notification has been enqueued,
+		/// or false if the queue is still full.
+
+	void enqueueNotifications(const NotificationVec& notifications);
+		/// Enqueues the given notifications, in order, by adding them
+		/// to the end of the queue. If the queue is full, waits until
+		/// notifications have been dequeued.
+		///
+		/// As many notifications as fit into the queue are
+		/// enqueued at once.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	std::size_t dequeueNotifications(NotificationVec& notifications, std::size_t maxCount);
+		/// Dequeues up to maxCount pending notifications and
+		/// appends them to the given vector.
+		///
+		/// Returns the number of notifications dequeued, which
+		/// is 0 if no notification is available.
+
+	std::size_t waitDequeueNotifications(NotificationVec& notifications, std::size_t maxCount);
+		/// Dequeues up to maxCount pending notifications and
+		/// appends them to the given vector. If no notification
+		/// is available, waits for a notification to be enqueued.
+		///
+		/// Returns the number of notifications dequeued, which
+		/// is 0 if wakeUpAll() has been called by another thread.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+		///
+		/// If other threads are enqueueing or dequeueing
+		/// notifications, the result is only an estimate.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of notifications in the queue.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+private:
+	class Parker;
+
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence;
+		Notification*            pNf;
+	};
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	static const std::size_t BATCH_SIZE = 64;
+
+	BoundedNotificationQueue(const BoundedNotificationQueue&);
+	BoundedNotificationQueue& operator = (const BoundedNotificationQueue&);
+
+	std::size_t enqueueMany(const Notification::Ptr* pNotifications, std::size_t count);
+	std::size_t dequeueMany(Notification** pNotifications, std::size_t maxCount);
+	std::size_t waitEnqueueMany(const Notification::Ptr* pNotifications, std::size_t count, long milliseconds);
+	std::size_t waitDequeueMany(Notification** pNotifications, std::size_t maxCount, long milliseconds);
+
+	std::size_t _capacity;
+	std::size_t _mask;
+	Cell*       _pCells;
+	Parker*     _pNotEmpty;
+	Parker*     _pNotFull;
+	std::atomic<Poco::UInt32> _wakeUps;
+	char        _pad1[CACHE_LINE_SIZE];
+	std::atomic<std::size_t>  _enqueuePos;
+	char        _pad2[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::size_t>  _dequeuePos;
+	char        _pad3[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+};
+
+
+//
+// inlines
+//
+inline std::size_t BoundedNotificationQueue::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BoundedNotificationQueue_INCLUDED
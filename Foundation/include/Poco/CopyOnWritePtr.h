@@ -0,0 +1,191 @@
+//
+// CopyOnWritePtr.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  CopyOnWritePtr
+//
+// Definition of the CopyOnWritePtr template class.
+//
+// Copyright (c) 2006-2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CopyOnWritePtr_INCLUDED
+#define Foundation_CopyOnWritePtr_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include <atomic>
+
+
+namespace Poco {
+
+
+template <class T>
+class CopyOnWritePtr
+	/// CopyOnWritePtr holds an immutable snapshot of a value that
+	/// is read by many threads and rarely modified, such as the
+	/// list of delegates of an event.
+	///
+	/// Readers obtain a reference to the current snapshot with
+	/// load(), without taking a lock. Writers never modify a
+	/// published snapshot; instead, they create a modified copy and
+	/// publish it with store(). The previous snapshot is destroyed
+	/// as soon as the last reader holding it releases it
+	/// (read-copy-update).
+	///
+	/// load() is wait-free, but not free of contention: it increments
+	/// and decrements a reader count shared by all readers, and
+	/// acquires a reference to the snapshot, i.e. it performs three
+	/// atomic read-modify-write operations on shared cache lines, and
+	/// the returned pointer performs a fourth when it is released.
+	/// Compared to locking a mutex and copying the value, this avoids
+	/// blocking and copying, but not cache line transfers between
+	/// threads calling load() concurrently.
+	///
+	/// store() waits until all readers that may have seen the previous
+	/// snapshot, but have not yet acquired a reference to it, are done;
+	/// this takes only a few instructions per reader. Writers must be
+	/// serialized by the caller, e.g. with a mutex.
+	///
+	/// A CopyOnWritePtr may be empty, in which case load() returns
+	/// a null pointer after a single atomic load.
+{
+public:
+	class Snapshot: public RefCountedObject
+		/// A reference counted snapshot of the value.
+	{
+	public:
+		Snapshot()
+		{
+		}
+
+		explicit Snapshot(const T& value):
+			_value(value)
+		{
+		}
+
+		T& value()
+			/// Returns the value. The value must not be modified
+			/// after the snapshot has been published.
+		{
+			return _value;
+		}
+
+		const T& value() const
+			/// Returns the value.
+		{
+			return _value;
+		}
+
+	protected:
+		~Snapshot()
+		{
+		}
+
+	private:
+		T _value;
+	};
+
+	typedef AutoPtr<Snapshot> Ptr;
+
+	constexpr CopyOnWritePtr():
+		_pSnapshot(nullptr),
+		_epoch(0),
+		_readers{}
+		/// Creates an empty CopyOnWritePtr.
+		///
+		/// The constructor is constexpr, so that a static
+		/// CopyOnWritePtr is initialized before any code using
+		/// it during the initialization of other static objects.
+	{
+	}
+
+	~CopyOnWritePtr()
+		/// Destroys the CopyOnWritePtr and releases the
+		/// current snapshot.
+	{
+		Snapshot* pSnapshot = _pSnapshot.load();
+		if (pSnapshot) pSnapshot->release();
+	}
+
+	Ptr load() const
+		/// Returns the current snapshot, or a null pointer
+		/// if the CopyOnWritePtr is empty.
+	{
+		if (!_pSnapshot.load(std::memory_order_acquire)) return Ptr();
+
+		// The reader count tells a concurrent store() that the
+		// snapshot must not be released until we hold a reference.
+		unsigned idx = _epoch.load(std::memory_order_relaxed) & 1;
+		_readers[idx].fetch_add(1);
+		Snapshot* pSnapshot = _pSnapshot.load();
+		if (pSnapshot) pSnapshot->duplicate();
+		_readers[idx].fetch_sub(1, std::memory_order_release);
+		return Ptr(pSnapshot);
+	}
+
+	Snapshot* get() const
+		/// Returns the current snapshot, without acquiring a reference.
+		/// Must only be called by a writer, while writers are
+		/// serialized.
+	{
+		return _pSnapshot.load(std::memory_order_relaxed);
+	}
+
+	void store(Snapshot* pSnapshot)
+		/// Publishes the given snapshot, which can be null, and
+		/// releases the previous snapshot. Takes ownership of the
+		/// given snapshot.
+	{
+		Snapshot* pOld = _pSnapshot.exchange(pSnapshot);
+		if (pOld)
+		{
+			synchronize();
+			pOld->release();
+		}
+	}
+
+	bool empty() const
+		/// Returns true iff the CopyOnWritePtr holds no snapshot.
+	{
+		return _pSnapshot.load(std::memory_order_acquire) == 0;
+	}
+
+private:
+	CopyOnWritePtr(const CopyOnWritePtr&);
+	CopyOnWritePtr& operator = (const CopyOnWritePtr&);
+
+	void synchronize()
+		/// Waits until no reader that has loaded the previous snapshot
+		/// is still about to acquire a reference to it.
+		///
+		/// Both reader counts must be observed to be zero after the
+		/// exchange. Flipping the epoch before waiting ensures that
+		/// new readers use the other count, so that the wait
+		/// cannot be starved.
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			unsigned idx = _epoch.fetch_add(1) & 1;
+			while (_readers[idx].load() != 0) Thread::yield();
+		}
+	}
+
+	std::atomic<Snapshot*>   _pSnapshot;
+	std::atomic<unsigned>    _epoch;
+	mutable std::atomic<int> _readers[2];
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CopyOnWritePtr_INCLUDED
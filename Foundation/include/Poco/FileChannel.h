@@ -23,6 +23,7 @@
 #include "Poco/Timestamp.h"
 #include "Poco/Timespan.h"
 #include "Poco/Mutex.h"
+#include <vector>
 
 
 namespace Poco {
@@ -242,8 +243,13 @@ protected:
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
 	void purge();
+	void writeLines(const std::vector<std::string>& lines);
+		/// Writes the given lines to the log file, rotating the
+		/// file first if necessary. Used by AsyncFileChannel to
+		/// write a batch of messages at once.
 
 private:
+	void rotateIfNecessary();
 	bool setNoPurge(const std::string& value);
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
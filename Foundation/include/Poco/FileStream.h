@@ -68,6 +68,10 @@ public:
 	FileStreamBuf* rdbuf();
 		/// Returns a pointer to the underlying streambuf.
 
+	FileStreamBuf::NativeHandle nativeHandle() const;
+		/// Returns the native file descriptor (POSIX) or
+		/// file handle (Windows) of the underlying file.
+
 protected:
 	FileStreamBuf _buf;
 	std::ios::openmode _defaultMode;
@@ -30,6 +30,8 @@ class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf
 	/// This stream buffer handles Fileio
 {
 public:
+	typedef HANDLE NativeHandle;
+
 	FileStreamBuf();
 		/// Creates a FileStreamBuf.
 
@@ -49,6 +51,10 @@ public:
 	std::streampos seekpos(std::streampos pos, std::ios::openmode mode = std::ios::in | std::ios::out);
 		/// change to specified position, according to mode
 
+	NativeHandle nativeHandle() const;
+		/// Returns the native file handle, or INVALID_HANDLE_VALUE
+		/// if the file is not open.
+
 protected:
 	enum
 	{
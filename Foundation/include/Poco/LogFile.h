@@ -19,6 +19,7 @@
 
 
 #include "Poco/Foundation.h"
+#include <vector>
 
 
 #if defined(POCO_OS_FAMILY_WINDOWS)
@@ -47,6 +48,13 @@ public:
 		/// If flush is true, the text will be immediately
 		/// flushed to the file.
 
+	void write(const std::vector<std::string>& lines, bool flush = true);
+		/// Writes the given lines, each followed by a line terminator,
+		/// to the log file. Where the platform supports gathering
+		/// writes, all lines are written with a single system call.
+		/// If flush is true, the lines will be immediately
+		/// flushed to the file.
+
 	UInt64 size() const;
 		/// Returns the current size in bytes of the log file.
 
@@ -67,6 +75,12 @@ inline void LogFile::write(const std::string& text, bool flush)
 }
 
 
+inline void LogFile::write(const std::vector<std::string>& lines, bool flush)
+{
+	writeImpl(lines, flush);
+}
+
+
 inline UInt64 LogFile::size() const
 {
 	return sizeImpl();
@@ -21,6 +21,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
 #include "Poco/FileStream.h"
+#include <vector>
 
 
 namespace Poco {
@@ -35,6 +36,7 @@ public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
 	void writeImpl(const std::string& text, bool flush);
+	void writeImpl(const std::vector<std::string>& lines, bool flush);
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
@@ -23,10 +23,12 @@
 #include "Poco/Message.h"
 #include "Poco/Format.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/CopyOnWritePtr.h"
 #include <map>
 #include <vector>
 #include <cstddef>
 #include <memory>
+#include <atomic>
 
 
 namespace Poco {
@@ -389,6 +391,8 @@ public:
 		/// Returns a reference to the Logger with the given name.
 		/// If the Logger does not yet exist, it is created, based
 		/// on its parent logger.
+		///
+		/// Looking up an existing Logger does not take a lock.
 
 	static Logger& unsafeGet(const std::string& name);
 		/// Returns a reference to the Logger with the given name.
@@ -411,7 +415,7 @@ public:
 		
 	static Ptr has(const std::string& name);
 		/// Returns a pointer to the Logger with the given name if it
-		/// exists, or a null pointer otherwise.
+		/// exists, or a null pointer otherwise. Does not take a lock.
 		
 	static void destroy(const std::string& name);
 		/// Destroys the logger with the specified name. Does nothing
@@ -462,15 +466,21 @@ protected:
 	static Ptr find(const std::string& name);
 
 private:
-	typedef std::unique_ptr<LoggerMap> LoggerMapPtr;
+	typedef CopyOnWritePtr<LoggerMap>::Snapshot LoggerMapPart;
+	typedef std::vector<AutoPtr<LoggerMapPart> > LoggerMapParts;
+	typedef CopyOnWritePtr<LoggerMapParts>      LoggerMapPtr;
+		/// The loggers are kept in immutable maps of decreasing size,
+		/// which are shared by successive snapshots (see add()).
+
+	static Ptr find(const LoggerMapParts& parts, const std::string& name);
 
 	Logger();
 	Logger(const Logger&);
 	Logger& operator = (const Logger&);
 
-	std::string  _name;
-	Channel::Ptr _pChannel;
-	int          _level;
+	std::string      _name;
+	Channel::Ptr     _pChannel;
+	std::atomic<int> _level;
 
 	// definitions in Foundation.cpp
 	static LoggerMapPtr _pLoggerMap;
@@ -625,13 +635,13 @@ inline const std::string& Logger::name() const
 
 inline int Logger::getLevel() const
 {
-	return _level;
+	return _level.load(std::memory_order_relaxed);
 }
 
 
 inline void Logger::log(const std::string& text, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio));
 	}
@@ -640,7 +650,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 
 inline void Logger::log(const std::string& text, Message::Priority prio, const char* file, int line)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		_pChannel->log(Message(_name, text, prio, file, line));
 	}
@@ -746,55 +756,55 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 
 inline bool Logger::is(int level) const
 {
-	return _level >= level;
+	return getLevel() >= level;
 }
 
 
 inline bool Logger::fatal() const
 {
-	return _level >= Message::PRIO_FATAL;
+	return getLevel() >= Message::PRIO_FATAL;
 }
 
 
 inline bool Logger::critical() const
 {
-	return _level >= Message::PRIO_CRITICAL;
+	return getLevel() >= Message::PRIO_CRITICAL;
 }
 
 
 inline bool Logger::error() const
 {
-	return _level >= Message::PRIO_ERROR;
+	return getLevel() >= Message::PRIO_ERROR;
 }
 
 
 inline bool Logger::warning() const
 {
-	return _level >= Message::PRIO_WARNING;
+	return getLevel() >= Message::PRIO_WARNING;
 }
 
 
 inline bool Logger::notice() const
 {
-	return _level >= Message::PRIO_NOTICE;
+	return getLevel() >= Message::PRIO_NOTICE;
 }
 
 
 inline bool Logger::information() const
 {
-	return _level >= Message::PRIO_INFORMATION;
+	return getLevel() >= Message::PRIO_INFORMATION;
 }
 
 
 inline bool Logger::debug() const
 {
-	return _level >= Message::PRIO_DEBUG;
+	return getLevel() >= Message::PRIO_DEBUG;
 }
 
 
 inline bool Logger::trace() const
 {
-	return _level >= Message::PRIO_TRACE;
+	return getLevel() >= Message::PRIO_TRACE;
 }
 
 
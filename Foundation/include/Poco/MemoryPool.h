@@ -21,11 +21,14 @@
 #include "Poco/Foundation.h"
 #include "Poco/Alignment.h"
 #include "Poco/Mutex.h"
+#include "Poco/ThreadCachingAllocator.h"
 #include "Poco/NestedDiagnosticContext.h"
 #include <vector>
 #include <cstring>
 #include <cstddef>
 #include <iostream>
+#include <atomic>
+#include <type_traits>
 
 
 namespace Poco {
@@ -43,11 +46,23 @@ class Foundation_API MemoryPool
 	/// All allocated blocks are retained for future use.
 	/// A limit on the number of blocks can be specified.
 	/// Blocks can be preallocated.
+	///
+	/// A MemoryPool created with threadCaching set obtains its
+	/// blocks from the ThreadCachingAllocator (unless the block
+	/// size exceeds ThreadCachingAllocator::MAX_SIZE), so that
+	/// get() and release() do not lock a mutex. Released blocks are
+	/// then retained by the allocator instead of the pool, and may
+	/// be reused by other pools with a similar block size.
 {
 public:
-	MemoryPool(std::size_t blockSize, int preAlloc = 0, int maxAlloc = 0);
+	MemoryPool(std::size_t blockSize, int preAlloc = 0, int maxAlloc = 0, bool threadCaching = false);
 	/// Creates a MemoryPool for blocks with the given blockSize.
 	/// The number of blocks given in preAlloc are preallocated.
+	///
+	/// If threadCaching is true, the pool is backed by the
+	/// ThreadCachingAllocator, provided the block size does
+	/// not exceed ThreadCachingAllocator::MAX_SIZE. Such a pool
+	/// can neither have a limit nor preallocated blocks.
 
 	~MemoryPool();
 
@@ -57,6 +72,9 @@ public:
 	///
 	/// If maxAlloc blocks are already allocated, an
 	/// OutOfMemoryException is thrown.
+	///
+	/// If the pool is backed by the ThreadCachingAllocator,
+	/// returns a block from the allocator.
 
 	void release(void* ptr);
 	/// Releases a memory block and returns it to the pool.
@@ -66,9 +84,19 @@ public:
 
 	int allocated() const;
 	/// Returns the number of allocated blocks.
+	///
+	/// If the pool is backed by the ThreadCachingAllocator,
+	/// returns the number of blocks currently in use.
 
 	int available() const;
 	/// Returns the number of available blocks in the pool.
+	///
+	/// Always returns 0 if the pool is backed by the
+	/// ThreadCachingAllocator.
+
+	bool threadCaching() const;
+	/// Returns true if the pool is backed by the
+	/// ThreadCachingAllocator.
 
 private:
 	MemoryPool();
@@ -84,11 +112,12 @@ private:
 
 	typedef std::vector<char*> BlockVec;
 
-	std::size_t _blockSize;
-	int         _maxAlloc;
-	int         _allocated;
-	BlockVec    _blocks;
-	FastMutex   _mutex;
+	std::size_t      _blockSize;
+	int              _maxAlloc;
+	std::atomic<int> _allocated;
+	bool             _threadCaching;
+	BlockVec         _blocks;
+	FastMutex        _mutex;
 };
 
 
@@ -113,6 +142,12 @@ inline int MemoryPool::available() const
 }
 
 
+inline bool MemoryPool::threadCaching() const
+{
+	return _threadCaching;
+}
+
+
 //
 // FastMemoryPool
 //
@@ -123,7 +158,17 @@ inline int MemoryPool::available() const
 #define POCO_FAST_MEMORY_POOL_PREALLOC 1000
 
 
-template <typename T, typename M = SpinlockMutex>
+class FastMemoryPoolBuckets
+	/// The default allocation policy of FastMemoryPool: blocks
+	/// are kept in buckets owned by the pool and guarded by
+	/// the pool's mutex.
+	///
+	/// The other supported policy is ThreadCachingAllocator.
+{
+};
+
+
+template <typename T, typename M = SpinlockMutex, typename A = FastMemoryPoolBuckets>
 class FastMemoryPool
 	/// FastMemoryPool is a class for pooling fixed-size blocks of memory.
 	///
@@ -207,7 +252,13 @@ class FastMemoryPool
 	/// parameter, if needed. Poco::NullMutex can be specified as template
 	/// parameter to avoid locking and improve speed in single-threaded
 	/// scenarios.
+	///
+	/// The allocation policy can be specified through the third template
+	/// parameter. See FastMemoryPool<T, M, ThreadCachingAllocator> for
+	/// a pool that does not lock a mutex.
 {
+	static_assert(std::is_same<A, FastMemoryPoolBuckets>::value, "unsupported FastMemoryPool allocation policy");
+
 private:
 	class Block
 		/// A block of memory. This class represents a memory
@@ -406,6 +457,88 @@ private:
 };
 
 
+template <typename T, typename M>
+class FastMemoryPool<T, M, ThreadCachingAllocator>
+	/// A FastMemoryPool that obtains its blocks from the
+	/// ThreadCachingAllocator, instead of keeping them in buckets
+	/// guarded by a mutex. get() and release() take blocks from and
+	/// return them to the calling thread's cache, so that many
+	/// threads can use the pool at the same time without contention.
+	/// The mutex type is not used.
+	///
+	/// Example:
+	///
+	///   Poco::FastMemoryPool<std::string, Poco::SpinlockMutex, Poco::ThreadCachingAllocator> pool;
+	///   std::string* pStr = new (pool.get()) std::string("text");
+	///   pool.release(pStr);
+	///
+	/// Unlike with other FastMemoryPool instances, memory is not
+	/// released when the pool is destroyed (it is retained by the
+	/// allocator), and blocks of the same size class are shared with
+	/// other users of the allocator. All blocks should be released
+	/// before the pool is destroyed. The constructor arguments are
+	/// accepted for compatibility only, and are ignored.
+{
+public:
+	FastMemoryPool(std::size_t /*blocksPerBucket*/ = POCO_FAST_MEMORY_POOL_PREALLOC, std::size_t /*bucketPreAlloc*/ = 10, std::size_t /*maxAlloc*/ = 0):
+		_allocated(0)
+		/// Creates the FastMemoryPool.
+	{
+	}
+
+	~FastMemoryPool()
+		/// Destroys the FastMemoryPool.
+	{
+	}
+
+	void* get()
+		/// Returns pointer to the next available memory block.
+	{
+		void* ptr = ThreadCachingAllocator::allocate(sizeof(T));
+		++_allocated;
+		return ptr;
+	}
+
+	template <typename P>
+	void release(P* ptr)
+		/// Calls the destructor for the given pointer and
+		/// returns the memory block to the allocator.
+		/// Releasing of null pointers is silently ignored.
+	{
+		if (!ptr) return;
+		reinterpret_cast<P*>(ptr)->~P();
+		ThreadCachingAllocator::deallocate(ptr, sizeof(T));
+		--_allocated;
+	}
+
+	std::size_t blockSize() const
+		/// Returns the block size in bytes.
+	{
+		return ThreadCachingAllocator::blockSize(sizeof(T));
+	}
+
+	std::size_t allocated() const
+		/// Returns the number of blocks currently in use.
+	{
+		return _allocated;
+	}
+
+	std::size_t available() const
+		/// Always returns 0, as free blocks are kept by the allocator.
+	{
+		return 0;
+	}
+
+private:
+	FastMemoryPool(const FastMemoryPool&) = delete;
+	FastMemoryPool& operator = (const FastMemoryPool&) = delete;
+	FastMemoryPool(FastMemoryPool&&) = delete;
+	FastMemoryPool& operator = (FastMemoryPool&&) = delete;
+
+	std::atomic<std::size_t> _allocated;
+};
+
+
 } // namespace Poco
 
 
@@ -132,6 +132,9 @@ public:
 	long getTid() const;
 		/// Returns the numeric thread identifier for the message.
 
+	void setOsTid(IntPtr tid);
+		/// Sets the numeric OS thread identifier for the message.
+
 	IntPtr getOsTid() const;
 		/// Returns the numeric OS thread identifier for the message.
 
@@ -193,9 +196,13 @@ public:
 		/// If the parameter does not exist, it is created with an
 		/// empty string value.
 
+	typedef std::map<std::string, std::string> StringMap;
+
+	const StringMap& getAll() const;
+		/// Returns all parameters of the message.
+
 protected:
 	void init();
-	typedef std::map<std::string, std::string> StringMap;
 
 private:
 	std::string _source;
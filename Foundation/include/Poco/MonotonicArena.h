@@ -0,0 +1,287 @@
+//
+// MonotonicArena.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  MonotonicArena
+//
+// Definition of the MonotonicArena and ArenaAllocator classes.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MonotonicArena_INCLUDED
+#define Foundation_MonotonicArena_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Bugcheck.h"
+#include <string>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API MonotonicArena
+	/// A MonotonicArena is a memory resource for objects that
+	/// share the same lifetime, such as all objects belonging to
+	/// a single request.
+	///
+	/// Memory is handed out from large chunks by incrementing a
+	/// pointer; individual allocations are never released. All memory
+	/// is released at once by reset() or when the arena is destroyed.
+	/// Objects created with create() are destroyed at that time, in
+	/// reverse order of their creation.
+	///
+	/// Chunks are obtained from the ThreadCachingAllocator. The size
+	/// of every new chunk is twice the size of the previous chunk, up
+	/// to ThreadCachingAllocator::MAX_SIZE, so that even a large number
+	/// of allocations requires only few chunks. Allocations larger than
+	/// a chunk get a chunk of their own.
+	///
+	/// Standard containers and strings can allocate their memory from
+	/// a MonotonicArena with an ArenaAllocator.
+	///
+	/// A MonotonicArena is not thread-safe.
+{
+public:
+	enum
+	{
+		DEFAULT_CHUNK_SIZE = 4096
+	};
+
+	explicit MonotonicArena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the MonotonicArena. The first chunk, with the given
+		/// size, is allocated with the first allocation.
+
+	~MonotonicArena();
+		/// Destroys all objects created with create() and
+		/// releases all memory.
+
+	void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+		/// Returns a memory block of the given size and alignment,
+		/// which must be a power of two.
+		///
+		/// Throws a std::bad_alloc if no memory is available.
+
+	template <typename T, typename... Args>
+	T* create(Args&&... args);
+		/// Creates an object of type T in the arena, passing the
+		/// given arguments to its constructor. The object is destroyed
+		/// by reset() or when the arena is destroyed, and must not be
+		/// deleted.
+
+	char* copy(const char* str, std::size_t length);
+		/// Copies the given characters into the arena and adds
+		/// a terminating null character.
+
+	char* copy(const std::string& str);
+		/// Copies the given string into the arena and adds
+		/// a terminating null character.
+
+	void reset();
+		/// Destroys all objects created with create() and releases
+		/// all memory, except the first chunk, which is reused.
+
+	std::size_t allocated() const;
+		/// Returns the number of bytes allocated from the arena
+		/// since it has been created or reset.
+
+	std::size_t capacity() const;
+		/// Returns the total size of the chunks owned by the arena.
+
+private:
+	struct Chunk
+	{
+		Chunk*      pNext;
+		std::size_t size;
+	};
+
+	struct Finalizer
+	{
+		void      (*destroy)(void*);
+		void*       pObject;
+		Finalizer*  pNext;
+	};
+
+	MonotonicArena(const MonotonicArena&);
+	MonotonicArena& operator = (const MonotonicArena&);
+
+	void* allocateChunk(std::size_t size, std::size_t alignment);
+	void finalize();
+	void release(Chunk* pChunk);
+
+	template <typename T>
+	static void destroy(void* pObject)
+	{
+		static_cast<T*>(pObject)->~T();
+	}
+
+	char*       _pPos;
+	char*       _pEnd;
+	Chunk*      _pChunks;     /// the most recently allocated chunk first
+	Finalizer*  _pFinalizers; /// the most recently created object first
+	std::size_t _chunkSize;
+	std::size_t _nextChunkSize;
+	std::size_t _allocated;
+	std::size_t _capacity;
+};
+
+
+template <typename T>
+class ArenaAllocator
+	/// An allocator for standard containers and strings that
+	/// allocates memory from a MonotonicArena. Memory is not
+	/// released when the container releases it, but when the
+	/// arena is reset or destroyed.
+	///
+	/// A default-constructed ArenaAllocator, which has no arena,
+	/// allocates memory with operator new.
+	///
+	/// Example:
+	///
+	///     Poco::MonotonicArena arena;
+	///     Poco::ArenaString str("text", Poco::ArenaAllocator<char>(arena));
+	///     std::vector<int, Poco::ArenaAllocator<int> > vec(Poco::ArenaAllocator<int>(arena));
+{
+public:
+	typedef T              value_type;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef std::size_t    size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator():
+		_pArena(0)
+	{
+	}
+
+	explicit ArenaAllocator(MonotonicArena& arena):
+		_pArena(&arena)
+	{
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other):
+		_pArena(other.arena())
+	{
+	}
+
+	T* allocate(std::size_t n)
+	{
+		if (_pArena)
+			return static_cast<T*>(_pArena->allocate(n*sizeof(T), alignof(T)));
+		else
+			return static_cast<T*>(::operator new(n*sizeof(T)));
+	}
+
+	void deallocate(T* ptr, std::size_t /*n*/)
+	{
+		if (!_pArena) ::operator delete(ptr);
+	}
+
+	MonotonicArena* arena() const
+	{
+		return _pArena;
+	}
+
+private:
+	MonotonicArena* _pArena;
+};
+
+
+template <typename T, typename U>
+inline bool operator == (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() == a2.arena();
+}
+
+
+template <typename T, typename U>
+inline bool operator != (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() != a2.arena();
+}
+
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+	/// A string that allocates its memory from a MonotonicArena.
+
+
+//
+// inlines
+//
+inline void* MonotonicArena::allocate(std::size_t size, std::size_t alignment)
+{
+	poco_assert_dbg (alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	std::size_t pos = reinterpret_cast<std::size_t>(_pPos);
+	std::size_t aligned = (pos + alignment - 1) & ~(alignment - 1);
+	if (_pPos && aligned - pos + size <= static_cast<std::size_t>(_pEnd - _pPos))
+	{
+		_pPos = reinterpret_cast<char*>(aligned + size);
+		_allocated += size;
+		return reinterpret_cast<void*>(aligned);
+	}
+	return allocateChunk(size, alignment);
+}
+
+
+template <typename T, typename... Args>
+T* MonotonicArena::create(Args&&... args)
+{
+	Finalizer* pFinalizer = 0;
+	if (!std::is_trivially_destructible<T>::value)
+	{
+		pFinalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+	}
+	T* pObject = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	if (pFinalizer)
+	{
+		pFinalizer->destroy = &MonotonicArena::destroy<T>;
+		pFinalizer->pObject = pObject;
+		pFinalizer->pNext   = _pFinalizers;
+		_pFinalizers = pFinalizer;
+	}
+	return pObject;
+}
+
+
+inline char* MonotonicArena::copy(const std::string& str)
+{
+	return copy(str.data(), str.size());
+}
+
+
+inline std::size_t MonotonicArena::allocated() const
+{
+	return _allocated;
+}
+
+
+inline std::size_t MonotonicArena::capacity() const
+{
+	return _capacity;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MonotonicArena_INCLUDED
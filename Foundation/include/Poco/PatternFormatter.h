@@ -27,6 +27,9 @@
 namespace Poco {
 
 
+class DateTime;
+
+
 class Foundation_API PatternFormatter: public Formatter
 	/// This Formatter allows for custom formatting of
 	/// log messages based on format patterns.
@@ -75,6 +78,13 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// The pattern is compiled into a sequence of steps when it is set.
+	/// Consecutive literal text and fields that only change once per
+	/// second (such as the date, time of day, time zone and host name)
+	/// are rendered together once per second and thread, and cached.
+	/// Formatting a message then only appends the cached text, the
+	/// fractional seconds and the fields taken from the message.
 
 {
 public:
@@ -94,7 +104,10 @@ public:
 
 	void format(const Message& msg, std::string& text);
 		/// Formats the message according to the specified
-		/// format pattern and places the result in text.
+		/// format pattern and appends the result to text.
+		///
+		/// As text is not cleared, the same string can be
+		/// reused as buffer for formatting many messages.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name to the given value.
@@ -127,24 +140,61 @@ protected:
 private:
 	struct PatternAction
 	{
-		PatternAction(): key(0), length(0)
+		PatternAction(): key(0), length(0), localTime(false)
 		{
 		}
 
 		char key;
 		int length;
+		bool localTime;
 		std::string property;
 		std::string prepend;
 	};
 
+	enum StepType
+	{
+		STEP_LITERAL,  /// append the literal text of the step
+		STEP_CACHED,   /// append a segment rendered once per second
+		STEP_FIELD     /// append a field of the message
+	};
+
+	struct PatternStep
+	{
+		StepType    type;
+		std::size_t first;   /// the first action of the step
+		std::size_t last;    /// one past the last action of the step
+		std::size_t segment; /// index of the cached segment (STEP_CACHED)
+		std::string text;    /// literal text (STEP_LITERAL)
+	};
+
 	void parsePattern();
-		/// Will parse the _pattern string into the vector of PatternActions,
-		/// which contains the message key, any text that needs to be written first
-		/// a property in case of %[] and required length.
+		/// Parses the pattern into a list of actions, and
+		/// compiles the actions into steps.
+
+	void compilePattern();
 
 	void parsePriorityNames();
 
+	void renderSegments(const Message& msg, std::vector<std::string>& segments) const;
+		/// Renders all cached segments for the second of
+		/// the message's timestamp.
+
+	void appendTimeField(const PatternAction& action, const DateTime& dateTime, std::string& text) const;
+	void appendMessageField(const PatternAction& action, const Message& msg, std::string& text);
+
+	enum FieldType
+	{
+		FIELD_NONE,    /// literal text only
+		FIELD_TIME,    /// changes at most once per second
+		FIELD_MESSAGE  /// taken from the message, or fractional seconds
+	};
+
+	static FieldType fieldType(char key);
+
 	std::vector<PatternAction> _patternActions;
+	std::vector<PatternStep> _steps;
+	std::size_t _segmentCount;
+	UInt64 _planId;
 	bool _localTime;
 	std::string _pattern;
 	std::string _priorityNames;
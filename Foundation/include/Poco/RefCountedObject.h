@@ -249,22 +249,22 @@ inline int RefCounter::operator++(int)
 inline int RefCounter::operator--()
 {
 #ifdef ENABLE_REFCOUNT_DC
-	int c = _counter.fetch_sub(1, std::memory_order_acquire) - 1;
+	int c = _counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
 	poco_rcdc_log;
 	return c;
 #endif
-	return _counter.fetch_sub(1, std::memory_order_acquire) - 1;
+	return _counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
 }
 
 
 inline int RefCounter::operator--(int)
 {
 #ifdef ENABLE_REFCOUNT_DC
-	int c = _counter.fetch_sub(1, std::memory_order_acquire);
+	int c = _counter.fetch_sub(1, std::memory_order_acq_rel);
 	poco_rcdc_log;
 	return c;
 #endif
-	return _counter.fetch_sub(1, std::memory_order_acquire);
+	return _counter.fetch_sub(1, std::memory_order_acq_rel);
 }
 
 
@@ -418,7 +418,7 @@ private:
 	mutable RefCounter _weakCounter;
 
 	friend class WeakRefCountedObject;
-	template <typename T, class M> friend class FastMemoryPool;
+	template <typename T, class M, class A> friend class FastMemoryPool;
 };
 
 //
@@ -556,7 +556,7 @@ private:
 	mutable std::atomic<WeakRefCounter*> _pCounter;
 
 	friend class RefCountDiagnosticContext;
-	template <typename T, class M> friend class FastMemoryPool;
+	template <typename T, class M, class A> friend class FastMemoryPool;
 };
 
 
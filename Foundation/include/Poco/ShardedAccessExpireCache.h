@@ -0,0 +1,64 @@
+//
+// ShardedAccessExpireCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ShardedAccessExpireCache
+//
+// Definition of the ShardedAccessExpireCache class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedAccessExpireCache_INCLUDED
+#define Foundation_ShardedAccessExpireCache_INCLUDED
+
+
+#include "Poco/ShardedCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = std::hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ShardedAccessExpireCache: public ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>
+	/// A ShardedAccessExpireCache caches entries for a fixed time period
+	/// (per default 10 minutes) after they have last been accessed,
+	/// for many concurrent threads (see ShardedCache).
+	///
+	/// Be careful when using a ShardedAccessExpireCache. A cache is often used
+	/// like cache.has(x) followed by cache.get(x). Note that it could happen
+	/// that the "has" call works, then the current execution thread gets descheduled, time passes,
+	/// the entry gets invalid, thus leading to an empty SharedPtr being returned
+	/// when "get" is invoked.
+{
+public:
+	ShardedAccessExpireCache(Timestamp::TimeDiff expire = 600000, std::size_t shards = ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::DEFAULT_SHARDS):
+		ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>(0, 0, typename ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::Weigher(), expire, true, shards)
+	{
+	}
+
+	~ShardedAccessExpireCache()
+	{
+	}
+
+private:
+	ShardedAccessExpireCache(const ShardedAccessExpireCache& aCache);
+	ShardedAccessExpireCache& operator = (const ShardedAccessExpireCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedAccessExpireCache_INCLUDED
@@ -0,0 +1,424 @@
+//
+// ShardedCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ShardedCache
+//
+// Definition of the ShardedCache class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedCache_INCLUDED
+#define Foundation_ShardedCache_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/KeyValueArgs.h"
+#include "Poco/BasicEvent.h"
+#include "Poco/EventArgs.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Clock.h"
+#include "Poco/Timestamp.h"
+#include <unordered_map>
+#include <functional>
+#include <list>
+#include <set>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = std::hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ShardedCache
+	/// A ShardedCache is a cache for many concurrent threads.
+	///
+	/// Unlike AbstractCache, which keeps all entries in a single map
+	/// protected by a single mutex, a ShardedCache distributes its
+	/// entries by hash value over a number of shards, each with its own
+	/// mutex (lock striping), so that threads accessing different
+	/// shards never contend. Within a shard, entries are kept in a hash
+	/// table and a list ordered by insertion or last access, so that all
+	/// operations, including eviction, take constant time.
+	///
+	/// Entries are evicted in list order (oldest or least recently
+	/// used first):
+	///   - if the shard holds more than its share of maxEntries entries,
+	///   - if the total weight of the entries in the shard exceeds its
+	///     share of maxBytes, as determined by a Weigher function, or
+	///   - if the entry has expired, i.e., more than expire milliseconds
+	///     have passed since the entry has been added or updated (or
+	///     accessed, if refreshOnAccess is true).
+	///
+	/// Since the limits apply per shard, eviction only approximates a
+	/// global LRU or FIFO order. Use a single shard if exact order
+	/// is required.
+	///
+	/// Expired entries are removed when they are accessed, when
+	/// entries are added to their shard, or by forceReplace().
+	///
+	/// The cache fires the same events as AbstractCache (Add, Update,
+	/// Remove, Get and Clear). Events without delegates cost almost
+	/// nothing. The events are fired while the shard is locked;
+	/// delegates must not call back into the cache.
+	///
+	/// For the common configurations, see ShardedLRUCache,
+	/// ShardedExpireCache and ShardedAccessExpireCache.
+{
+public:
+	BasicEvent<const KeyValueArgs<TKey, TValue>, TEventMutex> Add;
+	BasicEvent<const KeyValueArgs<TKey, TValue>, TEventMutex> Update;
+	BasicEvent<const TKey, TEventMutex>                       Remove;
+	BasicEvent<const TKey, TEventMutex>                       Get;
+	BasicEvent<const EventArgs, TEventMutex>                  Clear;
+
+	typedef std::function<std::size_t (const TKey&, const TValue&)> Weigher;
+		/// Returns the size of an entry in bytes, for the maxBytes limit.
+
+	enum
+	{
+		DEFAULT_SHARDS = 16
+	};
+
+	ShardedCache(std::size_t maxEntries, std::size_t maxBytes, const Weigher& weigher, Timestamp::TimeDiff expire, bool refreshOnAccess, std::size_t shards = DEFAULT_SHARDS):
+		_pShards(0),
+		_shardCount(1),
+		_maxShardEntries(0),
+		_maxShardBytes(0),
+		_weigher(weigher),
+		_expire(expire*1000),
+		_refreshOnAccess(refreshOnAccess)
+		/// Creates the ShardedCache.
+		///
+		/// maxEntries and maxBytes limit the number of entries and their
+		/// total weight; 0 means unlimited. If maxBytes is given, but no
+		/// weigher, every entry weighs sizeof(TKey) + sizeof(TValue) bytes.
+		/// expire is the lifetime of an entry in milliseconds; 0 means
+		/// entries never expire. If refreshOnAccess is true, get()
+		/// makes an entry the most recently used one and restarts its
+		/// lifetime. The number of shards is rounded up to a power of two.
+	{
+		while (_shardCount < shards) _shardCount *= 2;
+		if (maxEntries) _maxShardEntries = (maxEntries + _shardCount - 1)/_shardCount;
+		if (maxBytes) _maxShardBytes = (maxBytes + _shardCount - 1)/_shardCount;
+		_pShards = new Shard[_shardCount];
+	}
+
+	virtual ~ShardedCache()
+	{
+		delete [] _pShards;
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		add(key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void add(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten.
+	{
+		poco_check_ptr (val.get());
+
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::iterator it = shard.index.find(key);
+		if (it != shard.index.end()) erase(shard, it->second);
+		insert(shard, key, val);
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache, or replaces the value
+		/// of an existing entry. In contrast to add(), an existing entry
+		/// is not removed, but an Update event is fired.
+	{
+		update(key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void update(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache, or replaces the value
+		/// of an existing entry. Note that adding a NULL SharedPtr will fail!
+	{
+		poco_check_ptr (val.get());
+
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::iterator it = shard.index.find(key);
+		if (it == shard.index.end())
+		{
+			insert(shard, key, val);
+		}
+		else
+		{
+			typename EntryList::iterator itEntry = it->second;
+			KeyValueArgs<TKey, TValue> args(key, *val);
+			Update.notify(this, args);
+			std::size_t bytes = weigh(key, *val);
+			shard.bytes += bytes;
+			shard.bytes -= itEntry->bytes;
+			itEntry->pValue  = val;
+			itEntry->bytes   = bytes;
+			itEntry->expires = expiry();
+			shard.entries.splice(shard.entries.end(), shard.entries, itEntry);
+			evict(shard);
+		}
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::iterator it = shard.index.find(key);
+		if (it != shard.index.end()) erase(shard, it->second);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a valid value for the key.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::const_iterator it = shard.index.find(key);
+		return it != shard.index.end() && !expired(*it->second, Clock());
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for the key no value exists, an empty SharedPtr is returned.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Index::iterator it = shard.index.find(key);
+		if (it == shard.index.end()) return SharedPtr<TValue>();
+
+		typename EntryList::iterator itEntry = it->second;
+		if (_expire)
+		{
+			Clock now;
+			if (expired(*itEntry, now))
+			{
+				erase(shard, itEntry);
+				return SharedPtr<TValue>();
+			}
+			if (_refreshOnAccess) itEntry->expires = now.raw() + _expire;
+		}
+		if (_refreshOnAccess)
+		{
+			shard.entries.splice(shard.entries.end(), shard.entries, itEntry);
+		}
+		Get.notify(this, key);
+		return itEntry->pValue;
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+	{
+		static const EventArgs emptyArgs;
+		Clear.notify(this, emptyArgs);
+		for (std::size_t i = 0; i < _shardCount; ++i)
+		{
+			typename TMutex::ScopedLock lock(_pShards[i].mutex);
+			_pShards[i].index.clear();
+			_pShards[i].entries.clear();
+			_pShards[i].bytes = 0;
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of cached elements, after
+		/// removing expired elements.
+	{
+		std::size_t result = 0;
+		for (std::size_t i = 0; i < _shardCount; ++i)
+		{
+			typename TMutex::ScopedLock lock(_pShards[i].mutex);
+			evict(_pShards[i]);
+			result += _pShards[i].index.size();
+		}
+		return result;
+	}
+
+	std::size_t bytes()
+		/// Returns the total weight of the cached elements, after
+		/// removing expired elements. Returns 0 if the cache
+		/// has no maxBytes limit.
+	{
+		std::size_t result = 0;
+		for (std::size_t i = 0; i < _shardCount; ++i)
+		{
+			typename TMutex::ScopedLock lock(_pShards[i].mutex);
+			evict(_pShards[i]);
+			result += _pShards[i].bytes;
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Removes all expired elements from the cache.
+	{
+		for (std::size_t i = 0; i < _shardCount; ++i)
+		{
+			typename TMutex::ScopedLock lock(_pShards[i].mutex);
+			evict(_pShards[i]);
+		}
+	}
+
+	std::set<TKey> getAllKeys()
+		/// Returns a copy of all keys stored in the cache,
+		/// after removing expired elements.
+	{
+		std::set<TKey> result;
+		for (std::size_t i = 0; i < _shardCount; ++i)
+		{
+			typename TMutex::ScopedLock lock(_pShards[i].mutex);
+			evict(_pShards[i]);
+			for (typename EntryList::const_iterator it = _pShards[i].entries.begin(); it != _pShards[i].entries.end(); ++it)
+			{
+				result.insert(it->key);
+			}
+		}
+		return result;
+	}
+
+	std::size_t shards() const
+		/// Returns the number of shards.
+	{
+		return _shardCount;
+	}
+
+protected:
+	struct Entry
+	{
+		TKey              key;
+		SharedPtr<TValue> pValue;
+		std::size_t       bytes;
+		Clock::ClockVal   expires;
+	};
+
+	typedef std::list<Entry> EntryList;
+	typedef std::unordered_map<TKey, typename EntryList::iterator, THash> Index;
+
+	struct Shard
+	{
+		Shard(): bytes(0)
+		{
+		}
+
+		mutable TMutex mutex;
+		EntryList      entries; /// oldest or least recently used entry first
+		Index          index;
+		std::size_t    bytes;
+	};
+
+	Shard& shardFor(const TKey& key) const
+	{
+		// spread the hash value, as std::hash often is the identity
+		UInt64 h = static_cast<UInt64>(_hash(key))*0x9E3779B97F4A7C15ULL;
+		return _pShards[static_cast<std::size_t>(h >> 32) & (_shardCount - 1)];
+	}
+
+	std::size_t weigh(const TKey& key, const TValue& val) const
+	{
+		if (!_maxShardBytes) return 0;
+		return _weigher ? _weigher(key, val) : sizeof(TKey) + sizeof(TValue);
+	}
+
+	Clock::ClockVal expiry() const
+	{
+		return _expire ? Clock().raw() + _expire : 0;
+	}
+
+	bool expired(const Entry& entry, const Clock& now) const
+	{
+		return _expire && now.raw() >= entry.expires;
+	}
+
+	void insert(Shard& shard, const TKey& key, const SharedPtr<TValue>& val)
+	{
+		KeyValueArgs<TKey, TValue> args(key, *val);
+		Add.notify(this, args);
+		Entry entry;
+		entry.key     = key;
+		entry.pValue  = val;
+		entry.bytes   = weigh(key, *val);
+		entry.expires = expiry();
+		typename EntryList::iterator itEntry = shard.entries.insert(shard.entries.end(), entry);
+		try
+		{
+			shard.index[key] = itEntry;
+		}
+		catch (...)
+		{
+			shard.entries.erase(itEntry);
+			throw;
+		}
+		shard.bytes += entry.bytes;
+		evict(shard);
+	}
+
+	void erase(Shard& shard, typename EntryList::iterator itEntry)
+	{
+		Remove.notify(this, itEntry->key);
+		shard.bytes -= itEntry->bytes;
+		shard.index.erase(itEntry->key);
+		shard.entries.erase(itEntry);
+	}
+
+	void evict(Shard& shard)
+		/// Removes entries from the front of the list while the shard
+		/// exceeds its limits or the front entry has expired. As all
+		/// entries have the same lifetime, the list is ordered by
+		/// expiration time as well.
+	{
+		if (shard.entries.empty()) return;
+		if (_maxShardEntries)
+		{
+			while (shard.index.size() > _maxShardEntries) erase(shard, shard.entries.begin());
+		}
+		if (_maxShardBytes)
+		{
+			while (shard.bytes > _maxShardBytes && !shard.entries.empty()) erase(shard, shard.entries.begin());
+		}
+		if (_expire)
+		{
+			Clock now;
+			while (!shard.entries.empty() && expired(shard.entries.front(), now)) erase(shard, shard.entries.begin());
+		}
+	}
+
+private:
+	ShardedCache(const ShardedCache& aCache);
+	ShardedCache& operator = (const ShardedCache& aCache);
+
+	Shard*              _pShards;
+	std::size_t         _shardCount;
+	std::size_t         _maxShardEntries;
+	std::size_t         _maxShardBytes;
+	Weigher             _weigher;
+	Clock::ClockDiff    _expire;
+	bool                _refreshOnAccess;
+	THash               _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedCache_INCLUDED
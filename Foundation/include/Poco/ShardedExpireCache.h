@@ -0,0 +1,64 @@
+//
+// ShardedExpireCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ShardedExpireCache
+//
+// Definition of the ShardedExpireCache class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedExpireCache_INCLUDED
+#define Foundation_ShardedExpireCache_INCLUDED
+
+
+#include "Poco/ShardedCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = std::hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ShardedExpireCache: public ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>
+	/// A ShardedExpireCache caches entries for a fixed time period
+	/// (per default 10 minutes) after they have been added or updated,
+	/// for many concurrent threads (see ShardedCache).
+	///
+	/// Be careful when using a ShardedExpireCache. A cache is often used
+	/// like cache.has(x) followed by cache.get(x). Note that it could happen
+	/// that the "has" call works, then the current execution thread gets descheduled, time passes,
+	/// the entry gets invalid, thus leading to an empty SharedPtr being returned
+	/// when "get" is invoked.
+{
+public:
+	ShardedExpireCache(Timestamp::TimeDiff expire = 600000, std::size_t shards = ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::DEFAULT_SHARDS):
+		ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>(0, 0, typename ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::Weigher(), expire, false, shards)
+	{
+	}
+
+	~ShardedExpireCache()
+	{
+	}
+
+private:
+	ShardedExpireCache(const ShardedExpireCache& aCache);
+	ShardedExpireCache& operator = (const ShardedExpireCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedExpireCache_INCLUDED
@@ -0,0 +1,76 @@
+//
+// ShardedLRUCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ShardedLRUCache
+//
+// Definition of the ShardedLRUCache class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedLRUCache_INCLUDED
+#define Foundation_ShardedLRUCache_INCLUDED
+
+
+#include "Poco/ShardedCache.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = std::hash<TKey>,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class ShardedLRUCache: public ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>
+	/// A ShardedLRUCache implements Least Recently Used caching for
+	/// many concurrent threads (see ShardedCache). The default size
+	/// for a cache is 1024 entries.
+	///
+	/// The cache can also be limited by the total size of its entries
+	/// in bytes, as determined by a weigher function:
+	///
+	///     Poco::ShardedLRUCache<std::string, std::string> cache(0, 64*1024*1024,
+	///         [](const std::string& key, const std::string& value)
+	///         {
+	///             return key.size() + value.size();
+	///         });
+{
+public:
+	typedef typename ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::Weigher Weigher;
+
+	ShardedLRUCache(std::size_t size = 1024, std::size_t shards = ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::DEFAULT_SHARDS):
+		ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>(size, 0, Weigher(), 0, true, shards)
+	{
+	}
+
+	ShardedLRUCache(std::size_t size, std::size_t maxBytes, const Weigher& weigher, std::size_t shards = ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>::DEFAULT_SHARDS):
+		ShardedCache<TKey, TValue, THash, TMutex, TEventMutex>(size, maxBytes, weigher, 0, true, shards)
+		/// Creates a ShardedLRUCache limited to size entries (0 means
+		/// unlimited) and maxBytes bytes, as determined by the weigher.
+	{
+	}
+
+	~ShardedLRUCache()
+	{
+	}
+
+private:
+	ShardedLRUCache(const ShardedLRUCache& aCache);
+	ShardedLRUCache& operator = (const ShardedLRUCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedLRUCache_INCLUDED
@@ -33,6 +33,7 @@ namespace Poco {
 
 class Notification;
 class Exception;
+class WorkStealingExecutor;
 
 
 class Foundation_API TaskManager
@@ -58,6 +59,15 @@ public:
 		/// Creates the TaskManager, using the
 		/// given ThreadPool.
 
+	TaskManager(WorkStealingExecutor& executor);
+		/// Creates the TaskManager, using the given
+		/// WorkStealingExecutor instead of a ThreadPool.
+		///
+		/// Tasks are queued until a worker thread of the
+		/// executor becomes available, so start() does not
+		/// fail if all worker threads are busy. The cpu argument
+		/// of start() is ignored.
+
 	~TaskManager();
 		/// Destroys the TaskManager.
 
@@ -81,9 +91,9 @@ public:
 		/// in the TaskManager's thread pool.
 		///
 		/// Note: joinAll() will wait for ALL tasks in the
-		/// TaskManager's ThreadPool to complete. If the
-		/// ThreadPool has threads created by other
-		/// facilities, these threads must also complete
+		/// TaskManager's ThreadPool (or WorkStealingExecutor)
+		/// to complete. If the ThreadPool has threads created
+		/// by other facilities, these threads must also complete
 		/// before joinAll() can return.
 
 	TaskList taskList() const;
@@ -115,7 +125,8 @@ protected:
 	void taskFailed(Task* pTask, const Exception& exc);
 
 private:
-	ThreadPool&        _threadPool;
+	ThreadPool*           _pThreadPool;
+	WorkStealingExecutor* _pExecutor;
 	TaskList           _taskList;
 	Timestamp          _lastProgressNotification;
 	NotificationCenter _nc;
@@ -0,0 +1,121 @@
+//
+// ThreadCachingAllocator.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  ThreadCachingAllocator
+//
+// Definition of the ThreadCachingAllocator and ThreadCachingBufferAllocator classes.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ThreadCachingAllocator_INCLUDED
+#define Foundation_ThreadCachingAllocator_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <ios>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API ThreadCachingAllocator
+	/// A general purpose allocator for small and medium sized
+	/// memory blocks, which scales with the number of threads.
+	///
+	/// Block sizes are rounded up to one of a fixed set of size
+	/// classes (multiples of 16 bytes up to 128 bytes, then four
+	/// classes for every power of two, up to MAX_SIZE bytes).
+	/// Every thread keeps a cache of free blocks for every size
+	/// class, from which blocks are allocated and to which they are
+	/// released without any locking. A thread cache exchanges blocks
+	/// with a central arena in batches only, when it runs empty or
+	/// holds too many blocks, so that the lock of a size class in the
+	/// central arena is taken once for a whole batch of blocks.
+	/// The central arena obtains memory from the system in large slabs.
+	///
+	/// Blocks may be released by a different thread than the one that
+	/// allocated them. When a thread terminates, its cached blocks
+	/// are returned to the central arena.
+	///
+	/// Like MemoryPool, the allocator retains all memory for future
+	/// use; memory is not returned to the system. Blocks larger than
+	/// MAX_SIZE are allocated and released with operator new and
+	/// operator delete.
+	///
+	/// Blocks are aligned to 16 bytes (or the alignment guaranteed by
+	/// operator new, if less).
+	///
+	/// The ThreadCachingAllocator backs MemoryPool objects created
+	/// with threadCaching set, and the
+	/// FastMemoryPool<T, M, ThreadCachingAllocator> specialization.
+	/// With the ThreadCachingBufferAllocator adapter, it can be used
+	/// as the BufferAllocator of BasicBufferedStreamBuf.
+{
+public:
+	enum
+	{
+		MAX_SIZE    = 65536, /// largest block size served from a size class
+		CLASS_COUNT = 44     /// number of size classes
+	};
+
+	static void* allocate(std::size_t size);
+		/// Returns a memory block of at least the given size.
+		///
+		/// Throws a std::bad_alloc if no memory is available.
+
+	static void deallocate(void* ptr, std::size_t size);
+		/// Releases a memory block obtained from allocate().
+		/// The given size must be the size that has been passed
+		/// to allocate(). Releasing a null pointer does nothing.
+
+	static std::size_t blockSize(std::size_t size);
+		/// Returns the actual size of a block allocated
+		/// for the given size.
+
+	static void flush();
+		/// Returns all blocks cached by the calling thread
+		/// to the central arena.
+
+	static std::size_t cached();
+		/// Returns the number of free blocks cached by
+		/// the calling thread.
+
+private:
+	ThreadCachingAllocator();
+	ThreadCachingAllocator(const ThreadCachingAllocator&);
+	ThreadCachingAllocator& operator = (const ThreadCachingAllocator&);
+};
+
+
+template <typename ch>
+class ThreadCachingBufferAllocator
+	/// A BufferAllocator that obtains buffers from
+	/// the ThreadCachingAllocator.
+{
+public:
+	typedef ch char_type;
+
+	static char_type* allocate(std::streamsize size)
+	{
+		return static_cast<char_type*>(ThreadCachingAllocator::allocate(static_cast<std::size_t>(size)*sizeof(char_type)));
+	}
+
+	static void deallocate(char_type* ptr, std::streamsize size) throw()
+	{
+		ThreadCachingAllocator::deallocate(ptr, static_cast<std::size_t>(size)*sizeof(char_type));
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ThreadCachingAllocator_INCLUDED
@@ -0,0 +1,293 @@
+//
+// WorkStealingExecutor.h
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Definition of the WorkStealingExecutor class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_WorkStealingExecutor_INCLUDED
+#define Foundation_WorkStealingExecutor_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/ActiveResult.h"
+#include "Poco/ActiveRunnable.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <utility>
+
+
+namespace Poco {
+
+
+class Runnable;
+
+
+class Foundation_API WorkStealingExecutor
+	/// A WorkStealingExecutor runs Runnable objects on a fixed
+	/// number of worker threads, as an alternative to ThreadPool
+	/// for large numbers of short tasks.
+	///
+	/// Every worker thread owns a double-ended work queue
+	/// (a Chase-Lev deque). Tasks started from a worker thread are
+	/// pushed to the worker's own queue, from which the worker
+	/// takes them in LIFO order, without any locking. Tasks started
+	/// from other threads are placed in a global injection queue.
+	/// A worker that runs out of work takes tasks from the injection
+	/// queue, or steals them from the other end of another worker's
+	/// queue. Idle workers wait on a condition until new work arrives.
+	///
+	/// Unlike ThreadPool::start(), start() never blocks and never
+	/// throws a NoThreadAvailableException. Tasks are queued until
+	/// a worker becomes available.
+	///
+	/// Tasks should not block for a long time, as a blocked task
+	/// occupies its worker thread.
+	///
+	/// submit() runs a function object (e.g., a lambda) and returns
+	/// an ActiveResult for its return value.
+	///
+	/// TaskManager, ActiveDispatcher and Net::TCPServerDispatcher
+	/// can use a WorkStealingExecutor instead of a ThreadPool. For
+	/// ActiveMethod, the ExecutorStarter policy class runs the method
+	/// on the default executor.
+{
+public:
+	WorkStealingExecutor(int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingExecutor with the given number of
+		/// worker threads. If threads is 0, one worker thread for
+		/// every processor is created.
+
+	WorkStealingExecutor(const std::string& name, int threads = 0, int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingExecutor with the given name and
+		/// number of worker threads. If threads is 0, one worker thread
+		/// for every processor is created.
+		///
+		/// The name is used as the prefix for the names of the
+		/// worker threads.
+
+	~WorkStealingExecutor();
+		/// Waits until all queued tasks have completed, then stops
+		/// and destroys the worker threads.
+
+	void start(Runnable& target);
+		/// Queues the given Runnable for execution by a worker thread.
+		///
+		/// The Runnable must remain valid until its run() method
+		/// has returned. Exceptions thrown by the Runnable are
+		/// passed to the ErrorHandler.
+
+	template <class Function>
+	ActiveResult<decltype(std::declval<Function>()())> submit(const Function& function);
+		/// Queues the given function object for execution by a
+		/// worker thread, and returns an ActiveResult that receives
+		/// the function's result or exception.
+
+	void joinAll();
+		/// Waits until all queued and running tasks have completed,
+		/// including tasks started by these tasks.
+		///
+		/// Must not be called from a task.
+
+	int capacity() const;
+		/// Returns the number of worker threads.
+
+	int pending() const;
+		/// Returns the number of tasks that have been started
+		/// but have not completed yet.
+
+	const std::string& name() const;
+		/// Returns the name of the executor, or an empty string
+		/// if no name has been specified in the constructor.
+
+	static WorkStealingExecutor& defaultExecutor();
+		/// Returns a reference to the default executor, which
+		/// has one worker thread for every processor.
+
+private:
+	class Worker;
+	class Deque;
+
+	WorkStealingExecutor(const WorkStealingExecutor&);
+	WorkStealingExecutor& operator = (const WorkStealingExecutor&);
+
+	void init(int threads, int stackSize);
+	Worker* currentWorker() const;
+	Runnable* take(Worker& worker);
+	bool hasWork() const;
+	bool park();
+	void execute(Runnable* pRunnable);
+	void wakeUp();
+
+	enum
+	{
+		PARK_TIMEOUT = 100
+	};
+
+	typedef std::vector<Worker*> WorkerVec;
+	typedef std::deque<Runnable*> InjectionQueue;
+
+	std::string        _name;
+	WorkerVec          _workers;
+	InjectionQueue     _injectionQueue;
+	std::atomic<int>   _injected;
+	mutable FastMutex  _injectionMutex;
+	std::atomic<int>   _pending;
+	std::atomic<int>   _parked;
+	std::atomic<bool>  _stopped;
+	FastMutex          _parkMutex;
+	Condition          _parkCondition;
+	FastMutex          _joinMutex;
+	Condition          _joinCondition;
+};
+
+
+template <class ResultType, class Function>
+class ExecutorRunnable: public ActiveRunnableBase
+	/// This class is used by WorkStealingExecutor::submit().
+{
+public:
+	typedef ActiveResult<ResultType> ActiveResultType;
+
+	ExecutorRunnable(const Function& function, const ActiveResultType& result):
+		_function(function),
+		_result(result)
+	{
+	}
+
+	void run()
+	{
+		ActiveRunnableBase::Ptr guard(this, false); // ensure automatic release when done
+		try
+		{
+			_result.data(new ResultType(_function()));
+		}
+		catch (Exception& e)
+		{
+			_result.error(e);
+		}
+		catch (std::exception& e)
+		{
+			_result.error(e.what());
+		}
+		catch (...)
+		{
+			_result.error("unknown exception");
+		}
+		_result.notify();
+	}
+
+private:
+	Function _function;
+	ActiveResultType _result;
+};
+
+
+template <class Function>
+class ExecutorRunnable<void, Function>: public ActiveRunnableBase
+	/// This class is used by WorkStealingExecutor::submit().
+{
+public:
+	typedef ActiveResult<void> ActiveResultType;
+
+	ExecutorRunnable(const Function& function, const ActiveResultType& result):
+		_function(function),
+		_result(result)
+	{
+	}
+
+	void run()
+	{
+		ActiveRunnableBase::Ptr guard(this, false); // ensure automatic release when done
+		try
+		{
+			_function();
+		}
+		catch (Exception& e)
+		{
+			_result.error(e);
+		}
+		catch (std::exception& e)
+		{
+			_result.error(e.what());
+		}
+		catch (...)
+		{
+			_result.error("unknown exception");
+		}
+		_result.notify();
+	}
+
+private:
+	Function _function;
+	ActiveResultType _result;
+};
+
+
+template <class OwnerType>
+class ExecutorStarter
+	/// An implementation of the StarterType policy for
+	/// ActiveMethod that runs the method on the default
+	/// WorkStealingExecutor.
+{
+public:
+	static void start(OwnerType* /*pOwner*/, ActiveRunnableBase::Ptr pRunnable)
+	{
+		pRunnable->duplicate(); // The runnable will release itself.
+		WorkStealingExecutor::defaultExecutor().start(*pRunnable);
+	}
+};
+
+
+//
+// inlines
+//
+template <class Function>
+ActiveResult<decltype(std::declval<Function>()())> WorkStealingExecutor::submit(const Function& function)
+{
+	typedef decltype(std::declval<Function>()()) ResultType;
+
+	ActiveResult<ResultType> result(new ActiveResultHolder<ResultType>());
+	ActiveRunnableBase::Ptr pRunnable(new ExecutorRunnable<ResultType, Function>(function, result));
+	pRunnable->duplicate(); // The runnable will release itself.
+	start(*pRunnable);
+	return result;
+}
+
+
+inline int WorkStealingExecutor::capacity() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingExecutor::pending() const
+{
+	return _pending;
+}
+
+
+inline const std::string& WorkStealingExecutor::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingExecutor_INCLUDED
@@ -0,0 +1,137 @@
+//
+// EventBenchmark.cpp
+//
+// This sample shows a benchmark of event notification with
+// BasicEvent and FIFOEvent, compared to an event that copies
+// its delegates for every notification.
+//
+// Copyright (c) 2006-2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BasicEvent.h"
+#include "Poco/FIFOEvent.h"
+#include "Poco/DefaultStrategy.h"
+#include "Poco/AbstractDelegate.h"
+#include "Poco/Delegate.h"
+#include "Poco/Mutex.h"
+#include "Poco/Thread.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <string>
+#include <atomic>
+
+
+class CopyingEvent
+	/// An event that locks its mutex and copies the strategy for
+	/// every notification, as AbstractEvent did before it kept its
+	/// delegates in a copy-on-write snapshot. Used as the baseline.
+{
+public:
+	void operator += (const Poco::AbstractDelegate<int>& aDelegate)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_strategy.add(aDelegate);
+	}
+
+	void notify(const void* pSender, int& args)
+	{
+		Poco::ScopedLockWithUnlock<Poco::FastMutex> lock(_mutex);
+		Poco::DefaultStrategy<int, Poco::AbstractDelegate<int> > strategy(_strategy);
+		lock.unlock();
+		strategy.notify(pSender, args);
+	}
+
+private:
+	Poco::DefaultStrategy<int, Poco::AbstractDelegate<int> > _strategy;
+	Poco::FastMutex _mutex;
+};
+
+
+class Target
+{
+public:
+	Target(): _sum(0)
+	{
+	}
+
+	void onEvent(const void* pSender, int& args)
+	{
+		_sum.fetch_add(args, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<long> _sum;
+};
+
+
+const int MAX_DELEGATES = 4;
+
+
+template <typename Event>
+void benchmark(const std::string& label, int delegates, int threads)
+{
+	const int NOTIFICATIONS = 2000000/threads;
+
+	Event event;
+	Target targets[MAX_DELEGATES];
+	for (int i = 0; i < delegates; ++i)
+	{
+		event += Poco::delegate(&targets[i], &Target::onEvent);
+	}
+
+	Poco::Stopwatch sw;
+	sw.start();
+	if (threads == 1)
+	{
+		for (int n = 0; n < NOTIFICATIONS; ++n)
+		{
+			int args = 1;
+			event.notify(0, args);
+		}
+	}
+	else
+	{
+		Poco::Thread* pThreads = new Poco::Thread[threads];
+		for (int i = 0; i < threads; ++i)
+		{
+			pThreads[i].startFunc([&event, NOTIFICATIONS]()
+			{
+				for (int n = 0; n < NOTIFICATIONS; ++n)
+				{
+					int args = 1;
+					event.notify(0, args);
+				}
+			});
+		}
+		for (int i = 0; i < threads; ++i) pThreads[i].join();
+		delete [] pThreads;
+	}
+	sw.stop();
+
+	std::cout << label << ", " << delegates << " delegate(s), " << threads << " thread(s): "
+	          << sw.elapsed()*1000/(static_cast<Poco::Timestamp::TimeDiff>(NOTIFICATIONS)*threads) << " [ns] per notification" << std::endl;
+}
+
+
+template <typename Event>
+void benchmark(const std::string& label)
+{
+	benchmark<Event>(label, 0, 1);
+	benchmark<Event>(label, 1, 1);
+	benchmark<Event>(label, MAX_DELEGATES, 1);
+	benchmark<Event>(label, MAX_DELEGATES, 4);
+}
+
+
+int main(int argc, char** argv)
+{
+	benchmark<CopyingEvent>("CopyingEvent");
+	benchmark<Poco::BasicEvent<int> >("BasicEvent");
+	benchmark<Poco::FIFOEvent<int> >("FIFOEvent");
+
+	return 0;
+}
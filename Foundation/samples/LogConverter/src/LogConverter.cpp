@@ -0,0 +1,56 @@
+//
+// LogConverter.cpp
+//
+// This sample demonstrates the BinaryLogReader and PatternFormatter classes.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <fstream>
+
+
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::AutoPtr;
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || argc > 3)
+	{
+		std::cout << "usage: " << argv[0] << ": <input_file> [<pattern>]" << std::endl
+		          << "       read the binary log <input_file> written by a BinaryLogChannel," << std::endl
+		          << "       format its messages with <pattern> and write them to standard output" << std::endl;
+		return 1;
+	}
+
+	std::ifstream istr(argv[1], std::ios::binary);
+	if (!istr)
+	{
+		std::cerr << "cannot open input file: " << argv[1] << std::endl;
+		return 2;
+	}
+
+	AutoPtr<PatternFormatter> pFormatter = new PatternFormatter(argc == 3 ? argv[2] : "%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	BinaryLogReader reader(istr);
+	try
+	{
+		reader.format(*pFormatter, std::cout);
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 3;
+	}
+
+	return 0;
+}
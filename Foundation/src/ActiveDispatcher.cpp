@@ -13,6 +13,7 @@
 
 
 #include "Poco/ActiveDispatcher.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
 
@@ -45,19 +46,37 @@ namespace
 }
 
 
-ActiveDispatcher::ActiveDispatcher()
+ActiveDispatcher::ActiveDispatcher():
+	_pExecutor(0),
+	_drainer(*this, &ActiveDispatcher::drain),
+	_draining(false),
+	_drained(Event::EVENT_MANUALRESET)
 {
 	_thread.start(*this);
 }
 
 
-ActiveDispatcher::ActiveDispatcher(Thread::Priority prio)
+ActiveDispatcher::ActiveDispatcher(Thread::Priority prio):
+	_pExecutor(0),
+	_drainer(*this, &ActiveDispatcher::drain),
+	_draining(false),
+	_drained(Event::EVENT_MANUALRESET)
 {
 	_thread.setPriority(prio);
 	_thread.start(*this);
 }
 
 
+ActiveDispatcher::ActiveDispatcher(WorkStealingExecutor& executor):
+	_pExecutor(&executor),
+	_drainer(*this, &ActiveDispatcher::drain),
+	_draining(false),
+	_drained(Event::EVENT_MANUALRESET)
+{
+	_drained.set();
+}
+
+
 ActiveDispatcher::~ActiveDispatcher()
 {
 	try
@@ -75,6 +94,16 @@ void ActiveDispatcher::start(ActiveRunnableBase::Ptr pRunnable)
 	poco_check_ptr (pRunnable);
 
 	_queue.enqueueNotification(AutoPtr<Notification>(new MethodNotification(pRunnable)));
+	if (_pExecutor)
+	{
+		FastMutex::ScopedLock lock(_drainMutex);
+		if (!_draining)
+		{
+			_draining = true;
+			_drained.reset();
+			_pExecutor->start(_drainer);
+		}
+	}
 }
 
 
@@ -101,12 +130,45 @@ void ActiveDispatcher::run()
 }
 
 
+void ActiveDispatcher::drain()
+{
+	for (;;)
+	{
+		AutoPtr<Notification> pNf = _queue.dequeueNotification();
+		if (!pNf)
+		{
+			FastMutex::ScopedLock lock(_drainMutex);
+			// start() may have queued a method after the queue was found empty
+			if (_queue.empty())
+			{
+				_draining = false;
+				_drained.set();
+				return;
+			}
+			continue;
+		}
+		MethodNotification* pMethodNf = dynamic_cast<MethodNotification*>(pNf.get());
+		poco_check_ptr (pMethodNf);
+		ActiveRunnableBase::Ptr pRunnable = pMethodNf->runnable();
+		pRunnable->duplicate(); // run will release
+		pRunnable->run();
+	}
+}
+
+
 void ActiveDispatcher::stop()
 {
 	_queue.clear();
-	_queue.wakeUpAll();
-	_queue.enqueueNotification(AutoPtr<Notification>(new StopNotification));
-	_thread.join();
+	if (_pExecutor)
+	{
+		_drained.wait();
+	}
+	else
+	{
+		_queue.wakeUpAll();
+		_queue.enqueueNotification(AutoPtr<Notification>(new StopNotification));
+		_thread.join();
+	}
 }
 
 
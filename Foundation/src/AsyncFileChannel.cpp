@@ -0,0 +1,289 @@
+//
+// AsyncFileChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  AsyncFileChannel
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/AsyncFileChannel.h"
+#include "Poco/ThreadCachingAllocator.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Message.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include <new>
+
+
+namespace Poco {
+
+
+const std::string AsyncFileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string AsyncFileChannel::PROP_BATCHSIZE     = "batchSize";
+const std::string AsyncFileChannel::PROP_MAXPENDING    = "maxPending";
+const std::string AsyncFileChannel::PROP_OVERFLOW      = "overflow";
+
+
+AsyncFileChannel::AsyncFileChannel():
+	_pHead(0),
+	_pending(0),
+	_flushInterval(DEFAULT_FLUSH_INTERVAL),
+	_batchSize(DEFAULT_BATCH_SIZE),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_dropOnOverflow(false),
+	_running(false),
+	_stop(false)
+{
+}
+
+
+AsyncFileChannel::AsyncFileChannel(const std::string& rPath):
+	FileChannel(rPath),
+	_pHead(0),
+	_pending(0),
+	_flushInterval(DEFAULT_FLUSH_INTERVAL),
+	_batchSize(DEFAULT_BATCH_SIZE),
+	_maxPending(DEFAULT_MAX_PENDING),
+	_dropOnOverflow(false),
+	_running(false),
+	_stop(false)
+{
+}
+
+
+AsyncFileChannel::~AsyncFileChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void AsyncFileChannel::open()
+{
+	FileChannel::open();
+
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (!_running)
+	{
+		_stop = false;
+		_thread.start(*this);
+		_running = true;
+	}
+}
+
+
+void AsyncFileChannel::close()
+{
+	{
+		FastMutex::ScopedLock lock(_threadMutex);
+
+		if (_running)
+		{
+			_stop = true;
+			_wakeUp.set();
+			_thread.join();
+			_running = false;
+		}
+		// messages logged after the background thread
+		// has written its final batch
+		writePending();
+	}
+	FileChannel::close();
+}
+
+
+void AsyncFileChannel::log(const Message& msg)
+{
+	if (!_running.load(std::memory_order_acquire)) open();
+
+	std::size_t maxPending = _maxPending.load(std::memory_order_relaxed);
+	if (maxPending > 0 && _pending.load(std::memory_order_relaxed) >= maxPending && !waitForSpace(maxPending)) return;
+
+	// counted before the message is added, so that writePending()
+	// never sees more messages than have been counted
+	std::size_t pending = _pending.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	Entry* pEntry = new (ThreadCachingAllocator::allocate(sizeof(Entry))) Entry(msg.getText());
+	Entry* pHead = _pHead.load(std::memory_order_relaxed);
+	do
+	{
+		pEntry->pNext = pHead;
+	}
+	while (!_pHead.compare_exchange_weak(pHead, pEntry, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+	// close() may have written its final batch before the message
+	// has been added; it then must be written here
+	if (!_running.load(std::memory_order_seq_cst))
+	{
+		FastMutex::ScopedLock lock(_threadMutex);
+
+		if (!_running) writePending();
+		return;
+	}
+
+	// Only wake up the writer if it would otherwise
+	// wait longer than desired.
+	if (pending == _batchSize.load(std::memory_order_relaxed) || (!pHead && _flushInterval.load(std::memory_order_relaxed) == 0))
+	{
+		_wakeUp.set();
+	}
+}
+
+
+void AsyncFileChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == PROP_FLUSHINTERVAL)
+	{
+		int interval = NumberParser::parse(value);
+		if (interval < 0) throw InvalidArgumentException("flushInterval", value);
+		_flushInterval = interval;
+		_wakeUp.set();
+	}
+	else if (name == PROP_BATCHSIZE)
+	{
+		unsigned size = NumberParser::parseUnsigned(value);
+		if (size == 0) throw InvalidArgumentException("batchSize", value);
+		_batchSize = size;
+	}
+	else if (name == PROP_MAXPENDING)
+	{
+		_maxPending = NumberParser::parseUnsigned(value);
+	}
+	else if (name == PROP_OVERFLOW)
+	{
+		if (value == "block")
+			_dropOnOverflow = false;
+		else if (value == "drop")
+			_dropOnOverflow = true;
+		else
+			throw InvalidArgumentException("overflow", value);
+	}
+	else
+	{
+		FileChannel::setProperty(name, value);
+	}
+}
+
+
+std::string AsyncFileChannel::getProperty(const std::string& name) const
+{
+	if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval.load());
+	else if (name == PROP_BATCHSIZE)
+		return NumberFormatter::format(_batchSize.load());
+	else if (name == PROP_MAXPENDING)
+		return NumberFormatter::format(_maxPending.load());
+	else if (name == PROP_OVERFLOW)
+		return _dropOnOverflow ? "drop" : "block";
+	else
+		return FileChannel::getProperty(name);
+}
+
+
+void AsyncFileChannel::run()
+{
+	while (!_stop)
+	{
+		if (_pending.load(std::memory_order_relaxed) < _batchSize.load(std::memory_order_relaxed))
+		{
+			long interval = _flushInterval;
+			if (interval > 0)
+				_wakeUp.tryWait(interval);
+			else
+				_wakeUp.wait();
+		}
+		writePending();
+		_written.set();
+	}
+	writePending();
+	_written.set();
+}
+
+
+bool AsyncFileChannel::waitForSpace(std::size_t maxPending)
+{
+	// the background thread must not wait for itself
+	if (Thread::current() == &_thread) return true;
+	if (_dropOnOverflow) return false;
+
+	while (_pending.load(std::memory_order_relaxed) >= maxPending && _running.load(std::memory_order_acquire))
+	{
+		_wakeUp.set();
+		// several threads may be waiting, but only one is woken up
+		_written.tryWait(10);
+	}
+	return true;
+}
+
+
+void AsyncFileChannel::writePending()
+{
+	Entry* pEntry = _pHead.exchange(0, std::memory_order_seq_cst);
+	if (!pEntry) return;
+
+	// restore the order in which the messages have been logged
+	Entry* pFirst = 0;
+	std::size_t count = 0;
+	while (pEntry)
+	{
+		Entry* pNext = pEntry->pNext;
+		pEntry->pNext = pFirst;
+		pFirst = pEntry;
+		pEntry = pNext;
+		++count;
+	}
+
+	_lines.clear();
+	_lines.reserve(count);
+	while (pFirst)
+	{
+		Entry* pNext = pFirst->pNext;
+		_lines.push_back(std::move(pFirst->text));
+		destroy(pFirst);
+		pFirst = pNext;
+	}
+
+	try
+	{
+		writeLines(_lines);
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	_lines.clear();
+	// messages count as pending until they have been written
+	_pending.fetch_sub(count, std::memory_order_relaxed);
+}
+
+
+void AsyncFileChannel::destroy(Entry* pEntry)
+{
+	pEntry->~Entry();
+	ThreadCachingAllocator::deallocate(pEntry, sizeof(Entry));
+}
+
+
+} // namespace Poco
@@ -0,0 +1,215 @@
+//
+// BinaryLogChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Message.h"
+#include "Poco/FileStream.h"
+#include "Poco/Exception.h"
+#include "Poco/String.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	inline void appendUInt32(std::string& record, UInt32 value)
+	{
+		char bytes[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			bytes[i] = static_cast<char>(value & 0xFF);
+			value >>= 8;
+		}
+		record.append(bytes, 4);
+	}
+
+	inline void appendInt64(std::string& record, Int64 value)
+	{
+		UInt64 uvalue = static_cast<UInt64>(value);
+		char bytes[8];
+		for (int i = 0; i < 8; ++i)
+		{
+			bytes[i] = static_cast<char>(uvalue & 0xFF);
+			uvalue >>= 8;
+		}
+		record.append(bytes, 8);
+	}
+
+	inline void append7BitEncoded(std::string& record, UInt64 value)
+	{
+		while (value >= 0x80)
+		{
+			record += static_cast<char>(value | 0x80);
+			value >>= 7;
+		}
+		record += static_cast<char>(value);
+	}
+
+	inline void appendString(std::string& record, const char* str, std::size_t length)
+	{
+		append7BitEncoded(record, length);
+		record.append(str, length);
+	}
+
+	inline void appendString(std::string& record, const std::string& str)
+	{
+		appendString(record, str.data(), str.size());
+	}
+}
+
+
+const std::string BinaryLogChannel::PROP_PATH  = "path";
+const std::string BinaryLogChannel::PROP_FLUSH = "flush";
+const char BinaryLogChannel::MAGIC[4] = {'P', 'B', 'L', 'G'};
+
+
+BinaryLogChannel::BinaryLogChannel():
+	_flush(true),
+	_pStream(0)
+{
+}
+
+
+BinaryLogChannel::BinaryLogChannel(const std::string& rPath):
+	_path(rPath),
+	_flush(true),
+	_pStream(0)
+{
+}
+
+
+BinaryLogChannel::~BinaryLogChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void BinaryLogChannel::open()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_pStream)
+	{
+		FileOutputStream* pStream = new FileOutputStream(_path, std::ios::out | std::ios::app | std::ios::binary);
+		if (pStream->tellp() == 0)
+		{
+			std::string header(MAGIC, sizeof(MAGIC));
+			appendUInt32(header, FORMAT_VERSION);
+			pStream->write(header.data(), header.size());
+			pStream->flush();
+		}
+		if (!pStream->good())
+		{
+			delete pStream;
+			throw OpenFileException(_path);
+		}
+		_pStream = pStream;
+	}
+}
+
+
+void BinaryLogChannel::close()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	delete _pStream;
+	_pStream = 0;
+}
+
+
+void BinaryLogChannel::log(const Message& msg)
+{
+	open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	encode(msg);
+	_pStream->write(_record.data(), _record.size());
+	if (_flush) _pStream->flush();
+	if (!_pStream->good()) throw WriteFileException(_path);
+}
+
+
+void BinaryLogChannel::encode(const Message& msg)
+{
+	// the length is filled in when the record is complete
+	_record.assign(4, '\0');
+	appendInt64(_record, msg.getTime().epochMicroseconds());
+	_record += static_cast<char>(msg.getPriority());
+	append7BitEncoded(_record, static_cast<UInt64>(msg.getPid()));
+	append7BitEncoded(_record, static_cast<UInt64>(msg.getTid()));
+	append7BitEncoded(_record, static_cast<UInt64>(msg.getOsTid()));
+	append7BitEncoded(_record, static_cast<UInt32>(msg.getSourceLine()));
+	appendString(_record, msg.getSource());
+	appendString(_record, msg.getText());
+	appendString(_record, msg.getThread());
+	const char* file = msg.getSourceFile();
+	appendString(_record, file ? file : "", file ? std::strlen(file) : 0);
+	const Message::StringMap& params = msg.getAll();
+	append7BitEncoded(_record, params.size());
+	for (Message::StringMap::const_iterator it = params.begin(); it != params.end(); ++it)
+	{
+		appendString(_record, it->first);
+		appendString(_record, it->second);
+	}
+
+	UInt32 length = static_cast<UInt32>(_record.size() - 4);
+	for (int i = 0; i < 4; ++i)
+	{
+		_record[i] = static_cast<char>(length & 0xFF);
+		length >>= 8;
+	}
+}
+
+
+void BinaryLogChannel::setProperty(const std::string& name, const std::string& value)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (name == PROP_PATH)
+	{
+		_path = value;
+	}
+	else if (name == PROP_FLUSH)
+	{
+		_flush = icompare(value, "true") == 0;
+	}
+	else
+	{
+		Channel::setProperty(name, value);
+	}
+}
+
+
+std::string BinaryLogChannel::getProperty(const std::string& name) const
+{
+	if (name == PROP_PATH)
+		return _path;
+	else if (name == PROP_FLUSH)
+		return std::string(_flush ? "true" : "false");
+	else
+		return Channel::getProperty(name);
+}
+
+
+} // namespace Poco
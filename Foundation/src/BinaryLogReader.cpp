@@ -0,0 +1,222 @@
+//
+// BinaryLogReader.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Formatter.h"
+#include "Poco/Channel.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	UInt32 toUInt32(const char* bytes)
+	{
+		UInt32 value = 0;
+		for (int i = 3; i >= 0; --i)
+		{
+			value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+		}
+		return value;
+	}
+
+	class RecordDecoder
+		/// Decodes the fields of a record, checking that
+		/// they do not extend beyond the end of the record.
+	{
+	public:
+		RecordDecoder(const std::string& record):
+			_pos(record.data()),
+			_end(record.data() + record.size())
+		{
+		}
+
+		Int64 readInt64()
+		{
+			need(8);
+			UInt64 value = 0;
+			for (int i = 7; i >= 0; --i)
+			{
+				value = (value << 8) | static_cast<unsigned char>(_pos[i]);
+			}
+			_pos += 8;
+			return static_cast<Int64>(value);
+		}
+
+		UInt8 readUInt8()
+		{
+			need(1);
+			return static_cast<UInt8>(*_pos++);
+		}
+
+		UInt64 read7BitEncoded()
+		{
+			UInt64 value = 0;
+			int shift = 0;
+			UInt8 byte;
+			do
+			{
+				if (shift > 63) throw DataFormatException("Invalid integer in binary log record");
+				byte = readUInt8();
+				value |= static_cast<UInt64>(byte & 0x7F) << shift;
+				shift += 7;
+			}
+			while (byte & 0x80);
+			return value;
+		}
+
+		void readString(std::string& str)
+		{
+			UInt64 length = read7BitEncoded();
+			need(length);
+			str.assign(_pos, static_cast<std::size_t>(length));
+			_pos += length;
+		}
+
+	private:
+		void need(UInt64 length)
+		{
+			if (length > static_cast<UInt64>(_end - _pos))
+				throw DataFormatException("Damaged binary log record");
+		}
+
+		const char* _pos;
+		const char* _end;
+	};
+}
+
+
+BinaryLogReader::BinaryLogReader(std::istream& istr, std::size_t maxRecordSize):
+	_istr(istr),
+	_maxRecordSize(maxRecordSize),
+	_version(0)
+{
+}
+
+
+BinaryLogReader::~BinaryLogReader()
+{
+}
+
+
+bool BinaryLogReader::read(Message& msg)
+{
+	if (_version == 0 && !readHeader()) return false;
+
+	char length[4];
+	_istr.read(length, sizeof(length));
+	if (_istr.gcount() == 0) return false;
+	if (_istr.gcount() != sizeof(length)) throw DataFormatException("Incomplete binary log record");
+
+	UInt32 recordSize = toUInt32(length);
+	if (recordSize > _maxRecordSize) throw DataFormatException("Binary log record too large");
+	_record.resize(recordSize);
+	_istr.read(&_record[0], _record.size());
+	if (static_cast<std::size_t>(_istr.gcount()) != _record.size()) throw DataFormatException("Incomplete binary log record");
+
+	// Fields added by future versions follow the
+	// known fields, and are ignored.
+	RecordDecoder decoder(_record);
+	Timestamp time(decoder.readInt64());
+	UInt8 prio = decoder.readUInt8();
+	if (prio < Message::PRIO_FATAL || prio > Message::PRIO_TRACE) throw DataFormatException("Invalid priority in binary log record");
+	long pid = static_cast<long>(decoder.read7BitEncoded());
+	long tid = static_cast<long>(decoder.read7BitEncoded());
+	IntPtr osTid = static_cast<IntPtr>(decoder.read7BitEncoded());
+	int line = static_cast<int>(decoder.read7BitEncoded());
+	std::string source;
+	decoder.readString(source);
+	std::string text;
+	decoder.readString(text);
+	std::string thread;
+	decoder.readString(thread);
+	decoder.readString(_string);
+	const char* file = _string.empty() ? 0 : sourceFile(_string);
+
+	// Message cannot remove parameters, so the
+	// message is replaced instead of being modified.
+	Message result(source, text, static_cast<Message::Priority>(prio), file, line);
+	result.setTime(time);
+	result.setPid(pid);
+	result.setTid(tid);
+	result.setOsTid(osTid);
+	result.setThread(thread);
+	UInt64 count = decoder.read7BitEncoded();
+	std::string name;
+	for (UInt64 i = 0; i < count; ++i)
+	{
+		decoder.readString(name);
+		decoder.readString(_string);
+		result.set(name, _string);
+	}
+	msg.swap(result);
+	return true;
+}
+
+
+std::size_t BinaryLogReader::format(Formatter& formatter, std::ostream& ostr)
+{
+	std::size_t count = 0;
+	Message msg;
+	std::string text;
+	while (read(msg))
+	{
+		text.clear();
+		formatter.format(msg, text);
+		text += '\n';
+		ostr.write(text.data(), text.size());
+		++count;
+	}
+	return count;
+}
+
+
+std::size_t BinaryLogReader::replay(Channel& channel)
+{
+	std::size_t count = 0;
+	Message msg;
+	while (read(msg))
+	{
+		channel.log(msg);
+		++count;
+	}
+	return count;
+}
+
+
+bool BinaryLogReader::readHeader()
+{
+	char header[8];
+	_istr.read(header, sizeof(header));
+	if (_istr.gcount() == 0) return false;
+	if (_istr.gcount() != sizeof(header) || std::memcmp(header, BinaryLogChannel::MAGIC, sizeof(BinaryLogChannel::MAGIC)) != 0)
+		throw DataFormatException("Not a binary log");
+
+	_version = toUInt32(header + 4);
+	if (_version == 0) throw DataFormatException("Invalid binary log version");
+	return true;
+}
+
+
+const char* BinaryLogReader::sourceFile(const std::string& file)
+{
+	return _sourceFiles.insert(file).first->c_str();
+}
+
+
+} // namespace Poco
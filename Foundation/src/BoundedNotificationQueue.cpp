@@ -0,0 +1,441 @@
+//
+// BoundedNotificationQueue.cpp
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/Clock.h"
+#include <climits>
+#if POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID
+#define POCO_HAVE_FUTEX 1
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#else
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#endif
+
+
+namespace Poco {
+
+
+class BoundedNotificationQueue::Parker
+	/// An event count. A thread waiting for a condition calls
+	/// prepareWait(), checks the condition again, and then calls
+	/// either cancelWait(), or wait() with the key returned by
+	/// prepareWait(). A notify() after prepareWait() makes wait()
+	/// return immediately, so no wake-up can be lost.
+	///
+	/// notify() does not make a system call if no thread waits.
+{
+public:
+	Parker():
+		_epoch(0),
+		_waiters(0)
+	{
+	}
+
+	int prepareWait()
+	{
+		_waiters.fetch_add(1, std::memory_order_seq_cst);
+		// pairs with the fence in notify()
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return _epoch.load(std::memory_order_acquire);
+	}
+
+	void cancelWait()
+	{
+		_waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void wait(int key, long milliseconds)
+		/// Waits until notify() is called, but not longer than the
+		/// given time (or forever if milliseconds is negative).
+		/// May return spuriously.
+	{
+#if defined(POCO_HAVE_FUTEX)
+		struct timespec ts;
+		struct timespec* pTimeout = 0;
+		if (milliseconds >= 0)
+		{
+			ts.tv_sec  = milliseconds/1000;
+			ts.tv_nsec = (milliseconds % 1000)*1000000;
+			pTimeout = &ts;
+		}
+		syscall(SYS_futex, reinterpret_cast<int*>(&_epoch), FUTEX_WAIT_PRIVATE, key, pTimeout, 0, 0);
+#else
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_epoch.load(std::memory_order_relaxed) == key)
+			{
+				if (milliseconds < 0)
+					_condition.wait(_mutex);
+				else
+					_condition.tryWait(_mutex, milliseconds);
+			}
+		}
+#endif
+		_waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void notify(int count)
+		/// Wakes up to count waiting threads.
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (_waiters.load(std::memory_order_relaxed) > 0)
+		{
+#if defined(POCO_HAVE_FUTEX)
+			_epoch.fetch_add(1, std::memory_order_release);
+			syscall(SYS_futex, reinterpret_cast<int*>(&_epoch), FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+#else
+			FastMutex::ScopedLock lock(_mutex);
+			_epoch.fetch_add(1, std::memory_order_release);
+			if (count == 1)
+				_condition.signal();
+			else
+				_condition.broadcast();
+#endif
+		}
+	}
+
+	int waiters() const
+	{
+		return _waiters.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<int> _epoch;
+	std::atomic<int> _waiters;
+#if !defined(POCO_HAVE_FUTEX)
+	FastMutex        _mutex;
+	Condition        _condition;
+#endif
+};
+
+
+const std::size_t BoundedNotificationQueue::BATCH_SIZE;
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(std::size_t capacity):
+	_capacity(2),
+	_pCells(0),
+	_pNotEmpty(new Parker),
+	_pNotFull(new Parker),
+	_wakeUps(0),
+	_enqueuePos(0),
+	_dequeuePos(0)
+{
+	while (_capacity < capacity) _capacity <<= 1;
+	_mask = _capacity - 1;
+	_pCells = new Cell[_capacity];
+	for (std::size_t i = 0; i < _capacity; ++i)
+	{
+		_pCells[i].sequence.store(i, std::memory_order_relaxed);
+		_pCells[i].pNf = 0;
+	}
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	delete [] _pCells;
+	delete _pNotFull;
+	delete _pNotEmpty;
+}
+
+
+void BoundedNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+	waitEnqueueMany(&pNotification, 1, -1);
+}
+
+
+bool BoundedNotificationQueue::tryEnqueueNotification(Notification::Ptr pNotification, long milliseconds)
+{
+	poco_check_ptr (pNotification);
+	return waitEnqueueMany(&pNotification, 1, milliseconds) == 1;
+}
+
+
+void BoundedNotificationQueue::enqueueNotifications(const NotificationVec& notifications)
+{
+	for (NotificationVec::const_iterator it = notifications.begin(); it != notifications.end(); ++it)
+	{
+		poco_check_ptr (*it);
+	}
+	if (!notifications.empty())
+	{
+		waitEnqueueMany(&notifications[0], notifications.size(), -1);
+	}
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	Notification* pNf = 0;
+	dequeueMany(&pNf, 1);
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	Notification* pNf = 0;
+	waitDequeueMany(&pNf, 1, -1);
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	poco_assert (milliseconds >= 0);
+
+	Notification* pNf = 0;
+	waitDequeueMany(&pNf, 1, milliseconds);
+	return pNf;
+}
+
+
+std::size_t BoundedNotificationQueue::dequeueNotifications(NotificationVec& notifications, std::size_t maxCount)
+{
+	Notification* buffer[BATCH_SIZE];
+	std::size_t total = 0;
+	while (total < maxCount)
+	{
+		std::size_t n = dequeueMany(buffer, maxCount - total < BATCH_SIZE ? maxCount - total : BATCH_SIZE);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			notifications.emplace_back(buffer[i]);
+		}
+		total += n;
+		if (n < BATCH_SIZE) break;
+	}
+	return total;
+}
+
+
+std::size_t BoundedNotificationQueue::waitDequeueNotifications(NotificationVec& notifications, std::size_t maxCount)
+{
+	if (maxCount == 0) return 0;
+
+	Notification* buffer[BATCH_SIZE];
+	std::size_t n = waitDequeueMany(buffer, maxCount < BATCH_SIZE ? maxCount : BATCH_SIZE, -1);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		notifications.emplace_back(buffer[i]);
+	}
+	if (n == BATCH_SIZE)
+	{
+		n += dequeueNotifications(notifications, maxCount - n);
+	}
+	return n;
+}
+
+
+void BoundedNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification::Ptr pNf = dequeueNotification();
+	while (pNf)
+	{
+		notificationCenter.postNotification(pNf);
+		pNf = dequeueNotification();
+	}
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	_wakeUps.fetch_add(1, std::memory_order_seq_cst);
+	_pNotEmpty->notify(INT_MAX);
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	// a consumer can only claim a position that a producer has
+	// already claimed, so the dequeue position is read first
+	std::size_t dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+	std::size_t enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+	std::size_t n = enqueuePos - dequeuePos;
+	return static_cast<int>(n < _capacity ? n : _capacity);
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Notification* buffer[BATCH_SIZE];
+	std::size_t n = dequeueMany(buffer, BATCH_SIZE);
+	while (n > 0)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			buffer[i]->release();
+		}
+		n = dequeueMany(buffer, BATCH_SIZE);
+	}
+}
+
+
+bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	return _pNotEmpty->waiters() > 0;
+}
+
+
+std::size_t BoundedNotificationQueue::enqueueMany(const Notification::Ptr* pNotifications, std::size_t count)
+{
+	std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// A cell is free for position pos if its sequence is pos.
+		// Only the producer that claims pos can change the sequence
+		// of a free cell, so all cells found free here belong to this
+		// thread once the enqueue position has been advanced past them.
+		std::size_t n = 0;
+		while (n < count && _pCells[(pos + n) & _mask].sequence.load(std::memory_order_acquire) == pos + n) ++n;
+		if (n == 0)
+		{
+			std::size_t seq = _pCells[pos & _mask].sequence.load(std::memory_order_acquire);
+			if (static_cast<std::ptrdiff_t>(seq - pos) < 0) return 0; // full
+			pos = _enqueuePos.load(std::memory_order_relaxed);
+		}
+		else if (_enqueuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				Cell& cell = _pCells[(pos + i) & _mask];
+				cell.pNf = const_cast<Notification*>(pNotifications[i].get());
+				cell.pNf->duplicate();
+				cell.sequence.store(pos + i + 1, std::memory_order_release);
+			}
+			_pNotEmpty->notify(static_cast<int>(n));
+			return n;
+		}
+	}
+}
+
+
+std::size_t BoundedNotificationQueue::dequeueMany(Notification** pNotifications, std::size_t maxCount)
+{
+	std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		// A cell is full for position pos if its sequence is pos + 1.
+		std::size_t n = 0;
+		while (n < maxCount && _pCells[(pos + n) & _mask].sequence.load(std::memory_order_acquire) == pos + n + 1) ++n;
+		if (n == 0)
+		{
+			if (maxCount == 0) return 0;
+			std::size_t seq = _pCells[pos & _mask].sequence.load(std::memory_order_acquire);
+			if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0) return 0; // empty
+			pos = _dequeuePos.load(std::memory_order_relaxed);
+		}
+		else if (_dequeuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				Cell& cell = _pCells[(pos + i) & _mask];
+				pNotifications[i] = cell.pNf;
+				cell.pNf = 0;
+				cell.sequence.store(pos + i + _capacity, std::memory_order_release);
+			}
+			_pNotFull->notify(static_cast<int>(n));
+			return n;
+		}
+	}
+}
+
+
+std::size_t BoundedNotificationQueue::waitEnqueueMany(const Notification::Ptr* pNotifications, std::size_t count, long milliseconds)
+{
+	std::size_t n = enqueueMany(pNotifications, count);
+	if (n == count || milliseconds == 0) return n;
+
+	Clock deadline;
+	deadline += static_cast<Clock::ClockDiff>(milliseconds)*1000;
+	for (;;)
+	{
+		int key = _pNotFull->prepareWait();
+		std::size_t k = enqueueMany(pNotifications + n, count - n);
+		if (k > 0)
+		{
+			_pNotFull->cancelWait();
+			n += k;
+			if (n == count) return n;
+			continue;
+		}
+		long timeout = -1;
+		if (milliseconds > 0)
+		{
+			timeout = static_cast<long>((deadline - Clock() + 999)/1000);
+			if (timeout <= 0)
+			{
+				_pNotFull->cancelWait();
+				return n;
+			}
+		}
+		_pNotFull->wait(key, timeout);
+	}
+}
+
+
+std::size_t BoundedNotificationQueue::waitDequeueMany(Notification** pNotifications, std::size_t maxCount, long milliseconds)
+{
+	std::size_t n = dequeueMany(pNotifications, maxCount);
+	if (n > 0 || milliseconds == 0) return n;
+
+	Poco::UInt32 wakeUps = _wakeUps.load(std::memory_order_seq_cst);
+	Clock deadline;
+	deadline += static_cast<Clock::ClockDiff>(milliseconds)*1000;
+	for (;;)
+	{
+		int key = _pNotEmpty->prepareWait();
+		n = dequeueMany(pNotifications, maxCount);
+		if (n > 0 || _wakeUps.load(std::memory_order_seq_cst) != wakeUps)
+		{
+			_pNotEmpty->cancelWait();
+			return n;
+		}
+		long timeout = -1;
+		if (milliseconds > 0)
+		{
+			timeout = static_cast<long>((deadline - Clock() + 999)/1000);
+			if (timeout <= 0)
+			{
+				_pNotEmpty->cancelWait();
+				return 0;
+			}
+		}
+		_pNotEmpty->wait(key, timeout);
+	}
+}
+
+
+} // namespace Poco
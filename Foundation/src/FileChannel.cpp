@@ -120,6 +120,25 @@ void FileChannel::log(const Message& msg)
 
 	FastMutex::ScopedLock lock(_mutex);
 
+	rotateIfNecessary();
+	_pFile->write(msg.getText(), _flush);
+}
+
+
+void FileChannel::writeLines(const std::vector<std::string>& lines)
+{
+	// an overriding open() may be waiting for the calling thread
+	FileChannel::open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	rotateIfNecessary();
+	_pFile->write(lines, _flush);
+}
+
+
+void FileChannel::rotateIfNecessary()
+{
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
 		try
@@ -136,7 +155,6 @@ void FileChannel::log(const Message& msg)
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
 	}
-	_pFile->write(msg.getText(), _flush);
 }
 
 	
@@ -167,4 +167,10 @@ std::streampos FileStreamBuf::seekpos(std::streampos pos, std::ios::openmode mod
 }
 
 
+FileStreamBuf::NativeHandle FileStreamBuf::nativeHandle() const
+{
+	return _fd;
+}
+
+
 } // namespace Poco
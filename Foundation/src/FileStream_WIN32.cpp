@@ -201,4 +201,10 @@ std::streampos FileStreamBuf::seekpos(std::streampos pos, std::ios::openmode mod
 }
 
 
+FileStreamBuf::NativeHandle FileStreamBuf::nativeHandle() const
+{
+	return _handle;
+}
+
+
 } // namespace Poco
@@ -20,6 +20,17 @@
 namespace Poco {
 
 
+namespace
+{
+	enum
+	{
+		MAX_BUFFER_SIZE = 16384 /// larger buffers are not kept
+	};
+
+	thread_local std::string formatBuffer;
+}
+
+
 FormattingChannel::FormattingChannel():
 	_pFormatter(0),
 	_pChannel(0)
@@ -76,9 +87,15 @@ void FormattingChannel::log(const Message& msg)
 	{
 		if (_pFormatter)
 		{
+			// Reuse the buffer of the last message formatted by this
+			// thread. A nested call, e.g. from a channel logging
+			// an error, starts with an empty buffer.
 			std::string text;
+			text.swap(formatBuffer);
+			text.clear();
 			_pFormatter->format(msg, text);
 			_pChannel->log(Message(msg, text));
+			if (text.capacity() <= MAX_BUFFER_SIZE) formatBuffer.swap(text);
 		}
 		else
 		{
@@ -15,11 +15,51 @@
 #include "Poco/LogFile_STD.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <sys/uio.h>
+#include <limits.h>
+#include <errno.h>
 
 
 namespace Poco {
 
 
+namespace
+{
+#if defined(IOV_MAX)
+	const int MAX_IOV = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+	const int MAX_IOV = 16;
+#endif
+
+	bool writeFully(int fd, struct iovec* iov, int count)
+		/// Writes all given buffers, continuing after
+		/// partial writes and interruptions.
+	{
+		while (count > 0)
+		{
+			ssize_t n = ::writev(fd, iov, count);
+			if (n < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			while (count > 0 && static_cast<std::size_t>(n) >= iov->iov_len)
+			{
+				n -= iov->iov_len;
+				++iov;
+				--count;
+			}
+			if (count > 0)
+			{
+				iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+				iov->iov_len -= n;
+			}
+		}
+		return true;
+	}
+}
+
+
 LogFileImpl::LogFileImpl(const std::string& path):
 	_path(path),
 	_str(_path, std::ios::app),
@@ -55,6 +95,55 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::writeImpl(const std::vector<std::string>& lines, bool flush)
+{
+	if (!_str.good())
+	{
+		_str.close();
+		_str.open(_path, std::ios::app);
+	}
+	if (!_str.good()) throw WriteFileException(_path);
+
+	if (!flush)
+	{
+		// Leave the lines in the stream's buffer. tellp() would
+		// flush it, so the size is updated from the lines instead.
+		for (std::vector<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+		{
+			_str << *it << "\n";
+			_size += it->size() + 1;
+		}
+		if (!_str.good()) throw WriteFileException(_path);
+		return;
+	}
+
+	// Text still buffered by the stream must be written first.
+	// The lines are then written directly to the file, which
+	// makes them visible to readers immediately.
+	_str.flush();
+	int fd = _str.nativeHandle();
+	static char newline[] = "\n";
+	struct iovec iov[MAX_IOV];
+	std::vector<std::string>::const_iterator it = lines.begin();
+	while (it != lines.end())
+	{
+		int count = 0;
+		while (it != lines.end() && count + 2 <= MAX_IOV)
+		{
+			iov[count].iov_base = const_cast<char*>(it->data());
+			iov[count].iov_len  = it->size();
+			++count;
+			iov[count].iov_base = newline;
+			iov[count].iov_len  = 1;
+			++count;
+			++it;
+		}
+		if (!writeFully(fd, iov, count)) throw WriteFileException(_path);
+	}
+	_size = (UInt64) _str.tellp();
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	return _size;
@@ -57,6 +57,34 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::writeImpl(const std::vector<std::string>& lines, bool flush)
+{
+	if (INVALID_HANDLE_VALUE == _hFile)	createFile();
+
+	std::string buffer;
+	std::size_t length = 0;
+	for (std::vector<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+	{
+		length += it->size() + 2;
+	}
+	buffer.reserve(length);
+	for (std::vector<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+	{
+		buffer.append(*it);
+		buffer.append("\r\n", 2);
+	}
+
+	DWORD bytesWritten;
+	BOOL res = WriteFile(_hFile, buffer.data(), (DWORD) buffer.size(), &bytesWritten, NULL);
+	if (!res) throw WriteFileException(_path);
+	if (flush)
+	{
+		res = FlushFileBuffers(_hFile);
+		if (!res) throw WriteFileException(_path);
+	}
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	if (INVALID_HANDLE_VALUE == _hFile)
@@ -19,6 +19,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include <algorithm>
 
 
 namespace Poco {
@@ -71,7 +72,7 @@ void Logger::setProperty(const std::string& rName, const std::string& rValue)
 
 void Logger::log(const Message& msg)
 {
-	if (_level >= msg.getPriority() && _pChannel)
+	if (getLevel() >= msg.getPriority() && _pChannel)
 	{
 		_pChannel->log(msg);
 	}
@@ -92,7 +93,7 @@ void Logger::log(const Exception& exc, const char* file, int line)
 
 void Logger::dump(const std::string& msg, const void* buffer, std::size_t length, Message::Priority prio)
 {
-	if (_level >= prio && _pChannel)
+	if (getLevel() >= prio && _pChannel)
 	{
 		std::string text(msg);
 		formatDump(text, buffer, length);
@@ -105,15 +106,19 @@ void Logger::setLevel(const std::string& name, int level)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	if (LoggerMapPtr::Snapshot* pMap = _pLoggerMap.get())
 	{
 		std::string::size_type len = name.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
+		for (LoggerMapParts::iterator itPart = pMap->value().begin(); itPart != pMap->value().end(); ++itPart)
 		{
-			if (len == 0 ||
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+			LoggerMap& loggers = (*itPart)->value();
+			for (LoggerMap::iterator it = loggers.begin(); it != loggers.end(); ++it)
 			{
-				it->second->setLevel(level);
+				if (len == 0 ||
+					(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+				{
+					it->second->setLevel(level);
+				}
 			}
 		}
 	}
@@ -124,15 +129,19 @@ void Logger::setChannel(const std::string& name, Channel::Ptr pChannel)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	if (LoggerMapPtr::Snapshot* pMap = _pLoggerMap.get())
 	{
 		std::string::size_type len = name.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
+		for (LoggerMapParts::iterator itPart = pMap->value().begin(); itPart != pMap->value().end(); ++itPart)
 		{
-			if (len == 0 ||
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+			LoggerMap& loggers = (*itPart)->value();
+			for (LoggerMap::iterator it = loggers.begin(); it != loggers.end(); ++it)
 			{
-				it->second->setChannel(pChannel);
+				if (len == 0 ||
+					(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+				{
+					it->second->setChannel(pChannel);
+				}
 			}
 		}
 	}
@@ -143,15 +152,19 @@ void Logger::setProperty(const std::string& loggerName, const std::string& prope
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	if (LoggerMapPtr::Snapshot* pMap = _pLoggerMap.get())
 	{
 		std::string::size_type len = loggerName.length();
-		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
+		for (LoggerMapParts::iterator itPart = pMap->value().begin(); itPart != pMap->value().end(); ++itPart)
 		{
-			if (len == 0 ||
-				(it->first.compare(0, len, loggerName) == 0 && (it->first.length() == len || it->first[len] == '.')))
+			LoggerMap& loggers = (*itPart)->value();
+			for (LoggerMap::iterator it = loggers.begin(); it != loggers.end(); ++it)
 			{
-				it->second->setProperty(propertyName, value);
+				if (len == 0 ||
+					(it->first.compare(0, len, loggerName) == 0 && (it->first.length() == len || it->first[len] == '.')))
+				{
+					it->second->setProperty(propertyName, value);
+				}
 			}
 		}
 	}
@@ -273,6 +286,15 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	// The Logger is kept alive by the map until destroy()
+	// or shutdown() is called.
+	LoggerMapPtr::Ptr pMap = _pLoggerMap.load();
+	if (pMap)
+	{
+		Ptr pLogger = find(pMap->value(), name);
+		if (pLogger) return *pLogger;
+	}
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -312,16 +334,12 @@ Logger& Logger::create(const std::string& name, Channel::Ptr pChannel, int level
 
 Logger& Logger::root()
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
-	return unsafeGet(ROOT);
+	return get(ROOT);
 }
 
 
 Logger::Ptr Logger::has(const std::string& name)
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
 	return find(name);
 }
 
@@ -330,16 +348,25 @@ void Logger::shutdown()
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	_pLoggerMap.reset();
+	_pLoggerMap.store(0);
 }
 
 
 Logger::Ptr Logger::find(const std::string& name)
 {
-	if (_pLoggerMap)
+	LoggerMapPtr::Ptr pMap = _pLoggerMap.load();
+	if (pMap) return find(pMap->value(), name);
+	return 0;
+}
+
+
+Logger::Ptr Logger::find(const LoggerMapParts& parts, const std::string& name)
+{
+	for (LoggerMapParts::const_iterator itPart = parts.begin(); itPart != parts.end(); ++itPart)
 	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) return it->second;
+		const LoggerMap& loggers = (*itPart)->value();
+		LoggerMap::const_iterator it = loggers.find(name);
+		if (it != loggers.end()) return it->second;
 	}
 	return 0;
 }
@@ -349,25 +376,48 @@ void Logger::destroy(const std::string& name)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	LoggerMapPtr::Snapshot* pMap = _pLoggerMap.get();
+	if (!pMap) return;
+
+	const LoggerMapParts& parts = pMap->value();
+	for (std::size_t i = 0; i < parts.size(); ++i)
 	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
-		if (it != _pLoggerMap->end()) _pLoggerMap->erase(it);
+		if (parts[i]->value().find(name) != parts[i]->value().end())
+		{
+			// only the map holding the logger is copied
+			LoggerMapPtr::Ptr pNewMap = new LoggerMapPtr::Snapshot(parts);
+			LoggerMapParts& newParts = pNewMap->value();
+			if (parts[i]->value().size() == 1)
+			{
+				newParts.erase(newParts.begin() + i);
+			}
+			else
+			{
+				newParts[i] = new LoggerMapPart(parts[i]->value());
+				newParts[i]->value().erase(name);
+			}
+			_pLoggerMap.store(pNewMap.duplicate());
+			return;
+		}
 	}
 }
 
 
 void Logger::names(std::vector<std::string>& names)
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
 	names.clear();
-	if (_pLoggerMap)
+	LoggerMapPtr::Ptr pMap = _pLoggerMap.load();
+	if (pMap)
 	{
-		for (LoggerMap::const_iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
+		for (LoggerMapParts::const_iterator itPart = pMap->value().begin(); itPart != pMap->value().end(); ++itPart)
 		{
-			names.push_back(it->first);
+			const LoggerMap& loggers = (*itPart)->value();
+			for (LoggerMap::const_iterator it = loggers.begin(); it != loggers.end(); ++it)
+			{
+				names.push_back(it->first);
+			}
 		}
+		std::sort(names.begin(), names.end());
 	}
 }
 
@@ -426,8 +476,30 @@ int Logger::parseLevel(const std::string& level)
 
 void Logger::add(Ptr pLogger)
 {
-	if (!_pLoggerMap) _pLoggerMap.reset(new LoggerMap);
-	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	// Published maps are never modified, as they may be used by other
+	// threads. Instead of copying all loggers, the new logger is put
+	// into a new map, which is merged with the smallest existing maps
+	// as long as they are not larger, as in a binary counter. Every
+	// logger is thus copied O(log n) times in total, and the larger
+	// maps are shared with the previous snapshot.
+	LoggerMapPtr::Ptr pMap;
+	if (LoggerMapPtr::Snapshot* pOldMap = _pLoggerMap.get())
+		pMap = new LoggerMapPtr::Snapshot(pOldMap->value());
+	else
+		pMap = new LoggerMapPtr::Snapshot;
+
+	LoggerMapParts& parts = pMap->value();
+	AutoPtr<LoggerMapPart> pPart = new LoggerMapPart;
+	pPart->value().insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	while (!parts.empty() && parts.back()->value().size() <= pPart->value().size())
+	{
+		AutoPtr<LoggerMapPart> pMerged = new LoggerMapPart(parts.back()->value());
+		pMerged->value().insert(pPart->value().begin(), pPart->value().end());
+		pPart = pMerged;
+		parts.pop_back();
+	}
+	parts.push_back(pPart);
+	_pLoggerMap.store(pMap.duplicate());
 }
 
 
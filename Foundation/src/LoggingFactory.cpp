@@ -17,6 +17,8 @@
 #include "Poco/AsyncChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/FileChannel.h"
+#include "Poco/AsyncFileChannel.h"
+#include "Poco/BinaryLogChannel.h"
 #include "Poco/SimpleFileChannel.h"
 #include "Poco/FormattingChannel.h"
 #include "Poco/SplitterChannel.h"
@@ -96,6 +98,8 @@ void LoggingFactory::registerBuiltins()
 #ifndef POCO_NO_FILECHANNEL
 	_channelFactory.registerClass("FileChannel", new Instantiator<FileChannel, Channel>);
 	_channelFactory.registerClass("SimpleFileChannel", new Instantiator<SimpleFileChannel, Channel>);
+	_channelFactory.registerClass("AsyncFileChannel", new Instantiator<AsyncFileChannel, Channel>);
+	_channelFactory.registerClass("BinaryLogChannel", new Instantiator<BinaryLogChannel, Channel>);
 #endif
 	_channelFactory.registerClass("FormattingChannel", new Instantiator<FormattingChannel, Channel>);
 #ifndef POCO_NO_SPLITTERCHANNEL
@@ -19,13 +19,15 @@
 namespace Poco {
 
 
-MemoryPool::MemoryPool(std::size_t blockLength, int preAlloc, int maxAlloc):
+MemoryPool::MemoryPool(std::size_t blockLength, int preAlloc, int maxAlloc, bool threadCaching):
 		_blockSize(blockLength),
 		_maxAlloc(maxAlloc),
-		_allocated(preAlloc)
+		_allocated(preAlloc),
+		_threadCaching(threadCaching && blockLength <= ThreadCachingAllocator::MAX_SIZE)
 {
 	poco_assert (maxAlloc == 0 || maxAlloc >= preAlloc);
 	poco_assert (preAlloc >= 0 && maxAlloc >= 0);
+	poco_assert (!threadCaching || (preAlloc == 0 && maxAlloc == 0));
 
 	int r = BLOCK_RESERVE;
 	if (preAlloc > r)
@@ -67,6 +69,13 @@ void MemoryPool::clear()
 
 void* MemoryPool::get()
 {
+	if (_threadCaching)
+	{
+		void* ptr = ThreadCachingAllocator::allocate(_blockSize);
+		++_allocated;
+		return ptr;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (_blocks.empty())
@@ -89,6 +98,16 @@ void* MemoryPool::get()
 
 void MemoryPool::release(void* ptr)
 {
+	if (_threadCaching)
+	{
+		if (ptr)
+		{
+			ThreadCachingAllocator::deallocate(ptr, _blockSize);
+			--_allocated;
+		}
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	try
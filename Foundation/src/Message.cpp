@@ -229,6 +229,12 @@ void Message::setTid(long tid)
 }
 
 
+void Message::setOsTid(IntPtr tid)
+{
+	_ostid = tid;
+}
+
+
 void Message::setPid(long pid)
 {
 	_pid = pid;
@@ -253,6 +259,14 @@ bool Message::has(const std::string& param) const
 }
 
 
+const Message::StringMap& Message::getAll() const
+{
+	static const StringMap empty;
+
+	return _pMap ? *_pMap : empty;
+}
+
+
 const std::string& Message::get(const std::string& param) const
 {
 	if (_pMap)
@@ -0,0 +1,147 @@
+//
+// MonotonicArena.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  MonotonicArena
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MonotonicArena.h"
+#include "Poco/ThreadCachingAllocator.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+MonotonicArena::MonotonicArena(std::size_t chunkSize):
+	_pPos(0),
+	_pEnd(0),
+	_pChunks(0),
+	_pFinalizers(0),
+	_chunkSize(chunkSize < 2*sizeof(Chunk) ? 2*sizeof(Chunk) : chunkSize),
+	_nextChunkSize(_chunkSize),
+	_allocated(0),
+	_capacity(0)
+{
+}
+
+
+MonotonicArena::~MonotonicArena()
+{
+	finalize();
+	while (_pChunks)
+	{
+		Chunk* pChunk = _pChunks;
+		_pChunks = pChunk->pNext;
+		release(pChunk);
+	}
+}
+
+
+void* MonotonicArena::allocateChunk(std::size_t size, std::size_t alignment)
+{
+	std::size_t required = sizeof(Chunk) + size + alignment - 1;
+	bool dedicated = required > _nextChunkSize;
+	std::size_t chunkSize = dedicated ? required : _nextChunkSize;
+
+	Chunk* pChunk = static_cast<Chunk*>(ThreadCachingAllocator::allocate(chunkSize));
+	pChunk->size = chunkSize;
+	_capacity += chunkSize;
+
+	char* pBegin = reinterpret_cast<char*>(pChunk + 1);
+	char* pEnd   = reinterpret_cast<char*>(pChunk) + chunkSize;
+	std::size_t pos = reinterpret_cast<std::size_t>(pBegin);
+	char* pBlock = reinterpret_cast<char*>((pos + alignment - 1) & ~(alignment - 1));
+
+	if (dedicated && _pChunks)
+	{
+		// keep allocating from the current chunk, which
+		// likely has more space left than the new one
+		pChunk->pNext = _pChunks->pNext;
+		_pChunks->pNext = pChunk;
+	}
+	else
+	{
+		pChunk->pNext = _pChunks;
+		_pChunks = pChunk;
+		_pPos = pBlock + size;
+		_pEnd = pEnd;
+		if (!dedicated)
+		{
+			std::size_t maxSize = _chunkSize > ThreadCachingAllocator::MAX_SIZE ? _chunkSize : std::size_t(ThreadCachingAllocator::MAX_SIZE);
+			_nextChunkSize = 2*_nextChunkSize > maxSize ? maxSize : 2*_nextChunkSize;
+		}
+	}
+	_allocated += size;
+	return pBlock;
+}
+
+
+char* MonotonicArena::copy(const char* str, std::size_t length)
+{
+	char* pCopy = static_cast<char*>(allocate(length + 1, 1));
+	std::memcpy(pCopy, str, length);
+	pCopy[length] = 0;
+	return pCopy;
+}
+
+
+void MonotonicArena::reset()
+{
+	finalize();
+
+	Chunk* pFirst = 0;
+	while (_pChunks)
+	{
+		Chunk* pChunk = _pChunks;
+		_pChunks = pChunk->pNext;
+		if (_pChunks || pChunk->size > ThreadCachingAllocator::MAX_SIZE)
+			release(pChunk);
+		else
+			pFirst = pChunk;
+	}
+
+	_allocated = 0;
+	_nextChunkSize = _chunkSize;
+	if (pFirst)
+	{
+		pFirst->pNext = 0;
+		_pChunks  = pFirst;
+		_pPos     = reinterpret_cast<char*>(pFirst + 1);
+		_pEnd     = reinterpret_cast<char*>(pFirst) + pFirst->size;
+		_capacity = pFirst->size;
+	}
+	else
+	{
+		_pPos     = 0;
+		_pEnd     = 0;
+		_capacity = 0;
+	}
+}
+
+
+void MonotonicArena::finalize()
+{
+	while (_pFinalizers)
+	{
+		Finalizer* pFinalizer = _pFinalizers;
+		_pFinalizers = pFinalizer->pNext;
+		pFinalizer->destroy(pFinalizer->pObject);
+	}
+}
+
+
+void MonotonicArena::release(Chunk* pChunk)
+{
+	ThreadCachingAllocator::deallocate(pChunk, pChunk->size);
+}
+
+
+} // namespace Poco
@@ -23,6 +23,7 @@
 #include "Poco/Environment.h"
 #include "Poco/NumberParser.h"
 #include "Poco/StringTokenizer.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -33,7 +34,59 @@ const std::string PatternFormatter::PROP_TIMES   = "times";
 const std::string PatternFormatter::PROP_PRIORITY_NAMES = "priorityNames";
 
 
+namespace
+{
+	struct SegmentCache
+		/// The cached segments of a PatternFormatter, rendered
+		/// for the second the last message formatted has been
+		/// logged in.
+	{
+		SegmentCache():
+			planId(0),
+			second(0)
+		{
+		}
+
+		UInt64 planId;
+		Int64  second;
+		std::vector<std::string> segments;
+	};
+
+	enum
+	{
+		SEGMENT_CACHES = 4 /// number of formatters cached per thread
+	};
+
+	thread_local SegmentCache segmentCaches[SEGMENT_CACHES];
+	thread_local int nextSegmentCache = 0;
+
+	std::atomic<UInt64> nextPlanId(0);
+
+	inline void appendDigits(std::string& text, int value, int width)
+		/// Appends the given value, zero-padded to the given width.
+	{
+		char buffer[8];
+		for (int i = width - 1; i >= 0; --i)
+		{
+			buffer[i] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+		text.append(buffer, width);
+	}
+
+	inline Int64 secondOf(const Timestamp& timestamp)
+	{
+		Timestamp::TimeVal ts = timestamp.epochMicroseconds();
+		Timestamp::TimeVal second = ts/Timestamp::resolution();
+		if (ts < 0 && second*Timestamp::resolution() != ts) --second;
+		return second;
+	}
+}
+
+
 PatternFormatter::PatternFormatter():
+	_segmentCount(0),
+	_planId(0),
 	_localTime(false)
 {
 	parsePriorityNames();
@@ -41,6 +94,8 @@ PatternFormatter::PatternFormatter():
 
 
 PatternFormatter::PatternFormatter(const std::string& rFormat):
+	_segmentCount(0),
+	_planId(0),
 	_localTime(false),
 	_pattern(rFormat)
 {
@@ -56,86 +111,178 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
-	Timestamp timestamp = msg.getTime();
-	bool localTime = _localTime;
-	if (localTime)
-	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
-	}
-	DateTime dateTime = timestamp;
-	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+	const std::vector<std::string>* pSegments = 0;
+	if (_segmentCount > 0)
 	{
-		text.append(ip->prepend);
-		switch (ip->key)
+		Int64 second = secondOf(msg.getTime());
+		SegmentCache* pCache = 0;
+		for (int i = 0; i < SEGMENT_CACHES; ++i)
 		{
-		case 's': text.append(msg.getSource()); break;
-		case 't': text.append(msg.getText()); break;
-		case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
-		case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
-		case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
-		case 'P': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getPid())); break;
-		case 'I': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getTid())); break;
-		case 'T': text.append(msg.getThread()); break;
-		case 'O': NumberFormatter::append(text, msg.getOsTid()); break;
-		case 'N': text.append(Environment::nodeName()); break;
-		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
-		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-		case 'e': NumberFormatter::append(text, dateTime.day()); break;
-		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-		case 'n': NumberFormatter::append(text, dateTime.month()); break;
-		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'E': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getTime().epochTime())); break;
-		case 'v':
-			if (ip->length > msg.getSource().length())	//append spaces
-				text.append(msg.getSource()).append(ip->length - msg.getSource().length(), ' ');
-			else if (ip->length && ip->length < msg.getSource().length()) // crop
-				text.append(msg.getSource(), msg.getSource().length()-ip->length, ip->length);
-			else
-				text.append(msg.getSource());
-			break;
-		case 'x':
-			try
+			if (segmentCaches[i].planId == _planId)
 			{
-				text.append(msg[ip->property]);
+				pCache = &segmentCaches[i];
+				break;
 			}
-			catch (...)
+		}
+		if (!pCache || pCache->second != second)
+		{
+			if (!pCache)
 			{
+				pCache = &segmentCaches[nextSegmentCache];
+				nextSegmentCache = (nextSegmentCache + 1) % SEGMENT_CACHES;
 			}
-			break;
-		case 'L':
-			if (!localTime)
+			pCache->planId = 0;
+			renderSegments(msg, pCache->segments);
+			pCache->planId = _planId;
+			pCache->second = second;
+		}
+		pSegments = &pCache->segments;
+	}
+
+	for (std::vector<PatternStep>::const_iterator it = _steps.begin(); it != _steps.end(); ++it)
+	{
+		switch (it->type)
+		{
+		case STEP_LITERAL: text.append(it->text); break;
+		case STEP_CACHED:  text.append((*pSegments)[it->segment]); break;
+		case STEP_FIELD:   appendMessageField(_patternActions[it->first], msg, text); break;
+		}
+	}
+}
+
+
+void PatternFormatter::renderSegments(const Message& msg, std::vector<std::string>& segments) const
+{
+	segments.resize(_segmentCount);
+
+	Timestamp timestamp = msg.getTime();
+	DateTime utcTime(timestamp);
+	DateTime localTime(utcTime);
+	bool haveLocalTime = false;
+	for (std::vector<PatternStep>::const_iterator it = _steps.begin(); it != _steps.end(); ++it)
+	{
+		if (it->type != STEP_CACHED) continue;
+
+		std::string& segment = segments[it->segment];
+		segment.clear();
+		for (std::size_t i = it->first; i < it->last; ++i)
+		{
+			const PatternAction& action = _patternActions[i];
+			segment.append(action.prepend);
+			if (fieldType(action.key) != FIELD_TIME) continue;
+
+			if (action.localTime && !haveLocalTime)
 			{
-				localTime = true;
-				timestamp += Timezone::utcOffset()*Timestamp::resolution();
-				timestamp += Timezone::dst()*Timestamp::resolution();
-				dateTime = timestamp;
+				Timestamp localTimestamp = timestamp;
+				localTimestamp += Timezone::utcOffset()*Timestamp::resolution();
+				localTimestamp += Timezone::dst()*Timestamp::resolution();
+				localTime = localTimestamp;
+				haveLocalTime = true;
 			}
-			break;
+			appendTimeField(action, action.localTime ? localTime : utcTime, segment);
 		}
 	}
 }
 
 
+void PatternFormatter::appendTimeField(const PatternAction& action, const DateTime& dateTime, std::string& text) const
+{
+	switch (action.key)
+	{
+	case 'N': text.append(Environment::nodeName()); break;
+	case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+	case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+	case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+	case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+	case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+	case 'e': NumberFormatter::append(text, dateTime.day()); break;
+	case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
+	case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+	case 'n': NumberFormatter::append(text, dateTime.month()); break;
+	case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
+	case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+	case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
+	case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
+	case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+	case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
+	case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
+	case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
+	case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
+	case 'z': DateTimeFormatter::tzdISO(text, action.localTime ? Timezone::tzd() : DateTimeFormatter::UTC); break;
+	case 'Z': DateTimeFormatter::tzdRFC(text, action.localTime ? Timezone::tzd() : DateTimeFormatter::UTC); break;
+	}
+}
+
+
+void PatternFormatter::appendMessageField(const PatternAction& action, const Message& msg, std::string& text)
+{
+	switch (action.key)
+	{
+	case 's': text.append(msg.getSource()); break;
+	case 't': text.append(msg.getText()); break;
+	case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
+	case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
+	case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
+	case 'P': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getPid())); break;
+	case 'I': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getTid())); break;
+	case 'T': text.append(msg.getThread()); break;
+	case 'O': NumberFormatter::append(text, msg.getOsTid()); break;
+	case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
+	case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+	case 'E': NumberFormatter::append(text, static_cast<Poco::Int64>(msg.getTime().epochTime())); break;
+	case 'i':
+	case 'c':
+	case 'F':
+		{
+			// fractional seconds do not depend on the time zone
+			Int64 us = msg.getTime().epochMicroseconds() - secondOf(msg.getTime())*Timestamp::resolution();
+			if (action.key == 'i')
+				appendDigits(text, static_cast<int>(us/1000), 3);
+			else if (action.key == 'c')
+				appendDigits(text, static_cast<int>(us/100000), 1);
+			else
+				appendDigits(text, static_cast<int>(us), 6);
+		}
+		break;
+	case 'v':
+		if (action.length > msg.getSource().length())	//append spaces
+			text.append(msg.getSource()).append(action.length - msg.getSource().length(), ' ');
+		else if (action.length && action.length < msg.getSource().length()) // crop
+			text.append(msg.getSource(), msg.getSource().length()-action.length, action.length);
+		else
+			text.append(msg.getSource());
+		break;
+	case 'x':
+		try
+		{
+			text.append(msg[action.property]);
+		}
+		catch (...)
+		{
+		}
+		break;
+	}
+}
+
+
+PatternFormatter::FieldType PatternFormatter::fieldType(char key)
+{
+	switch (key)
+	{
+	case 'N': case 'w': case 'W': case 'b': case 'B': case 'd': case 'e':
+	case 'f': case 'm': case 'n': case 'o': case 'y': case 'Y': case 'H':
+	case 'h': case 'a': case 'A': case 'M': case 'S': case 'z': case 'Z':
+		return FIELD_TIME;
+	case 's': case 't': case 'l': case 'p': case 'q': case 'P': case 'I':
+	case 'T': case 'O': case 'U': case 'u': case 'E': case 'i': case 'c':
+	case 'F': case 'v': case 'x':
+		return FIELD_MESSAGE;
+	default:
+		return FIELD_NONE;
+	}
+}
+
+
 void PatternFormatter::parsePattern()
 {
 	_patternActions.clear();
@@ -148,9 +295,14 @@ void PatternFormatter::parsePattern()
 		{
 			if (++it != end)
 			{
+				// literal text becomes an action of its own,
+				// so that it can be cached with adjacent fields
+				if (!endAct.prepend.empty())
+				{
+					_patternActions.push_back(endAct);
+					endAct.prepend.clear();
+				}
 				PatternAction act;
-				act.prepend = endAct.prepend;
-				endAct.prepend.clear();
 
 				if (*it == '[')
 				{
@@ -192,6 +344,58 @@ void PatternFormatter::parsePattern()
 	{
 		_patternActions.push_back(endAct);
 	}
+	compilePattern();
+}
+
+
+void PatternFormatter::compilePattern()
+{
+	bool localTime = _localTime;
+	for (std::vector<PatternAction>::iterator it = _patternActions.begin(); it != _patternActions.end(); ++it)
+	{
+		it->localTime = localTime;
+		if (it->key == 'L') localTime = true;
+	}
+
+	_steps.clear();
+	_segmentCount = 0;
+	std::size_t i = 0;
+	std::size_t n = _patternActions.size();
+	while (i < n)
+	{
+		PatternStep step;
+		step.first   = i;
+		step.segment = 0;
+		if (fieldType(_patternActions[i].key) == FIELD_MESSAGE)
+		{
+			step.type = STEP_FIELD;
+			step.last = ++i;
+			_steps.push_back(step);
+			continue;
+		}
+
+		bool cached = false;
+		while (i < n && fieldType(_patternActions[i].key) != FIELD_MESSAGE)
+		{
+			if (fieldType(_patternActions[i].key) == FIELD_TIME) cached = true;
+			step.text.append(_patternActions[i].prepend);
+			++i;
+		}
+		step.last = i;
+		if (cached)
+		{
+			step.type    = STEP_CACHED;
+			step.segment = _segmentCount++;
+			step.text.clear();
+			_steps.push_back(step);
+		}
+		else if (!step.text.empty())
+		{
+			step.type = STEP_LITERAL;
+			_steps.push_back(step);
+		}
+	}
+	_planId = ++nextPlanId;
 }
 
 	
@@ -205,6 +409,7 @@ void PatternFormatter::setProperty(const std::string& name, const std::string& v
 	else if (name == PROP_TIMES)
 	{
 		_localTime = (value == "local");
+		compilePattern();
 	}
 	else if (name == PROP_PRIORITY_NAMES)
 	{
@@ -14,6 +14,7 @@
 
 #include "Poco/TaskManager.h"
 #include "Poco/TaskNotification.h"
+#include "Poco/WorkStealingExecutor.h"
 
 
 namespace Poco {
@@ -23,13 +24,22 @@ const int TaskManager::MIN_PROGRESS_NOTIFICATION_INTERVAL = 100000; // 100 milli
 
 
 TaskManager::TaskManager(ThreadPool::ThreadAffinityPolicy affinityPolicy):
-	_threadPool(ThreadPool::defaultPool(affinityPolicy))
+	_pThreadPool(&ThreadPool::defaultPool(affinityPolicy)),
+	_pExecutor(0)
 {
 }
 
 
 TaskManager::TaskManager(ThreadPool& pool):
-	_threadPool(pool)
+	_pThreadPool(&pool),
+	_pExecutor(0)
+{
+}
+
+
+TaskManager::TaskManager(WorkStealingExecutor& executor):
+	_pThreadPool(0),
+	_pExecutor(&executor)
 {
 }
 
@@ -49,7 +59,10 @@ void TaskManager::start(Task* pTask, int cpu)
 	_taskList.push_back(pAutoTask);
 	try
 	{
-		_threadPool.start(*pAutoTask, pAutoTask->name(), cpu);
+		if (_pExecutor)
+			_pExecutor->start(*pAutoTask);
+		else
+			_pThreadPool->start(*pAutoTask, pAutoTask->name(), cpu);
 	}
 	catch (...)
 	{
@@ -101,7 +114,10 @@ void TaskManager::cancelAll()
 
 void TaskManager::joinAll()
 {
-	_threadPool.joinAll();
+	if (_pExecutor)
+		_pExecutor->joinAll();
+	else
+		_pThreadPool->joinAll();
 }
 
 
@@ -0,0 +1,298 @@
+//
+// ThreadCachingAllocator.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  ThreadCachingAllocator
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ThreadCachingAllocator.h"
+#include "Poco/Mutex.h"
+#include <vector>
+#include <new>
+
+
+namespace Poco {
+
+
+namespace
+{
+	enum
+	{
+		SMALL_SIZE   = 128,   /// classes up to this size are 16 bytes apart
+		SMALL_COUNT  = 8,
+		SLAB_SIZE    = 65536, /// minimum size of memory obtained from the system
+		BATCH_BYTES  = 65536,
+		MAX_BATCH    = 64
+	};
+
+	struct Block
+	{
+		Block* pNext;
+	};
+
+	struct Chain
+	{
+		Block*      pHead;
+		std::size_t count;
+	};
+
+	inline int sizeClass(std::size_t size)
+	{
+		if (size <= SMALL_SIZE)
+		{
+			return size == 0 ? 0 : static_cast<int>((size - 1) >> 4);
+		}
+		else
+		{
+			// four classes between 2^k + 1 and 2^(k + 1)
+			std::size_t n = size - 1;
+			int k = 7;
+			while ((n >> (k + 1)) != 0) ++k;
+			return SMALL_COUNT + (k - 7)*4 + static_cast<int>((n - (std::size_t(1) << k)) >> (k - 2));
+		}
+	}
+
+	inline std::size_t classSize(int sizeClass)
+	{
+		if (sizeClass < SMALL_COUNT)
+		{
+			return static_cast<std::size_t>(sizeClass + 1) << 4;
+		}
+		else
+		{
+			int k = 7 + (sizeClass - SMALL_COUNT)/4;
+			int j = (sizeClass - SMALL_COUNT) % 4;
+			return (std::size_t(1) << k) + (static_cast<std::size_t>(j + 1) << (k - 2));
+		}
+	}
+
+	inline std::size_t batchSize(int sizeClass)
+		/// Returns the number of blocks exchanged between
+		/// a thread cache and the central arena at once.
+	{
+		std::size_t n = BATCH_BYTES/classSize(sizeClass);
+		if (n < 2) n = 2;
+		if (n > MAX_BATCH) n = MAX_BATCH;
+		return n;
+	}
+
+
+	class CentralArena
+		/// Keeps the free blocks not cached by any thread, in
+		/// chains of blocks, one list of chains per size class.
+	{
+	public:
+		Chain fetch(int sizeClass)
+			/// Returns a chain of free blocks of the given size class,
+			/// obtaining a new slab from the system if necessary.
+		{
+			{
+				FastMutex::ScopedLock lock(_bins[sizeClass].mutex);
+				std::vector<Chain>& chains = _bins[sizeClass].chains;
+				if (!chains.empty())
+				{
+					Chain chain = chains.back();
+					chains.pop_back();
+					return chain;
+				}
+			}
+			return carve(sizeClass);
+		}
+
+		void release(int sizeClass, Block* pHead, std::size_t count)
+			/// Takes a chain of count free blocks of the given size class.
+		{
+			Chain chain = {pHead, count};
+			FastMutex::ScopedLock lock(_bins[sizeClass].mutex);
+			_bins[sizeClass].chains.push_back(chain);
+		}
+
+	private:
+		Chain carve(int sizeClass)
+			/// Obtains a slab from the system and divides it into
+			/// chains of blocks. The first chain is returned, the
+			/// others are added to the bin.
+		{
+			std::size_t size  = classSize(sizeClass);
+			std::size_t batch = batchSize(sizeClass);
+			std::size_t slabSize = size*batch;
+			if (slabSize < SLAB_SIZE) slabSize = (SLAB_SIZE/slabSize)*slabSize;
+			char* pSlab = static_cast<char*>(::operator new(slabSize));
+
+			std::size_t blocks = slabSize/size;
+			std::vector<Chain> chains;
+			chains.reserve(blocks/batch);
+			for (std::size_t i = 0; i < blocks; i += batch)
+			{
+				for (std::size_t k = 0; k < batch - 1; ++k)
+				{
+					reinterpret_cast<Block*>(pSlab + (i + k)*size)->pNext = reinterpret_cast<Block*>(pSlab + (i + k + 1)*size);
+				}
+				reinterpret_cast<Block*>(pSlab + (i + batch - 1)*size)->pNext = 0;
+				Chain chain = {reinterpret_cast<Block*>(pSlab + i*size), batch};
+				chains.push_back(chain);
+			}
+
+			Chain first = chains.back();
+			chains.pop_back();
+			if (!chains.empty())
+			{
+				FastMutex::ScopedLock lock(_bins[sizeClass].mutex);
+				_bins[sizeClass].chains.insert(_bins[sizeClass].chains.end(), chains.begin(), chains.end());
+			}
+			return first;
+		}
+
+		struct Bin
+		{
+			FastMutex          mutex;
+			std::vector<Chain> chains;
+		};
+
+		Bin _bins[ThreadCachingAllocator::CLASS_COUNT];
+	};
+
+
+	CentralArena& arena()
+	{
+		// Never destroyed, as blocks may be released by static
+		// objects and terminating threads during process shutdown.
+		static CentralArena* pArena = new CentralArena;
+		return *pArena;
+	}
+
+
+	struct ThreadCache
+		/// The free blocks cached by a thread, in one
+		/// list per size class.
+	{
+		~ThreadCache();
+
+		void flush();
+
+		Chain lists[ThreadCachingAllocator::CLASS_COUNT];
+	};
+
+
+	thread_local ThreadCache threadCache;
+	thread_local bool threadCacheDestroyed = false;
+
+
+	ThreadCache::~ThreadCache()
+	{
+		flush();
+		threadCacheDestroyed = true;
+	}
+
+
+	void ThreadCache::flush()
+	{
+		for (int i = 0; i < ThreadCachingAllocator::CLASS_COUNT; ++i)
+		{
+			if (lists[i].pHead)
+			{
+				arena().release(i, lists[i].pHead, lists[i].count);
+				lists[i].pHead = 0;
+				lists[i].count = 0;
+			}
+		}
+	}
+}
+
+
+void* ThreadCachingAllocator::allocate(std::size_t size)
+{
+	if (size > MAX_SIZE) return ::operator new(size);
+
+	int c = sizeClass(size);
+	if (threadCacheDestroyed)
+	{
+		// called during thread termination
+		Chain chain = arena().fetch(c);
+		Block* pBlock = chain.pHead;
+		if (chain.count > 1) arena().release(c, pBlock->pNext, chain.count - 1);
+		return pBlock;
+	}
+
+	Chain& list = threadCache.lists[c];
+	if (!list.pHead)
+	{
+		list = arena().fetch(c);
+	}
+	Block* pBlock = list.pHead;
+	list.pHead = pBlock->pNext;
+	--list.count;
+	return pBlock;
+}
+
+
+void ThreadCachingAllocator::deallocate(void* ptr, std::size_t size)
+{
+	if (!ptr) return;
+	if (size > MAX_SIZE)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	int c = sizeClass(size);
+	Block* pBlock = static_cast<Block*>(ptr);
+	if (threadCacheDestroyed)
+	{
+		pBlock->pNext = 0;
+		arena().release(c, pBlock, 1);
+		return;
+	}
+
+	Chain& list = threadCache.lists[c];
+	pBlock->pNext = list.pHead;
+	list.pHead = pBlock;
+	++list.count;
+
+	std::size_t batch = batchSize(c);
+	if (list.count >= 2*batch)
+	{
+		// keep the most recently released blocks, which are
+		// likely still in the CPU cache, and return the others
+		Block* pLast = list.pHead;
+		for (std::size_t i = 1; i < batch; ++i) pLast = pLast->pNext;
+		Block* pHead = pLast->pNext;
+		pLast->pNext = 0;
+		arena().release(c, pHead, list.count - batch);
+		list.count = batch;
+	}
+}
+
+
+std::size_t ThreadCachingAllocator::blockSize(std::size_t size)
+{
+	if (size > MAX_SIZE) return size;
+	return classSize(sizeClass(size));
+}
+
+
+void ThreadCachingAllocator::flush()
+{
+	if (!threadCacheDestroyed) threadCache.flush();
+}
+
+
+std::size_t ThreadCachingAllocator::cached()
+{
+	std::size_t n = 0;
+	if (!threadCacheDestroyed)
+	{
+		for (int i = 0; i < CLASS_COUNT; ++i) n += threadCache.lists[i].count;
+	}
+	return n;
+}
+
+
+} // namespace Poco
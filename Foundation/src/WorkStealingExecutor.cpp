@@ -0,0 +1,465 @@
+//
+// WorkStealingExecutor.cpp
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingExecutor
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/Runnable.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Environment.h"
+#include "Poco/SingletonHolder.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+
+
+class WorkStealingExecutor::Deque
+	/// A Chase-Lev work-stealing deque, as described in
+	/// "Dynamic Circular Work-Stealing Deque" by David Chase and
+	/// Yossi Lev (SPAA 2005), with the memory orderings from
+	/// "Correct and Efficient Work-Stealing for Weak Memory Models"
+	/// by Nhat Minh Le et al. (PPoPP 2013).
+	///
+	/// Only the owning worker thread may call push() and pop().
+	/// Any thread may call steal().
+{
+public:
+	Deque():
+		_top(0),
+		_bottom(0),
+		_pArray(new Array(INITIAL_CAPACITY))
+	{
+		_arrays.push_back(_pArray.load(std::memory_order_relaxed));
+	}
+
+	~Deque()
+	{
+		for (std::vector<Array*>::iterator it = _arrays.begin(); it != _arrays.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void push(Runnable* pRunnable)
+	{
+		Poco::Int64 b = _bottom.load(std::memory_order_relaxed);
+		Poco::Int64 t = _top.load(std::memory_order_acquire);
+		Array* pArray = _pArray.load(std::memory_order_relaxed);
+		if (b - t > pArray->capacity() - 1)
+		{
+			pArray = grow(pArray, t, b);
+		}
+		pArray->put(b, pRunnable);
+		std::atomic_thread_fence(std::memory_order_release);
+		_bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	Runnable* pop()
+	{
+		Poco::Int64 b = _bottom.load(std::memory_order_relaxed) - 1;
+		Array* pArray = _pArray.load(std::memory_order_relaxed);
+		_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Poco::Int64 t = _top.load(std::memory_order_relaxed);
+		Runnable* pRunnable = 0;
+		if (t <= b)
+		{
+			pRunnable = pArray->get(b);
+			if (t == b)
+			{
+				// last element; race against thieves
+				if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					pRunnable = 0;
+				_bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			_bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return pRunnable;
+	}
+
+	Runnable* steal()
+	{
+		Poco::Int64 t = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Poco::Int64 b = _bottom.load(std::memory_order_acquire);
+		if (t < b)
+		{
+			Array* pArray = _pArray.load(std::memory_order_acquire);
+			Runnable* pRunnable = pArray->get(t);
+			if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return pRunnable;
+		}
+		return 0;
+	}
+
+	bool empty() const
+	{
+		return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+	}
+
+private:
+	enum
+	{
+		INITIAL_CAPACITY = 256
+	};
+
+	class Array
+	{
+	public:
+		explicit Array(Poco::Int64 capacity):
+			_capacity(capacity),
+			_mask(capacity - 1),
+			_pSlots(new std::atomic<Runnable*>[static_cast<std::size_t>(capacity)])
+		{
+		}
+
+		~Array()
+		{
+			delete [] _pSlots;
+		}
+
+		Poco::Int64 capacity() const
+		{
+			return _capacity;
+		}
+
+		Runnable* get(Poco::Int64 index) const
+		{
+			return _pSlots[index & _mask].load(std::memory_order_relaxed);
+		}
+
+		void put(Poco::Int64 index, Runnable* pRunnable)
+		{
+			_pSlots[index & _mask].store(pRunnable, std::memory_order_relaxed);
+		}
+
+	private:
+		Poco::Int64 _capacity;
+		Poco::Int64 _mask;
+		std::atomic<Runnable*>* _pSlots;
+	};
+
+	Array* grow(Array* pArray, Poco::Int64 top, Poco::Int64 bottom)
+	{
+		Array* pNewArray = new Array(2*pArray->capacity());
+		for (Poco::Int64 i = top; i < bottom; ++i)
+		{
+			pNewArray->put(i, pArray->get(i));
+		}
+		// Thieves may still read from the old array, so it is
+		// kept until the deque is destroyed.
+		_arrays.push_back(pNewArray);
+		_pArray.store(pNewArray, std::memory_order_release);
+		return pNewArray;
+	}
+
+	std::atomic<Poco::Int64> _top;
+	std::atomic<Poco::Int64> _bottom;
+	std::atomic<Array*>      _pArray;
+	std::vector<Array*>      _arrays;
+};
+
+
+class WorkStealingExecutor::Worker: public Runnable
+{
+public:
+	Worker(WorkStealingExecutor& executor, int index, const std::string& name, int stackSize):
+		_executor(executor),
+		_index(index),
+		_seed(static_cast<Poco::UInt32>(index)*2654435761U + 1)
+	{
+		_thread.setName(name);
+		if (stackSize > 0) _thread.setStackSize(stackSize);
+	}
+
+	void start()
+	{
+		_thread.start(*this);
+	}
+
+	void join()
+	{
+		_thread.join();
+	}
+
+	void run()
+	{
+		for (;;)
+		{
+			Runnable* pRunnable = _deque.pop();
+			if (!pRunnable)
+			{
+				pRunnable = _executor.take(*this);
+				// let another parked worker help with the remaining tasks
+				if (pRunnable && _executor.hasWork()) _executor.wakeUp();
+			}
+			if (pRunnable)
+				_executor.execute(pRunnable);
+			else if (!_executor.park())
+				break;
+		}
+	}
+
+	Thread& thread()
+	{
+		return _thread;
+	}
+
+	Deque& deque()
+	{
+		return _deque;
+	}
+
+	int index() const
+	{
+		return _index;
+	}
+
+	int random(int n)
+	{
+		// xorshift32
+		_seed ^= _seed << 13;
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+		return static_cast<int>(_seed % static_cast<Poco::UInt32>(n));
+	}
+
+private:
+	WorkStealingExecutor& _executor;
+	int _index;
+	Poco::UInt32 _seed;
+	Deque _deque;
+	Thread _thread;
+};
+
+
+WorkStealingExecutor::WorkStealingExecutor(int threads, int stackSize):
+	_injected(0),
+	_pending(0),
+	_parked(0),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingExecutor::WorkStealingExecutor(const std::string& name, int threads, int stackSize):
+	_name(name),
+	_injected(0),
+	_pending(0),
+	_parked(0),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+	try
+	{
+		joinAll();
+		_stopped = true;
+		{
+			FastMutex::ScopedLock lock(_parkMutex);
+			_parkCondition.broadcast();
+		}
+		for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+		{
+			(*it)->join();
+			delete *it;
+		}
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void WorkStealingExecutor::init(int threads, int stackSize)
+{
+	poco_assert (threads >= 0);
+
+	if (threads == 0) threads = static_cast<int>(Environment::processorCount());
+	if (threads == 0) threads = 1;
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; ++i)
+	{
+		std::string name(_name.empty() ? std::string("WorkStealingExecutor") : _name);
+		name += "[#";
+		name += NumberFormatter::format(i);
+		name += "]";
+		_workers.push_back(new Worker(*this, i, name, stackSize));
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->start();
+	}
+}
+
+
+void WorkStealingExecutor::start(Runnable& target)
+{
+	++_pending;
+	Worker* pWorker = currentWorker();
+	if (pWorker)
+	{
+		pWorker->deque().push(&target);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_injectionMutex);
+		_injectionQueue.push_back(&target);
+		++_injected;
+	}
+	wakeUp();
+}
+
+
+void WorkStealingExecutor::joinAll()
+{
+	poco_assert_dbg (!currentWorker());
+
+	FastMutex::ScopedLock lock(_joinMutex);
+	while (_pending > 0)
+	{
+		_joinCondition.tryWait(_joinMutex, PARK_TIMEOUT);
+	}
+}
+
+
+WorkStealingExecutor::Worker* WorkStealingExecutor::currentWorker() const
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+	{
+		for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+		{
+			if (&(*it)->thread() == pThread) return *it;
+		}
+	}
+	return 0;
+}
+
+
+Runnable* WorkStealingExecutor::take(Worker& worker)
+{
+	if (_injected > 0)
+	{
+		FastMutex::ScopedLock lock(_injectionMutex);
+		if (!_injectionQueue.empty())
+		{
+			Runnable* pRunnable = _injectionQueue.front();
+			_injectionQueue.pop_front();
+			--_injected;
+			return pRunnable;
+		}
+	}
+
+	int n = static_cast<int>(_workers.size());
+	if (n > 1)
+	{
+		int start = worker.random(n);
+		for (int i = 0; i < n; ++i)
+		{
+			Worker* pVictim = _workers[(start + i) % n];
+			if (pVictim == &worker) continue;
+			Runnable* pRunnable = pVictim->deque().steal();
+			if (pRunnable) return pRunnable;
+		}
+	}
+	return 0;
+}
+
+
+bool WorkStealingExecutor::hasWork() const
+{
+	if (_injected > 0) return true;
+	for (WorkerVec::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		if (!(*it)->deque().empty()) return true;
+	}
+	return false;
+}
+
+
+bool WorkStealingExecutor::park()
+{
+	FastMutex::ScopedLock lock(_parkMutex);
+	++_parked;
+	// pairs with the fence in wakeUp(): either the starting thread
+	// sees this worker parked, or this worker sees the new task
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!_stopped && !hasWork())
+	{
+		_parkCondition.tryWait(_parkMutex, PARK_TIMEOUT);
+	}
+	--_parked;
+	return !_stopped || hasWork();
+}
+
+
+void WorkStealingExecutor::execute(Runnable* pRunnable)
+{
+	try
+	{
+		pRunnable->run();
+	}
+	catch (Exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (std::exception& exc)
+	{
+		ErrorHandler::handle(exc);
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+	if (--_pending == 0)
+	{
+		FastMutex::ScopedLock lock(_joinMutex);
+		_joinCondition.broadcast();
+	}
+}
+
+
+void WorkStealingExecutor::wakeUp()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_parked > 0)
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_parkCondition.signal();
+	}
+}
+
+
+namespace
+{
+	static SingletonHolder<WorkStealingExecutor> sh;
+}
+
+
+WorkStealingExecutor& WorkStealingExecutor::defaultExecutor()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
@@ -13,9 +13,12 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/ActiveDispatcher.h"
 #include "Poco/ActiveMethod.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Thread.h"
 #include "Poco/Event.h"
 #include "Poco/Exception.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
 
 
 using Poco::ActiveDispatcher;
@@ -25,6 +28,7 @@ using Poco::ActiveStarter;
 using Poco::Thread;
 using Poco::Event;
 using Poco::Exception;
+using Poco::WorkStealingExecutor;
 
 
 namespace
@@ -85,6 +89,39 @@ namespace
 	private:
 		Event _continue;
 	};
+
+	class ExecutorActiveObject: public ActiveDispatcher
+	{
+	public:
+		ExecutorActiveObject(WorkStealingExecutor& executor):
+			ActiveDispatcher(executor),
+			append(this, &ExecutorActiveObject::appendImpl),
+			_running(0)
+		{
+		}
+
+		ActiveMethod<int, int, ExecutorActiveObject, ActiveStarter<ActiveDispatcher> > append;
+
+		const std::vector<int>& values() const
+		{
+			return _values;
+		}
+
+	protected:
+		int appendImpl(const int& n)
+		{
+			// methods must never run concurrently
+			if (++_running != 1) throw Exception("concurrent execution");
+			_values.push_back(n);
+			Thread::yield();
+			--_running;
+			return static_cast<int>(_values.size());
+		}
+
+	private:
+		std::vector<int> _values;
+		Poco::AtomicCounter _running;
+	};
 }
 
 
@@ -195,6 +232,28 @@ void ActiveDispatcherTest::testVoidIn()
 }
 
 
+void ActiveDispatcherTest::testExecutor()
+{
+	WorkStealingExecutor executor(4);
+	ExecutorActiveObject activeObj(executor);
+	std::vector<ActiveResult<int> > results;
+	for (int i = 0; i < 1000; ++i)
+	{
+		results.push_back(activeObj.append(i));
+	}
+	for (int i = 0; i < 1000; ++i)
+	{
+		results[i].wait();
+		assertTrue (!results[i].failed());
+		assertTrue (results[i].data() == i + 1);
+	}
+	for (int i = 0; i < 1000; ++i)
+	{
+		assertTrue (activeObj.values()[i] == i);
+	}
+}
+
+
 void ActiveDispatcherTest::setUp()
 {
 }
@@ -216,6 +275,7 @@ CppUnit::Test* ActiveDispatcherTest::suite()
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoid);
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoidIn);
 	CppUnit_addTest(pSuite, ActiveDispatcherTest, testVoidInOut);
+	CppUnit_addTest(pSuite, ActiveDispatcherTest, testExecutor);
 
 	return pSuite;
 }
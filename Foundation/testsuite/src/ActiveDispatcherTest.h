@@ -27,6 +27,7 @@ public:
 	void testFailure();
 	void testVoid();
 	void testVoidIn();
+	void testExecutor();
 	void testVoidInOut();
 
 	void setUp();
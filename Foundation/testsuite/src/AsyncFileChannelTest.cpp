@@ -0,0 +1,461 @@
+//
+// AsyncFileChannelTest.cpp
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "AsyncFileChannelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/AsyncFileChannel.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/FileStream.h"
+#include "Poco/Timestamp.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/Exception.h"
+
+
+using Poco::AsyncFileChannel;
+using Poco::Message;
+using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::File;
+using Poco::Path;
+using Poco::FileInputStream;
+using Poco::Timestamp;
+using Poco::DateTimeFormatter;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+using Poco::DirectoryIterator;
+using Poco::InvalidArgumentException;
+
+
+namespace
+{
+	const int THREADS  = 4;
+	const int MESSAGES = 2000;
+
+	void logMessages(AsyncFileChannel* pChannel, int thread)
+	{
+		for (int i = 0; i < MESSAGES; ++i)
+		{
+			std::string text(NumberFormatter::format(thread));
+			text += ' ';
+			text += NumberFormatter::format(i);
+			pChannel->log(Message("source", text, Message::PRIO_INFORMATION));
+		}
+	}
+}
+
+
+AsyncFileChannelTest::AsyncFileChannelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+AsyncFileChannelTest::~AsyncFileChannelTest()
+{
+}
+
+
+void AsyncFileChannelTest::testLog()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->open();
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(Message("source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+		pChannel->close();
+
+		std::vector<std::string> lines = readLines(name);
+		assertTrue (lines.size() == 100);
+		for (int i = 0; i < 100; ++i)
+		{
+			assertTrue (lines[i] == NumberFormatter::format(i));
+		}
+
+		// logging after close() reopens the channel
+		pChannel->log(Message("source", "reopened", Message::PRIO_INFORMATION));
+		pChannel->close();
+		lines = readLines(name);
+		assertTrue (lines.size() == 101);
+		assertTrue (lines.back() == "reopened");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testConcurrentLog()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_BATCHSIZE, "100");
+		pChannel->open();
+
+		AsyncFileChannel* pRawChannel = pChannel;
+		Thread threads[THREADS];
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].startFunc([pRawChannel, t]() { logMessages(pRawChannel, t); });
+		}
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].join();
+		}
+		pChannel->close();
+
+		// the messages of every thread must appear completely,
+		// in the order in which they have been logged
+		std::vector<std::string> lines = readLines(name);
+		assertTrue (lines.size() == THREADS*MESSAGES);
+		int next[THREADS] = {0};
+		for (std::vector<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+		{
+			std::string::size_type pos = it->find(' ');
+			assertTrue (pos != std::string::npos);
+			int t = NumberParser::parse(it->substr(0, pos));
+			int i = NumberParser::parse(it->substr(pos + 1));
+			assertTrue (t >= 0 && t < THREADS);
+			assertTrue (i == next[t]);
+			++next[t];
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testCloseWhileLogging()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->open();
+
+		AsyncFileChannel* pRawChannel = pChannel;
+		Thread threads[THREADS];
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].startFunc([pRawChannel, t]() { logMessages(pRawChannel, t); });
+		}
+		pChannel->close();
+		for (int t = 0; t < THREADS; ++t)
+		{
+			threads[t].join();
+		}
+
+		// destroying the channel writes the messages logged
+		// while or after it has been closed
+		pChannel = 0;
+		assertTrue (readLines(name).size() == THREADS*MESSAGES);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testFlushInterval()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "10");
+		pChannel->open();
+		pChannel->log(Message("source", "This is a log file entry", Message::PRIO_INFORMATION));
+
+		// written by the background thread without closing the channel
+		int n = 0;
+		while (readLines(name).empty() && n++ < 200) Thread::sleep(10);
+		assertTrue (readLines(name).size() == 1);
+
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "0");
+		pChannel->log(Message("source", "This is another log file entry", Message::PRIO_INFORMATION));
+		n = 0;
+		while (readLines(name).size() < 2 && n++ < 200) Thread::sleep(10);
+		assertTrue (readLines(name).size() == 2);
+		pChannel->close();
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testNoFlush()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "0");
+		pChannel->open();
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(Message("source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+
+		// the lines stay in the file's buffer until it is closed
+		Thread::sleep(100);
+		assertTrue (readLines(name).empty());
+
+		pChannel->close();
+		std::vector<std::string> lines = readLines(name);
+		assertTrue (lines.size() == 10);
+		assertTrue (lines.back() == "9");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testMaxPending()
+{
+	std::string name = filename();
+	try
+	{
+		// the writer is only woken up by a full queue
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "10000");
+		pChannel->setProperty(AsyncFileChannel::PROP_MAXPENDING, "10");
+		pChannel->open();
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(Message("source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+		// log() has waited for the writer
+		assertTrue (readLines(name).size() >= 90);
+		pChannel->close();
+		std::vector<std::string> lines = readLines(name);
+		assertTrue (lines.size() == 100);
+		assertTrue (lines.back() == "99");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "10000");
+		pChannel->setProperty(AsyncFileChannel::PROP_MAXPENDING, "10");
+		pChannel->setProperty(AsyncFileChannel::PROP_OVERFLOW, "drop");
+		pChannel->open();
+		for (int i = 0; i < 100; ++i)
+		{
+			pChannel->log(Message("source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+		}
+		pChannel->close();
+		std::vector<std::string> lines = readLines(name);
+		assertTrue (lines.size() == 10);
+		assertTrue (lines.back() == "9");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testRotateBySize()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel(name);
+		pChannel->setProperty(AsyncFileChannel::PROP_ROTATION, "2 K");
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+
+		// close() writes each batch of 250 bytes, and rotation
+		// is checked before every batch
+		for (int i = 0; i < 20; ++i)
+		{
+			for (int k = 0; k < 10; ++k)
+			{
+				pChannel->log(msg);
+			}
+			pChannel->close();
+		}
+		File f(name + ".0");
+		assertTrue (f.exists());
+		f = name + ".1";
+		assertTrue (f.exists());
+		f = name + ".2";
+		assertTrue (!f.exists());
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void AsyncFileChannelTest::testProperties()
+{
+	AutoPtr<AsyncFileChannel> pChannel = new AsyncFileChannel("test.log");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_FLUSHINTERVAL) == "100");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_BATCHSIZE) == "1024");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_MAXPENDING) == "65536");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_OVERFLOW) == "block");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_PATH) == "test.log");
+
+	pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "250");
+	pChannel->setProperty(AsyncFileChannel::PROP_BATCHSIZE, "64");
+	pChannel->setProperty(AsyncFileChannel::PROP_MAXPENDING, "0");
+	pChannel->setProperty(AsyncFileChannel::PROP_OVERFLOW, "drop");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_FLUSHINTERVAL) == "250");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_BATCHSIZE) == "64");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_MAXPENDING) == "0");
+	assertTrue (pChannel->getProperty(AsyncFileChannel::PROP_OVERFLOW) == "drop");
+
+	try
+	{
+		pChannel->setProperty(AsyncFileChannel::PROP_OVERFLOW, "wait");
+		fail("invalid overflow policy - must throw");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		pChannel->setProperty(AsyncFileChannel::PROP_FLUSHINTERVAL, "-1");
+		fail("negative flush interval - must throw");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		pChannel->setProperty(AsyncFileChannel::PROP_BATCHSIZE, "0");
+		fail("zero batch size - must throw");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+}
+
+
+void AsyncFileChannelTest::setUp()
+{
+}
+
+
+void AsyncFileChannelTest::tearDown()
+{
+}
+
+
+void AsyncFileChannelTest::remove(const std::string& baseName)
+{
+	DirectoryIterator it(Path::current());
+	DirectoryIterator end;
+	std::vector<std::string> files;
+	while (it != end)
+	{
+		if (it.name().find(baseName) == 0)
+		{
+			files.push_back(it.name());
+		}
+		++it;
+	}
+	for (std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+	{
+		try
+		{
+			File f(*it);
+			f.remove();
+		} catch (...)
+		{
+		}
+	}
+}
+
+
+std::string AsyncFileChannelTest::filename() const
+{
+	std::string name = "asynclog_";
+	name.append(DateTimeFormatter::format(Timestamp(), "%Y%m%d%H%M%S"));
+	name.append(".log");
+	return name;
+}
+
+
+std::vector<std::string> AsyncFileChannelTest::readLines(const std::string& path) const
+{
+	std::vector<std::string> lines;
+	if (File(path).exists())
+	{
+		FileInputStream istr(path);
+		std::string line;
+		while (std::getline(istr, line))
+		{
+			lines.push_back(line);
+		}
+	}
+	return lines;
+}
+
+
+CppUnit::Test* AsyncFileChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("AsyncFileChannelTest");
+
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testLog);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testConcurrentLog);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testCloseWhileLogging);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testFlushInterval);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testNoFlush);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testMaxPending);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testRotateBySize);
+	CppUnit_addTest(pSuite, AsyncFileChannelTest, testProperties);
+
+	return pSuite;
+}
@@ -0,0 +1,49 @@
+//
+// AsyncFileChannelTest.h
+//
+// Definition of the AsyncFileChannelTest class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef AsyncFileChannelTest_INCLUDED
+#define AsyncFileChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+#include <vector>
+
+
+class AsyncFileChannelTest: public CppUnit::TestCase
+{
+public:
+	AsyncFileChannelTest(const std::string& name);
+	~AsyncFileChannelTest();
+
+	void testLog();
+	void testConcurrentLog();
+	void testCloseWhileLogging();
+	void testFlushInterval();
+	void testNoFlush();
+	void testMaxPending();
+	void testRotateBySize();
+	void testProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void remove(const std::string& baseName);
+	std::string filename() const;
+	std::vector<std::string> readLines(const std::string& path) const;
+};
+
+
+#endif // AsyncFileChannelTest_INCLUDED
@@ -18,6 +18,7 @@
 #include "Poco/Thread.h"
 #include "Poco/Exception.h"
 #include "Poco/StdFunctionDelegate.h"
+#include <atomic>
 
 
 using namespace Poco;
@@ -352,6 +353,50 @@ void BasicEventTest::testLambda()
 }
 
 
+void BasicEventTest::testConcurrentNotify()
+{
+	const int THREADS = 4;
+	const int NOTIFICATIONS = 20000;
+
+	Poco::BasicEvent<int> event;
+	std::atomic<int> count(0);
+	std::atomic<int> transientCount(0);
+	auto f = StdFunctionDelegate<int>([&](const void*, int& args) { count += args; });
+	auto g = StdFunctionDelegate<int>([&](const void*, int& args) { transientCount += args; });
+	event += f;
+
+	Poco::Thread threads[THREADS];
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].startFunc([&event]()
+		{
+			for (int n = 0; n < NOTIFICATIONS; ++n)
+			{
+				int args = 1;
+				event.notify(0, args);
+			}
+		});
+	}
+
+	// modify the delegates while the other threads notify
+	for (int i = 0; i < 1000; ++i)
+	{
+		event += g;
+		event -= g;
+	}
+	for (int i = 0; i < THREADS; ++i) threads[i].join();
+
+	assertTrue (count == THREADS*NOTIFICATIONS);
+	assertTrue (transientCount <= THREADS*NOTIFICATIONS);
+
+	event -= f;
+	assertTrue (event.empty());
+	int args = 1;
+	event.notify(0, args);
+	assertTrue (count == THREADS*NOTIFICATIONS);
+}
+
+
 void BasicEventTest::onStaticVoid(const void* pSender)
 {
 	BasicEventTest* p = const_cast<BasicEventTest*>(reinterpret_cast<const BasicEventTest*>(pSender));
@@ -494,5 +539,6 @@ CppUnit::Test* BasicEventTest::suite()
 	CppUnit_addTest(pSuite, BasicEventTest, testAsyncNotify);
 	CppUnit_addTest(pSuite, BasicEventTest, testNullMutex);
 	CppUnit_addTest(pSuite, BasicEventTest, testLambda);
+	CppUnit_addTest(pSuite, BasicEventTest, testConcurrentNotify);
 	return pSuite;
 }
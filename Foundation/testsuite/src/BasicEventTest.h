@@ -48,6 +48,7 @@ public:
 	void testAsyncNotify();
 	void testNullMutex();
 	void testLambda();
+	void testConcurrentNotify();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,351 @@
+//
+// BinaryLogChannelTest.cpp
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BinaryLogChannelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+#include "TestChannel.h"
+#include <sstream>
+
+
+using Poco::BinaryLogChannel;
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::AutoPtr;
+using Poco::File;
+using Poco::FileInputStream;
+using Poco::Timestamp;
+using Poco::DataFormatException;
+
+
+BinaryLogChannelTest::BinaryLogChannelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+BinaryLogChannelTest::~BinaryLogChannelTest()
+{
+}
+
+
+void BinaryLogChannelTest::testRoundTrip()
+{
+	std::string name = filename();
+	try
+	{
+		Message msg1("source", "text with\nnewline", Message::PRIO_WARNING, "BinaryLogChannelTest.cpp", 42);
+		msg1.setTime(Timestamp::fromEpochTime(1500000000) + 123456);
+		msg1.setPid(1234);
+		msg1.setTid(56);
+		msg1.setOsTid(7890123);
+		msg1.setThread("worker");
+		msg1["user"] = "alice";
+		msg1["request"] = std::string("id\0x", 4);
+
+		Message msg2("other", "", Message::PRIO_TRACE);
+		msg2.setTime(Timestamp::fromEpochTime(0));
+
+		AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(name);
+		pChannel->log(msg1);
+		pChannel->log(msg2);
+		pChannel->close();
+
+		FileInputStream istr(name, std::ios::in | std::ios::binary);
+		BinaryLogReader reader(istr);
+		Message msg;
+		assertTrue (reader.read(msg));
+		assertTrue (reader.version() == BinaryLogChannel::FORMAT_VERSION);
+		assertTrue (msg.getSource() == "source");
+		assertTrue (msg.getText() == "text with\nnewline");
+		assertTrue (msg.getPriority() == Message::PRIO_WARNING);
+		assertTrue (msg.getTime() == msg1.getTime());
+		assertTrue (msg.getPid() == 1234);
+		assertTrue (msg.getTid() == 56);
+		assertTrue (msg.getOsTid() == 7890123);
+		assertTrue (msg.getThread() == "worker");
+		assertTrue (std::string(msg.getSourceFile()) == "BinaryLogChannelTest.cpp");
+		assertTrue (msg.getSourceLine() == 42);
+		assertTrue (msg.getAll().size() == 2);
+		assertTrue (msg["user"] == "alice");
+		assertTrue (msg["request"] == std::string("id\0x", 4));
+
+		assertTrue (reader.read(msg));
+		assertTrue (msg.getSource() == "other");
+		assertTrue (msg.getText().empty());
+		assertTrue (msg.getPriority() == Message::PRIO_TRACE);
+		assertTrue (msg.getTime() == msg2.getTime());
+		assertTrue (msg.getSourceFile() == 0);
+		assertTrue (msg.getAll().empty());
+
+		assertTrue (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryLogChannelTest::testFormat()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(name);
+		for (int i = 0; i < 3; ++i)
+		{
+			Message msg("source", "message", Message::PRIO_ERROR);
+			msg["index"] = std::string(1, static_cast<char>('0' + i));
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		FileInputStream istr(name, std::ios::in | std::ios::binary);
+		BinaryLogReader reader(istr);
+		AutoPtr<PatternFormatter> pFormatter = new PatternFormatter("%s [%p] %t %[index]");
+		std::ostringstream ostr;
+		assertTrue (reader.format(*pFormatter, ostr) == 3);
+		assertTrue (ostr.str() ==
+			"source [Error] message 0\n"
+			"source [Error] message 1\n"
+			"source [Error] message 2\n");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryLogChannelTest::testReplay()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(name);
+		pChannel->log(Message("source", "first", Message::PRIO_INFORMATION));
+		pChannel->log(Message("source", "second", Message::PRIO_DEBUG));
+		pChannel->close();
+
+		FileInputStream istr(name, std::ios::in | std::ios::binary);
+		BinaryLogReader reader(istr);
+		AutoPtr<TestChannel> pTestChannel = new TestChannel;
+		assertTrue (reader.replay(*pTestChannel) == 2);
+		assertTrue (pTestChannel->list().size() == 2);
+		assertTrue (pTestChannel->list().front().getText() == "first");
+		assertTrue (pTestChannel->list().back().getText() == "second");
+		assertTrue (pTestChannel->list().back().getPriority() == Message::PRIO_DEBUG);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryLogChannelTest::testAppend()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(name);
+		pChannel->log(Message("source", "first", Message::PRIO_INFORMATION));
+		pChannel->close();
+		File::FileSize size = File(name).getSize();
+
+		pChannel->log(Message("source", "again", Message::PRIO_INFORMATION));
+		pChannel->close();
+		assertTrue (File(name).getSize() == 2*size - 8);
+
+		FileInputStream istr(name, std::ios::in | std::ios::binary);
+		BinaryLogReader reader(istr);
+		Message msg;
+		assertTrue (reader.read(msg));
+		assertTrue (msg.getText() == "first");
+		assertTrue (reader.read(msg));
+		assertTrue (msg.getText() == "again");
+		assertTrue (!reader.read(msg));
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryLogChannelTest::testInvalidHeader()
+{
+	std::istringstream empty;
+	BinaryLogReader emptyReader(empty);
+	Message msg;
+	assertTrue (!emptyReader.read(msg));
+
+	std::istringstream istr("This is not a binary log.");
+	BinaryLogReader reader(istr);
+	try
+	{
+		reader.read(msg);
+		fail("not a binary log - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::testTruncatedRecord()
+{
+	std::string name = filename();
+	std::string data;
+	try
+	{
+		AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(name);
+		pChannel->log(Message("source", "text", Message::PRIO_INFORMATION));
+		pChannel->close();
+
+		FileInputStream istr(name, std::ios::in | std::ios::binary);
+		std::ostringstream ostr;
+		ostr << istr.rdbuf();
+		data = ostr.str();
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+
+	std::istringstream istr(data.substr(0, data.size() - 1));
+	BinaryLogReader reader(istr);
+	Message msg;
+	try
+	{
+		reader.read(msg);
+		fail("truncated record - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	// a record with a length too short for its fields
+	std::string damaged(data);
+	damaged[8] = 3;
+	damaged.resize(8 + 4 + 3);
+	std::istringstream istr2(damaged);
+	BinaryLogReader reader2(istr2);
+	try
+	{
+		reader2.read(msg);
+		fail("damaged record - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	// a record with a damaged length exceeding the maximum record size
+	damaged = data;
+	damaged[11] = '\x7F';
+	std::istringstream istr3(damaged);
+	BinaryLogReader reader3(istr3);
+	try
+	{
+		reader3.read(msg);
+		fail("oversized record - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	// the maximum record size can be given to the reader
+	std::istringstream istr4(data);
+	BinaryLogReader reader4(istr4, 8);
+	try
+	{
+		reader4.read(msg);
+		fail("record exceeds maximum size - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::testProperties()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel;
+	pChannel->setProperty(BinaryLogChannel::PROP_PATH, "test.blog");
+	assertTrue (pChannel->getProperty(BinaryLogChannel::PROP_PATH) == "test.blog");
+	assertTrue (pChannel->path() == "test.blog");
+	assertTrue (pChannel->getProperty(BinaryLogChannel::PROP_FLUSH) == "true");
+	pChannel->setProperty(BinaryLogChannel::PROP_FLUSH, "false");
+	assertTrue (pChannel->getProperty(BinaryLogChannel::PROP_FLUSH) == "false");
+}
+
+
+void BinaryLogChannelTest::setUp()
+{
+}
+
+
+void BinaryLogChannelTest::tearDown()
+{
+}
+
+
+std::string BinaryLogChannelTest::filename() const
+{
+	return "binarylog.blog";
+}
+
+
+void BinaryLogChannelTest::remove(const std::string& path)
+{
+	try
+	{
+		File(path).remove();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+CppUnit::Test* BinaryLogChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BinaryLogChannelTest");
+
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testRoundTrip);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testFormat);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testReplay);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testAppend);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testInvalidHeader);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testTruncatedRecord);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testProperties);
+
+	return pSuite;
+}
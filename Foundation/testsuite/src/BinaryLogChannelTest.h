@@ -0,0 +1,46 @@
+//
+// BinaryLogChannelTest.h
+//
+// Definition of the BinaryLogChannelTest class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BinaryLogChannelTest_INCLUDED
+#define BinaryLogChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class BinaryLogChannelTest: public CppUnit::TestCase
+{
+public:
+	BinaryLogChannelTest(const std::string& name);
+	~BinaryLogChannelTest();
+
+	void testRoundTrip();
+	void testFormat();
+	void testReplay();
+	void testAppend();
+	void testInvalidHeader();
+	void testTruncatedRecord();
+	void testProperties();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	std::string filename() const;
+	void remove(const std::string& path);
+};
+
+
+#endif // BinaryLogChannelTest_INCLUDED
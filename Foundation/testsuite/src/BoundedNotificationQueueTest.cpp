@@ -0,0 +1,404 @@
+//
+// BoundedNotificationQueueTest.cpp
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BoundedNotificationQueueTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+
+
+using Poco::BoundedNotificationQueue;
+using Poco::Notification;
+using Poco::Thread;
+using Poco::RunnableAdapter;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	class Consumer: public Poco::Runnable
+	{
+	public:
+		Consumer(BoundedNotificationQueue& queue):
+			_queue(queue)
+		{
+		}
+
+		void run()
+		{
+			_pNf = _queue.waitDequeueNotification();
+		}
+
+		Notification::Ptr notification() const
+		{
+			return _pNf;
+		}
+
+	private:
+		BoundedNotificationQueue& _queue;
+		Notification::Ptr _pNf;
+	};
+
+	enum
+	{
+		PRODUCER_COUNT = 4,
+		CONSUMER_COUNT = 3,
+		PRODUCER_NOTIFICATIONS = 10000,
+		BATCH = 5
+	};
+}
+
+
+BoundedNotificationQueueTest::BoundedNotificationQueueTest(const std::string& rName):
+	CppUnit::TestCase(rName),
+	_queue(16)
+{
+}
+
+
+BoundedNotificationQueueTest::~BoundedNotificationQueueTest()
+{
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeue()
+{
+	BoundedNotificationQueue queue;
+	assertTrue (queue.capacity() == BoundedNotificationQueue::DEFAULT_CAPACITY);
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification);
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pNf = queue.dequeueNotification();
+	assertNotNullPtr(pNf);
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+	pNf->release();
+
+	queue.enqueueNotification(new QTestNotification("first"));
+	queue.enqueueNotification(new QTestNotification("second"));
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "first");
+	pTNf->release();
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "second");
+	pTNf->release();
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+
+	Notification::Ptr pShared = new Notification;
+	queue.enqueueNotification(pShared);
+	assertTrue (pShared->referenceCount() == 2);
+	queue.clear();
+	assertTrue (queue.empty());
+	assertTrue (pShared->referenceCount() == 1);
+}
+
+
+void BoundedNotificationQueueTest::testQueueDequeueBatch()
+{
+	BoundedNotificationQueue queue(8);
+	BoundedNotificationQueue::NotificationVec in;
+	for (int i = 0; i < 5; ++i)
+	{
+		in.push_back(new QTestNotification(std::string(1, 'a' + i)));
+	}
+	queue.enqueueNotifications(in);
+	assertTrue (queue.size() == 5);
+
+	BoundedNotificationQueue::NotificationVec out;
+	assertTrue (queue.dequeueNotifications(out, 3) == 3);
+	assertTrue (out.size() == 3);
+	assertTrue (queue.size() == 2);
+	assertTrue (queue.dequeueNotifications(out, 10) == 2);
+	assertTrue (out.size() == 5);
+	assertTrue (queue.empty());
+	for (int i = 0; i < 5; ++i)
+	{
+		QTestNotification* pTNf = dynamic_cast<QTestNotification*>(out[i].get());
+		assertNotNullPtr(pTNf);
+		assertTrue (pTNf->data() == std::string(1, 'a' + i));
+		assertTrue (out[i] == in[i]);
+	}
+	assertTrue (queue.dequeueNotifications(out, 10) == 0);
+	assertTrue (out.size() == 5);
+
+	queue.enqueueNotifications(in);
+	out.clear();
+	assertTrue (queue.waitDequeueNotifications(out, 10) == 5);
+	assertTrue (out.size() == 5);
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testWaitDequeue()
+{
+	BoundedNotificationQueue queue;
+	queue.enqueueNotification(new QTestNotification("third"));
+	queue.enqueueNotification(new QTestNotification("fourth"));
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 2);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "third");
+	pTNf->release();
+	assertTrue (!queue.empty());
+	assertTrue (queue.size() == 1);
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(10));
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "fourth");
+	pTNf->release();
+	assertTrue (queue.empty());
+	assertTrue (queue.size() == 0);
+
+	Stopwatch sw;
+	sw.start();
+	Notification* pNf = queue.waitDequeueNotification(50);
+	sw.stop();
+	assertNullPtr(pNf);
+	assertTrue (sw.elapsed() >= 45000);
+
+	Consumer consumer(queue);
+	Thread thread;
+	thread.start(consumer);
+	while (!queue.hasIdleThreads()) Thread::sleep(10);
+	queue.enqueueNotification(new QTestNotification("fifth"));
+	thread.join();
+	pTNf = dynamic_cast<QTestNotification*>(consumer.notification().get());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "fifth");
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testFull()
+{
+	BoundedNotificationQueue queue(3);
+	assertTrue (queue.capacity() == 4);
+	for (int i = 0; i < 4; ++i)
+	{
+		assertTrue (queue.tryEnqueueNotification(new Notification));
+	}
+	assertTrue (queue.size() == 4);
+	assertTrue (!queue.tryEnqueueNotification(new Notification));
+	assertTrue (!queue.tryEnqueueNotification(new Notification, 20));
+	assertTrue (queue.size() == 4);
+
+	Consumer consumer(queue);
+	Thread thread;
+	thread.start(consumer);
+	// blocks until the consumer has dequeued a notification
+	queue.enqueueNotification(new QTestNotification("last"));
+	thread.join();
+	assertNotNullPtr(consumer.notification().get());
+	assertTrue (queue.size() == 4);
+
+	Notification::Ptr pNf;
+	for (int i = 0; i < 3; ++i)
+	{
+		pNf = queue.dequeueNotification();
+		assertNotNullPtr(pNf.get());
+	}
+	pNf = queue.dequeueNotification();
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(pNf.get());
+	assertNotNullPtr(pTNf);
+	assertTrue (pTNf->data() == "last");
+	assertTrue (queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testThreads()
+{
+	const int NOTIFICATION_COUNT = 5000;
+
+	Thread t1("thread1");
+	Thread t2("thread2");
+	Thread t3("thread3");
+
+	RunnableAdapter<BoundedNotificationQueueTest> ra(*this, &BoundedNotificationQueueTest::work);
+	t1.start(ra);
+	t2.start(ra);
+	t3.start(ra);
+	for (int i = 0; i < NOTIFICATION_COUNT; ++i)
+	{
+		_queue.enqueueNotification(new Notification);
+	}
+	while (!_queue.empty()) Thread::sleep(50);
+	Thread::sleep(20);
+	_queue.wakeUpAll();
+	t1.join();
+	t2.join();
+	t3.join();
+	assertTrue (_handled.size() == NOTIFICATION_COUNT);
+	assertTrue (_handled.count("thread1") > 0);
+	assertTrue (_handled.count("thread2") > 0);
+	assertTrue (_handled.count("thread3") > 0);
+}
+
+
+void BoundedNotificationQueueTest::testProducers()
+{
+	RunnableAdapter<BoundedNotificationQueueTest> producer(*this, &BoundedNotificationQueueTest::produce);
+	RunnableAdapter<BoundedNotificationQueueTest> consumer(*this, &BoundedNotificationQueueTest::consume);
+	Thread producers[PRODUCER_COUNT];
+	Thread consumers[CONSUMER_COUNT];
+	for (int i = 0; i < CONSUMER_COUNT; ++i)
+	{
+		consumers[i].start(consumer);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; ++i)
+	{
+		producers[i].start(producer);
+	}
+	for (int i = 0; i < PRODUCER_COUNT; ++i)
+	{
+		producers[i].join();
+	}
+	while (_consumed < PRODUCER_COUNT*PRODUCER_NOTIFICATIONS) Thread::sleep(10);
+	for (int i = 0; i < CONSUMER_COUNT; ++i)
+	{
+		while (!consumers[i].tryJoin(10)) _queue.wakeUpAll();
+	}
+	assertTrue (_consumed == PRODUCER_COUNT*PRODUCER_NOTIFICATIONS);
+	assertTrue (_queue.empty());
+}
+
+
+void BoundedNotificationQueueTest::testWakeUpAll()
+{
+	BoundedNotificationQueue queue;
+	Consumer consumer1(queue);
+	Consumer consumer2(queue);
+	Thread t1;
+	Thread t2;
+	t1.start(consumer1);
+	t2.start(consumer2);
+	while (!queue.hasIdleThreads()) Thread::sleep(10);
+	queue.wakeUpAll();
+	// a consumer that was not waiting yet is not woken up
+	while (!t1.tryJoin(10)) queue.wakeUpAll();
+	while (!t2.tryJoin(10)) queue.wakeUpAll();
+	assertNullPtr(consumer1.notification().get());
+	assertNullPtr(consumer2.notification().get());
+	assertTrue (!queue.hasIdleThreads());
+}
+
+
+void BoundedNotificationQueueTest::setUp()
+{
+	_handled.clear();
+	_consumed = 0;
+}
+
+
+void BoundedNotificationQueueTest::tearDown()
+{
+}
+
+
+void BoundedNotificationQueueTest::work()
+{
+	Poco::Random rnd;
+	Thread::sleep(50);
+	Notification* pNf = _queue.waitDequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		_mutex.lock();
+		_handled.insert(Thread::current()->name());
+		_mutex.unlock();
+		if (rnd.next(100) == 0) Thread::sleep(1);
+		pNf = _queue.waitDequeueNotification();
+	}
+}
+
+
+void BoundedNotificationQueueTest::produce()
+{
+	BoundedNotificationQueue::NotificationVec batch;
+	for (int i = 0; i < PRODUCER_NOTIFICATIONS; i += BATCH)
+	{
+		if (i % 2)
+		{
+			for (int k = 0; k < BATCH; ++k) _queue.enqueueNotification(new Notification);
+		}
+		else
+		{
+			batch.clear();
+			for (int k = 0; k < BATCH; ++k) batch.push_back(new Notification);
+			_queue.enqueueNotifications(batch);
+		}
+	}
+}
+
+
+void BoundedNotificationQueueTest::consume()
+{
+	BoundedNotificationQueue::NotificationVec batch;
+	for (;;)
+	{
+		batch.clear();
+		std::size_t n = _queue.waitDequeueNotifications(batch, 8);
+		if (n == 0) break;
+		_consumed += static_cast<int>(n);
+	}
+}
+
+
+CppUnit::Test* BoundedNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BoundedNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testQueueDequeueBatch);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testFull);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testThreads);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testProducers);
+	CppUnit_addTest(pSuite, BoundedNotificationQueueTest, testWakeUpAll);
+
+	return pSuite;
+}
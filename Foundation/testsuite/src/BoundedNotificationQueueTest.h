@@ -0,0 +1,57 @@
+//
+// BoundedNotificationQueueTest.h
+//
+// Definition of the BoundedNotificationQueueTest class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BoundedNotificationQueueTest_INCLUDED
+#define BoundedNotificationQueueTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/Mutex.h"
+#include <set>
+#include <atomic>
+
+
+class BoundedNotificationQueueTest: public CppUnit::TestCase
+{
+public:
+	BoundedNotificationQueueTest(const std::string& name);
+	~BoundedNotificationQueueTest();
+
+	void testQueueDequeue();
+	void testQueueDequeueBatch();
+	void testWaitDequeue();
+	void testFull();
+	void testThreads();
+	void testProducers();
+	void testWakeUpAll();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	void work();
+	void produce();
+	void consume();
+
+private:
+	Poco::BoundedNotificationQueue _queue;
+	std::multiset<std::string>     _handled;
+	Poco::FastMutex                _mutex;
+	std::atomic<int>               _consumed;
+};
+
+
+#endif // BoundedNotificationQueueTest_INCLUDED
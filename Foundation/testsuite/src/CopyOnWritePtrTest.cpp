@@ -0,0 +1,183 @@
+//
+// CopyOnWritePtrTest.cpp
+//
+// Copyright (c) 2006-2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "CopyOnWritePtrTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/CopyOnWritePtr.h"
+#include "Poco/Thread.h"
+#include <vector>
+#include <atomic>
+
+
+using Poco::CopyOnWritePtr;
+using Poco::Thread;
+
+
+namespace
+{
+	std::atomic<int> instances(0);
+
+	class Counted
+	{
+	public:
+		explicit Counted(int value = 0):
+			_value(value)
+		{
+			++instances;
+		}
+
+		Counted(const Counted& other):
+			_value(other._value)
+		{
+			++instances;
+		}
+
+		~Counted()
+		{
+			--instances;
+		}
+
+		int value() const
+		{
+			return _value;
+		}
+
+	private:
+		int _value;
+	};
+
+	typedef CopyOnWritePtr<std::vector<int> > VectorPtr;
+}
+
+
+CopyOnWritePtrTest::CopyOnWritePtrTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+CopyOnWritePtrTest::~CopyOnWritePtrTest()
+{
+}
+
+
+void CopyOnWritePtrTest::testEmpty()
+{
+	VectorPtr ptr;
+	assertTrue (ptr.empty());
+	assertTrue (ptr.load().isNull());
+	assertTrue (ptr.get() == 0);
+
+	ptr.store(new VectorPtr::Snapshot);
+	assertTrue (!ptr.empty());
+	ptr.store(0);
+	assertTrue (ptr.empty());
+}
+
+
+void CopyOnWritePtrTest::testStore()
+{
+	VectorPtr ptr;
+	for (int i = 0; i < 10; ++i)
+	{
+		VectorPtr::Snapshot* pCurrent = ptr.get();
+		VectorPtr::Snapshot* pCopy = pCurrent ? new VectorPtr::Snapshot(pCurrent->value()) : new VectorPtr::Snapshot;
+		pCopy->value().push_back(i);
+		ptr.store(pCopy);
+	}
+	VectorPtr::Ptr pSnapshot = ptr.load();
+	assertTrue (pSnapshot->value().size() == 10);
+	for (int i = 0; i < 10; ++i)
+	{
+		assertTrue (pSnapshot->value()[i] == i);
+	}
+}
+
+
+void CopyOnWritePtrTest::testSnapshotLifetime()
+{
+	{
+		CopyOnWritePtr<Counted> ptr;
+		ptr.store(new CopyOnWritePtr<Counted>::Snapshot(Counted(1)));
+		assertTrue (instances == 1);
+
+		CopyOnWritePtr<Counted>::Ptr pOld = ptr.load();
+		ptr.store(new CopyOnWritePtr<Counted>::Snapshot(Counted(2)));
+		assertTrue (instances == 2);
+		assertTrue (pOld->value().value() == 1);
+		assertTrue (ptr.load()->value().value() == 2);
+
+		pOld = 0;
+		assertTrue (instances == 1);
+	}
+	assertTrue (instances == 0);
+}
+
+
+void CopyOnWritePtrTest::testConcurrentUpdate()
+{
+	const int THREADS = 4;
+	const int UPDATES = 2000;
+
+	CopyOnWritePtr<Counted> ptr;
+	ptr.store(new CopyOnWritePtr<Counted>::Snapshot(Counted(0)));
+	std::atomic<bool> stop(false);
+	std::atomic<bool> ok(true);
+
+	Thread threads[THREADS];
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i].startFunc([&]()
+		{
+			int last = 0;
+			while (!stop)
+			{
+				CopyOnWritePtr<Counted>::Ptr pSnapshot = ptr.load();
+				int value = pSnapshot->value().value();
+				if (value < last) ok = false;
+				last = value;
+			}
+		});
+	}
+
+	for (int i = 1; i <= UPDATES; ++i)
+	{
+		ptr.store(new CopyOnWritePtr<Counted>::Snapshot(Counted(i)));
+	}
+	stop = true;
+	for (int i = 0; i < THREADS; ++i) threads[i].join();
+
+	assertTrue (ok);
+	assertTrue (ptr.load()->value().value() == UPDATES);
+	assertTrue (instances == 1);
+}
+
+
+void CopyOnWritePtrTest::setUp()
+{
+}
+
+
+void CopyOnWritePtrTest::tearDown()
+{
+}
+
+
+CppUnit::Test* CopyOnWritePtrTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("CopyOnWritePtrTest");
+
+	CppUnit_addTest(pSuite, CopyOnWritePtrTest, testEmpty);
+	CppUnit_addTest(pSuite, CopyOnWritePtrTest, testStore);
+	CppUnit_addTest(pSuite, CopyOnWritePtrTest, testSnapshotLifetime);
+	CppUnit_addTest(pSuite, CopyOnWritePtrTest, testConcurrentUpdate);
+
+	return pSuite;
+}
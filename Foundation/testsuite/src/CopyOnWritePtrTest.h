@@ -0,0 +1,41 @@
+//
+// CopyOnWritePtrTest.h
+//
+// Definition of the CopyOnWritePtrTest class.
+//
+// Copyright (c) 2006-2011, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef CopyOnWritePtrTest_INCLUDED
+#define CopyOnWritePtrTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class CopyOnWritePtrTest: public CppUnit::TestCase
+{
+public:
+	CopyOnWritePtrTest(const std::string& name);
+	~CopyOnWritePtrTest();
+
+	void testEmpty();
+	void testStore();
+	void testSnapshotLifetime();
+	void testConcurrentUpdate();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // CopyOnWritePtrTest_INCLUDED
@@ -26,6 +26,9 @@
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
 #include "MemoryPoolTest.h"
+#include "ThreadCachingAllocatorTest.h"
+#include "MonotonicArenaTest.h"
+#include "CopyOnWritePtrTest.h"
 #include "AnyTest.h"
 #include "VarTest.h"
 #include "FormatTest.h"
@@ -60,6 +63,9 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
+	pSuite->addTest(ThreadCachingAllocatorTest::suite());
+	pSuite->addTest(MonotonicArenaTest::suite());
+	pSuite->addTest(CopyOnWritePtrTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(VarTest::suite());
 	pSuite->addTest(FormatTest::suite());
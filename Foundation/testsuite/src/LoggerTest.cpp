@@ -13,13 +13,18 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/NumberFormatter.h"
 #include "TestChannel.h"
+#include <atomic>
 
 
 using Poco::Logger;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::NumberFormatter;
 
 
 LoggerTest::LoggerTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -289,6 +294,110 @@ void LoggerTest::testDump()
 }
 
 
+namespace
+{
+	const int LOGGERS = 50;
+
+	void getLoggers(int thread, std::atomic<int>* pErrors)
+	{
+		for (int k = 0; k < 20; ++k)
+		{
+			for (int i = 0; i < LOGGERS; ++i)
+			{
+				std::string shared("Concurrent.Shared.");
+				shared += NumberFormatter::format(i);
+				std::string own("Concurrent.");
+				own += NumberFormatter::format(thread);
+				own += '.';
+				own += NumberFormatter::format(i);
+
+				Logger& sharedLogger = Logger::get(shared);
+				Logger& ownLogger = Logger::get(own);
+				if (sharedLogger.name() != shared || ownLogger.name() != own) ++*pErrors;
+				if (&sharedLogger != &Logger::get(shared)) ++*pErrors;
+				if (Logger::has(own).get() != &ownLogger) ++*pErrors;
+			}
+		}
+	}
+}
+
+
+void LoggerTest::testConcurrentGet()
+{
+	Logger::get("Concurrent").setLevel(Message::PRIO_DEBUG);
+
+	const int THREADS = 4;
+	std::atomic<int> errors(0);
+	Thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		std::atomic<int>* pErrors = &errors;
+		threads[t].startFunc([t, pErrors]() { getLoggers(t, pErrors); });
+	}
+	for (int i = 0; i < 100; ++i)
+	{
+		Logger::setLevel("Concurrent", i % 2 ? Message::PRIO_DEBUG : Message::PRIO_TRACE);
+	}
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].join();
+	}
+	assertTrue (errors == 0);
+
+	// one logger per thread and name, one shared
+	// logger per name, and the common parent
+	std::vector<std::string> names;
+	Logger::names(names);
+	assertTrue (names.size() == 1 + 1 + (THREADS + 1)*LOGGERS);
+
+	Logger::setLevel("Concurrent", Message::PRIO_ERROR);
+	assertTrue (Logger::get("Concurrent.Shared.0").is(Message::PRIO_ERROR));
+	assertTrue (!Logger::get("Concurrent.Shared.0").is(Message::PRIO_WARNING));
+
+	Logger::destroy("Concurrent.Shared.0");
+	assertTrue (Logger::has("Concurrent.Shared.0").isNull());
+	assertTrue (!Logger::has("Concurrent.Shared.1").isNull());
+}
+
+
+void LoggerTest::testManyLoggers()
+{
+	const int COUNT = 1000;
+	for (int i = 0; i < COUNT; ++i)
+	{
+		Logger::get("Many." + NumberFormatter::format0(i, 4));
+	}
+	for (int i = 0; i < COUNT; ++i)
+	{
+		std::string name("Many." + NumberFormatter::format0(i, 4));
+		assertTrue (Logger::has(name)->name() == name);
+	}
+
+	std::vector<std::string> names;
+	Logger::names(names);
+	assertTrue (names.size() == COUNT + 1);
+	assertTrue (names[0] == "");
+	assertTrue (names[1] == "Many.0000");
+	assertTrue (names.back() == "Many.0999");
+
+	for (int i = 0; i < COUNT; i += 3)
+	{
+		Logger::destroy("Many." + NumberFormatter::format0(i, 4));
+	}
+	for (int i = 0; i < COUNT; ++i)
+	{
+		assertTrue (Logger::has("Many." + NumberFormatter::format0(i, 4)).isNull() == (i % 3 == 0));
+	}
+	Logger::names(names);
+	assertTrue (names.size() == COUNT + 1 - ((COUNT - 1)/3 + 1));
+
+	Logger::setLevel("Many", Message::PRIO_TRACE);
+	assertTrue (Logger::get("Many.0001").trace());
+	assertTrue (Logger::get("Many.0998").trace());
+	assertTrue (!Logger::root().trace());
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -308,6 +417,8 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testManyLoggers);
 
 	return pSuite;
 }
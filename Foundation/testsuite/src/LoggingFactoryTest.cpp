@@ -21,6 +21,8 @@
 #ifndef POCO_NO_FILECHANNEL
 #include "Poco/FileChannel.h"
 #include "Poco/SimpleFileChannel.h"
+#include "Poco/AsyncFileChannel.h"
+#include "Poco/BinaryLogChannel.h"
 #endif
 #include "Poco/SplitterChannel.h"
 #include "Poco/Formatter.h"
@@ -37,6 +39,8 @@ using Poco::ConsoleChannel;
 #ifndef POCO_NO_FILECHANNEL
 using Poco::FileChannel;
 using Poco::SimpleFileChannel;
+using Poco::AsyncFileChannel;
+using Poco::BinaryLogChannel;
 #endif
 using Poco::SplitterChannel;
 using Poco::Formatter;
@@ -92,6 +96,12 @@ void LoggingFactoryTest::testBuiltins()
 
 	Channel::Ptr pSimpleFileChannel = fact.createChannel("SimpleFileChannel");
 	assertTrue(!pSimpleFileChannel.cast<SimpleFileChannel>().isNull());
+
+	Channel::Ptr pAsyncFileChannel = fact.createChannel("AsyncFileChannel");
+	assertTrue (!pAsyncFileChannel.cast<AsyncFileChannel>().isNull());
+
+	Channel::Ptr pBinaryLogChannel = fact.createChannel("BinaryLogChannel");
+	assertTrue (!pBinaryLogChannel.cast<BinaryLogChannel>().isNull());
 #endif
 
 	Channel::Ptr pSplitterChannel = fact.createChannel("SplitterChannel");
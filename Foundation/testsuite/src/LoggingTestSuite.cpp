@@ -13,6 +13,8 @@
 #include "ChannelTest.h"
 #include "PatternFormatterTest.h"
 #include "FileChannelTest.h"
+#include "AsyncFileChannelTest.h"
+#include "BinaryLogChannelTest.h"
 #include "SimpleFileChannelTest.h"
 #include "LoggingFactoryTest.h"
 #include "LoggingRegistryTest.h"
@@ -27,6 +29,8 @@ CppUnit::Test* LoggingTestSuite::suite()
 	pSuite->addTest(ChannelTest::suite());
 	pSuite->addTest(PatternFormatterTest::suite());
 	pSuite->addTest(FileChannelTest::suite());
+	pSuite->addTest(AsyncFileChannelTest::suite());
+	pSuite->addTest(BinaryLogChannelTest::suite());
 	pSuite->addTest(SimpleFileChannelTest::suite());
 	pSuite->addTest(LoggingFactoryTest::suite());
 	pSuite->addTest(LoggingRegistryTest::suite());
@@ -0,0 +1,235 @@
+//
+// MonotonicArenaTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MonotonicArenaTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/MonotonicArena.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstring>
+
+
+using Poco::MonotonicArena;
+using Poco::ArenaAllocator;
+using Poco::ArenaString;
+
+
+namespace
+{
+	class Tracked
+	{
+	public:
+		Tracked(std::vector<int>& log, int id):
+			_log(log),
+			_id(id)
+		{
+		}
+
+		~Tracked()
+		{
+			_log.push_back(_id);
+		}
+
+		int id() const
+		{
+			return _id;
+		}
+
+	private:
+		std::vector<int>& _log;
+		int _id;
+	};
+
+	struct Plain
+	{
+		Plain(int a, double b): a(a), b(b)
+		{
+		}
+
+		int a;
+		double b;
+	};
+}
+
+
+MonotonicArenaTest::MonotonicArenaTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MonotonicArenaTest::~MonotonicArenaTest()
+{
+}
+
+
+void MonotonicArenaTest::testAllocate()
+{
+	MonotonicArena arena(256);
+	assertTrue (arena.allocated() == 0);
+	assertTrue (arena.capacity() == 0);
+
+	std::vector<char*> blocks;
+	for (int i = 0; i < 100; ++i)
+	{
+		char* p = static_cast<char*>(arena.allocate(40));
+		std::memset(p, i, 40);
+		blocks.push_back(p);
+	}
+	assertTrue (arena.allocated() == 4000);
+	assertTrue (arena.capacity() >= 4000);
+	for (int i = 0; i < 100; ++i)
+	{
+		for (int k = 0; k < 40; ++k)
+		{
+			assertTrue (blocks[i][k] == static_cast<char>(i));
+		}
+	}
+}
+
+
+void MonotonicArenaTest::testAlignment()
+{
+	MonotonicArena arena;
+	for (std::size_t alignment = 1; alignment <= 64; alignment *= 2)
+	{
+		arena.allocate(1, 1);
+		void* p = arena.allocate(8, alignment);
+		assertTrue (reinterpret_cast<std::size_t>(p) % alignment == 0);
+	}
+	void* p = arena.allocate(3);
+	assertTrue (reinterpret_cast<std::size_t>(p) % alignof(std::max_align_t) == 0);
+}
+
+
+void MonotonicArenaTest::testLargeAllocation()
+{
+	MonotonicArena arena(256);
+	char* p1 = static_cast<char*>(arena.allocate(16));
+	char* p2 = static_cast<char*>(arena.allocate(100000));
+	std::memset(p2, 'x', 100000);
+	char* p3 = static_cast<char*>(arena.allocate(16));
+
+	// the chunk of p1 is still used after a dedicated chunk
+	assertTrue (p3 == p1 + 16);
+	assertTrue (arena.capacity() > 100000);
+	assertTrue (arena.allocated() == 100032);
+}
+
+
+void MonotonicArenaTest::testCreate()
+{
+	std::vector<int> log;
+	{
+		MonotonicArena arena;
+		Tracked* p1 = arena.create<Tracked>(log, 1);
+		Tracked* p2 = arena.create<Tracked>(log, 2);
+		Plain* p3 = arena.create<Plain>(42, 1.5);
+		assertTrue (p1->id() == 1);
+		assertTrue (p2->id() == 2);
+		assertTrue (p3->a == 42 && p3->b == 1.5);
+		assertTrue (log.empty());
+	}
+	assertTrue (log.size() == 2);
+	assertTrue (log[0] == 2);
+	assertTrue (log[1] == 1);
+}
+
+
+void MonotonicArenaTest::testCopy()
+{
+	MonotonicArena arena;
+	std::string str("Hello, world!");
+	char* p1 = arena.copy(str);
+	char* p2 = arena.copy(str.data(), 5);
+	assertTrue (std::strcmp(p1, "Hello, world!") == 0);
+	assertTrue (std::strcmp(p2, "Hello") == 0);
+	assertTrue (p1 != str.data());
+}
+
+
+void MonotonicArenaTest::testReset()
+{
+	std::vector<int> log;
+	MonotonicArena arena(1024);
+	void* pFirst = arena.allocate(16);
+	for (int i = 0; i < 1000; ++i) arena.allocate(100);
+	arena.create<Tracked>(log, 1);
+	assertTrue (arena.capacity() > 100000);
+
+	arena.reset();
+	assertTrue (log.size() == 1);
+	assertTrue (arena.allocated() == 0);
+	assertTrue (arena.capacity() == 1024);
+
+	// the first chunk is reused
+	void* p = arena.allocate(16);
+	assertTrue (p == pFirst);
+
+	arena.reset();
+	arena.reset();
+	assertTrue (log.size() == 1);
+}
+
+
+void MonotonicArenaTest::testAllocator()
+{
+	MonotonicArena arena;
+	{
+		std::vector<int, ArenaAllocator<int> > vec((ArenaAllocator<int>(arena)));
+		for (int i = 0; i < 1000; ++i) vec.push_back(i);
+		for (int i = 0; i < 1000; ++i) assertTrue (vec[i] == i);
+		assertTrue (arena.allocated() >= 1000*sizeof(int));
+
+		ArenaString str("a string that is too long for the small string buffer", ArenaAllocator<char>(arena));
+		str += str;
+		assertTrue (str.size() == 106);
+
+		typedef std::map<int, ArenaString, std::less<int>, ArenaAllocator<std::pair<const int, ArenaString> > > Map;
+		Map map((std::less<int>()), ArenaAllocator<std::pair<const int, ArenaString> >(arena));
+		map.insert(Map::value_type(1, str));
+		assertTrue (map.find(1)->second == str);
+	}
+
+	std::size_t allocated = arena.allocated();
+	std::vector<int, ArenaAllocator<int> > vec;
+	vec.push_back(1);
+	assertTrue (arena.allocated() == allocated);
+	assertTrue (vec.get_allocator().arena() == 0);
+	assertTrue (ArenaAllocator<int>(arena) == ArenaAllocator<char>(arena));
+	assertTrue (ArenaAllocator<int>(arena) != ArenaAllocator<int>());
+}
+
+
+void MonotonicArenaTest::setUp()
+{
+}
+
+
+void MonotonicArenaTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MonotonicArenaTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MonotonicArenaTest");
+
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testAllocate);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testAlignment);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testLargeAllocation);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testCreate);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testCopy);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testReset);
+	CppUnit_addTest(pSuite, MonotonicArenaTest, testAllocator);
+
+	return pSuite;
+}
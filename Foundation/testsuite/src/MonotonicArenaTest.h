@@ -0,0 +1,44 @@
+//
+// MonotonicArenaTest.h
+//
+// Definition of the MonotonicArenaTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MonotonicArenaTest_INCLUDED
+#define MonotonicArenaTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class MonotonicArenaTest: public CppUnit::TestCase
+{
+public:
+	MonotonicArenaTest(const std::string& name);
+	~MonotonicArenaTest();
+
+	void testAllocate();
+	void testAlignment();
+	void testLargeAllocation();
+	void testCreate();
+	void testCopy();
+	void testReset();
+	void testAllocator();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MonotonicArenaTest_INCLUDED
@@ -14,12 +14,23 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timezone.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
 #include "Poco/Exception.h"
+#include <vector>
 
 
 using Poco::PatternFormatter;
 using Poco::Message;
 using Poco::DateTime;
+using Poco::Timestamp;
+using Poco::Timezone;
+using Poco::NumberFormatter;
+using Poco::AutoPtr;
+using Poco::Thread;
 
 
 PatternFormatterTest::PatternFormatterTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -110,6 +121,123 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCachedTime()
+{
+	Message msg("TestSource", "Test message text", Message::PRIO_ERROR);
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i.%F.%c [%p] %t");
+
+	// the date and time are rendered once per second,
+	// the fractional seconds for every message
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500).timestamp());
+	std::string result;
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.500.500000.5 [Error] Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 12, 345).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.012.012345.0 [Error] Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 16, 0, 1).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:16.000.000001.0 [Error] Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 999, 999).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.999.999999.9 [Error] Test message text");
+
+	// the result is appended to the buffer
+	fmt.format(msg, result);
+	assertTrue (result == "2005-01-01 14:30:15.999.999999.9 [Error] Test message text2005-01-01 14:30:15.999.999999.9 [Error] Test message text");
+
+	result.clear();
+	msg.setTime(DateTime(1969, 12, 31, 23, 59, 59, 250).timestamp());
+	fmt.format(msg, result);
+	assertTrue (result == "1969-12-31 23:59:59.250.250000.2 [Error] Test message text");
+
+	// changing the pattern or time mode takes effect immediately
+	result.clear();
+	fmt.setProperty("pattern", "%H:%M:%S");
+	fmt.format(msg, result);
+	assertTrue (result == "23:59:59");
+
+	Timestamp local = msg.getTime();
+	local += (Timezone::utcOffset() + Timezone::dst())*Timestamp::resolution();
+	std::string localTime(NumberFormatter::format0(DateTime(local).hour(), 2));
+	result.clear();
+	fmt.setProperty("pattern", "%H %L%H");
+	fmt.format(msg, result);
+	assertTrue (result == "23 " + localTime);
+
+	result.clear();
+	fmt.setProperty("times", "local");
+	fmt.format(msg, result);
+	assertTrue (result == localTime + " " + localTime);
+
+	// more formatters than are cached per thread
+	std::vector<AutoPtr<PatternFormatter> > formatters;
+	for (int i = 0; i < 10; ++i)
+	{
+		formatters.push_back(new PatternFormatter(NumberFormatter::format(i) + " %Y %t"));
+	}
+	for (int k = 0; k < 3; ++k)
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			result.clear();
+			formatters[i]->format(msg, result);
+			assertTrue (result == NumberFormatter::format(i) + " 1969 Test message text");
+		}
+	}
+}
+
+
+namespace
+{
+	void formatMessages(PatternFormatter* pFormatter, int thread, bool* pOk)
+	{
+		std::string result;
+		for (int i = 0; i < 10000; ++i)
+		{
+			Message msg("TestSource", NumberFormatter::format(thread), Message::PRIO_ERROR);
+			msg.setTime(DateTime(2005, 1, 1, 14, 30, i % 60, i % 1000).timestamp());
+			std::string expected("2005-01-01 14:30:");
+			NumberFormatter::append0(expected, i % 60, 2);
+			expected += '.';
+			NumberFormatter::append0(expected, i % 1000, 3);
+			expected += ' ';
+			expected += NumberFormatter::format(thread);
+			result.clear();
+			pFormatter->format(msg, result);
+			if (result != expected) *pOk = false;
+		}
+	}
+}
+
+
+void PatternFormatterTest::testConcurrentFormat()
+{
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i %t");
+	const int THREADS = 4;
+	Thread threads[THREADS];
+	bool ok[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		ok[t] = true;
+		PatternFormatter* pFormatter = &fmt;
+		bool* pOk = &ok[t];
+		threads[t].startFunc([pFormatter, t, pOk]() { formatMessages(pFormatter, t, pOk); });
+	}
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].join();
+		assertTrue (ok[t]);
+	}
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -125,6 +253,8 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCachedTime);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testConcurrentFormat);
 
 	return pSuite;
 }
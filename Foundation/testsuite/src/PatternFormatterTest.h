@@ -25,6 +25,8 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCachedTime();
+	void testConcurrentFormat();
 
 	void setUp();
 	void tearDown();
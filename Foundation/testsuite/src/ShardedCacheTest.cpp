@@ -0,0 +1,305 @@
+//
+// ShardedCacheTest.cpp
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ShardedCacheTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/ShardedLRUCache.h"
+#include "Poco/ShardedExpireCache.h"
+#include "Poco/ShardedAccessExpireCache.h"
+#include "Poco/Delegate.h"
+#include "Poco/Thread.h"
+#include <string>
+#include <atomic>
+
+
+using namespace Poco;
+
+
+#define DURSLEEP 250
+#define DURHALFSLEEP DURSLEEP / 2
+#define DURWAIT  300
+
+
+ShardedCacheTest::ShardedCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ShardedCacheTest::~ShardedCacheTest()
+{
+}
+
+
+void ShardedCacheTest::testLRU()
+{
+	// a single shard gives exact LRU order
+	ShardedLRUCache<int, int> cache(3, 1);
+	assertTrue (cache.shards() == 1);
+	cache.add(1, 2);
+	cache.add(3, 4);
+	cache.add(5, 6);
+	assertTrue (cache.size() == 3);
+
+	// 1 becomes the most recently used entry
+	assertTrue (*cache.get(1) == 2);
+	cache.add(7, 8);
+	assertTrue (cache.size() == 3);
+	assertTrue (cache.has(1));
+	assertTrue (!cache.has(3));
+	assertTrue (cache.has(5));
+	assertTrue (cache.has(7));
+
+	// has() does not change the order
+	assertTrue (cache.has(5));
+	cache.add(9, 10);
+	assertTrue (!cache.has(5));
+	assertTrue (cache.getAllKeys().size() == 3);
+
+	cache.remove(1);
+	assertTrue (!cache.has(1));
+	assertTrue (cache.get(1).isNull());
+	assertTrue (cache.size() == 2);
+}
+
+
+void ShardedCacheTest::testLRUShards()
+{
+	ShardedLRUCache<int, std::string> cache(1024, 5);
+	assertTrue (cache.shards() == 8);
+	for (int i = 0; i < 10000; ++i)
+	{
+		cache.add(i, "value");
+	}
+	assertTrue (cache.size() <= 1024);
+	assertTrue (cache.size() >= 512);
+	assertTrue (cache.has(9999));
+	assertTrue (!cache.has(0));
+}
+
+
+void ShardedCacheTest::testMaxBytes()
+{
+	ShardedLRUCache<int, std::string> cache(0, 100, [](const int&, const std::string& value)
+	{
+		return value.size();
+	}, 1);
+
+	cache.add(1, std::string(40, 'a'));
+	cache.add(2, std::string(40, 'b'));
+	assertTrue (cache.bytes() == 80);
+	cache.add(3, std::string(40, 'c'));
+	assertTrue (cache.bytes() == 80);
+	assertTrue (!cache.has(1));
+	assertTrue (cache.has(2));
+	assertTrue (cache.has(3));
+
+	cache.update(2, std::string(10, 'b'));
+	assertTrue (cache.bytes() == 50);
+	cache.add(4, std::string(50, 'd'));
+	assertTrue (cache.bytes() == 100);
+	assertTrue (cache.size() == 3);
+
+	// an entry larger than the limit is not kept
+	cache.add(5, std::string(200, 'e'));
+	assertTrue (cache.size() == 0);
+	assertTrue (cache.bytes() == 0);
+}
+
+
+void ShardedCacheTest::testExpire()
+{
+	ShardedExpireCache<int, int> cache(DURSLEEP);
+	cache.add(1, 2);
+	cache.add(3, 4);
+	assertTrue (cache.has(1));
+	assertTrue (*cache.get(3) == 4);
+	Thread::sleep(DURHALFSLEEP);
+	cache.add(5, 6);
+	assertTrue (cache.get(1));
+	Thread::sleep(DURHALFSLEEP + 20);
+
+	// access does not extend the lifetime
+	assertTrue (!cache.has(1));
+	assertTrue (cache.get(3).isNull());
+	assertTrue (cache.has(5));
+	assertTrue (cache.size() == 1);
+
+	Thread::sleep(DURWAIT);
+	assertTrue (cache.size() == 0);
+}
+
+
+void ShardedCacheTest::testAccessExpire()
+{
+	ShardedAccessExpireCache<int, int> cache(DURSLEEP);
+	cache.add(1, 2);
+	cache.add(3, 4);
+	Thread::sleep(DURHALFSLEEP);
+	assertTrue (*cache.get(1) == 2);
+	Thread::sleep(DURHALFSLEEP + 20);
+
+	// access extends the lifetime
+	assertTrue (cache.has(1));
+	assertTrue (!cache.has(3));
+	Thread::sleep(DURWAIT);
+	assertTrue (!cache.has(1));
+	assertTrue (cache.getAllKeys().empty());
+}
+
+
+void ShardedCacheTest::testUpdate()
+{
+	_addCount = _updateCount = _removeCount = _getCount = 0;
+	ShardedLRUCache<int, int> cache(3, 1);
+	cache.Add += delegate(this, &ShardedCacheTest::onAdd);
+	cache.Update += delegate(this, &ShardedCacheTest::onUpdate);
+	cache.Remove += delegate(this, &ShardedCacheTest::onRemove);
+
+	cache.update(1, 2);
+	cache.update(1, 3);
+	assertTrue (*cache.get(1) == 3);
+	assertTrue (_addCount == 1);
+	assertTrue (_updateCount == 1);
+	assertTrue (_removeCount == 0);
+
+	cache.add(1, 4);
+	assertTrue (*cache.get(1) == 4);
+	assertTrue (_addCount == 2);
+	assertTrue (_removeCount == 1);
+
+	SharedPtr<int> ptr(new int(5));
+	cache.update(2, ptr);
+	assertTrue (cache.get(2) == ptr);
+	assertTrue (cache.size() == 2);
+}
+
+
+void ShardedCacheTest::testEvents()
+{
+	_addCount = _updateCount = _removeCount = _getCount = 0;
+	ShardedLRUCache<int, int> cache(2, 1);
+	cache.Add += delegate(this, &ShardedCacheTest::onAdd);
+	cache.Remove += delegate(this, &ShardedCacheTest::onRemove);
+	cache.Get += delegate(this, &ShardedCacheTest::onGet);
+
+	cache.add(1, 1);
+	cache.add(2, 2);
+	cache.get(1);
+	cache.get(3);
+	cache.add(3, 3);
+	assertTrue (_addCount == 3);
+	assertTrue (_getCount == 1);
+	assertTrue (_removeCount == 1);
+	assertTrue (!cache.has(2));
+
+	cache.Remove -= delegate(this, &ShardedCacheTest::onRemove);
+	cache.remove(1);
+	assertTrue (_removeCount == 1);
+}
+
+
+void ShardedCacheTest::testClear()
+{
+	ShardedLRUCache<int, int> cache;
+	for (int i = 0; i < 100; ++i) cache.add(i, i);
+	assertTrue (cache.size() == 100);
+	cache.clear();
+	assertTrue (cache.size() == 0);
+	assertTrue (!cache.has(1));
+}
+
+
+void ShardedCacheTest::testConcurrentAccess()
+{
+	const int THREADS = 4;
+	const int OPERATIONS = 50000;
+
+	ShardedLRUCache<int, int> cache(256);
+	std::atomic<bool> ok(true);
+
+	Thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads[t].startFunc([&cache, &ok, t]()
+		{
+			for (int i = 0; i < OPERATIONS; ++i)
+			{
+				int key = (i*7 + t) % 1000;
+				if (i % 4 == 0)
+				{
+					cache.add(key, key);
+				}
+				else
+				{
+					SharedPtr<int> p = cache.get(key);
+					if (p && *p != key) ok = false;
+				}
+			}
+		});
+	}
+	for (int t = 0; t < THREADS; ++t) threads[t].join();
+
+	assertTrue (ok);
+	assertTrue (cache.size() <= 256);
+}
+
+
+void ShardedCacheTest::onAdd(const void* pSender, const KeyValueArgs<int, int>& args)
+{
+	++_addCount;
+}
+
+
+void ShardedCacheTest::onUpdate(const void* pSender, const KeyValueArgs<int, int>& args)
+{
+	++_updateCount;
+}
+
+
+void ShardedCacheTest::onRemove(const void* pSender, const int& args)
+{
+	++_removeCount;
+}
+
+
+void ShardedCacheTest::onGet(const void* pSender, const int& args)
+{
+	++_getCount;
+}
+
+
+void ShardedCacheTest::setUp()
+{
+	_addCount = _updateCount = _removeCount = _getCount = 0;
+}
+
+
+void ShardedCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ShardedCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ShardedCacheTest");
+
+	CppUnit_addTest(pSuite, ShardedCacheTest, testLRU);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testLRUShards);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testMaxBytes);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testAccessExpire);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testUpdate);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testEvents);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testClear);
+	CppUnit_addTest(pSuite, ShardedCacheTest, testConcurrentAccess);
+
+	return pSuite;
+}
@@ -0,0 +1,55 @@
+//
+// ShardedCacheTest.h
+//
+// Definition of the ShardedCacheTest class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ShardedCacheTest_INCLUDED
+#define ShardedCacheTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/KeyValueArgs.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ShardedCacheTest: public CppUnit::TestCase
+{
+public:
+	ShardedCacheTest(const std::string& name);
+	~ShardedCacheTest();
+
+	void testLRU();
+	void testLRUShards();
+	void testMaxBytes();
+	void testExpire();
+	void testAccessExpire();
+	void testUpdate();
+	void testEvents();
+	void testClear();
+	void testConcurrentAccess();
+
+	void setUp();
+	void tearDown();
+	static CppUnit::Test* suite();
+
+private:
+	void onAdd(const void* pSender, const Poco::KeyValueArgs<int, int>& args);
+	void onUpdate(const void* pSender, const Poco::KeyValueArgs<int, int>& args);
+	void onRemove(const void* pSender, const int& args);
+	void onGet(const void* pSender, const int& args);
+
+	int _addCount;
+	int _updateCount;
+	int _removeCount;
+	int _getCount;
+};
+
+
+#endif // ShardedCacheTest_INCLUDED
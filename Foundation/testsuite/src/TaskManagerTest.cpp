@@ -13,6 +13,7 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Exception.h"
 #include "Poco/TaskManager.h"
+#include "Poco/WorkStealingExecutor.h"
 #include "Poco/Task.h"
 #include "Poco/TaskNotification.h"
 #include "Poco/NotificationCenter.h"
@@ -35,6 +36,7 @@ using Poco::TaskProgressNotification;
 using Poco::TaskCustomNotification;
 using Poco::Thread;
 using Poco::ThreadPool;
+using Poco::WorkStealingExecutor;
 using Poco::Event;
 using Poco::Observer;
 using Poco::Exception;
@@ -588,6 +590,24 @@ void TaskManagerTest::testCustomThreadPool()
 	tp.joinAll();
 }
 
+void TaskManagerTest::testExecutor()
+{
+	WorkStealingExecutor executor(2);
+	TaskManager tm(executor);
+
+	// more tasks than worker threads are queued
+	for (int i = 0; i < 4; ++i)
+	{
+		tm.start(new SimpleTask);
+	}
+	assertTrue (tm.count() == 4);
+
+	tm.cancelAll();
+	tm.joinAll();
+	assertTrue (tm.count() == 0);
+}
+
+
 void TaskManagerTest::setUp()
 {
 }
@@ -608,6 +628,7 @@ CppUnit::Test* TaskManagerTest::suite()
 	CppUnit_addTest(pSuite, TaskManagerTest, testMultiTasks);
 	CppUnit_addTest(pSuite, TaskManagerTest, testCustom);
 	CppUnit_addTest(pSuite, TaskManagerTest, testCustomThreadPool);
+	CppUnit_addTest(pSuite, TaskManagerTest, testExecutor);
 
 	return pSuite;
 }
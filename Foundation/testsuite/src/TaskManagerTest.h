@@ -38,6 +38,7 @@ public:
 	void testTaskInclusion();
 	void testTaskQueue();
 	void testCustomThreadPool();
+	void testExecutor();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,375 @@
+//
+// ThreadCachingAllocatorTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ThreadCachingAllocatorTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/ThreadCachingAllocator.h"
+#include "Poco/MemoryPool.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <istream>
+
+
+using Poco::ThreadCachingAllocator;
+using Poco::ThreadCachingBufferAllocator;
+using Poco::Thread;
+
+
+namespace
+{
+	bool checkBlock(void* ptr, std::size_t size, char fill)
+	{
+		const char* p = static_cast<const char*>(ptr);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (p[i] != fill) return false;
+		}
+		return true;
+	}
+
+	class Worker: public Poco::Runnable
+		/// Allocates blocks, and releases the blocks
+		/// allocated by another worker.
+	{
+	public:
+		Worker(int id):
+			_id(id),
+			_ok(true),
+			_pOther(0)
+		{
+		}
+
+		void allocate()
+		{
+			for (int i = 0; i < 5000; ++i)
+			{
+				std::size_t size = 1 + (i*37 + _id*101) % 3000;
+				void* ptr = ThreadCachingAllocator::allocate(size);
+				std::memset(ptr, _id, size);
+				_blocks.push_back(Block(ptr, size));
+			}
+		}
+
+		void run()
+		{
+			// churn the thread cache
+			for (int i = 0; i < 20000; ++i)
+			{
+				std::size_t size = 1 + (i*13) % 500;
+				void* ptr = ThreadCachingAllocator::allocate(size);
+				std::memset(ptr, _id, size);
+				_ok = _ok && checkBlock(ptr, size, static_cast<char>(_id));
+				ThreadCachingAllocator::deallocate(ptr, size);
+			}
+			if (_pOther)
+			{
+				for (std::vector<Block>::iterator it = _pOther->_blocks.begin(); it != _pOther->_blocks.end(); ++it)
+				{
+					_ok = _ok && checkBlock(it->first, it->second, static_cast<char>(_pOther->_id));
+					ThreadCachingAllocator::deallocate(it->first, it->second);
+				}
+			}
+		}
+
+		void setOther(Worker* pOther)
+		{
+			_pOther = pOther;
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		typedef std::pair<void*, std::size_t> Block;
+
+		int _id;
+		bool _ok;
+		Worker* _pOther;
+		std::vector<Block> _blocks;
+	};
+
+	class TestStreamBuf: public Poco::BasicBufferedStreamBuf<char, std::char_traits<char>, ThreadCachingBufferAllocator<char> >
+	{
+	public:
+		TestStreamBuf(const std::string& data):
+			Poco::BasicBufferedStreamBuf<char, std::char_traits<char>, ThreadCachingBufferAllocator<char> >(16, std::ios::in),
+			_data(data),
+			_pos(0)
+		{
+		}
+
+	protected:
+		int readFromDevice(char* buffer, std::streamsize length)
+		{
+			std::size_t n = _data.size() - _pos;
+			if (n > static_cast<std::size_t>(length)) n = static_cast<std::size_t>(length);
+			std::memcpy(buffer, _data.data() + _pos, n);
+			_pos += n;
+			return static_cast<int>(n);
+		}
+
+	private:
+		std::string _data;
+		std::size_t _pos;
+	};
+}
+
+
+ThreadCachingAllocatorTest::ThreadCachingAllocatorTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ThreadCachingAllocatorTest::~ThreadCachingAllocatorTest()
+{
+}
+
+
+void ThreadCachingAllocatorTest::testAllocate()
+{
+	std::vector<void*> blocks;
+	for (std::size_t size = 1; size <= ThreadCachingAllocator::MAX_SIZE; size = size*3/2 + 1)
+	{
+		void* ptr = ThreadCachingAllocator::allocate(size);
+		assertNotNullPtr (ptr);
+		assertTrue (reinterpret_cast<std::size_t>(ptr) % 16 == 0);
+		std::memset(ptr, static_cast<int>(size & 0x7F), size);
+		blocks.push_back(ptr);
+	}
+	std::size_t i = 0;
+	for (std::size_t size = 1; size <= ThreadCachingAllocator::MAX_SIZE; size = size*3/2 + 1)
+	{
+		assertTrue (checkBlock(blocks[i], size, static_cast<char>(size & 0x7F)));
+		ThreadCachingAllocator::deallocate(blocks[i], size);
+		++i;
+	}
+
+	ThreadCachingAllocator::deallocate(0, 16);
+}
+
+
+void ThreadCachingAllocatorTest::testBlockSize()
+{
+	assertTrue (ThreadCachingAllocator::blockSize(0) == 16);
+	assertTrue (ThreadCachingAllocator::blockSize(1) == 16);
+	assertTrue (ThreadCachingAllocator::blockSize(16) == 16);
+	assertTrue (ThreadCachingAllocator::blockSize(17) == 32);
+	assertTrue (ThreadCachingAllocator::blockSize(128) == 128);
+	assertTrue (ThreadCachingAllocator::blockSize(129) == 160);
+	assertTrue (ThreadCachingAllocator::blockSize(256) == 256);
+	assertTrue (ThreadCachingAllocator::blockSize(257) == 320);
+	assertTrue (ThreadCachingAllocator::blockSize(1500) == 1536);
+	assertTrue (ThreadCachingAllocator::blockSize(4096) == 4096);
+	assertTrue (ThreadCachingAllocator::blockSize(4097) == 5120);
+	assertTrue (ThreadCachingAllocator::blockSize(ThreadCachingAllocator::MAX_SIZE) == ThreadCachingAllocator::MAX_SIZE);
+	assertTrue (ThreadCachingAllocator::blockSize(ThreadCachingAllocator::MAX_SIZE + 1) == ThreadCachingAllocator::MAX_SIZE + 1);
+
+	std::size_t last = 0;
+	for (std::size_t size = 1; size <= ThreadCachingAllocator::MAX_SIZE; ++size)
+	{
+		std::size_t blockSize = ThreadCachingAllocator::blockSize(size);
+		assertTrue (blockSize >= size);
+		assertTrue (blockSize >= last);
+		assertTrue (blockSize % 16 == 0);
+		// at most 25% overhead above 128 bytes
+		assertTrue (size <= 128 || blockSize - size < size/4);
+		last = blockSize;
+	}
+}
+
+
+void ThreadCachingAllocatorTest::testReuse()
+{
+	void* ptr1 = ThreadCachingAllocator::allocate(100);
+	ThreadCachingAllocator::deallocate(ptr1, 100);
+	void* ptr2 = ThreadCachingAllocator::allocate(110);
+	assertTrue (ptr1 == ptr2);
+	void* ptr3 = ThreadCachingAllocator::allocate(100);
+	assertTrue (ptr3 != ptr2);
+	ThreadCachingAllocator::deallocate(ptr2, 110);
+	ThreadCachingAllocator::deallocate(ptr3, 100);
+}
+
+
+void ThreadCachingAllocatorTest::testLargeBlocks()
+{
+	std::size_t size = ThreadCachingAllocator::MAX_SIZE*4;
+	void* ptr = ThreadCachingAllocator::allocate(size);
+	assertNotNullPtr (ptr);
+	std::memset(ptr, 'x', size);
+	std::size_t cached = ThreadCachingAllocator::cached();
+	ThreadCachingAllocator::deallocate(ptr, size);
+	assertTrue (ThreadCachingAllocator::cached() == cached);
+}
+
+
+void ThreadCachingAllocatorTest::testFlush()
+{
+	assertTrue (ThreadCachingAllocator::cached() == 0);
+	void* ptr = ThreadCachingAllocator::allocate(1000);
+	assertTrue (ThreadCachingAllocator::cached() > 0);
+	ThreadCachingAllocator::flush();
+	assertTrue (ThreadCachingAllocator::cached() == 0);
+	ThreadCachingAllocator::deallocate(ptr, 1000);
+	assertTrue (ThreadCachingAllocator::cached() == 1);
+
+	// the cache size is bounded
+	std::vector<void*> blocks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		blocks.push_back(ThreadCachingAllocator::allocate(64));
+	}
+	for (int i = 0; i < 1000; ++i)
+	{
+		ThreadCachingAllocator::deallocate(blocks[i], 64);
+	}
+	assertTrue (ThreadCachingAllocator::cached() < 200);
+	ThreadCachingAllocator::flush();
+	assertTrue (ThreadCachingAllocator::cached() == 0);
+}
+
+
+void ThreadCachingAllocatorTest::testThreads()
+{
+	const int WORKERS = 4;
+	std::vector<Worker*> workers;
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		workers.push_back(new Worker(i + 1));
+		workers.back()->allocate();
+	}
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		workers[i]->setOther(workers[(i + 1) % WORKERS]);
+	}
+	Thread threads[WORKERS];
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		threads[i].start(*workers[i]);
+	}
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		threads[i].join();
+	}
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		assertTrue (workers[i]->ok());
+		delete workers[i];
+	}
+}
+
+
+void ThreadCachingAllocatorTest::testMemoryPool()
+{
+	Poco::MemoryPool pool(100, 0, 0, true);
+	assertTrue (pool.threadCaching());
+	assertTrue (pool.blockSize() == 100);
+
+	std::vector<void*> ptrs;
+	for (int i = 0; i < 10; ++i)
+	{
+		ptrs.push_back(pool.get());
+		std::memset(ptrs.back(), i, 100);
+		assertTrue (pool.allocated() == i + 1);
+		assertTrue (pool.available() == 0);
+	}
+	for (int i = 0; i < 10; ++i)
+	{
+		assertTrue (checkBlock(ptrs[i], 100, static_cast<char>(i)));
+		pool.release(ptrs[i]);
+	}
+	assertTrue (pool.allocated() == 0);
+
+	Poco::MemoryPool defaultPool(100);
+	assertTrue (!defaultPool.threadCaching());
+	void* ptr = defaultPool.get();
+	defaultPool.release(ptr);
+	assertTrue (defaultPool.allocated() == 1);
+	assertTrue (defaultPool.available() == 1);
+	Poco::MemoryPool largePool(ThreadCachingAllocator::MAX_SIZE + 1, 0, 0, true);
+	assertTrue (!largePool.threadCaching());
+}
+
+
+void ThreadCachingAllocatorTest::testFastMemoryPool()
+{
+	const int blocks = 100;
+	Poco::FastMemoryPool<std::string, Poco::SpinlockMutex, ThreadCachingAllocator> pool;
+	assertTrue (pool.blockSize() >= sizeof(std::string));
+
+	std::vector<std::string*> strVec(blocks);
+	for (int i = 0; i < blocks; ++i)
+	{
+		strVec[i] = new (pool.get()) std::string(std::to_string(i));
+	}
+	assertTrue (pool.allocated() == blocks);
+	assertTrue (pool.available() == 0);
+	for (int i = 0; i < blocks; ++i)
+	{
+		assertTrue (*strVec[i] == std::to_string(i));
+		pool.release(strVec[i]);
+	}
+	assertTrue (pool.allocated() == 0);
+
+	std::string* pNull = 0;
+	pool.release(pNull);
+	assertTrue (pool.allocated() == 0);
+}
+
+
+void ThreadCachingAllocatorTest::testBufferAllocator()
+{
+	char* pBuffer = ThreadCachingBufferAllocator<char>::allocate(4096);
+	std::memset(pBuffer, 'a', 4096);
+	ThreadCachingBufferAllocator<char>::deallocate(pBuffer, 4096);
+
+	std::string data("The quick brown fox jumps over the lazy dog.");
+	TestStreamBuf sb(data);
+	std::istream istr(&sb);
+	std::string result;
+	std::getline(istr, result);
+	assertTrue (result == data);
+}
+
+
+void ThreadCachingAllocatorTest::setUp()
+{
+	ThreadCachingAllocator::flush();
+}
+
+
+void ThreadCachingAllocatorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ThreadCachingAllocatorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ThreadCachingAllocatorTest");
+
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testAllocate);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testBlockSize);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testReuse);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testLargeBlocks);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testFlush);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testThreads);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testMemoryPool);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testFastMemoryPool);
+	CppUnit_addTest(pSuite, ThreadCachingAllocatorTest, testBufferAllocator);
+
+	return pSuite;
+}
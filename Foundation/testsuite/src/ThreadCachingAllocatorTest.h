@@ -0,0 +1,46 @@
+//
+// ThreadCachingAllocatorTest.h
+//
+// Definition of the ThreadCachingAllocatorTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ThreadCachingAllocatorTest_INCLUDED
+#define ThreadCachingAllocatorTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ThreadCachingAllocatorTest: public CppUnit::TestCase
+{
+public:
+	ThreadCachingAllocatorTest(const std::string& name);
+	~ThreadCachingAllocatorTest();
+
+	void testAllocate();
+	void testBlockSize();
+	void testReuse();
+	void testLargeBlocks();
+	void testFlush();
+	void testThreads();
+	void testMemoryPool();
+	void testFastMemoryPool();
+	void testBufferAllocator();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // ThreadCachingAllocatorTest_INCLUDED
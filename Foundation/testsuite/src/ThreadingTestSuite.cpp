@@ -14,6 +14,7 @@
 #include "SemaphoreTest.h"
 #include "RWLockTest.h"
 #include "ThreadPoolTest.h"
+#include "WorkStealingExecutorTest.h"
 #include "TimerTest.h"
 #include "ThreadLocalTest.h"
 #include "ActivityTest.h"
@@ -31,6 +32,7 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(SemaphoreTest::suite());
 	pSuite->addTest(RWLockTest::suite());
 	pSuite->addTest(ThreadPoolTest::suite());
+	pSuite->addTest(WorkStealingExecutorTest::suite());
 	pSuite->addTest(TimerTest::suite());
 	pSuite->addTest(ThreadLocalTest::suite());
 	pSuite->addTest(ActivityTest::suite());
@@ -0,0 +1,293 @@
+//
+// WorkStealingExecutorTest.cpp
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WorkStealingExecutorTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/WorkStealingExecutor.h"
+#include "Poco/ActiveMethod.h"
+#include "Poco/Runnable.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+using Poco::WorkStealingExecutor;
+using Poco::ExecutorStarter;
+using Poco::ActiveMethod;
+using Poco::ActiveResult;
+using Poco::Runnable;
+using Poco::AtomicCounter;
+using Poco::Thread;
+using Poco::Event;
+using Poco::Exception;
+using Poco::InvalidArgumentException;
+
+
+namespace
+{
+	class CountingRunnable: public Runnable
+	{
+	public:
+		CountingRunnable(AtomicCounter& counter):
+			_counter(counter)
+		{
+		}
+
+		void run()
+		{
+			++_counter;
+		}
+
+	private:
+		AtomicCounter& _counter;
+	};
+
+	class TreeRunnable: public Runnable
+		/// Starts two child tasks until the given depth
+		/// is reached, exercising the per-worker queues.
+	{
+	public:
+		TreeRunnable(WorkStealingExecutor& executor, AtomicCounter& counter, int depth):
+			_executor(executor),
+			_counter(counter),
+			_depth(depth)
+		{
+		}
+
+		~TreeRunnable()
+		{
+			for (std::vector<TreeRunnable*>::iterator it = _children.begin(); it != _children.end(); ++it)
+			{
+				delete *it;
+			}
+		}
+
+		void run()
+		{
+			++_counter;
+			if (_depth > 0)
+			{
+				for (int i = 0; i < 2; ++i)
+				{
+					TreeRunnable* pChild = new TreeRunnable(_executor, _counter, _depth - 1);
+					_children.push_back(pChild);
+					_executor.start(*pChild);
+				}
+			}
+		}
+
+	private:
+		WorkStealingExecutor& _executor;
+		AtomicCounter& _counter;
+		int _depth;
+		std::vector<TreeRunnable*> _children;
+	};
+
+	class BlockingRunnable: public Runnable
+	{
+	public:
+		BlockingRunnable(Event& event, AtomicCounter& counter):
+			_event(event),
+			_counter(counter)
+		{
+		}
+
+		void run()
+		{
+			_event.wait();
+			++_counter;
+		}
+
+	private:
+		Event& _event;
+		AtomicCounter& _counter;
+	};
+
+	class ActiveObject
+	{
+	public:
+		ActiveObject():
+			square(this, &ActiveObject::squareImpl)
+		{
+		}
+
+		ActiveMethod<int, int, ActiveObject, ExecutorStarter<ActiveObject> > square;
+
+	protected:
+		int squareImpl(const int& n)
+		{
+			if (n < 0) throw InvalidArgumentException("n < 0");
+			return n*n;
+		}
+	};
+
+	int answer()
+	{
+		return 42;
+	}
+}
+
+
+WorkStealingExecutorTest::WorkStealingExecutorTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+WorkStealingExecutorTest::~WorkStealingExecutorTest()
+{
+}
+
+
+void WorkStealingExecutorTest::testStart()
+{
+	WorkStealingExecutor executor("test", 4);
+	assertTrue (executor.capacity() == 4);
+	assertTrue (executor.name() == "test");
+
+	AtomicCounter counter;
+	CountingRunnable runnable(counter);
+	for (int i = 0; i < 1000; ++i)
+	{
+		executor.start(runnable);
+	}
+	executor.joinAll();
+	assertTrue (counter.value() == 1000);
+	assertTrue (executor.pending() == 0);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		executor.start(runnable);
+	}
+	executor.joinAll();
+	assertTrue (counter.value() == 2000);
+}
+
+
+void WorkStealingExecutorTest::testSubmit()
+{
+	WorkStealingExecutor executor(2);
+	ActiveResult<int> result = executor.submit(&answer);
+	result.wait();
+	assertTrue (!result.failed());
+	assertTrue (result.data() == 42);
+
+	AtomicCounter counter;
+	std::vector<ActiveResult<void> > results;
+	for (int i = 0; i < 100; ++i)
+	{
+		results.push_back(executor.submit([&counter]() { ++counter; }));
+	}
+	for (std::vector<ActiveResult<void> >::iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->wait();
+		assertTrue (!it->failed());
+	}
+	assertTrue (counter.value() == 100);
+
+	int n = 6;
+	ActiveResult<int> square = executor.submit([n]() { return n*n; });
+	square.wait();
+	assertTrue (square.data() == 36);
+}
+
+
+void WorkStealingExecutorTest::testSubmitFailure()
+{
+	WorkStealingExecutor executor(2);
+	ActiveResult<int> result = executor.submit([]() -> int { throw InvalidArgumentException("test"); });
+	result.wait();
+	assertTrue (result.failed());
+	assertTrue (result.error() == "test");
+	assertTrue (dynamic_cast<InvalidArgumentException*>(result.exception()) != 0);
+	try
+	{
+		result.data();
+		fail("failed result has no data - must throw");
+	}
+	catch (Exception&)
+	{
+	}
+}
+
+
+void WorkStealingExecutorTest::testNested()
+{
+	AtomicCounter counter;
+	{
+		WorkStealingExecutor executor(4);
+		// 2^13 - 1 tasks, most of them started from worker threads
+		TreeRunnable root(executor, counter, 12);
+		executor.start(root);
+		executor.joinAll();
+		assertTrue (counter.value() == 8191);
+	}
+}
+
+
+void WorkStealingExecutorTest::testOverload()
+{
+	// unlike ThreadPool, the executor queues tasks
+	// if all worker threads are busy
+	WorkStealingExecutor executor(2);
+	Event event(Event::EVENT_MANUALRESET);
+	AtomicCounter counter;
+	BlockingRunnable runnable(event, counter);
+	for (int i = 0; i < 10; ++i)
+	{
+		executor.start(runnable);
+	}
+	Thread::sleep(100);
+	assertTrue (counter.value() == 0);
+	assertTrue (executor.pending() == 10);
+	event.set();
+	executor.joinAll();
+	assertTrue (counter.value() == 10);
+}
+
+
+void WorkStealingExecutorTest::testActiveMethod()
+{
+	ActiveObject obj;
+	ActiveResult<int> result = obj.square(7);
+	result.wait();
+	assertTrue (result.data() == 49);
+
+	result = obj.square(-1);
+	result.wait();
+	assertTrue (result.failed());
+}
+
+
+void WorkStealingExecutorTest::setUp()
+{
+}
+
+
+void WorkStealingExecutorTest::tearDown()
+{
+}
+
+
+CppUnit::Test* WorkStealingExecutorTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingExecutorTest");
+
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testSubmit);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testSubmitFailure);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testNested);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testOverload);
+	CppUnit_addTest(pSuite, WorkStealingExecutorTest, testActiveMethod);
+
+	return pSuite;
+}
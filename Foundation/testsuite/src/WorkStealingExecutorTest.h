@@ -0,0 +1,43 @@
+//
+// WorkStealingExecutorTest.h
+//
+// Definition of the WorkStealingExecutorTest class.
+//
+// Copyright (c) 2004-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WorkStealingExecutorTest_INCLUDED
+#define WorkStealingExecutorTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class WorkStealingExecutorTest: public CppUnit::TestCase
+{
+public:
+	WorkStealingExecutorTest(const std::string& name);
+	~WorkStealingExecutorTest();
+
+	void testStart();
+	void testSubmit();
+	void testSubmitFailure();
+	void testNested();
+	void testOverload();
+	void testActiveMethod();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // WorkStealingExecutorTest_INCLUDED
@@ -177,6 +177,52 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	int sendBatch(const SocketBufVec& datagrams, const SocketAddress& address, int flags = 0);
+		/// Sends each of the given buffers as a separate
+		/// datagram to the given address.
+		///
+		/// On Linux, the datagrams are sent with sendmmsg(), so
+		/// that many datagrams are sent with one system call.
+		///
+		/// Returns the number of datagrams sent, which may be less
+		/// than the number of buffers if the socket is non-blocking
+		/// or an error occurs after the first datagram has been sent.
+
+	int sendBatch(const SocketBufVec& datagrams, const std::vector<SocketAddress>& addresses, int flags = 0);
+		/// Sends each of the given buffers as a separate datagram
+		/// to the address with the same index.
+		///
+		/// Returns the number of datagrams sent.
+
+	int receiveBatch(SocketBufVec& datagrams, std::vector<int>& lengths, std::vector<SocketAddress>& addresses, int flags = 0);
+		/// Receives up to datagrams.size() datagrams (but at most
+		/// SocketImpl::MAX_DATAGRAM_BATCH), each one into the
+		/// buffer with the same index. The lengths and sender
+		/// addresses of the datagrams are stored in lengths and
+		/// addresses, which are resized to the number of datagrams
+		/// received.
+		///
+		/// On Linux, the datagrams are received with one recvmmsg()
+		/// system call, which only waits for the first datagram. On
+		/// other platforms, a single datagram is received.
+		///
+		/// Returns the number of datagrams received, or a negative
+		/// value if the socket is non-blocking and no datagram
+		/// is available.
+
+	int receiveBatch(SocketBufVec& datagrams, int* lengths, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int flags = 0);
+		/// Receives up to datagrams.size() datagrams (but at most
+		/// SocketImpl::MAX_DATAGRAM_BATCH), each one into the
+		/// buffer with the same index. Stores the length of
+		/// datagram i in lengths[i], the native address of its
+		/// sender in ppSA[i] and the length of the native address
+		/// in *ppSALen[i], which must be initialized with the
+		/// size of the address buffer.
+		///
+		/// Returns the number of datagrams received, or a negative
+		/// value if the socket is non-blocking and no datagram
+		/// is available.
+
 	void setBroadcast(bool flag);
 		/// Sets the value of the SO_BROADCAST socket option.
 		///
@@ -19,7 +19,7 @@
 
 
 #include "Poco/Net/Net.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ThreadCachingAllocator.h"
 #include <ios>
 
 
@@ -29,6 +29,8 @@ namespace Net {
 
 class Net_API HTTPBufferAllocator
 	/// A BufferAllocator for HTTP streams.
+	///
+	/// Buffers are obtained from the ThreadCachingAllocator.
 {
 public:
 	static char* allocate(std::streamsize size);
@@ -38,9 +40,6 @@ public:
 	{
 		BUFFER_SIZE = 4096
 	};
-
-private:
-	static Poco::MemoryPool _pool;
 };
 
 
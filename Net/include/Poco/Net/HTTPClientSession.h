@@ -390,6 +390,7 @@ private:
 	HTTPClientSession& operator = (const HTTPClientSession&);
 
 	friend class WebSocket;
+	friend class HTTPClientSessionPool;
 };
 
 
@@ -0,0 +1,190 @@
+//
+// HTTPClientSessionPool.h
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Definition of the HTTPClientSessionPool class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPClientSessionPool_INCLUDED
+#define Net_HTTPClientSessionPool_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPSessionFactory.h"
+#include "Poco/URI.h"
+#include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include <map>
+#include <deque>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API HTTPClientSessionPool
+	/// A pool of idle persistent HTTPClientSession objects.
+	///
+	/// Sessions are kept in separate idle lists for each combination
+	/// of scheme, host, port and proxy (host, port and username).
+	/// A session obtained with get() belongs to the caller. When the
+	/// caller is done with it, it should give it back with release(),
+	/// which keeps the session (and its open connection) for reuse
+	/// by a later get() for the same server, or deletes the session
+	/// if it cannot be reused.
+	///
+	/// A session is only kept if it is connected, has keep-alive
+	/// enabled, the server has not asked to close the connection
+	/// and the idle list for its server is not full. Sessions
+	/// that have been idle for longer than the pool's idle timeout,
+	/// or the session's own keep-alive timeout, are closed. Before
+	/// a session is handed out again, its socket is checked; if the
+	/// server has closed the connection (or sent unexpected data),
+	/// the session is discarded.
+	///
+	/// New sessions for a URI are created with the HTTPSessionFactory
+	/// given to the pool, so that sessions for other schemes (such
+	/// as https) can be pooled as well. Keep-alive is enabled for
+	/// all sessions created by the pool.
+	///
+	/// HTTPStreamFactory uses the default pool, so that URIs opened
+	/// through URIStreamOpener reuse their connections.
+	///
+	/// All member functions are thread-safe.
+{
+public:
+	HTTPClientSessionPool();
+		/// Creates the HTTPClientSessionPool, using the default
+		/// HTTPSessionFactory for creating sessions, with at most
+		/// 8 idle sessions per server and an idle timeout of
+		/// 8 seconds.
+
+	HTTPClientSessionPool(HTTPSessionFactory& factory, std::size_t maxIdle, const Poco::Timespan& idleTimeout);
+		/// Creates the HTTPClientSessionPool, using the given
+		/// HTTPSessionFactory for creating sessions, and keeping
+		/// at most maxIdle idle sessions per server for at most
+		/// the given idle timeout.
+
+	~HTTPClientSessionPool();
+		/// Destroys the HTTPClientSessionPool and all idle sessions.
+
+	HTTPClientSession* get(const Poco::URI& uri);
+		/// Returns an idle session for the scheme, host and port
+		/// of the given URI, using the proxy configured in the
+		/// HTTPSessionFactory (or, if none, the global proxy
+		/// configuration of HTTPClientSession).
+		///
+		/// If there is no idle session, a new one is created
+		/// with the HTTPSessionFactory.
+		///
+		/// The caller takes ownership of the session.
+
+	HTTPClientSession* get(const std::string& host, Poco::UInt16 port, const HTTPClientSession::ProxyConfig& proxyConfig);
+		/// Returns an idle http (non-secure) session for the given
+		/// host, port and proxy configuration, or creates a new one.
+		///
+		/// The caller takes ownership of the session.
+
+	void release(HTTPClientSession* pSession);
+		/// Gives a session obtained with get() back to the pool.
+		///
+		/// The session must not have a request or response in
+		/// progress; the response body (if any) must have been read
+		/// completely. If the session cannot be reused, it is deleted.
+		///
+		/// The pool takes ownership of the session.
+
+	void evict();
+		/// Closes and removes all sessions that have been idle
+		/// for longer than the idle timeout.
+		///
+		/// This is also done periodically by get() and release().
+
+	void clear();
+		/// Closes and removes all idle sessions.
+
+	std::size_t idle() const;
+		/// Returns the total number of idle sessions.
+
+	std::size_t idle(const Poco::URI& uri) const;
+		/// Returns the number of idle sessions for
+		/// the given URI's server.
+
+	void setMaxIdle(std::size_t maxIdle);
+		/// Sets the maximum number of idle sessions per server.
+		/// A value of 0 disables pooling.
+
+	std::size_t getMaxIdle() const;
+		/// Returns the maximum number of idle sessions per server.
+
+	void setIdleTimeout(const Poco::Timespan& idleTimeout);
+		/// Sets the time after which idle sessions are closed.
+
+	Poco::Timespan getIdleTimeout() const;
+		/// Returns the time after which idle sessions are closed.
+
+	static HTTPClientSessionPool& defaultPool();
+		/// Returns the default HTTPClientSessionPool.
+
+protected:
+	virtual bool isReusable(HTTPClientSession& session) const;
+		/// Returns true if the given idle session can be used
+		/// for another request.
+		///
+		/// The default implementation checks that the session is
+		/// still connected, and that its socket is not readable
+		/// (which would indicate that the server has closed the
+		/// connection).
+		///
+		/// Called without holding the pool's lock, for a session
+		/// that has already been removed from the pool.
+
+private:
+	enum
+	{
+		DEFAULT_MAX_IDLE = 8,
+		DEFAULT_IDLE_TIMEOUT = 8
+	};
+
+	struct IdleSession
+	{
+		HTTPClientSession* pSession;
+		Poco::Timestamp    since;
+	};
+
+	typedef std::deque<IdleSession> IdleList;
+	typedef std::map<std::string, IdleList> IdleMap;
+
+	HTTPClientSessionPool(const HTTPClientSessionPool&);
+	HTTPClientSessionPool& operator = (const HTTPClientSessionPool&);
+
+	HTTPClientSession* take(const std::string& key);
+	bool expired(const IdleSession& idle, const Poco::Timestamp& now) const;
+	void evictImpl(std::deque<HTTPClientSession*>& expiredSessions);
+	static std::string key(const std::string& scheme, const std::string& host, Poco::UInt16 port, const std::string& proxyHost, Poco::UInt16 proxyPort, const std::string& proxyUsername);
+	static std::string key(const HTTPClientSession& session);
+
+	HTTPSessionFactory&     _factory;
+	IdleMap                 _idle;
+	std::size_t             _maxIdle;
+	Poco::Timespan          _idleTimeout;
+	Poco::Timestamp         _lastEviction;
+	mutable Poco::FastMutex _mutex;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPClientSessionPool_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
+#include "Poco/MemoryPool.h"
 #include <cstddef>
 #include <istream>
 #include <ostream>
@@ -0,0 +1,300 @@
+//
+// HTTPHeaderParser.h
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPHeaderParser
+//
+// Definition of the HTTPHeaderParser class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPHeaderParser_INCLUDED
+#define Net_HTTPHeaderParser_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/MonotonicArena.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+namespace Net {
+
+
+class MessageHeader;
+class HTTPRequest;
+
+
+class Net_API HTTPHeaderParser
+	/// A parser for HTTP message headers that are
+	/// completely contained in a contiguous buffer.
+	///
+	/// Unlike MessageHeader::read() and HTTPRequest::read(), which
+	/// read the header from a stream one character at a time, the
+	/// HTTPHeaderParser locates line ends and field separators with
+	/// std::memchr() (which is vectorized by most C libraries) and
+	/// does not copy any data. The request line tokens and the header
+	/// fields are exposed as Token objects referring to the buffer;
+	/// std::string objects are only created when a Token is converted,
+	/// or when the parsed header is copied into a MessageHeader
+	/// or HTTPRequest with fill().
+	///
+	/// The buffer must not be modified or released as long as
+	/// any Token obtained from the parser is in use.
+	///
+	/// The parser applies the same syntax rules and limits as
+	/// MessageHeader::read() and HTTPRequest::read(): invalid header
+	/// lines (without a colon) are ignored, folded field values are
+	/// supported, and field names, field values, the number of fields
+	/// and the request line tokens are limited in length.
+	///
+	/// The vector holding the header fields can allocate its memory
+	/// from a MonotonicArena, such as the arena of a server request.
+{
+public:
+	class Net_API Token
+		/// A Token refers to a range of characters in the parsed buffer.
+	{
+	public:
+		Token();
+			/// Creates an empty Token.
+
+		Token(const char* data, std::size_t length);
+			/// Creates a Token referring to the given range.
+
+		const char* data() const;
+			/// Returns a pointer to the first character.
+
+		std::size_t length() const;
+			/// Returns the number of characters.
+
+		bool empty() const;
+			/// Returns true if the Token is empty.
+
+		std::string str() const;
+			/// Returns a copy of the characters as std::string.
+
+		bool equals(const std::string& str) const;
+			/// Returns true if the Token is equal to the given string.
+
+		bool iequals(const std::string& str) const;
+			/// Returns true if the Token is equal to the given string,
+			/// ignoring the case of ASCII characters.
+
+	private:
+		const char* _data;
+		std::size_t _length;
+	};
+
+	struct Net_API Field
+		/// A header field.
+	{
+		Field();
+
+		std::string value() const;
+			/// Returns the field value as std::string.
+			///
+			/// For a folded field, the line breaks are removed
+			/// from the value, as done by MessageHeader::read().
+
+		Token name;
+			/// The field name. The name is not trimmed.
+
+		Token rawValue;
+			/// The field value, without leading and trailing whitespace.
+			/// For a folded field, the Token includes the line breaks.
+
+		bool folded;
+			/// True if the field value spans more than one line.
+	};
+
+	typedef std::vector<Field, Poco::ArenaAllocator<Field> > FieldVec;
+
+	HTTPHeaderParser();
+		/// Creates the HTTPHeaderParser with the default
+		/// field limit of MessageHeader.
+
+	explicit HTTPHeaderParser(int fieldLimit);
+		/// Creates the HTTPHeaderParser with the given
+		/// field limit. A limit of 0 means unlimited.
+
+	HTTPHeaderParser(int fieldLimit, Poco::MonotonicArena& arena);
+		/// Creates the HTTPHeaderParser with the given
+		/// field limit, allocating the header fields from
+		/// the given arena, which must outlive the parser.
+
+	~HTTPHeaderParser();
+		/// Destroys the HTTPHeaderParser.
+
+	std::size_t parseRequest(const char* begin, const char* end);
+		/// Parses a HTTP request line, followed by the header fields and
+		/// the empty line terminating the header, from the given buffer.
+		/// Empty lines preceding the request line are skipped.
+		///
+		/// Returns the number of bytes up to and including the empty
+		/// line terminating the header, or 0 if the buffer does not
+		/// contain the complete header.
+		///
+		/// Throws a MessageException if the request line or a header
+		/// field is malformed or too long, or if there are too many
+		/// header fields.
+
+	std::size_t parseHeader(const char* begin, const char* end);
+		/// Parses the header fields, followed by an empty line,
+		/// from the given buffer.
+		///
+		/// Returns the number of bytes up to and including the empty
+		/// line, or 0 if the buffer does not contain the complete header.
+		///
+		/// Throws a MessageException if a header field is malformed
+		/// or too long, or if there are too many header fields.
+
+	void reset();
+		/// Clears the results of the last parse.
+
+	const Token& method() const;
+		/// Returns the request method.
+
+	const Token& uri() const;
+		/// Returns the request URI.
+
+	const Token& version() const;
+		/// Returns the HTTP version string.
+
+	const FieldVec& fields() const;
+		/// Returns the header fields, in the order they appear
+		/// in the header.
+
+	const Field* find(const std::string& name) const;
+		/// Returns the first field with the given name (ignoring case),
+		/// or a null pointer if the header has no such field.
+
+	void fill(MessageHeader& header) const;
+		/// Adds all header fields to the given MessageHeader.
+		///
+		/// Field values are decoded with MessageHeader::decodeWord(),
+		/// as done by MessageHeader::read().
+
+	void fill(HTTPRequest& request) const;
+		/// Sets method, URI and version of the given request, and
+		/// adds all header fields to it.
+
+	int getFieldLimit() const;
+		/// Returns the maximum number of header fields
+		/// allowed.
+
+	void setFieldLimit(int limit);
+		/// Sets the maximum number of header fields
+		/// allowed. A limit of 0 means unlimited.
+
+private:
+	enum Limits
+		/// Limits, as enforced by MessageHeader and HTTPRequest.
+	{
+		MAX_NAME_LENGTH    = 256,
+		MAX_VALUE_LENGTH   = 8192,
+		MAX_METHOD_LENGTH  = 32,
+		MAX_URI_LENGTH     = 16384,
+		MAX_VERSION_LENGTH = 8,
+		DFL_FIELD_LIMIT    = 100
+	};
+
+	const char* parseFields(const char* begin, const char* end);
+
+	Token    _method;
+	Token    _uri;
+	Token    _version;
+	FieldVec _fields;
+	int      _fieldLimit;
+};
+
+
+//
+// inlines
+//
+inline HTTPHeaderParser::Token::Token():
+	_data(0),
+	_length(0)
+{
+}
+
+
+inline HTTPHeaderParser::Token::Token(const char* data, std::size_t length):
+	_data(data),
+	_length(length)
+{
+}
+
+
+inline const char* HTTPHeaderParser::Token::data() const
+{
+	return _data;
+}
+
+
+inline std::size_t HTTPHeaderParser::Token::length() const
+{
+	return _length;
+}
+
+
+inline bool HTTPHeaderParser::Token::empty() const
+{
+	return _length == 0;
+}
+
+
+inline std::string HTTPHeaderParser::Token::str() const
+{
+	return std::string(_data, _length);
+}
+
+
+inline bool HTTPHeaderParser::Token::equals(const std::string& str) const
+{
+	return str.compare(0, std::string::npos, _data, _length) == 0;
+}
+
+
+inline const HTTPHeaderParser::Token& HTTPHeaderParser::method() const
+{
+	return _method;
+}
+
+
+inline const HTTPHeaderParser::Token& HTTPHeaderParser::uri() const
+{
+	return _uri;
+}
+
+
+inline const HTTPHeaderParser::Token& HTTPHeaderParser::version() const
+{
+	return _version;
+}
+
+
+inline const HTTPHeaderParser::FieldVec& HTTPHeaderParser::fields() const
+{
+	return _fields;
+}
+
+
+inline int HTTPHeaderParser::getFieldLimit() const
+{
+	return _fieldLimit;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPHeaderParser_INCLUDED
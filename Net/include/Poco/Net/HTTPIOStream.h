@@ -28,6 +28,7 @@ namespace Net {
 
 
 class HTTPClientSession;
+class HTTPClientSessionPool;
 
 
 class Net_API HTTPResponseStreamBuf: public Poco::UnbufferedStreamBuf
@@ -74,11 +75,17 @@ class Net_API HTTPResponseStream: public HTTPResponseIOS, public std::istream
 {
 public:
 	HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession);
+
+	HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession, HTTPClientSessionPool* pPool);
+		/// Creates the HTTPResponseStream. If the response has been
+		/// read completely when the stream is destroyed, the session
+		/// is given back to the pool, otherwise it is deleted.
 		
 	~HTTPResponseStream();
 	
 private:
-	HTTPClientSession* _pSession;
+	HTTPClientSession*     _pSession;
+	HTTPClientSessionPool* _pPool;
 };
 
 
@@ -0,0 +1,127 @@
+//
+// HTTPReactorConnection.h
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorConnection
+//
+// Definition of the HTTPReactorConnection class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPReactorConnection_INCLUDED
+#define Net_HTTPReactorConnection_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Mutex.h"
+#include <string>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPReactorServer;
+class HTTPServerSession;
+
+
+class Net_API HTTPReactorConnection: public Poco::RefCountedObject
+	/// This class is used internally by HTTPReactorServer
+	/// to receive and frame the requests on a client connection
+	/// in the reactor thread, and to handle complete requests
+	/// in a worker thread.
+{
+public:
+	typedef Poco::AutoPtr<HTTPReactorConnection> Ptr;
+
+	HTTPReactorConnection(const StreamSocket& socket, HTTPReactorServer& server);
+		/// Creates the HTTPReactorConnection and registers
+		/// it with the server's reactor.
+
+	void process();
+		/// Handles the complete request at the beginning
+		/// of the receive buffer. Called by a worker thread.
+
+	void close();
+		/// Closes the connection and unregisters it from the reactor.
+
+	void onReadable(ReadableNotification* pNotification);
+	void onTimeout(SocketTimeoutNotification* pNotification);
+	void onShutdown(ShutdownNotification* pNotification);
+
+protected:
+	~HTTPReactorConnection();
+		/// Destroys the HTTPReactorConnection.
+
+	std::size_t requestLength();
+		/// Returns the length of the complete request at the beginning
+		/// of the receive buffer, or 0 if the request has not been
+		/// received completely yet.
+		///
+		/// Throws a MessageException if the request is malformed, or if the
+		/// header or body exceeds the limits given in HTTPServerParams.
+		/// In the latter case, the code of the exception is the HTTP
+		/// status of the error response.
+
+	void parseHeader();
+	std::size_t chunkedLength();
+	void checkFramingLength(std::size_t pending);
+	void resetRequest();
+	bool dispatchRequest();
+	void resume();
+	bool handleRequest(HTTPServerSession& session);
+	void sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status);
+	void sendErrorResponse(HTTPResponse::HTTPStatus status);
+	void addEventHandlers();
+	void scheduleTimeout();
+	void removeReadableHandler();
+
+private:
+	enum
+	{
+		RECEIVE_BUFFER_SIZE = 4096
+	};
+
+	HTTPReactorConnection();
+	HTTPReactorConnection(const HTTPReactorConnection&);
+	HTTPReactorConnection& operator = (const HTTPReactorConnection&);
+
+	StreamSocket          _socket;
+	HTTPReactorServer&    _server;
+	HTTPServerParams::Ptr _pParams;
+	std::string           _buffer;
+	std::size_t           _scanPos;
+	std::size_t           _headerLength;
+	std::size_t           _contentLength;
+	std::size_t           _chunkPos;
+	std::size_t           _requestLength;
+	std::size_t           _bodyLength;
+	std::size_t           _framingLength;
+	bool                  _chunked;
+	bool                  _chunkTrailer;
+	bool                  _expectContinue;
+	bool                  _continueSent;
+	bool                  _busy;
+	bool                  _closed;
+	bool                  _closeDeferred;
+	int                   _requestsLeft;
+	Poco::FastMutex       _mutex;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPReactorConnection_INCLUDED
@@ -0,0 +1,231 @@
+//
+// HTTPReactorServer.h
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServer
+//
+// Definition of the HTTPReactorServer class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPReactorServer_INCLUDED
+#define Net_HTTPReactorServer_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketNotification.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/NotificationQueue.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Event.h"
+#include <memory>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPReactorConnection;
+
+
+class Net_API HTTPReactorServer: public Poco::Runnable
+	/// An event-driven HTTP server that does not tie a thread
+	/// to each client connection.
+	///
+	/// All client connections are served by a single SocketReactor
+	/// running in its own thread. The reactor receives data from the
+	/// sockets as it arrives and incrementally frames requests (request
+	/// line, header and body, as given by Content-Length or chunked
+	/// Transfer-Encoding). Only requests that have been received
+	/// completely are handed over to a fixed number of worker threads,
+	/// which run the HTTPRequestHandler and send the response. While
+	/// a connection is idle (e.g., between requests on a persistent
+	/// connection), it does not occupy a worker thread.
+	///
+	/// The number of worker threads is given by HTTPServerParams::getMaxThreads(),
+	/// or, if that is 0, the capacity of the thread pool. Since worker
+	/// threads are occupied until the server is stopped, the server
+	/// creates its own thread pool unless one is given. At most
+	/// HTTPServerParams::getMaxQueued() complete requests are queued
+	/// for the workers; if the queue is full, the server responds with
+	/// 503 Service Unavailable and closes the connection.
+	///
+	/// Idle persistent connections are closed after the keep-alive
+	/// timeout, and connections sending an incomplete request are closed
+	/// after the timeout given in HTTPServerParams.
+	///
+	/// Since request bodies are buffered in memory until the request
+	/// is complete, HTTPReactorServer is best suited for requests with
+	/// small bodies. Requests with a body must specify a Content-Length
+	/// or use chunked Transfer-Encoding. Requests with a header or body
+	/// larger than given by HTTPServerParams::getMaxHeaderSize() and
+	/// HTTPServerParams::getMaxBodySize() are rejected with 431 or 413
+	/// as soon as their size is known, and the connection is closed.
+	///
+	/// HTTPRequestHandler implementations written for HTTPServer
+	/// can be used with HTTPReactorServer without changes.
+{
+public:
+	enum
+	{
+		DEFAULT_WORKER_THREADS = 16
+			/// The number of worker threads if neither a thread pool
+			/// nor HTTPServerParams::getMaxThreads() is given.
+	};
+
+	HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, const ServerSocket& socket, HTTPServerParams::Ptr pParams);
+		/// Creates the HTTPReactorServer, using the given ServerSocket.
+		///
+		/// The ServerSocket must be bound and in listening state.
+		///
+		/// Worker threads are taken from a thread pool owned by the
+		/// server, with HTTPServerParams::getMaxThreads() threads, or
+		/// DEFAULT_WORKER_THREADS if that is 0.
+
+	HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams);
+		/// Creates the HTTPReactorServer, using the given ServerSocket.
+		///
+		/// The ServerSocket must be bound and in listening state.
+		///
+		/// Worker threads are taken from the given thread pool, and
+		/// are not returned to it until the server is stopped.
+
+	~HTTPReactorServer();
+		/// Stops and destroys the HTTPReactorServer.
+
+	void start();
+		/// Starts the reactor thread and the worker threads.
+
+	void stop();
+		/// Stops the server.
+		///
+		/// All client connections are closed. Requests that are being
+		/// handled by a worker thread are allowed to complete.
+
+	const HTTPServerParams& params() const;
+		/// Returns a const reference to the HTTPServerParams object
+		/// used by the server.
+
+	const ServerSocket& socket() const;
+		/// Returns the underlying server socket.
+
+	Poco::UInt16 port() const;
+		/// Returns the port the server socket listens on.
+
+	int workerThreads() const;
+		/// Returns the number of worker threads.
+
+	int totalConnections() const;
+		/// Returns the total number of handled connections.
+
+	int currentConnections() const;
+		/// Returns the number of currently open connections.
+
+	int totalRequests() const;
+		/// Returns the total number of requests handed over
+		/// to the worker threads.
+
+	int queuedRequests() const;
+		/// Returns the number of complete requests waiting
+		/// for a worker thread.
+
+	int refusedRequests() const;
+		/// Returns the number of requests refused because
+		/// the request queue was full.
+
+protected:
+	void run();
+		/// Worker thread procedure.
+
+	void onAccept(ReadableNotification* pNotification);
+		/// Accepts a new client connection.
+
+private:
+	HTTPReactorServer();
+	HTTPReactorServer(const HTTPReactorServer&);
+	HTTPReactorServer& operator = (const HTTPReactorServer&);
+
+	bool enqueue(HTTPReactorConnection* pConnection);
+	void connectionClosed();
+	bool stopped() const;
+	SocketReactor& reactor();
+	HTTPRequestHandlerFactory::Ptr factory() const;
+	HTTPServerParams::Ptr serverParams() const;
+
+	ServerSocket                   _socket;
+	HTTPRequestHandlerFactory::Ptr _pFactory;
+	HTTPServerParams::Ptr          _pParams;
+	std::unique_ptr<Poco::ThreadPool> _pOwnThreadPool;
+	Poco::ThreadPool*              _pThreadPool;
+	SocketReactor                  _reactor;
+	Poco::Thread                   _reactorThread;
+	Poco::NotificationQueue        _queue;
+	Poco::AtomicCounter            _workers;
+	Poco::Event                    _workersDone;
+	Poco::AtomicCounter            _totalConnections;
+	Poco::AtomicCounter            _currentConnections;
+	Poco::AtomicCounter            _totalRequests;
+	Poco::AtomicCounter            _refusedRequests;
+	bool                           _started;
+	std::atomic<bool>              _stopped;
+
+	friend class HTTPReactorConnection;
+};
+
+
+//
+// inlines
+//
+inline const HTTPServerParams& HTTPReactorServer::params() const
+{
+	return *_pParams;
+}
+
+
+inline const ServerSocket& HTTPReactorServer::socket() const
+{
+	return _socket;
+}
+
+
+inline bool HTTPReactorServer::stopped() const
+{
+	return _stopped;
+}
+
+
+inline SocketReactor& HTTPReactorServer::reactor()
+{
+	return _reactor;
+}
+
+
+inline HTTPRequestHandlerFactory::Ptr HTTPReactorServer::factory() const
+{
+	return _pFactory;
+}
+
+
+inline HTTPServerParams::Ptr HTTPReactorServer::serverParams() const
+{
+	return _pParams;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPReactorServer_INCLUDED
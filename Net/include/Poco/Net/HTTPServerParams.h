@@ -43,6 +43,9 @@ public:
 		///   - keepAlive:            true
 		///   - maxKeepAliveRequests: 0
 		///   - keepAliveTimeout:     10 seconds
+		///   - responseBatching:     true
+		///   - maxHeaderSize:        64 KiB
+		///   - maxBodySize:          1 MiB
 		
 	void setServerName(const std::string& serverName);
 		/// Sets the name and port (name:port) that the server uses to identify itself.
@@ -95,6 +98,45 @@ public:
 		/// during a persistent connection, or 0 if
 		/// unlimited connections are allowed.
 
+	void setResponseBatching(bool batching);
+		/// Enables (batching == true) or disables (batching == false)
+		/// batching of responses to pipelined requests.
+		///
+		/// If enabled, and a client sends several requests without waiting
+		/// for the responses (HTTP/1.1 pipelining), responses are held back
+		/// as long as further requests are waiting in the receive buffer,
+		/// and are then sent together with as few system calls as possible.
+		/// Requests that are not pipelined are not affected.
+		///
+		/// Handlers that stream data over a long time and rely on
+		/// every flush reaching the client immediately should disable
+		/// response batching.
+
+	bool getResponseBatching() const;
+		/// Returns true iff responses to pipelined requests are batched.
+
+	void setMaxHeaderSize(std::size_t size);
+		/// Sets the maximum size of a request header, in bytes.
+		///
+		/// Currently only enforced by HTTPReactorServer, which buffers
+		/// requests in memory and rejects larger request headers with
+		/// 431 Request Header Fields Too Large.
+
+	std::size_t getMaxHeaderSize() const;
+		/// Returns the maximum size of a request header.
+
+	void setMaxBodySize(std::size_t size);
+		/// Sets the maximum size of a request body, in bytes.
+		/// 0 means unlimited.
+		///
+		/// Currently only enforced by HTTPReactorServer, which buffers
+		/// requests in memory and rejects larger request bodies with
+		/// 413 Request Entity Too Large before receiving them.
+
+	std::size_t getMaxBodySize() const;
+		/// Returns the maximum size of a request body,
+		/// or 0 if the size is unlimited.
+
 protected:
 	virtual ~HTTPServerParams();
 		/// Destroys the HTTPServerParams.
@@ -106,6 +148,9 @@ private:
 	bool           _keepAlive;
 	int            _maxKeepAliveRequests;
 	Poco::Timespan _keepAliveTimeout;
+	bool           _responseBatching;
+	std::size_t    _maxHeaderSize;
+	std::size_t    _maxBodySize;
 };
 
 
@@ -148,6 +193,24 @@ inline const Poco::Timespan& HTTPServerParams::getKeepAliveTimeout() const
 }
 
 
+inline bool HTTPServerParams::getResponseBatching() const
+{
+	return _responseBatching;
+}
+
+
+inline std::size_t HTTPServerParams::getMaxHeaderSize() const
+{
+	return _maxHeaderSize;
+}
+
+
+inline std::size_t HTTPServerParams::getMaxBodySize() const
+{
+	return _maxBodySize;
+}
+
+
 } } // namespace Poco::Net
 
 
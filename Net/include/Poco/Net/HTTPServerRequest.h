@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/SocketAddress.h"
+#include "Poco/MonotonicArena.h"
 #include <istream>
 
 
@@ -71,6 +72,25 @@ public:
 		/// connection. Returns false if no secure connection
 		/// is used, or if it is not known whether a secure
 		/// connection is used.
+
+	virtual Poco::MonotonicArena& arena();
+		/// Returns the memory arena of the request.
+		///
+		/// Request handlers can use the arena for temporary
+		/// objects, strings and containers (see ArenaAllocator)
+		/// needed while handling the request. All memory obtained
+		/// from the arena is released at once when the request
+		/// object is destroyed.
+		///
+		/// The default implementation creates an arena on first
+		/// use. Subclasses may override it to share an arena with
+		/// their own data, as HTTPServerRequestImpl does.
+
+private:
+	HTTPServerRequest(const HTTPServerRequest&);
+	HTTPServerRequest& operator = (const HTTPServerRequest&);
+
+	Poco::MonotonicArena* _pArena;
 };
 
 
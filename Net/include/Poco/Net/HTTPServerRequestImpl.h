@@ -84,8 +84,24 @@ public:
 		
 	HTTPServerSession& session();
 		/// Returns the underlying HTTPServerSession.
+
+	Poco::MonotonicArena& arena();
+		/// Returns the memory arena of the request, which
+		/// also holds the field list of the header parser and
+		/// the request body stream.
+		///
+		/// The request line and the header fields themselves are
+		/// still stored in std::string members of HTTPRequest and
+		/// its NameValueCollection, so parsing a request is not
+		/// free of heap allocations.
 	
 private:
+	enum
+	{
+		ARENA_CHUNK_SIZE = 2048
+	};
+
+	Poco::MonotonicArena            _arena;
 	HTTPServerResponseImpl&         _response;
 	HTTPServerSession&              _session;
 	std::istream*                   _pStream;
@@ -136,6 +152,12 @@ inline HTTPServerSession& HTTPServerRequestImpl::session()
 }
 
 
+inline Poco::MonotonicArena& HTTPServerRequestImpl::arena()
+{
+	return _arena;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -20,9 +20,17 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <utility>
 
 
 namespace Poco {
+
+
+class FileInputStream;
+
+
 namespace Net {
 
 
@@ -67,6 +75,19 @@ public:
 		/// Sends the response header to the client, followed
 		/// by the content of the given file.
 		///
+		/// The file content is sent with StreamSocket::sendFile(),
+		/// which avoids copying it through user space where possible.
+		///
+		/// The response carries Last-Modified and ETag headers
+		/// (the entity tag is built from the file's modification
+		/// time and size). For GET and HEAD requests with status 200,
+		/// conditional requests (If-None-Match, If-Modified-Since)
+		/// are answered with 304 Not Modified. For GET requests,
+		/// byte ranges (Range, If-Range) are supported; a single
+		/// range is sent as 206 Partial Content, multiple ranges as
+		/// a multipart/byteranges body, and unsatisfiable ranges
+		/// result in 416 Requested Range Not Satisfiable.
+		///
 		/// Must not be called after send(), sendBuffer()
 		/// or redirect() has been called.
 		///
@@ -110,6 +131,27 @@ protected:
 	void attachRequest(HTTPServerRequestImpl* pRequest);
 	
 private:
+	enum
+	{
+		MAX_RANGES = 32
+			/// Requests with more ranges are answered with the complete file.
+	};
+
+	typedef std::pair<Poco::UInt64, Poco::UInt64> Range;
+		/// First and last byte position, inclusive.
+	typedef std::vector<Range> RangeVec;
+
+	void sendFileRange(Poco::FileInputStream& istr, const std::string& path, Poco::UInt64 offset, Poco::UInt64 count);
+	bool notModified(const std::string& etag, const Poco::Timestamp& lastModified) const;
+	bool parseRanges(const std::string& etag, const std::string& lastModified, Poco::UInt64 length, RangeVec& ranges) const;
+		/// Returns false if the request has a valid Range header
+		/// without any satisfiable range. If the ranges must
+		/// be ignored, returns true and leaves ranges empty.
+	static std::string entityTag(const Poco::Timestamp& lastModified, Poco::UInt64 length);
+	static std::string contentRange(const Range& range, Poco::UInt64 length);
+	static std::string partHeader(const std::string& boundary, const std::string& mediaType, const Range& range, Poco::UInt64 length);
+	static std::string partTrailer(const std::string& boundary);
+
 	HTTPServerSession& _session;
 	HTTPServerRequestImpl* _pRequest;
 	std::ostream*      _pStream;
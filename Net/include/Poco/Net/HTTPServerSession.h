@@ -23,6 +23,7 @@
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/HTTPServerSession.h"
 #include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPHeaderParser.h"
 #include "Poco/Timespan.h"
 
 
@@ -53,6 +54,26 @@ public:
 		
 	SocketAddress serverAddress();
 		/// Returns the server's address.
+
+	bool readRequestHeader(HTTPHeaderParser& parser);
+		/// Parses the request line and header of the next request
+		/// directly in the session's receive buffer, without
+		/// going through a stream. Receives data from the socket
+		/// if the buffer is empty.
+		///
+		/// Returns true and consumes the header if it is completely
+		/// contained in the buffer and well-formed. The tokens in the
+		/// parser refer to the receive buffer and are only valid until
+		/// the next read from the session.
+		///
+		/// Returns false if the header is incomplete or malformed.
+		/// In that case, nothing is consumed and the header must be
+		/// read from a HTTPHeaderInputStream.
+		///
+		/// Throws a NoMessageException if the connection has been
+		/// closed by the peer, or if receiving data failed (e.g.,
+		/// due to a reset or timeout). In the latter case, the
+		/// original exception is available from networkException().
 		
 private:
 	bool           _firstRequest;
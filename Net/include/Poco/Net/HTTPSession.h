@@ -99,6 +99,9 @@ public:
 		///
 		/// The socket is returned, and a new, uninitialized socket is
 		/// attached to the session.
+		///
+		/// Data held back by write batching is sent before
+		/// the socket is detached.
 
 	StreamSocket& socket();
 		/// Returns a reference to the underlying socket.
@@ -110,6 +113,22 @@ public:
 		/// This is usually used together with detachSocket() to
 		/// obtain any data already read from the socket, but not
 		/// yet processed.
+		///
+		/// Data given to primeBuffer() that has not been read
+		/// yet is copied as well.
+
+	void primeBuffer(const char* buffer, std::size_t length);
+		/// Makes the given data, which has already been received
+		/// from the socket by other means, available for reading
+		/// through the session. The data is read before any
+		/// further data is received from the socket.
+		///
+		/// This is used by event-driven servers that receive a
+		/// complete request before handing it over to a session.
+
+	void flush();
+		/// Sends all response data that has been held back
+		/// by write batching (see setWriteBatching()).
 
 protected:
 	HTTPSession();
@@ -160,6 +179,30 @@ protected:
 
 	void refill();
 		/// Refills the internal buffer.
+
+	const char* buffer() const;
+		/// Returns a pointer to the next unread byte in the
+		/// internal buffer. The number of bytes available
+		/// is given by buffered().
+
+	void consume(int length);
+		/// Marks the given number of bytes at the beginning
+		/// of the internal buffer as read.
+
+	void setWriteBatching(bool batching);
+		/// Enables or disables write batching.
+		///
+		/// If write batching is enabled, data written while there is
+		/// still unread data in the receive buffer (e.g., a pipelined
+		/// request) is held back and sent together with subsequent
+		/// data, using a single vectored send where possible. Held back
+		/// data is sent as soon as the receive buffer has been consumed
+		/// completely, before the session receives more data from the
+		/// socket, when flush() or detachSocket() is called, or if it
+		/// exceeds an internal limit.
+
+	bool getWriteBatching() const;
+		/// Returns true if write batching is enabled.
 		
 	virtual void connect(const SocketAddress& targetAddress);
 		/// Connects the underlying socket to the given address
@@ -187,8 +230,14 @@ private:
 	enum
 	{
 		HTTP_DEFAULT_TIMEOUT = 60000000,
-		HTTP_DEFAULT_CONNECTION_TIMEOUT = 30000000
+		HTTP_DEFAULT_CONNECTION_TIMEOUT = 30000000,
+		HTTP_MAX_BATCH_SIZE = 65536
 	};
+
+	int sendBatch(const char* buffer, std::streamsize length);
+		/// Sends the held back data, followed by the given data,
+		/// and returns the number of bytes of the given data sent.
+		/// Held back data that can't be sent stays in the batch.
 	
 	HTTPSession(const HTTPSession&);
 	HTTPSession& operator = (const HTTPSession&);
@@ -203,6 +252,10 @@ private:
 	Poco::Timespan   _sendTimeout;
 	Poco::Exception* _pException;
 	Poco::Any        _data;
+	std::string      _primed;
+	std::size_t      _primedPos;
+	std::string      _batch;
+	bool             _writeBatching;
 	
 	friend class HTTPStreamBuf;
 	friend class HTTPHeaderStreamBuf;
@@ -244,6 +297,26 @@ inline int HTTPSession::buffered() const
 }
 
 
+inline const char* HTTPSession::buffer() const
+{
+	return _pCurrent;
+}
+
+
+inline void HTTPSession::consume(int length)
+{
+	poco_assert_dbg (length >= 0 && length <= buffered());
+
+	_pCurrent += length;
+}
+
+
+inline bool HTTPSession::getWriteBatching() const
+{
+	return _writeBatching;
+}
+
+
 inline const Poco::Any& HTTPSession::sessionData() const
 {
 	return _data;
@@ -27,6 +27,9 @@ namespace Poco {
 namespace Net {
 
 
+class HTTPClientSessionPool;
+
+
 class Net_API HTTPStreamFactory: public Poco::URIStreamFactory
 	/// An implementation of the URIStreamFactory interface
 	/// that handles Hyper-Text Transfer Protocol (http) URIs.
@@ -64,6 +67,23 @@ public:
 		/// UnsupportedRedirectException exception is thrown.
 		/// The offending URI can then be obtained via the message()
 		/// method of UnsupportedRedirectException.
+		///
+		/// Sessions are obtained from the session pool (if one is
+		/// set). When the returned stream has been read to the end
+		/// and is deleted, the session is given back to the pool.
+
+	void setSessionPool(HTTPClientSessionPool* pPool);
+		/// Sets the HTTPClientSessionPool used for obtaining
+		/// sessions. Setting a null pointer disables pooling, in
+		/// which case a new connection is opened for every stream.
+		///
+		/// The default is HTTPClientSessionPool::defaultPool().
+		/// The pool must outlive the HTTPStreamFactory and all
+		/// streams opened with it.
+
+	HTTPClientSessionPool* getSessionPool() const;
+		/// Returns the HTTPClientSessionPool used for obtaining
+		/// sessions, or a null pointer if pooling is disabled.
 		
 	static void registerFactory();
 		/// Registers the HTTPStreamFactory with the
@@ -83,9 +103,25 @@ private:
 	Poco::UInt16 _proxyPort;
 	std::string  _proxyUsername;
 	std::string  _proxyPassword;
+	HTTPClientSessionPool* _pPool;
 };
 
 
+//
+// inlines
+//
+inline void HTTPStreamFactory::setSessionPool(HTTPClientSessionPool* pPool)
+{
+	_pPool = pPool;
+}
+
+
+inline HTTPClientSessionPool* HTTPStreamFactory::getSessionPool() const
+{
+	return _pPool;
+}
+
+
 } } // namespace Poco::Net
 
 
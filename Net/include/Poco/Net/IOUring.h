@@ -0,0 +1,174 @@
+//
+// IOUring.h
+//
+// Library: Net
+// Package: Sockets
+// Module:  IOUring
+//
+// Definition of the IOUring class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_IOUring_INCLUDED
+#define Net_IOUring_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/SocketDefs.h"
+#include "Poco/Timespan.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+class StreamSocket;
+class ServerSocket;
+class SocketAddress;
+
+
+class Net_API IOUring
+	/// A completion-based interface to the Linux io_uring facility.
+	///
+	/// Operations (receive, send, accept, connect, poll and cancel)
+	/// are queued in the submission queue, together with a 64-bit
+	/// user data value identifying the operation. Queuing an operation
+	/// does not involve a system call. Queued operations are passed
+	/// to the kernel in one batch by submit() or wait(), and wait()
+	/// collects the completions of all finished operations, again
+	/// with a single system call.
+	///
+	/// Buffers, sockets and socket addresses passed to an operation
+	/// must remain valid until the operation's completion has been
+	/// returned by wait().
+	///
+	/// IOUring requires Linux 5.13 or later (for multishot poll and
+	/// the extended wait arguments). Use available() to find out
+	/// whether io_uring can be used on the running system; the
+	/// constructor throws a Poco::NotImplementedException if not.
+	///
+	/// Operations can be queued and submitted from multiple threads,
+	/// but only one thread at a time must call wait().
+{
+public:
+	struct Completion
+		/// The completion of a single operation, as returned by wait().
+	{
+		Poco::UInt64 userData; /// user data given when the operation was queued
+		int          result;   /// operation result, or the negated error code (-errno)
+		unsigned     flags;    /// completion flags (see MORE)
+	};
+
+	typedef std::vector<Completion> CompletionVec;
+
+	enum
+	{
+		DEFAULT_ENTRIES = 256,
+		MORE = 0x02 /// completion flag: a multishot operation remains active (IORING_CQE_F_MORE)
+	};
+
+	explicit IOUring(unsigned entries = DEFAULT_ENTRIES);
+		/// Creates the IOUring, with a submission queue for
+		/// the given number of entries (rounded up to the next
+		/// power of two by the kernel). The completion queue
+		/// has twice as many entries.
+		///
+		/// Throws a Poco::NotImplementedException if io_uring
+		/// is not available.
+
+	~IOUring();
+		/// Destroys the IOUring. Operations still in progress
+		/// are cancelled by the kernel.
+
+	void poll(poco_socket_t fd, int mode, Poco::UInt64 userData, bool multiShot = false);
+		/// Queues a readiness poll for the given socket. The mode
+		/// is an OR'd combination of PollSet::POLL_READ, POLL_WRITE and
+		/// POLL_ERROR. The completion result is the poll(2) event mask,
+		/// which can be converted with pollMode().
+		///
+		/// A one-shot poll completes once. A multishot poll completes
+		/// every time the socket becomes ready, until it is removed
+		/// with removePoll(), or until a completion without the MORE flag
+		/// is delivered.
+
+	void removePoll(Poco::UInt64 target, Poco::UInt64 userData);
+		/// Queues the removal of the poll identified by the
+		/// given target user data. The removed poll completes
+		/// with -ECANCELED.
+
+	void receive(const StreamSocket& socket, void* buffer, int length, Poco::UInt64 userData, int flags = 0);
+		/// Queues receiving up to length bytes from the socket.
+		/// The completion result is the number of bytes received
+		/// (0 if the peer has shut down the connection).
+
+	void send(const StreamSocket& socket, const void* buffer, int length, Poco::UInt64 userData, int flags = 0);
+		/// Queues sending up to length bytes over the socket.
+		/// The completion result is the number of bytes sent.
+
+	void accept(const ServerSocket& socket, Poco::UInt64 userData);
+		/// Queues accepting a connection on the server socket.
+		/// The completion result is the file descriptor of the
+		/// accepted connection, which can be wrapped in a StreamSocket
+		/// with StreamSocket(new StreamSocketImpl(fd)).
+
+	void connect(const StreamSocket& socket, const SocketAddress& address, Poco::UInt64 userData);
+		/// Queues connecting the socket to the given address.
+		/// The completion result is 0 on success.
+		///
+		/// The underlying socket must already have been created,
+		/// e.g. with StreamSocket(SocketAddress::Family).
+
+	void cancel(Poco::UInt64 target, Poco::UInt64 userData);
+		/// Queues the cancellation of the operation identified by
+		/// the given target user data. The cancelled operation
+		/// completes with -ECANCELED.
+
+	int submit();
+		/// Submits all queued operations to the kernel, without
+		/// waiting for completions. Returns the number of submitted
+		/// operations.
+
+	int wait(const Poco::Timespan& timeout, CompletionVec& completions);
+		/// Submits all queued operations and waits until at least one
+		/// operation has completed, or the timeout expires.
+		///
+		/// Stores all available completions in the given vector, which
+		/// is cleared first, and returns their number. If the same vector
+		/// is reused for every call, no memory is allocated once the vector
+		/// has reached its steady-state capacity.
+
+	static int pollMode(int result);
+		/// Converts the result of a poll completion into an OR'd
+		/// combination of PollSet::POLL_READ, POLL_WRITE and POLL_ERROR.
+
+	static bool available();
+		/// Returns true if io_uring, with all features required by
+		/// IOUring, is available on the running system.
+
+private:
+	struct Ring;
+
+	IOUring(const IOUring&);
+	IOUring& operator = (const IOUring&);
+
+	void* prepare(int opcode, int fd, Poco::UInt64 userData);
+	void commit();
+	void submitImpl();
+
+	Ring*           _pRing;
+	Poco::FastMutex _sqMutex;
+	Poco::FastMutex _cqMutex;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_IOUring_INCLUDED
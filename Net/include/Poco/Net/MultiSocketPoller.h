@@ -51,6 +51,7 @@ public:
 		/// Creates the MutiSocketPoller.
 	{
 		poco_assert (_address.port() > 0 && _address.host().toString() != "0.0.0.0");
+		_reader.setBatchSize(serverParams.receiveBatchSize());
 		addSockets(serverParams.numberOfSockets());
 	}
 
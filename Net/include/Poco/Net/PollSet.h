@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Socket.h"
 #include <map>
+#include <vector>
 
 
 namespace Poco {
@@ -35,23 +36,57 @@ class Net_API PollSet
 	/// If supported, PollSet is implemented using epoll (Linux) or
 	/// poll (BSD) APIs. A fallback implementation using select()
 	/// is also provided.
+	///
+	/// On Linux, an implementation based on io_uring (see IOUring)
+	/// can be selected at runtime with BACKEND_IO_URING. Sockets are
+	/// then polled with io_uring poll requests, and all changes made
+	/// to the PollSet, as well as the re-arming of sockets after
+	/// events, are submitted in batches, so that a poll() call
+	/// usually needs a single system call only. If io_uring is not
+	/// available on the running kernel, epoll is used instead.
 {
 public:
+	enum Backend
+	{
+		BACKEND_NATIVE,  /// epoll (Linux), poll (BSD, Windows) or select
+		BACKEND_IO_URING /// io_uring (Linux 5.13 or later); BACKEND_NATIVE if not available
+	};
+
 	enum Mode
 	{
-		POLL_READ  = 0x01,
-		POLL_WRITE = 0x02,
-		POLL_ERROR = 0x04
+		POLL_READ    = 0x01,
+		POLL_WRITE   = 0x02,
+		POLL_ERROR   = 0x04,
+		POLL_EDGE    = 0x08, /// edge-triggered notification (EPOLLET, multishot poll with io_uring); ignored by poll/select
+		POLL_ONESHOT = 0x10  /// disarm socket after one event (EPOLLONESHOT, one-shot poll with io_uring); ignored by poll/select
+	};
+
+	struct Event
+		/// A single readiness event, as reported by poll(timeout, events).
+	{
+		poco_socket_t fd;
+		int mode;
 	};
 
 	typedef std::map<Poco::Net::Socket, int> SocketModeMap;
+	typedef std::vector<Event> EventVec;
 
 	PollSet();
-		/// Creates an empty PollSet.
+		/// Creates an empty PollSet, using the default
+		/// backend (see setDefaultBackend()).
+
+	explicit PollSet(Backend backend);
+		/// Creates an empty PollSet, using the given backend.
+		///
+		/// If the backend is not available, BACKEND_NATIVE
+		/// is used instead.
 
 	~PollSet();
 		/// Destroys the PollSet.
 
+	Backend backend() const;
+		/// Returns the backend actually used by the PollSet.
+
 	void add(const Poco::Net::Socket& socket, int mode);
 		/// Adds the given socket to the set, for polling with
 		/// the given mode, which can be an OR'd combination of
@@ -78,9 +113,39 @@ public:
 		/// Returns a PollMap containing the sockets that have had
 		/// their state changed.
 
+	int poll(const Poco::Timespan& timeout, EventVec& events);
+		/// Waits until the state of at least one of the PollSet's sockets
+		/// changes accordingly to its mode, or the timeout expires.
+		///
+		/// Stores the file descriptors of the ready sockets, together
+		/// with their modes, in the given vector, which is cleared first,
+		/// and returns the number of ready sockets.
+		///
+		/// Unlike the SocketModeMap-returning variant, this does not build
+		/// a map of Socket objects. If the same vector is reused for
+		/// every call, no memory is allocated once the vector has reached
+		/// its steady-state capacity.
+		///
+		/// Sockets added with POLL_ONESHOT must be re-armed with update()
+		/// after an event has been reported for them.
+
+	static void setDefaultBackend(Backend backend);
+		/// Sets the backend used by PollSet objects created with
+		/// the default constructor, including the PollSet of a
+		/// SocketReactor. The default is BACKEND_NATIVE.
+		///
+		/// Should be called during program startup, before
+		/// any PollSet is created.
+
+	static Backend getDefaultBackend();
+		/// Returns the backend used by PollSet objects
+		/// created with the default constructor.
+
 private:
 	PollSetImpl* _pImpl;
 
+	static Backend _defaultBackend;
+
 	PollSet(const PollSet&);
 	PollSet& operator = (const PollSet&);
 };
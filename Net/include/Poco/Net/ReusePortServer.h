@@ -0,0 +1,194 @@
+//
+// ReusePortServer.h
+//
+// Library: Net
+// Package: Reactor
+// Module:  ReusePortServer
+//
+// Definition of the ReusePortServer class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_ReusePortServer_INCLUDED
+#define Net_ReusePortServer_INCLUDED
+
+
+#include "Poco/Net/SocketReactor.h"
+#include "Poco/Net/SocketAcceptor.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Environment.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Thread.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+template <class ServiceHandler, class SR = SocketReactor>
+class ReusePortServer
+	/// A multi-threaded TCP server that shards incoming connections
+	/// across several listening sockets bound to the same address
+	/// with the SO_REUSEPORT socket option.
+	///
+	/// For every shard, the ReusePortServer creates a ServerSocket, a
+	/// reactor (of type SR, which must be SocketReactor or a subclass)
+	/// running in its own thread, and a SocketAcceptor registered with
+	/// that reactor. The kernel distributes incoming connections among
+	/// the listening sockets, and every accepted connection is serviced
+	/// by the reactor (and thus the thread) whose socket accepted it.
+	/// Unlike ParallelSocketAcceptor, there is no single accepting
+	/// socket and no hand-off of connections between threads.
+	///
+	/// Optionally, each reactor thread can be bound to a CPU core
+	/// (shard i runs on core i modulo the number of processors).
+	///
+	/// The ServiceHandler class must provide a constructor that
+	/// takes a StreamSocket and a SocketReactor as arguments,
+	/// see SocketAcceptor for details.
+	///
+	/// SO_REUSEPORT is supported on Linux 3.9 and later and on the BSDs,
+	/// but only Linux balances connections among the listening sockets.
+	/// On platforms without SO_REUSEPORT, binding the second socket fails
+	/// and the constructor throws an exception.
+{
+public:
+	typedef Poco::Net::SocketAcceptor<ServiceHandler> Acceptor;
+
+	ReusePortServer(const SocketAddress& address,
+		unsigned shards = Poco::Environment::processorCount(),
+		bool pinThreads = false,
+		int backlog = 64):
+		_pinThreads(pinThreads)
+		/// Creates the ReusePortServer, binds the given number of
+		/// listening sockets to the given address and starts
+		/// one reactor thread per socket.
+		///
+		/// If the port number of address is 0, the first socket is
+		/// bound to an ephemeral port and the remaining sockets are
+		/// bound to the same port.
+	{
+		poco_assert (shards > 0);
+
+		SocketAddress bindAddress(address);
+		try
+		{
+			for (unsigned i = 0; i < shards; ++i)
+			{
+				ShardPtr pShard = new Shard;
+				pShard->socket.bind(bindAddress, true, true);
+				pShard->socket.listen(backlog);
+				if (i == 0) bindAddress = pShard->socket.address();
+				pShard->pAcceptor = new Acceptor(pShard->socket, pShard->reactor);
+				_shards.push_back(pShard);
+				pShard->thread.start(pShard->reactor);
+				if (_pinThreads) pShard->thread.setAffinity(static_cast<int>(i % Poco::Environment::processorCount()));
+			}
+		}
+		catch (...)
+		{
+			stop();
+			throw;
+		}
+	}
+
+	virtual ~ReusePortServer()
+		/// Stops all reactors and destroys the ReusePortServer.
+	{
+		try
+		{
+			stop();
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	void stop()
+		/// Stops all reactor threads and closes the listening sockets.
+		///
+		/// Service handlers that are still registered with a reactor
+		/// receive a ShutdownNotification.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			ShardPtr pShard = *it;
+			pShard->reactor.stop();
+			pShard->reactor.wakeUp();
+			if (pShard->thread.isRunning()) pShard->thread.join();
+			delete pShard->pAcceptor;
+			pShard->pAcceptor = 0;
+			pShard->socket.close();
+		}
+		_shards.clear();
+	}
+
+	Poco::UInt16 port() const
+		/// Returns the port number all listening sockets are bound to.
+	{
+		poco_assert (!_shards.empty());
+
+		return _shards.front()->socket.address().port();
+	}
+
+	std::size_t shards() const
+		/// Returns the number of shards (listening sockets and reactor threads).
+	{
+		return _shards.size();
+	}
+
+	SR& reactor(std::size_t idx)
+		/// Returns the reactor of the shard at position idx.
+	{
+		return _shards.at(idx)->reactor;
+	}
+
+	ServerSocket& socket(std::size_t idx)
+		/// Returns the listening socket of the shard at position idx.
+	{
+		return _shards.at(idx)->socket;
+	}
+
+	bool pinThreads() const
+		/// Returns true if reactor threads are bound to CPU cores.
+	{
+		return _pinThreads;
+	}
+
+private:
+	struct Shard
+	{
+		Shard(): pAcceptor(0)
+		{
+		}
+
+		ServerSocket  socket;
+		SR            reactor;
+		Acceptor*     pAcceptor;
+		Poco::Thread  thread;
+	};
+
+	typedef Poco::SharedPtr<Shard> ShardPtr;
+	typedef std::vector<ShardPtr>  ShardVec;
+
+	ReusePortServer();
+	ReusePortServer(const ReusePortServer&);
+	ReusePortServer& operator = (const ReusePortServer&);
+
+	ShardVec _shards;
+	bool     _pinThreads;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_ReusePortServer_INCLUDED
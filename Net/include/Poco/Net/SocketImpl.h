@@ -27,6 +27,11 @@
 
 
 namespace Poco {
+
+
+class FileInputStream;
+
+
 namespace Net {
 
 
@@ -39,6 +44,13 @@ class Net_API SocketImpl: public Poco::RefCountedObject
 	/// You should not create any instances of this class.
 {
 public:
+	enum
+	{
+		MAX_DATAGRAM_BATCH = 64
+			/// Maximum number of datagrams received with
+			/// one call to receiveBatch().
+	};
+
 	enum SelectMode
 	{
 		SELECT_READ  = 1,
@@ -175,6 +187,23 @@ public:
 		///
 		/// Always returns zero for platforms where not implemented.
 
+	virtual Poco::Int64 sendFile(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes of the given file, starting at offset,
+		/// through the socket. The position of the stream is not used
+		/// and may be changed.
+		///
+		/// On Linux, the data is sent with sendfile() (without copying
+		/// it to user space) unless the socket is secure. Otherwise, on
+		/// POSIX platforms the file is mapped into memory and sent with
+		/// sendBytes(), so that secure sockets encrypt the data. Where
+		/// neither is possible, the file is read into a buffer.
+		///
+		/// For a blocking socket, all data is sent, unless the file
+		/// ends before offset + count. For a non-blocking socket, as
+		/// much data as possible is sent.
+		///
+		/// Returns the number of bytes sent.
+
 	virtual int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
@@ -248,6 +277,37 @@ public:
 		///
 		/// Returns the number of bytes received.
 
+	int sendBatch(const SocketBufVec& datagrams, const SocketAddress& address, int flags = 0);
+		/// Sends each buffer as a separate datagram
+		/// to the given address.
+		///
+		/// On Linux, the datagrams are sent with sendmmsg(),
+		/// using one system call for up to MAX_DATAGRAM_BATCH
+		/// datagrams.
+		///
+		/// Returns the number of datagrams sent.
+
+	int sendBatch(const SocketBufVec& datagrams, const std::vector<SocketAddress>& addresses, int flags = 0);
+		/// Sends each buffer as a separate datagram to the
+		/// address with the same index.
+		///
+		/// Returns the number of datagrams sent.
+
+	int receiveBatch(SocketBufVec& datagrams, int* lengths, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int flags = 0);
+		/// Receives up to datagrams.size() (but at most MAX_DATAGRAM_BATCH)
+		/// datagrams, each one into the buffer with the same index.
+		/// The length of datagram i is stored in lengths[i], its sender's
+		/// native address in ppSA[i] and the address length (which must
+		/// be initialized to the size of the address buffer) in *ppSALen[i].
+		///
+		/// On Linux, the datagrams are received with a single recvmmsg()
+		/// call, which waits for the first datagram only. On other
+		/// platforms, a single datagram is received.
+		///
+		/// Returns the number of datagrams received, or a negative
+		/// value if the socket is non-blocking and no datagram
+		/// is available.
+
 	virtual void sendUrgent(unsigned char data);
 		/// Sends one byte of urgent data through
 		/// the socket.
@@ -516,6 +576,16 @@ private:
 	SocketImpl(const SocketImpl&);
 	SocketImpl& operator = (const SocketImpl&);
 
+	Poco::Int64 sendFileMapped(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+	Poco::Int64 sendFileBuffered(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+
+	int sendBatchImpl(const SocketBufVec& datagrams, const SocketAddress* pAddresses, bool addressPerDatagram, int flags);
+
+	enum
+	{
+		SENDFILE_CHUNK_SIZE = 1024*1024
+	};
+
 	poco_socket_t  _sockfd;
 	Poco::Timespan _recvTimeout;
 	Poco::Timespan _sndTimeout;
@@ -525,6 +595,9 @@ private:
 	friend class Socket;
 	friend class SecureSocketImpl;
 	friend class PollSetImpl;
+	friend class EPollSetImpl;
+	friend class IOUringPollSetImpl;
+	friend class IOUring;
 };
 
 
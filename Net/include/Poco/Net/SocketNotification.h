@@ -106,6 +106,20 @@ public:
 };
 
 
+class Net_API SocketTimeoutNotification: public SocketNotification
+	/// This notification is sent to the event handlers of a
+	/// single socket when a timeout scheduled for the socket
+	/// with SocketReactor::scheduleTimeout() expires.
+{
+public:
+	SocketTimeoutNotification(SocketReactor* pReactor);
+		/// Creates the SocketTimeoutNotification for the given SocketReactor.
+
+	~SocketTimeoutNotification();
+		/// Destroys the SocketTimeoutNotification.
+};
+
+
 class Net_API IdleNotification: public SocketNotification
 	/// This notification is sent when the SocketReactor does
 	/// not have any sockets to react to.
@@ -20,6 +20,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
+#include "Poco/Net/TimerWheel.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/NotificationCenter.h"
 #include "Poco/Observer.h"
@@ -64,6 +65,14 @@ public:
 	std::size_t countObservers() const;
 		/// Returns the number of subscribers;
 
+	const Socket& socket() const;
+		/// Returns the socket this notifier dispatches events for.
+
+	TimerWheel::Timer& timer();
+		/// Returns the timer used by SocketReactor for timeouts
+		/// scheduled for the socket. The timer's context is
+		/// the SocketNotifier.
+
 protected:
 	~SocketNotifier();
 		/// Destroys the SocketNotifier.
@@ -77,6 +86,7 @@ private:
 	Poco::NotificationCenter _nc;
 	Socket                   _socket;
 	MutexType                _mutex;
+	TimerWheel::Timer        _timer;
 };
 
 
@@ -108,6 +118,18 @@ inline std::size_t SocketNotifier::countObservers() const
 }
 
 
+inline const Socket& SocketNotifier::socket() const
+{
+	return _socket;
+}
+
+
+inline TimerWheel::Timer& SocketNotifier::timer()
+{
+	return _timer;
+}
+
+
 } } // namespace Poco::Net
 
 
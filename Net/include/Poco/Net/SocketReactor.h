@@ -21,11 +21,13 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
 #include "Poco/Net/PollSet.h"
+#include "Poco/Net/TimerWheel.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
 #include "Poco/Observer.h"
 #include "Poco/AutoPtr.h"
 #include <map>
+#include <vector>
 
 
 namespace Poco {
@@ -111,6 +113,30 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// from another thread while the SocketReactor is running. Also,
 	/// it is safe to call addEventHandler() and removeEventHandler()
 	/// from event handlers.
+	///
+	/// The reactor polls its sockets with PollSet::poll(timeout, events),
+	/// reusing the same event vector in every iteration, and looks up
+	/// the event handlers for a ready socket in a table indexed by
+	/// the socket's file descriptor. No memory is allocated in the
+	/// steady state of the event loop.
+	///
+	/// In addition to the reactor-wide timeout, a timeout can be
+	/// scheduled for every single socket with scheduleTimeout().
+	/// When it expires, a SocketTimeoutNotification is dispatched
+	/// to the event handlers of that socket only. Per-socket timeouts
+	/// are kept in a hierarchical timing wheel (see TimerWheel), so
+	/// that scheduling, rescheduling and cancelling a timeout takes
+	/// constant time, even with a very large number of sockets. This
+	/// makes it possible to expire idle connections or request
+	/// deadlines without scanning all connections.
+	///
+	/// With setPollMode(), sockets can be registered edge-triggered
+	/// (PollSet::POLL_EDGE) and/or one-shot (PollSet::POLL_ONESHOT).
+	/// These modes are only supported by the epoll and io_uring based
+	/// PollSet implementations on Linux and are ignored on other
+	/// platforms. The io_uring based implementation is used if
+	/// PollSet::BACKEND_IO_URING has been made the default with
+	/// PollSet::setDefaultBackend().
 {
 public:
 	SocketReactor();
@@ -149,6 +175,27 @@ public:
 	const Poco::Timespan& getTimeout() const;
 		/// Returns the timeout.
 
+	void setPollMode(int mode);
+		/// Sets additional PollSet mode flags that are used when
+		/// registering sockets. Valid flags are PollSet::POLL_EDGE
+		/// and PollSet::POLL_ONESHOT, which can be OR'd.
+		///
+		/// With PollSet::POLL_EDGE, a ReadableNotification is only
+		/// dispatched when new data arrives, so event handlers must
+		/// read from the socket until no more data is available
+		/// (the socket should be non-blocking).
+		///
+		/// With PollSet::POLL_ONESHOT, the socket is disabled in the
+		/// PollSet after an event has been reported for it, and is
+		/// re-armed by the reactor after the event handlers have
+		/// been invoked.
+		///
+		/// Must be called before any event handlers are added.
+		/// The default is 0 (level-triggered).
+
+	int getPollMode() const;
+		/// Returns the additional PollSet mode flags.
+
 	void addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer);
 		/// Registers an event handler with the SocketReactor.
 		///
@@ -169,6 +216,23 @@ public:
 	bool has(const Socket& socket) const;
 		/// Returns true if socket is registered with this rector.
 
+	bool scheduleTimeout(const Socket& socket, const Poco::Timespan& timeout);
+		/// Schedules a SocketTimeoutNotification to be dispatched to
+		/// the event handlers of the given socket after the given
+		/// timeout. A timeout that has already been scheduled for
+		/// the socket is replaced.
+		///
+		/// The timeout is cancelled automatically when the last event
+		/// handler for the socket is removed. Returns false (and does
+		/// nothing) if no event handler is registered for the socket.
+		///
+		/// Timeouts have a resolution of 10 milliseconds. If a timeout
+		/// is scheduled from another thread while the reactor is waiting
+		/// for events, it may expire up to the reactor's timeout later.
+
+	void cancelTimeout(const Socket& socket);
+		/// Cancels the timeout scheduled for the given socket, if any.
+
 protected:
 	virtual void onTimeout();
 		/// Called if the timeout expires and no other events are available.
@@ -209,12 +273,19 @@ private:
 	typedef Poco::AutoPtr<SocketNotifier>     NotifierPtr;
 	typedef Poco::AutoPtr<SocketNotification> NotificationPtr;
 	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
+	typedef std::vector<NotifierPtr>          NotifierSlots;
 	typedef Poco::FastMutex                   MutexType;
 	typedef MutexType::ScopedLock             ScopedLock;
 
 	bool hasSocketHandlers();
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
 	NotifierPtr getNotifier(const Socket& socket, bool makeNew = false);
+	NotifierPtr getNotifier(poco_socket_t fd);
+	void clearSlot(const Socket& socket, const NotifierPtr& pNotifier);
+	int pollMode(NotifierPtr& pNotifier);
+	void rearm(NotifierPtr& pNotifier);
+	Poco::Timespan waitTime(const Poco::Timespan& timeout);
+	void expireTimeouts();
 
 	enum
 	{
@@ -227,12 +298,19 @@ private:
 	bool              _stop;
 #endif
 	Poco::Timespan    _timeout;
+	int               _pollMode;
 	EventHandlerMap   _handlers;
+	NotifierSlots     _slots;
 	PollSet           _pollSet;
+	PollSet::EventVec _events;
+	TimerWheel        _timerWheel;
+	TimerWheel::TimerVec _expiredTimers;
+	std::vector<NotifierPtr> _expiredNotifiers;
 	NotificationPtr   _pReadableNotification;
 	NotificationPtr   _pWritableNotification;
 	NotificationPtr   _pErrorNotification;
 	NotificationPtr   _pTimeoutNotification;
+	NotificationPtr   _pSocketTimeoutNotification;
 	NotificationPtr   _pIdleNotification;
 	NotificationPtr   _pShutdownNotification;
 	MutexType         _mutex;
@@ -150,6 +150,19 @@ public:
 		/// Certain socket implementations may also return a negative
 		/// value denoting a certain condition.
 
+	Poco::Int64 sendFile(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count);
+		/// Sends count bytes of the given file, starting at offset,
+		/// through the socket.
+		///
+		/// On Linux, non-secure sockets send the data with sendfile(),
+		/// without copying it to user space. Otherwise, the file is
+		/// mapped into memory (or, where this is not possible, read)
+		/// and sent with sendBytes().
+		///
+		/// Returns the number of bytes sent, which is less than count
+		/// if the file ends before offset + count, or if the socket
+		/// is non-blocking.
+
 	int receiveBytes(void* buffer, int length, int flags = 0);
 		/// Receives data from the socket and stores it
 		/// in buffer. Up to length bytes are received.
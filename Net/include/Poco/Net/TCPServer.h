@@ -30,6 +30,11 @@
 
 
 namespace Poco {
+
+
+class WorkStealingExecutor;
+
+
 namespace Net {
 
 
@@ -91,6 +96,10 @@ class Net_API TCPServer: public Poco::Runnable
 	/// The number of connection threads is adjusted dynamically, depending
 	/// on the number of connections waiting to be served.
 	///
+	/// Instead of a thread pool, a WorkStealingExecutor can be used to
+	/// run the connections. Then no thread waits for new connections
+	/// while the queue is empty.
+	///
 	/// It is possible to specify a maximum number of queued connections.
 	/// This prevents the connection queue from overflowing in the
 	/// case of an extreme server load. In such a case, connections that
@@ -145,6 +154,19 @@ public:
 		///
 		/// New threads are taken from the given thread pool.
 
+	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, const ServerSocket& socket, TCPServerParams::Ptr pParams = 0);
+		/// Creates the TCPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is given, the server's TCPServerDispatcher
+		/// creates its own one.
+		///
+		/// Connections are run on the worker threads of the given
+		/// WorkStealingExecutor, which must outlive the server.
+
 	virtual ~TCPServer();
 		/// Destroys the TCPServer and its TCPServerConnectionFactory.
 
@@ -29,6 +29,11 @@
 
 
 namespace Poco {
+
+
+class WorkStealingExecutor;
+
+
 namespace Net {
 
 
@@ -44,6 +49,19 @@ public:
 		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
 		/// creates one.
 
+	TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, TCPServerParams::Ptr pParams);
+		/// Creates the TCPServerDispatcher, which runs connections
+		/// on the given WorkStealingExecutor.
+		///
+		/// The dispatcher does not wait for new connections on the
+		/// executor's worker threads; it returns a worker to the executor
+		/// as soon as the connection queue is empty. The maximum number
+		/// of threads defaults to the executor's capacity.
+		///
+		/// The dispatcher takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is supplied, the TCPServerDispatcher
+		/// creates one.
+
 	void duplicate();
 		/// Increments the object's reference count.
 
@@ -95,6 +113,10 @@ protected:
 	void endConnection();
 		/// Updates the performance counters.
 
+	void handleConnection(Poco::Notification* pNf);
+		/// Creates and runs the TCPServerConnection for
+		/// a queued connection.
+
 private:
 	TCPServerDispatcher();
 	TCPServerDispatcher(const TCPServerDispatcher&);
@@ -134,7 +156,8 @@ private:
 	std::atomic<bool> _stopped;
 	Poco::NotificationQueue         _queue;
 	TCPServerConnectionFactory::Ptr _pConnectionFactory;
-	Poco::ThreadPool&               _threadPool;
+	Poco::ThreadPool*               _pThreadPool;
+	Poco::WorkStealingExecutor*     _pExecutor;
 	mutable Poco::FastMutex         _mutex;
 };
 
@@ -0,0 +1,199 @@
+//
+// TimerWheel.h
+//
+// Library: Net
+// Package: Reactor
+// Module:  TimerWheel
+//
+// Definition of the TimerWheel class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_TimerWheel_INCLUDED
+#define Net_TimerWheel_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Clock.h"
+#include "Poco/Timespan.h"
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API TimerWheel
+	/// A hierarchical timing wheel, used by SocketReactor to
+	/// manage per-socket timeouts.
+	///
+	/// Time is divided into ticks of a fixed resolution. Timers
+	/// expiring within the next 256 ticks are kept in the 256 slots
+	/// of the first wheel; timers expiring later are kept in the
+	/// coarser slots of three further wheels with 64 slots each,
+	/// and are moved to the finer wheels as time advances. With the
+	/// default resolution of 10 milliseconds, timers up to about
+	/// 7.7 days into the future are handled exactly; later timers
+	/// are kept in the last wheel until they are due.
+	///
+	/// Scheduling and cancelling a timer takes constant time,
+	/// independent of the number of timers. Timers are intrusive
+	/// (no memory is allocated by the TimerWheel), and are never
+	/// reported before their expiry time, but may be reported up
+	/// to one tick later.
+	///
+	/// Time is measured with the monotonic Poco::Clock.
+	///
+	/// The TimerWheel is not thread-safe.
+{
+public:
+	class Net_API Timer
+		/// A timer that can be scheduled with a TimerWheel.
+		///
+		/// A Timer is usually embedded in the object it
+		/// belongs to, which is passed as the context.
+	{
+	public:
+		explicit Timer(void* pContext = 0);
+			/// Creates the Timer with the given context.
+
+		~Timer();
+			/// Destroys the Timer, removing it from
+			/// its TimerWheel, if it is scheduled.
+
+		void* context() const;
+			/// Returns the context given to the constructor.
+
+		bool scheduled() const;
+			/// Returns true if the timer is scheduled.
+
+	private:
+		Timer(const Timer&);
+		Timer& operator = (const Timer&);
+
+		void link(Timer& head);
+		void unlink();
+
+		void*        _pContext;
+		Timer*       _pPrev;
+		Timer*       _pNext;
+		Poco::UInt64 _expiry;
+		int          _level;
+		TimerWheel*  _pWheel;
+
+		friend class TimerWheel;
+	};
+
+	typedef std::vector<Timer*> TimerVec;
+
+	TimerWheel();
+		/// Creates the TimerWheel with a resolution of 10 milliseconds.
+
+	explicit TimerWheel(const Poco::Timespan& resolution);
+		/// Creates the TimerWheel with the given resolution,
+		/// which must be at least one millisecond.
+
+	~TimerWheel();
+		/// Destroys the TimerWheel. All timers are cancelled.
+
+	void schedule(Timer& timer, const Poco::Timespan& delay);
+		/// Schedules the timer to expire after the given delay.
+		/// If the timer is already scheduled, it is rescheduled.
+
+	void cancel(Timer& timer);
+		/// Cancels the timer, if it is scheduled.
+
+	std::size_t advance(TimerVec& expired);
+		/// Advances the TimerWheel to the current time.
+		///
+		/// All timers that have expired are removed from the TimerWheel
+		/// and appended to the given vector, in order of their expiry.
+		/// Returns the number of expired timers.
+
+	Poco::Timespan nextTimeout(const Poco::Timespan& maxTimeout) const;
+		/// Returns the time until the TimerWheel should be advanced
+		/// next (either because a timer expires, or because timers have
+		/// to be moved to a finer wheel), but not more than maxTimeout.
+		///
+		/// Returns maxTimeout if no timer is scheduled.
+
+	std::size_t size() const;
+		/// Returns the number of scheduled timers.
+
+	bool empty() const;
+		/// Returns true if no timer is scheduled.
+
+	const Poco::Timespan& resolution() const;
+		/// Returns the resolution of the TimerWheel.
+
+private:
+	enum
+	{
+		LEVEL0_BITS  = 8,
+		LEVEL0_SIZE  = 1 << LEVEL0_BITS,
+		LEVEL_BITS   = 6,
+		LEVEL_SIZE   = 1 << LEVEL_BITS,
+		LEVELS       = 4,
+		SLOTS        = LEVEL0_SIZE + (LEVELS - 1)*LEVEL_SIZE,
+		MAX_BITS     = LEVEL0_BITS + (LEVELS - 1)*LEVEL_BITS,
+		DEFAULT_RESOLUTION = 10000
+	};
+
+	TimerWheel(const TimerWheel&);
+	TimerWheel& operator = (const TimerWheel&);
+
+	void insert(Timer& timer);
+	void cascade(int level);
+	Poco::UInt64 currentTick(const Poco::Clock& now) const;
+
+	Poco::Timespan     _resolution;
+	Poco::Clock        _origin;
+	Poco::UInt64       _tick;       /// the next tick to be processed
+	std::size_t        _size;
+	std::size_t        _level0Size; /// number of timers in the first wheel
+	Timer              _slots[SLOTS];
+};
+
+
+//
+// inlines
+//
+inline void* TimerWheel::Timer::context() const
+{
+	return _pContext;
+}
+
+
+inline bool TimerWheel::Timer::scheduled() const
+{
+	return _pWheel != 0;
+}
+
+
+inline std::size_t TimerWheel::size() const
+{
+	return _size;
+}
+
+
+inline bool TimerWheel::empty() const
+{
+	return _size == 0;
+}
+
+
+inline const Poco::Timespan& TimerWheel::resolution() const
+{
+	return _resolution;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_TimerWheel_INCLUDED
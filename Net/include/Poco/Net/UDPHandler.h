@@ -23,7 +23,7 @@
 #include "Poco/AutoPtr.h"
 #include "Poco/Runnable.h"
 #include "Poco/Thread.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ThreadCachingAllocator.h"
 #include "Poco/Event.h"
 #include "Poco/Error.h"
 #include "Poco/Mutex.h"
@@ -49,6 +49,9 @@ class UDPHandlerImpl: public Runnable, public RefCountedObject
 	/// to the handler when there is data or error ready for processing.
 	/// Typically, user will inherit from this class and override processData()
 	/// and processError() members to do the actual work.
+	///
+	/// Memory blocks are obtained from the ThreadCachingAllocator and
+	/// returned to it when the handler is destroyed.
 {
 public:
 	typedef UDPMsgSizeT             MsgSizeT;
@@ -84,6 +87,13 @@ public:
 	{
 		stop();
 		_thread.join();
+		for (BufMap::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+		{
+			for (BLIt lIt = it->second.begin(); lIt != it->second.end(); ++lIt)
+			{
+				Poco::ThreadCachingAllocator::deallocate(*lIt, S);
+			}
+		}
 	}
 
 	std::size_t blockSize() const
@@ -334,7 +344,6 @@ private:
 	typedef std::map<poco_socket_t, BufList> BufMap;
 	typedef typename BufList::iterator       BLIt;
 	typedef std::map<poco_socket_t, BLIt>    BufIt;
-	typedef Poco::FastMemoryPool<char[S]>    MemPool;
 	typedef std::atomic<Poco::Int32>         Counter;
 
 	void setStatusImpl(char*& pBuf, MsgSizeT status)
@@ -350,7 +359,7 @@ private:
 
 	void makeNext(poco_socket_t sock, char** ret)
 	{
-		_buffers[sock].push_back(reinterpret_cast<char*>(_memPool.get()));
+		_buffers[sock].push_back(static_cast<char*>(Poco::ThreadCachingAllocator::allocate(S)));
 		setStatusImpl(_buffers[sock].back(), BUF_STATUS_BUSY);
 		_bufIt[sock] = _buffers[sock].begin();
 		*ret = _buffers[sock].back();
@@ -364,7 +373,6 @@ private:
 	BufIt             _bufIt;
 	std::size_t       _bufListSize;
 	const std::size_t _blockSize;
-	MemPool           _memPool;
 	Counter           _dataBacklog;
 	Counter           _errorBacklog;
 	Poco::FastMutex   _mutex;
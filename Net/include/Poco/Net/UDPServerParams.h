@@ -36,7 +36,8 @@ public:
 		Poco::Timespan timeout = 250000,
 		std::size_t handlerBufListSize = 1000,
 		bool notifySender = false,
-		int  backlogThreshold = 10);
+		int  backlogThreshold = 10,
+		int  receiveBatchSize = 1);
 		/// Creates UDPServerParams.
 
 	~UDPServerParams();
@@ -64,6 +65,13 @@ public:
 		/// reports backlogs back to the client. Only meaningful
 		/// if notifySender() is true.
 
+	int receiveBatchSize() const;
+		/// Returns the maximum number of datagrams received
+		/// from a readable socket at once. With a value greater
+		/// than one, datagrams are received with recvmmsg() (where
+		/// available) directly into the handler's buffers, saving
+		/// system calls when many datagrams arrive.
+
 private:
 	UDPServerParams();
 
@@ -73,6 +81,7 @@ private:
 	std::size_t              _handlerBufListSize;
 	bool                     _notifySender;
 	int                      _backlogThreshold;
+	int                      _receiveBatchSize;
 };
 
 
@@ -116,6 +125,12 @@ inline int UDPServerParams::backlogThreshold() const
 }
 
 
+inline int UDPServerParams::receiveBatchSize() const
+{
+	return _receiveBatchSize;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -35,12 +35,18 @@ class UDPSocketReader
 	/// handler for handling (if any configured).
 	/// Depending on settings, data senders may be notified of the handler's
 	/// data and error backlogs.
+	///
+	/// If the batch size is greater than one, up to batch size datagrams
+	/// are received with a single DatagramSocket::receiveBatch() call
+	/// (which uses recvmmsg() where available) directly into the
+	/// handler's buffers.
 {
 public:
 	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, int backlogThreshold = 0):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(backlogThreshold)
+		_backlogThreshold(backlogThreshold),
+		_batchSize(1)
 		/// Creates the UDPSocketReader.
 	{
 		poco_assert(_handler != _handlers.end());
@@ -49,10 +55,12 @@ public:
 	UDPSocketReader(typename UDPHandlerImpl<S>::List& handlers, const UDPServerParams& serverParams):
 		_handlers(handlers),
 		_handler(_handlers.begin()),
-		_backlogThreshold(serverParams.backlogThreshold())
+		_backlogThreshold(serverParams.backlogThreshold()),
+		_batchSize(1)
 		/// Creates the UDPSocketReader.
 	{
 		poco_assert(_handler != _handlers.end());
+		setBatchSize(serverParams.receiveBatchSize());
 	}
 
 	~UDPSocketReader()
@@ -66,6 +74,12 @@ public:
 		/// for replying to sender and data or error backlog threshold is
 		/// exceeded, sender is notified of the current backlog size.
 	{
+		if (_batchSize > 1)
+		{
+			readBatch(sock);
+			return;
+		}
+
 		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
 		char* p = 0;
 		struct sockaddr* pSA = 0;
@@ -114,6 +128,94 @@ public:
 		handler().notify();
 	}
 
+	void readBatch(DatagramSocket& sock)
+		/// Reads up to batch size datagrams from the socket with
+		/// a single system call (where supported) and passes them
+		/// on to the next handler.
+	{
+		typedef typename UDPHandlerImpl<S>::MsgSizeT RT;
+		char* bufs[SocketImpl::MAX_DATAGRAM_BATCH];
+		struct sockaddr* pSA[SocketImpl::MAX_DATAGRAM_BATCH];
+		poco_socklen_t* pAL[SocketImpl::MAX_DATAGRAM_BATCH];
+		int lengths[SocketImpl::MAX_DATAGRAM_BATCH];
+		poco_socket_t sockfd = sock.impl()->sockfd();
+		nextHandler();
+
+		// _bufVec has capacity for the batch size, so
+		// resizing it does not allocate memory
+		Poco::UInt16 off = handler().offset();
+		_bufVec.resize(_batchSize);
+		int n = 0;
+		for (; n < _batchSize; ++n)
+		{
+			char* p = handler().next(sockfd);
+			if (!p) break;
+			bufs[n] = p;
+			pAL[n] = reinterpret_cast<poco_socklen_t*>(p + sizeof(RT));
+			*pAL[n] = SocketAddress::MAX_ADDRESS_LENGTH;
+			pSA[n] = reinterpret_cast<struct sockaddr*>(p + sizeof(RT) + sizeof(poco_socklen_t));
+			_bufVec[n] = Socket::makeBuffer(p + off, S - off - 1);
+		}
+		if (n == 0) return;
+		_bufVec.resize(n);
+
+		int received = 0;
+		std::string err;
+		try
+		{
+			received = sock.receiveBatch(_bufVec, lengths, pSA, pAL);
+			if (received < 0) err = Error::getMessage(Error::last());
+		}
+		catch (Poco::Exception& exc)
+		{
+			err = exc.displayText();
+		}
+		if (!err.empty())
+		{
+			setError(sockfd, bufs[0], err);
+			received = 1;
+		}
+		else
+		{
+			for (int i = 0; i < received; ++i)
+			{
+				Poco::Int32 data = handler().setData(bufs[i], lengths[i]);
+				bufs[i][off + lengths[i]] = 0; // for ascii convenience, zero-terminate
+				if (_backlogThreshold > 0 && data > _backlogThreshold && data != _dataBacklog[sockfd])
+				{
+					try
+					{
+						sock.sendTo(&data, sizeof(Poco::Int32), SocketAddress(pSA[i], *pAL[i]));
+						_dataBacklog[sockfd] = data;
+					}
+					catch (Poco::Exception&)
+					{
+					}
+				}
+			}
+		}
+		for (int i = received; i < n; ++i)
+		{
+			handler().setIdle(bufs[i]);
+		}
+		handler().notify();
+	}
+
+	void setBatchSize(int batchSize)
+		/// Sets the maximum number of datagrams read at once.
+		/// The value is limited to SocketImpl::MAX_DATAGRAM_BATCH.
+	{
+		poco_assert (batchSize > 0);
+		_batchSize = batchSize < SocketImpl::MAX_DATAGRAM_BATCH ? batchSize : static_cast<int>(SocketImpl::MAX_DATAGRAM_BATCH);
+		_bufVec.resize(_batchSize);
+	}
+
+	int getBatchSize() const
+		/// Returns the maximum number of datagrams read at once.
+	{
+		return _batchSize;
+	}
+
 	bool handlerStopped() const
 		/// Returns true if all handlers are stopped.
 	{
@@ -178,6 +280,8 @@ private:
 	CounterMap      _dataBacklog;
 	CounterMap      _errorBacklog;
 	int             _backlogThreshold;
+	int             _batchSize;
+	SocketBufVec    _bufVec;
 };
 
 
@@ -15,6 +15,7 @@
 #include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/DatagramSocketImpl.h"
 #include "Poco/Exception.h"
+#include <algorithm>
 
 
 using Poco::InvalidArgumentException;
@@ -153,4 +154,48 @@ int DatagramSocket::receiveFrom(SocketBufVec& buffers, struct sockaddr** ppSA, p
 }
 
 
+
+int DatagramSocket::sendBatch(const SocketBufVec& datagrams, const SocketAddress& address, int flags)
+{
+	return impl()->sendBatch(datagrams, address, flags);
+}
+
+
+int DatagramSocket::sendBatch(const SocketBufVec& datagrams, const std::vector<SocketAddress>& addresses, int flags)
+{
+	return impl()->sendBatch(datagrams, addresses, flags);
+}
+
+
+int DatagramSocket::receiveBatch(SocketBufVec& datagrams, std::vector<int>& lengths, std::vector<SocketAddress>& addresses, int flags)
+{
+	std::size_t n = std::min<std::size_t>(datagrams.size(), SocketImpl::MAX_DATAGRAM_BATCH);
+	std::vector<sockaddr_storage> storage(n);
+	std::vector<struct sockaddr*> pSA(n);
+	std::vector<poco_socklen_t> saLen(n, sizeof(sockaddr_storage));
+	std::vector<poco_socklen_t*> pSALen(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		pSA[i] = reinterpret_cast<struct sockaddr*>(&storage[i]);
+		pSALen[i] = &saLen[i];
+	}
+	lengths.resize(n);
+	int rc = n > 0 ? impl()->receiveBatch(datagrams, &lengths[0], &pSA[0], &pSALen[0], flags) : 0;
+	std::size_t received = rc > 0 ? static_cast<std::size_t>(rc) : 0;
+	lengths.resize(received);
+	addresses.clear();
+	addresses.reserve(received);
+	for (std::size_t i = 0; i < received; ++i)
+	{
+		addresses.push_back(SocketAddress(pSA[i], saLen[i]));
+	}
+	return rc;
+}
+
+
+int DatagramSocket::receiveBatch(SocketBufVec& datagrams, int* lengths, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int flags)
+{
+	return impl()->receiveBatch(datagrams, lengths, ppSA, ppSALen, flags);
+}
+
 } } // namespace Poco::Net
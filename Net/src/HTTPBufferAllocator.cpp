@@ -15,21 +15,18 @@
 #include "Poco/Net/HTTPBufferAllocator.h"
 
 
-using Poco::MemoryPool;
+using Poco::ThreadCachingAllocator;
 
 
 namespace Poco {
 namespace Net {
 
 
-MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
-
-
 char* HTTPBufferAllocator::allocate(std::streamsize size)
 {
 	poco_assert_dbg (size == BUFFER_SIZE);
 
-	return reinterpret_cast<char*>(_pool.get());
+	return static_cast<char*>(ThreadCachingAllocator::allocate(BUFFER_SIZE));
 }
 
 
@@ -37,7 +34,7 @@ void HTTPBufferAllocator::deallocate(char* ptr, std::streamsize size)
 {
 	poco_assert_dbg (size == BUFFER_SIZE);
 
-	_pool.release(ptr);
+	ThreadCachingAllocator::deallocate(ptr, BUFFER_SIZE);
 }
 
 
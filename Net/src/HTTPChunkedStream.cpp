@@ -137,7 +137,7 @@ HTTPChunkedStreamBuf* HTTPChunkedIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream));
+Poco::MemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream), 0, 0, true);
 
 
 HTTPChunkedInputStream::HTTPChunkedInputStream(HTTPSession& session):
@@ -176,7 +176,7 @@ void HTTPChunkedInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream));
+Poco::MemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream), 0, 0, true);
 
 
 HTTPChunkedOutputStream::HTTPChunkedOutputStream(HTTPSession& session):
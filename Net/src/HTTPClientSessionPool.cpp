@@ -0,0 +1,347 @@
+//
+// HTTPClientSessionPool.cpp
+//
+// Library: Net
+// Package: HTTPClient
+// Module:  HTTPClientSessionPool
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/SingletonHolder.h"
+
+
+using Poco::FastMutex;
+using Poco::NumberFormatter;
+
+
+namespace Poco {
+namespace Net {
+
+
+HTTPClientSessionPool::HTTPClientSessionPool():
+	_factory(HTTPSessionFactory::defaultFactory()),
+	_maxIdle(DEFAULT_MAX_IDLE),
+	_idleTimeout(DEFAULT_IDLE_TIMEOUT, 0)
+{
+}
+
+
+HTTPClientSessionPool::HTTPClientSessionPool(HTTPSessionFactory& factory, std::size_t maxIdle, const Poco::Timespan& idleTimeout):
+	_factory(factory),
+	_maxIdle(maxIdle),
+	_idleTimeout(idleTimeout)
+{
+}
+
+
+HTTPClientSessionPool::~HTTPClientSessionPool()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::get(const Poco::URI& uri)
+{
+	std::string proxyHost = _factory.proxyHost();
+	Poco::UInt16 proxyPort = _factory.proxyPort();
+	std::string proxyUsername = _factory.proxyUsername();
+	if (proxyHost.empty())
+	{
+		const HTTPClientSession::ProxyConfig& globalConfig = HTTPClientSession::getGlobalProxyConfig();
+		proxyHost = globalConfig.host;
+		proxyPort = globalConfig.port;
+		proxyUsername = globalConfig.username;
+	}
+
+	HTTPClientSession* pSession = take(key(uri.getScheme(), uri.getHost(), uri.getPort(), proxyHost, proxyPort, proxyUsername));
+	if (!pSession)
+	{
+		pSession = _factory.createClientSession(uri);
+		pSession->setKeepAlive(true);
+	}
+	return pSession;
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::get(const std::string& host, Poco::UInt16 port, const HTTPClientSession::ProxyConfig& proxyConfig)
+{
+	HTTPClientSession* pSession = take(key("http", host, port, proxyConfig.host, proxyConfig.port, proxyConfig.username));
+	if (!pSession)
+	{
+		pSession = new HTTPClientSession(host, port, proxyConfig);
+		pSession->setKeepAlive(true);
+	}
+	return pSession;
+}
+
+
+void HTTPClientSessionPool::release(HTTPClientSession* pSession)
+{
+	poco_check_ptr (pSession);
+
+	std::deque<HTTPClientSession*> discarded;
+	if (pSession->connected() && pSession->getKeepAlive() && !pSession->mustReconnect() && !pSession->networkException())
+	{
+		std::string sessionKey = key(*pSession);
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_maxIdle > 0)
+		{
+			IdleList& list = _idle[sessionKey];
+			if (list.size() >= _maxIdle)
+			{
+				// keep the most recently used sessions
+				discarded.push_back(list.front().pSession);
+				list.pop_front();
+			}
+			IdleSession idle;
+			idle.pSession = pSession;
+			list.push_back(idle);
+			pSession = 0;
+		}
+		evictImpl(discarded);
+	}
+	delete pSession;
+	for (std::deque<HTTPClientSession*>::iterator it = discarded.begin(); it != discarded.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void HTTPClientSessionPool::evict()
+{
+	std::deque<HTTPClientSession*> discarded;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_lastEviction = 0;
+		evictImpl(discarded);
+	}
+	for (std::deque<HTTPClientSession*>::iterator it = discarded.begin(); it != discarded.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void HTTPClientSessionPool::clear()
+{
+	IdleMap idle;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		idle.swap(_idle);
+	}
+	for (IdleMap::iterator it = idle.begin(); it != idle.end(); ++it)
+	{
+		for (IdleList::iterator itList = it->second.begin(); itList != it->second.end(); ++itList)
+		{
+			delete itList->pSession;
+		}
+	}
+}
+
+
+std::size_t HTTPClientSessionPool::idle() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	std::size_t n = 0;
+	for (IdleMap::const_iterator it = _idle.begin(); it != _idle.end(); ++it)
+	{
+		n += it->second.size();
+	}
+	return n;
+}
+
+
+std::size_t HTTPClientSessionPool::idle(const Poco::URI& uri) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	std::size_t n = 0;
+	std::string prefix = key(uri.getScheme(), uri.getHost(), uri.getPort(), "", 0, "");
+	prefix.resize(prefix.find('|'));
+	for (IdleMap::const_iterator it = _idle.begin(); it != _idle.end(); ++it)
+	{
+		if (it->first.compare(0, prefix.size(), prefix) == 0 && it->first[prefix.size()] == '|')
+			n += it->second.size();
+	}
+	return n;
+}
+
+
+void HTTPClientSessionPool::setMaxIdle(std::size_t maxIdle)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_maxIdle = maxIdle;
+}
+
+
+std::size_t HTTPClientSessionPool::getMaxIdle() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _maxIdle;
+}
+
+
+void HTTPClientSessionPool::setIdleTimeout(const Poco::Timespan& idleTimeout)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_idleTimeout = idleTimeout;
+}
+
+
+Poco::Timespan HTTPClientSessionPool::getIdleTimeout() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _idleTimeout;
+}
+
+
+bool HTTPClientSessionPool::isReusable(HTTPClientSession& session) const
+{
+	if (!session.connected()) return false;
+	try
+	{
+		// An idle connection must not have anything to read. If it has,
+		// the server has closed the connection or sent unexpected data.
+		return !session.socket().poll(Poco::Timespan(0), Socket::SELECT_READ | Socket::SELECT_ERROR);
+	}
+	catch (Poco::Exception&)
+	{
+		return false;
+	}
+}
+
+
+HTTPClientSession* HTTPClientSessionPool::take(const std::string& key)
+{
+	for (;;)
+	{
+		std::deque<HTTPClientSession*> discarded;
+		HTTPClientSession* pSession = 0;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			IdleMap::iterator it = _idle.find(key);
+			if (it != _idle.end())
+			{
+				Poco::Timestamp now;
+				IdleList& list = it->second;
+				while (!pSession && !list.empty())
+				{
+					IdleSession idle = list.back();
+					list.pop_back();
+					if (!expired(idle, now))
+						pSession = idle.pSession;
+					else
+						discarded.push_back(idle.pSession);
+				}
+				if (list.empty()) _idle.erase(it);
+			}
+			evictImpl(discarded);
+		}
+		for (std::deque<HTTPClientSession*>::iterator it = discarded.begin(); it != discarded.end(); ++it)
+		{
+			delete *it;
+		}
+		if (!pSession) return 0;
+
+		// checked without holding the lock, since it polls the socket
+		if (isReusable(*pSession)) return pSession;
+		delete pSession;
+	}
+}
+
+
+bool HTTPClientSessionPool::expired(const IdleSession& idle, const Poco::Timestamp& now) const
+{
+	Poco::Timestamp::TimeDiff idleTime = now - idle.since;
+	return idleTime >= _idleTimeout.totalMicroseconds() || idleTime >= idle.pSession->getKeepAliveTimeout().totalMicroseconds();
+}
+
+
+void HTTPClientSessionPool::evictImpl(std::deque<HTTPClientSession*>& expiredSessions)
+{
+	// scanning all idle lists is only worth it from time to time
+	Poco::Timestamp now;
+	if (now - _lastEviction < _idleTimeout.totalMicroseconds()/2) return;
+	_lastEviction = now;
+
+	IdleMap::iterator it = _idle.begin();
+	while (it != _idle.end())
+	{
+		IdleList& list = it->second;
+		// sessions are appended in release order, so the oldest come first
+		while (!list.empty() && expired(list.front(), now))
+		{
+			expiredSessions.push_back(list.front().pSession);
+			list.pop_front();
+		}
+		if (list.empty())
+			_idle.erase(it++);
+		else
+			++it;
+	}
+}
+
+
+std::string HTTPClientSessionPool::key(const std::string& scheme, const std::string& host, Poco::UInt16 port, const std::string& proxyHost, Poco::UInt16 proxyPort, const std::string& proxyUsername)
+{
+	std::string result(scheme);
+	result += "://";
+	result += host;
+	result += ':';
+	NumberFormatter::append(result, port);
+	result += '|';
+	if (!proxyHost.empty())
+	{
+		result += proxyUsername;
+		result += '@';
+		result += proxyHost;
+		result += ':';
+		NumberFormatter::append(result, proxyPort);
+	}
+	return result;
+}
+
+
+std::string HTTPClientSessionPool::key(const HTTPClientSession& session)
+{
+	return key(session.secure() ? "https" : "http", session.getHost(), session.getPort(), session.getProxyHost(), session.getProxyPort(), session.getProxyUsername());
+}
+
+
+namespace
+{
+	static Poco::SingletonHolder<HTTPClientSessionPool> singleton;
+}
+
+
+HTTPClientSessionPool& HTTPClientSessionPool::defaultPool()
+{
+	return *singleton.get();
+}
+
+
+} } // namespace Poco::Net
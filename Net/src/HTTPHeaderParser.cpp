@@ -0,0 +1,269 @@
+//
+// HTTPHeaderParser.cpp
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPHeaderParser
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPHeaderParser.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/MessageHeader.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	inline const char* findChar(const char* begin, const char* end, char ch)
+	{
+		return static_cast<const char*>(std::memchr(begin, ch, end - begin));
+	}
+
+	inline bool isBlank(char ch)
+	{
+		return ch == ' ' || ch == '\t';
+	}
+
+	inline const char* skipSpace(const char* it, const char* end)
+	{
+		while (it != end && Poco::Ascii::isSpace(*it)) ++it;
+		return it;
+	}
+
+	inline const char* skipToken(const char* it, const char* end)
+	{
+		while (it != end && !Poco::Ascii::isSpace(*it)) ++it;
+		return it;
+	}
+}
+
+
+bool HTTPHeaderParser::Token::iequals(const std::string& str) const
+{
+	if (str.size() != _length) return false;
+	for (std::size_t i = 0; i < _length; ++i)
+	{
+		if (Poco::Ascii::toLower(_data[i]) != Poco::Ascii::toLower(str[i])) return false;
+	}
+	return true;
+}
+
+
+HTTPHeaderParser::Field::Field():
+	folded(false)
+{
+}
+
+
+std::string HTTPHeaderParser::Field::value() const
+{
+	if (!folded) return rawValue.str();
+
+	std::string result;
+	result.reserve(rawValue.length());
+	const char* it  = rawValue.data();
+	const char* end = it + rawValue.length();
+	for (; it != end; ++it)
+	{
+		if (*it != '\r' && *it != '\n') result += *it;
+	}
+	return result;
+}
+
+
+HTTPHeaderParser::HTTPHeaderParser():
+	_fieldLimit(DFL_FIELD_LIMIT)
+{
+}
+
+
+HTTPHeaderParser::HTTPHeaderParser(int fieldLimit):
+	_fieldLimit(fieldLimit)
+{
+	poco_assert (fieldLimit >= 0);
+}
+
+
+HTTPHeaderParser::HTTPHeaderParser(int fieldLimit, Poco::MonotonicArena& arena):
+	_fields(Poco::ArenaAllocator<Field>(arena)),
+	_fieldLimit(fieldLimit)
+{
+	poco_assert (fieldLimit >= 0);
+}
+
+
+HTTPHeaderParser::~HTTPHeaderParser()
+{
+}
+
+
+std::size_t HTTPHeaderParser::parseRequest(const char* begin, const char* end)
+{
+	reset();
+
+	const char* it = skipSpace(begin, end);
+	const char* eol = findChar(it, end, '\n');
+	if (!eol)
+	{
+		if (end - it > MAX_METHOD_LENGTH + MAX_URI_LENGTH + MAX_VERSION_LENGTH + 4)
+			throw MessageException("HTTP request line too long");
+		return 0;
+	}
+
+	const char* tokenEnd = skipToken(it, eol);
+	if (tokenEnd == eol || tokenEnd - it > MAX_METHOD_LENGTH) throw MessageException("HTTP request method invalid or too long");
+	_method = Token(it, tokenEnd - it);
+
+	it = skipSpace(tokenEnd, eol);
+	tokenEnd = skipToken(it, eol);
+	if (tokenEnd == eol || tokenEnd - it > MAX_URI_LENGTH) throw MessageException("HTTP request URI invalid or too long");
+	_uri = Token(it, tokenEnd - it);
+
+	it = skipSpace(tokenEnd, eol);
+	tokenEnd = skipToken(it, eol);
+	if (tokenEnd == it || tokenEnd - it > MAX_VERSION_LENGTH) throw MessageException("Invalid HTTP version string");
+	_version = Token(it, tokenEnd - it);
+
+	const char* headerEnd = parseFields(eol + 1, end);
+	if (!headerEnd)
+	{
+		reset();
+		return 0;
+	}
+	return headerEnd - begin;
+}
+
+
+std::size_t HTTPHeaderParser::parseHeader(const char* begin, const char* end)
+{
+	reset();
+
+	const char* headerEnd = parseFields(begin, end);
+	if (!headerEnd)
+	{
+		reset();
+		return 0;
+	}
+	return headerEnd - begin;
+}
+
+
+const char* HTTPHeaderParser::parseFields(const char* begin, const char* end)
+{
+	const char* it = begin;
+	for (;;)
+	{
+		const char* eol = findChar(it, end, '\n');
+		if (!eol) return 0;
+		const char* lineEnd = eol;
+		if (lineEnd != it && *(lineEnd - 1) == '\r') --lineEnd;
+
+		if (lineEnd == it) return eol + 1; // empty line terminates the header
+
+		if (isBlank(*it) && !_fields.empty())
+		{
+			// folded field value
+			Field& field = _fields.back();
+			const char* valueEnd = lineEnd;
+			while (valueEnd != it && Poco::Ascii::isSpace(*(valueEnd - 1))) --valueEnd;
+			if (findChar(it, lineEnd, '\r') || static_cast<std::size_t>(valueEnd - field.rawValue.data()) > MAX_VALUE_LENGTH)
+				throw MessageException("Folded field value too long/no CRLF found");
+			if (valueEnd != it)
+			{
+				field.rawValue = Token(field.rawValue.data(), valueEnd - field.rawValue.data());
+				field.folded = true;
+			}
+		}
+		else
+		{
+			const char* colon = findChar(it, lineEnd, ':');
+			if (!colon)
+			{
+				// ignore invalid header lines
+				if (eol - it >= MAX_NAME_LENGTH) throw MessageException("Field name too long/no colon found");
+				it = eol + 1;
+				continue;
+			}
+			if (colon - it > MAX_NAME_LENGTH) throw MessageException("Field name too long/no colon found");
+			if (_fieldLimit > 0 && static_cast<int>(_fields.size()) == _fieldLimit)
+				throw MessageException("Too many header fields");
+
+			const char* value = colon + 1;
+			while (value != lineEnd && Poco::Ascii::isSpace(*value) && *value != '\r') ++value;
+			if (lineEnd - value > MAX_VALUE_LENGTH || findChar(value, lineEnd, '\r'))
+				throw MessageException("Field value too long/no CRLF found");
+			const char* valueEnd = lineEnd;
+			while (valueEnd != value && Poco::Ascii::isSpace(*(valueEnd - 1))) --valueEnd;
+
+			_fields.push_back(Field());
+			Field& field = _fields.back();
+			field.name = Token(it, colon - it);
+			field.rawValue = Token(value, valueEnd - value);
+		}
+		it = eol + 1;
+	}
+}
+
+
+void HTTPHeaderParser::reset()
+{
+	_method  = Token();
+	_uri     = Token();
+	_version = Token();
+	_fields.clear();
+}
+
+
+const HTTPHeaderParser::Field* HTTPHeaderParser::find(const std::string& name) const
+{
+	for (FieldVec::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+	{
+		if (it->name.iequals(name)) return &*it;
+	}
+	return 0;
+}
+
+
+void HTTPHeaderParser::fill(MessageHeader& header) const
+{
+	for (FieldVec::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+	{
+		std::string value = it->value();
+		if (value.find("=?") == std::string::npos)
+			header.add(it->name.str(), value);
+		else
+			header.add(it->name.str(), MessageHeader::decodeWord(value));
+	}
+}
+
+
+void HTTPHeaderParser::fill(HTTPRequest& request) const
+{
+	fill(static_cast<MessageHeader&>(request));
+	request.setMethod(_method.str());
+	request.setURI(_uri.str());
+	request.setVersion(_version.str());
+}
+
+
+void HTTPHeaderParser::setFieldLimit(int limit)
+{
+	poco_assert (limit >= 0);
+
+	_fieldLimit = limit;
+}
+
+
+} } // namespace Poco::Net
@@ -102,7 +102,7 @@ HTTPHeaderStreamBuf* HTTPHeaderIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
+Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream), 0, 0, true);
 
 
 HTTPHeaderInputStream::HTTPHeaderInputStream(HTTPSession& session):
@@ -141,7 +141,7 @@ void HTTPHeaderInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
+Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream), 0, 0, true);
 
 
 HTTPHeaderOutputStream::HTTPHeaderOutputStream(HTTPSession& session):
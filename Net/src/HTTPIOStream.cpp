@@ -14,6 +14,7 @@
 
 #include "Poco/Net/HTTPIOStream.h"
 #include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 
 
 using Poco::UnbufferedStreamBuf;
@@ -51,14 +52,35 @@ HTTPResponseIOS::~HTTPResponseIOS()
 HTTPResponseStream::HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession):
 	HTTPResponseIOS(istr),
 	std::istream(&_buf),
-	_pSession(pSession)
+	_pSession(pSession),
+	_pPool(0)
+{
+}
+
+
+HTTPResponseStream::HTTPResponseStream(std::istream& istr, HTTPClientSession* pSession, HTTPClientSessionPool* pPool):
+	HTTPResponseIOS(istr),
+	std::istream(&_buf),
+	_pSession(pSession),
+	_pPool(pPool)
 {
 }
 
 
 HTTPResponseStream::~HTTPResponseStream()
 {
-	delete _pSession;
+	if (_pPool && eof() && !bad())
+	{
+		try
+		{
+			_pPool->release(_pSession);
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+	else delete _pSession;
 }
 
 
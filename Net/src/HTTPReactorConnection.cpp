@@ -0,0 +1,543 @@
+//
+// HTTPReactorConnection.cpp
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorConnection
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPReactorConnection.h"
+#include "Poco/Net/HTTPReactorServer.h"
+#include "Poco/Net/HTTPServerSession.h"
+#include "Poco/Net/HTTPHeaderParser.h"
+#include "Poco/Net/HTTPServerRequestImpl.h"
+#include "Poco/Net/HTTPServerResponseImpl.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Observer.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Ascii.h"
+#include "Poco/ErrorHandler.h"
+#include <sstream>
+#include <memory>
+#include <limits>
+
+
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Net {
+
+
+HTTPReactorConnection::HTTPReactorConnection(const StreamSocket& socket, HTTPReactorServer& server):
+	_socket(socket),
+	_server(server),
+	_pParams(server.serverParams()),
+	_scanPos(0),
+	_headerLength(0),
+	_contentLength(0),
+	_chunkPos(0),
+	_requestLength(0),
+	_bodyLength(0),
+	_framingLength(0),
+	_chunked(false),
+	_chunkTrailer(false),
+	_expectContinue(false),
+	_continueSent(false),
+	_busy(false),
+	_closed(false),
+	_closeDeferred(false),
+	_requestsLeft(_pParams->getMaxKeepAliveRequests() > 0 ? _pParams->getMaxKeepAliveRequests() : -1)
+{
+	addEventHandlers();
+}
+
+
+HTTPReactorConnection::~HTTPReactorConnection()
+{
+}
+
+
+void HTTPReactorConnection::addEventHandlers()
+{
+	SocketReactor& reactor = _server.reactor();
+	reactor.addEventHandler(_socket, Poco::Observer<HTTPReactorConnection, ReadableNotification>(*this, &HTTPReactorConnection::onReadable));
+	reactor.addEventHandler(_socket, Poco::Observer<HTTPReactorConnection, SocketTimeoutNotification>(*this, &HTTPReactorConnection::onTimeout));
+	reactor.addEventHandler(_socket, Poco::Observer<HTTPReactorConnection, ShutdownNotification>(*this, &HTTPReactorConnection::onShutdown));
+	scheduleTimeout();
+}
+
+
+void HTTPReactorConnection::removeReadableHandler()
+{
+	_server.reactor().removeEventHandler(_socket, Poco::Observer<HTTPReactorConnection, ReadableNotification>(*this, &HTTPReactorConnection::onReadable));
+}
+
+
+void HTTPReactorConnection::scheduleTimeout()
+{
+	// waiting for the next request, or for the rest of the current one
+	const Poco::Timespan& timeout = _buffer.empty() ? _pParams->getKeepAliveTimeout() : _pParams->getTimeout();
+	_server.reactor().scheduleTimeout(_socket, timeout);
+}
+
+
+void HTTPReactorConnection::onReadable(ReadableNotification* pNotification)
+{
+	pNotification->release();
+	try
+	{
+		char buffer[RECEIVE_BUFFER_SIZE];
+		int n = _socket.receiveBytes(buffer, sizeof(buffer));
+		if (n > 0)
+		{
+			_buffer.append(buffer, n);
+			if (!dispatchRequest()) scheduleTimeout();
+		}
+		else if (n == 0)
+		{
+			close();
+		}
+	}
+	catch (MessageException& exc)
+	{
+		sendErrorResponse(exc.code() ? static_cast<HTTPResponse::HTTPStatus>(exc.code()) : HTTPResponse::HTTP_BAD_REQUEST);
+		close();
+	}
+	catch (Poco::Exception&)
+	{
+		close();
+	}
+}
+
+
+void HTTPReactorConnection::onTimeout(SocketTimeoutNotification* pNotification)
+{
+	pNotification->release();
+	bool expired = false;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		expired = !_busy;
+	}
+	if (expired) close();
+}
+
+
+void HTTPReactorConnection::onShutdown(ShutdownNotification* pNotification)
+{
+	pNotification->release();
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		if (_busy)
+		{
+			// closed by the worker thread once the response has been sent
+			_closeDeferred = true;
+			return;
+		}
+	}
+	close();
+}
+
+
+void HTTPReactorConnection::close()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		if (_closed) return;
+		_closed = true;
+	}
+	try
+	{
+		SocketReactor& reactor = _server.reactor();
+		removeReadableHandler();
+		reactor.removeEventHandler(_socket, Poco::Observer<HTTPReactorConnection, SocketTimeoutNotification>(*this, &HTTPReactorConnection::onTimeout));
+		reactor.removeEventHandler(_socket, Poco::Observer<HTTPReactorConnection, ShutdownNotification>(*this, &HTTPReactorConnection::onShutdown));
+		_socket.close();
+	}
+	catch (...)
+	{
+	}
+	_server.connectionClosed();
+	release();
+}
+
+
+bool HTTPReactorConnection::dispatchRequest()
+{
+	std::size_t length = requestLength();
+	if (length > 0)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_busy = true;
+		}
+		removeReadableHandler();
+		_server.reactor().cancelTimeout(_socket);
+		if (!_server.enqueue(this))
+		{
+			if (!_server.stopped()) sendErrorResponse(HTTPResponse::HTTP_SERVICE_UNAVAILABLE);
+			close();
+		}
+		return true;
+	}
+	else if (_expectContinue && !_continueSent)
+	{
+		_continueSent = true;
+		std::string cont("HTTP/1.1 100 Continue\r\n\r\n");
+		_socket.sendBytes(cont.data(), static_cast<int>(cont.size()));
+	}
+	return false;
+}
+
+
+void HTTPReactorConnection::process()
+{
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		if (_closed) return;
+	}
+
+	bool keepAlive = false;
+	try
+	{
+		_socket.setBlocking(true);
+		HTTPServerSession session(_socket, _pParams);
+		try
+		{
+			session.primeBuffer(_buffer.data(), _requestLength);
+			_buffer.erase(0, _requestLength);
+			resetRequest();
+			keepAlive = handleRequest(session);
+		}
+		catch (Poco::Exception& exc)
+		{
+			keepAlive = false;
+			if (!session.networkException()) ErrorHandler::handle(exc);
+		}
+		// the session must not close the socket
+		session.detachSocket();
+		if (keepAlive) _socket.setBlocking(false);
+	}
+	catch (Poco::Exception&)
+	{
+		keepAlive = false;
+	}
+
+	if (keepAlive && !_server.stopped())
+		resume();
+	else
+		close();
+}
+
+
+void HTTPReactorConnection::resume()
+{
+	bool closeDeferred = false;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		closeDeferred = _closeDeferred;
+	}
+	if (closeDeferred)
+	{
+		close();
+		return;
+	}
+	try
+	{
+		// a pipelined request may already have been received
+		if (dispatchRequest()) return;
+
+		// The connection is registered again before it stops being busy.
+		// Otherwise, the reactor thread could close it on a timeout or
+		// shutdown while it is being registered.
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			closeDeferred = _closeDeferred;
+			if (!closeDeferred)
+			{
+				scheduleTimeout();
+				_server.reactor().addEventHandler(_socket, Poco::Observer<HTTPReactorConnection, ReadableNotification>(*this, &HTTPReactorConnection::onReadable));
+				_busy = false;
+			}
+		}
+		if (closeDeferred)
+			close();
+		else
+			_server.reactor().wakeUp();
+	}
+	catch (MessageException& exc)
+	{
+		sendErrorResponse(exc.code() ? static_cast<HTTPResponse::HTTPStatus>(exc.code()) : HTTPResponse::HTTP_BAD_REQUEST);
+		close();
+	}
+	catch (Poco::Exception&)
+	{
+		close();
+	}
+}
+
+
+bool HTTPReactorConnection::handleRequest(HTTPServerSession& session)
+{
+	if (_requestsLeft > 0) --_requestsLeft;
+	bool canKeepAlive = _requestsLeft != 0;
+
+	try
+	{
+		HTTPServerResponseImpl response(session);
+		HTTPServerRequestImpl request(response, session, _pParams);
+
+		Poco::Timestamp now;
+		response.setDate(now);
+		response.setVersion(request.getVersion());
+		response.setKeepAlive(_pParams->getKeepAlive() && request.getKeepAlive() && canKeepAlive);
+		const std::string& server = _pParams->getSoftwareVersion();
+		if (!server.empty())
+			response.set("Server", server);
+		try
+		{
+			std::unique_ptr<HTTPRequestHandler> pHandler(_server.factory()->createRequestHandler(request));
+			if (pHandler.get())
+			{
+				// the request body has already been received by the reactor,
+				// so 100 Continue, if requested, has been sent at that time
+				pHandler->handleRequest(request, response);
+				return _pParams->getKeepAlive() && response.getKeepAlive() && canKeepAlive;
+			}
+			else sendErrorResponse(session, HTTPResponse::HTTP_NOT_IMPLEMENTED);
+		}
+		catch (Poco::Exception&)
+		{
+			if (!response.sent())
+			{
+				try
+				{
+					sendErrorResponse(session, HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+				}
+				catch (...)
+				{
+				}
+			}
+			throw;
+		}
+	}
+	catch (NoMessageException&)
+	{
+	}
+	catch (MessageException&)
+	{
+		sendErrorResponse(session, HTTPResponse::HTTP_BAD_REQUEST);
+	}
+	return false;
+}
+
+
+void HTTPReactorConnection::sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status)
+{
+	HTTPServerResponseImpl response(session);
+	response.setVersion(HTTPMessage::HTTP_1_1);
+	response.setStatusAndReason(status);
+	response.setKeepAlive(false);
+	response.send();
+	session.setKeepAlive(false);
+}
+
+
+void HTTPReactorConnection::sendErrorResponse(HTTPResponse::HTTPStatus status)
+{
+	try
+	{
+		HTTPResponse response(HTTPMessage::HTTP_1_1, status);
+		response.setKeepAlive(false);
+		response.setContentLength(0);
+		std::ostringstream ostr;
+		response.write(ostr);
+		std::string msg(ostr.str());
+		_socket.sendBytes(msg.data(), static_cast<int>(msg.size()));
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void HTTPReactorConnection::resetRequest()
+{
+	_scanPos = 0;
+	_headerLength = 0;
+	_contentLength = 0;
+	_chunkPos = 0;
+	_requestLength = 0;
+	_bodyLength = 0;
+	_framingLength = 0;
+	_chunked = false;
+	_chunkTrailer = false;
+	_expectContinue = false;
+	_continueSent = false;
+}
+
+
+std::size_t HTTPReactorConnection::requestLength()
+{
+	if (_requestLength > 0) return _requestLength;
+
+	if (_headerLength == 0)
+	{
+		// skip empty lines preceding the request line
+		if (_scanPos == 0)
+		{
+			std::string::size_type start = 0;
+			while (start < _buffer.size() && (_buffer[start] == '\r' || _buffer[start] == '\n')) ++start;
+			if (start > 0) _buffer.erase(0, start);
+		}
+
+		std::string::size_type pos = _buffer.find('\n', _scanPos);
+		while (pos != std::string::npos)
+		{
+			if (pos + 1 < _buffer.size() && _buffer[pos + 1] == '\n')
+			{
+				_headerLength = pos + 2;
+				break;
+			}
+			else if (pos + 2 < _buffer.size() && _buffer[pos + 1] == '\r' && _buffer[pos + 2] == '\n')
+			{
+				_headerLength = pos + 3;
+				break;
+			}
+			else if (pos + 2 >= _buffer.size())
+			{
+				// need more data to decide
+				break;
+			}
+			pos = _buffer.find('\n', pos + 1);
+		}
+		if (_headerLength == 0)
+		{
+			_scanPos = pos != std::string::npos ? pos : _buffer.size();
+			if (_buffer.size() > _pParams->getMaxHeaderSize())
+				throw MessageException("Request header too large", HTTPResponse::HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE);
+			return 0;
+		}
+		if (_headerLength > _pParams->getMaxHeaderSize())
+			throw MessageException("Request header too large", HTTPResponse::HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE);
+		parseHeader();
+	}
+
+	if (_chunked)
+	{
+		_requestLength = chunkedLength();
+	}
+	else if (_buffer.size() - _headerLength >= _contentLength)
+	{
+		_requestLength = _headerLength + _contentLength;
+	}
+	return _requestLength;
+}
+
+
+void HTTPReactorConnection::parseHeader()
+{
+	HTTPHeaderParser parser;
+	if (parser.parseRequest(_buffer.data(), _buffer.data() + _headerLength) != _headerLength)
+		throw MessageException("Malformed request header");
+
+	const HTTPHeaderParser::FieldVec& fields = parser.fields();
+	for (HTTPHeaderParser::FieldVec::const_iterator it = fields.begin(); it != fields.end(); ++it)
+	{
+		if (it->name.iequals(HTTPMessage::CONTENT_LENGTH))
+		{
+			Poco::UInt64 length;
+			if (!Poco::NumberParser::tryParseUnsigned64(it->value(), length)) throw MessageException("Invalid Content-Length");
+			std::size_t maxBodySize = _pParams->getMaxBodySize();
+			if ((maxBodySize > 0 && length > maxBodySize) || length > std::numeric_limits<std::size_t>::max() - _headerLength)
+				throw MessageException("Request body too large", HTTPResponse::HTTP_REQUEST_ENTITY_TOO_LARGE);
+			_contentLength = static_cast<std::size_t>(length);
+		}
+		else if (it->name.iequals(HTTPMessage::TRANSFER_ENCODING))
+		{
+			_chunked = it->rawValue.iequals(HTTPMessage::CHUNKED_TRANSFER_ENCODING);
+		}
+		else if (it->name.iequals(HTTPRequest::EXPECT))
+		{
+			_expectContinue = it->rawValue.iequals("100-continue");
+		}
+	}
+	_chunkPos = _headerLength;
+}
+
+
+std::size_t HTTPReactorConnection::chunkedLength()
+{
+	std::size_t maxBodySize = _pParams->getMaxBodySize();
+	for (;;)
+	{
+		std::string::size_type eol = _buffer.find('\n', _chunkPos);
+		if (eol == std::string::npos)
+		{
+			checkFramingLength(_buffer.size() - _chunkPos);
+			return 0;
+		}
+		if (_chunkTrailer)
+		{
+			// trailer fields are terminated by an empty line
+			bool empty = eol == _chunkPos || (eol == _chunkPos + 1 && _buffer[_chunkPos] == '\r');
+			_framingLength += eol + 1 - _chunkPos;
+			_chunkPos = eol + 1;
+			if (empty) return _chunkPos;
+			checkFramingLength(0);
+		}
+		else
+		{
+			std::string::size_type pos = _chunkPos;
+			while (pos < eol && Poco::Ascii::isSpace(_buffer[pos])) ++pos;
+			std::string::size_type start = pos;
+			while (pos < eol && Poco::Ascii::isHexDigit(_buffer[pos]) && pos - start < 8) ++pos;
+			unsigned chunkLength;
+			if (pos == start || !Poco::NumberParser::tryParseHex(_buffer.substr(start, pos - start), chunkLength))
+				throw MessageException("Invalid chunk length");
+			if (chunkLength == 0)
+			{
+				_chunkTrailer = true;
+				_framingLength += eol + 1 - _chunkPos;
+				_chunkPos = eol + 1;
+			}
+			else
+			{
+				if (maxBodySize > 0 && chunkLength > maxBodySize - _bodyLength)
+					throw MessageException("Request body too large", HTTPResponse::HTTP_REQUEST_ENTITY_TOO_LARGE);
+				std::string::size_type dataEnd = eol + 1 + chunkLength;
+				if (dataEnd >= _buffer.size()) return 0;
+				std::string::size_type next = _buffer.find('\n', dataEnd);
+				if (next == std::string::npos)
+				{
+					checkFramingLength(eol + 1 - _chunkPos + _buffer.size() - dataEnd);
+					return 0;
+				}
+				_bodyLength += chunkLength;
+				_framingLength += eol + 1 - _chunkPos + next + 1 - dataEnd;
+				_chunkPos = next + 1;
+				checkFramingLength(0);
+			}
+		}
+	}
+}
+
+
+void HTTPReactorConnection::checkFramingLength(std::size_t pending)
+{
+	// chunk size lines, extensions and trailers must not
+	// make the buffered request much larger than its body
+	if (_framingLength + pending > _bodyLength + _pParams->getMaxHeaderSize())
+		throw MessageException("Chunked request framing too large", HTTPResponse::HTTP_REQUEST_ENTITY_TOO_LARGE);
+}
+
+
+} } // namespace Poco::Net
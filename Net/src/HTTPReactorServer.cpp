@@ -0,0 +1,277 @@
+//
+// HTTPReactorServer.cpp
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  HTTPReactorServer
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPReactorServer.h"
+#include "Poco/Net/HTTPReactorConnection.h"
+#include "Poco/Observer.h"
+#include "Poco/Notification.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+
+
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Net {
+
+
+class HTTPRequestNotification: public Notification
+{
+public:
+	HTTPRequestNotification(HTTPReactorConnection* pConnection):
+		_pConnection(pConnection, true)
+	{
+	}
+
+	~HTTPRequestNotification()
+	{
+	}
+
+	HTTPReactorConnection::Ptr connection() const
+	{
+		return _pConnection;
+	}
+
+private:
+	HTTPReactorConnection::Ptr _pConnection;
+};
+
+
+namespace
+{
+	static const std::string threadName("HTTPReactorServer");
+}
+
+
+HTTPReactorServer::HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, const ServerSocket& socket, HTTPServerParams::Ptr pParams):
+	_socket(socket),
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_pThreadPool(0),
+	_workersDone(Poco::Event::EVENT_MANUALRESET),
+	_started(false),
+	_stopped(false)
+{
+	poco_check_ptr (pFactory);
+
+	if (!_pParams) _pParams = new HTTPServerParams;
+
+	// worker threads are not returned to the pool until the server
+	// is stopped, so they must not be taken from a shared pool
+	int threads = _pParams->getMaxThreads();
+	if (threads == 0) threads = DEFAULT_WORKER_THREADS;
+	_pOwnThreadPool.reset(new Poco::ThreadPool(threadName, threads, threads));
+	_pThreadPool = _pOwnThreadPool.get();
+}
+
+
+HTTPReactorServer::HTTPReactorServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams):
+	_socket(socket),
+	_pFactory(pFactory),
+	_pParams(pParams),
+	_pThreadPool(&threadPool),
+	_workersDone(Poco::Event::EVENT_MANUALRESET),
+	_started(false),
+	_stopped(false)
+{
+	poco_check_ptr (pFactory);
+
+	if (!_pParams) _pParams = new HTTPServerParams;
+}
+
+
+HTTPReactorServer::~HTTPReactorServer()
+{
+	try
+	{
+		stop();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void HTTPReactorServer::start()
+{
+	poco_assert (!_started);
+
+	_started = true;
+
+	int threads = _pParams->getMaxThreads();
+	if (threads == 0) threads = _pThreadPool->capacity();
+	_workers = threads;
+	for (int i = 0; i < threads; ++i)
+	{
+		try
+		{
+			_pThreadPool->startWithPriority(_pParams->getThreadPriority(), *this, threadName);
+		}
+		catch (Poco::NoThreadAvailableException&)
+		{
+			if (i == 0) throw;
+			_workers = i;
+			break;
+		}
+	}
+
+	_reactor.addEventHandler(_socket, Poco::Observer<HTTPReactorServer, ReadableNotification>(*this, &HTTPReactorServer::onAccept));
+	_reactorThread.start(_reactor);
+}
+
+
+void HTTPReactorServer::stop()
+{
+	if (!_started || _stopped) return;
+
+	_stopped = true;
+	_reactor.stop();
+	_reactor.wakeUp();
+	_reactorThread.join();
+	_reactor.removeEventHandler(_socket, Poco::Observer<HTTPReactorServer, ReadableNotification>(*this, &HTTPReactorServer::onAccept));
+
+	_queue.wakeUpAll();
+	if (_workers > 0) _workersDone.wait();
+
+	// release connections that were still queued when the workers stopped
+	Poco::AutoPtr<Notification> pNf = _queue.dequeueNotification();
+	while (pNf)
+	{
+		HTTPRequestNotification* pRNf = dynamic_cast<HTTPRequestNotification*>(pNf.get());
+		if (pRNf) pRNf->connection()->close();
+		pNf = _queue.dequeueNotification();
+	}
+}
+
+
+Poco::UInt16 HTTPReactorServer::port() const
+{
+	return _socket.address().port();
+}
+
+
+int HTTPReactorServer::workerThreads() const
+{
+	return _workers;
+}
+
+
+int HTTPReactorServer::totalConnections() const
+{
+	return _totalConnections;
+}
+
+
+int HTTPReactorServer::currentConnections() const
+{
+	return _currentConnections;
+}
+
+
+int HTTPReactorServer::totalRequests() const
+{
+	return _totalRequests;
+}
+
+
+int HTTPReactorServer::queuedRequests() const
+{
+	return _queue.size();
+}
+
+
+int HTTPReactorServer::refusedRequests() const
+{
+	return _refusedRequests;
+}
+
+
+void HTTPReactorServer::run()
+{
+	long idleTime = static_cast<long>(_pParams->getThreadIdleTime().totalMilliseconds());
+
+	while (!_stopped)
+	{
+		try
+		{
+			Poco::AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
+			if (pNf)
+			{
+				HTTPRequestNotification* pRNf = dynamic_cast<HTTPRequestNotification*>(pNf.get());
+				if (pRNf)
+				{
+					// keeps the connection alive until it has been closed
+					// or registered with the reactor again
+					HTTPReactorConnection::Ptr pConnection = pRNf->connection();
+					pConnection->process();
+				}
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+	if (--_workers == 0) _workersDone.set();
+}
+
+
+void HTTPReactorServer::onAccept(ReadableNotification* pNotification)
+{
+	pNotification->release();
+	StreamSocket socket = _socket.acceptConnection();
+	socket.setBlocking(false);
+	socket.setNoDelay(true);
+	++_totalConnections;
+	++_currentConnections;
+	new HTTPReactorConnection(socket, *this);
+}
+
+
+bool HTTPReactorServer::enqueue(HTTPReactorConnection* pConnection)
+{
+	if (_stopped) return false;
+
+	if (_queue.size() < _pParams->getMaxQueued())
+	{
+		++_totalRequests;
+		// the notification holds a reference to the connection
+		_queue.enqueueNotification(new HTTPRequestNotification(pConnection));
+		return true;
+	}
+	else
+	{
+		++_refusedRequests;
+		return false;
+	}
+}
+
+
+void HTTPReactorServer::connectionClosed()
+{
+	--_currentConnections;
+}
+
+
+} } // namespace Poco::Net
@@ -23,7 +23,10 @@ HTTPServerParams::HTTPServerParams():
 	_timeout(60000000),
 	_keepAlive(true),
 	_maxKeepAliveRequests(0),
-	_keepAliveTimeout(15000000)
+	_keepAliveTimeout(15000000),
+	_responseBatching(true),
+	_maxHeaderSize(65536),
+	_maxBodySize(1048576)
 {
 }
 
@@ -70,4 +73,23 @@ void HTTPServerParams::setMaxKeepAliveRequests(int maxKeepAliveRequests)
 }
 	
 
+void HTTPServerParams::setResponseBatching(bool batching)
+{
+	_responseBatching = batching;
+}
+
+
+void HTTPServerParams::setMaxHeaderSize(std::size_t size)
+{
+	poco_assert (size > 0);
+	_maxHeaderSize = size;
+}
+
+
+void HTTPServerParams::setMaxBodySize(std::size_t size)
+{
+	_maxBodySize = size;
+}
+
+
 } } // namespace Poco::Net
@@ -19,13 +19,22 @@ namespace Poco {
 namespace Net {
 
 
-HTTPServerRequest::HTTPServerRequest()
+HTTPServerRequest::HTTPServerRequest():
+	_pArena(0)
 {
 }
 
 
 HTTPServerRequest::~HTTPServerRequest()
 {
+	delete _pArena;
+}
+
+
+Poco::MonotonicArena& HTTPServerRequest::arena()
+{
+	if (!_pArena) _pArena = new Poco::MonotonicArena;
+	return *_pArena;
 }
 
 
@@ -16,6 +16,7 @@
 #include "Poco/Net/HTTPServerResponseImpl.h"
 #include "Poco/Net/HTTPServerSession.h"
 #include "Poco/Net/HTTPHeaderStream.h"
+#include "Poco/Net/HTTPHeaderParser.h"
 #include "Poco/Net/HTTPStream.h"
 #include "Poco/Net/HTTPFixedLengthStream.h"
 #include "Poco/Net/HTTPChunkedStream.h"
@@ -32,6 +33,7 @@ namespace Net {
 
 
 HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, HTTPServerSession& session, HTTPServerParams* pParams):
+	_arena(ARENA_CHUNK_SIZE),
 	_response(response),
 	_session(session),
 	_pStream(0),
@@ -39,31 +41,39 @@ HTTPServerRequestImpl::HTTPServerRequestImpl(HTTPServerResponseImpl& response, H
 {
 	response.attachRequest(this);
 
-	HTTPHeaderInputStream hs(session);
-	read(hs);
+	HTTPHeaderParser parser(getFieldLimit(), _arena);
+	if (session.readRequestHeader(parser))
+	{
+		parser.fill(*this);
+	}
+	else
+	{
+		HTTPHeaderInputStream hs(session);
+		read(hs);
+	}
 	
 	// Now that we know socket is still connected, obtain addresses
 	_clientAddress = session.clientAddress();
 	_serverAddress = session.serverAddress();
 	
 	if (getChunkedTransferEncoding())
-		_pStream = new HTTPChunkedInputStream(session);
+		_pStream = _arena.create<HTTPChunkedInputStream>(session);
 	else if (hasContentLength())
 #if defined(POCO_HAVE_INT64)
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength64());
+		_pStream = _arena.create<HTTPFixedLengthInputStream>(session, getContentLength64());
 #else
-		_pStream = new HTTPFixedLengthInputStream(session, getContentLength());
+		_pStream = _arena.create<HTTPFixedLengthInputStream>(session, getContentLength());
 #endif
 	else if (getMethod() == HTTPRequest::HTTP_GET || getMethod() == HTTPRequest::HTTP_HEAD || getMethod() == HTTPRequest::HTTP_DELETE)
-		_pStream = new HTTPFixedLengthInputStream(session, 0);
+		_pStream = _arena.create<HTTPFixedLengthInputStream>(session, 0);
 	else
-		_pStream = new HTTPInputStream(session);
+		_pStream = _arena.create<HTTPInputStream>(session);
 }
 
 
 HTTPServerRequestImpl::~HTTPServerRequestImpl()
 {
-	delete _pStream;
+	// the stream is destroyed by the arena
 }
 
 
@@ -28,6 +28,11 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#include "Poco/DateTimeParser.h"
+#include "Poco/DateTime.h"
+#include "Poco/NumberParser.h"
+#include "Poco/StringTokenizer.h"
+#include "Poco/Net/MultipartWriter.h"
 
 
 using Poco::File;
@@ -37,6 +42,9 @@ using Poco::StreamCopier;
 using Poco::OpenFileException;
 using Poco::DateTimeFormatter;
 using Poco::DateTimeFormat;
+using Poco::DateTimeParser;
+using Poco::NumberParser;
+using Poco::StringTokenizer;
 
 
 namespace Poco {
@@ -112,26 +120,89 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 	File f(path);
 	Timestamp dateTime    = f.getLastModified();
 	File::FileSize length = f.getSize();
-	set("Last-Modified", DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
-#if defined(POCO_HAVE_INT64)	
-	setContentLength64(length);
+	std::string lastModified = DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT);
+	std::string etag = entityTag(dateTime, length);
+	set("Last-Modified", lastModified);
+	set("ETag", etag);
+
+	Poco::FileInputStream istr(path);
+	if (!istr.good()) throw OpenFileException(path);
+
+	bool isGet = _pRequest && _pRequest->getMethod() == HTTPRequest::HTTP_GET;
+	bool isHead = _pRequest && _pRequest->getMethod() == HTTPRequest::HTTP_HEAD;
+	RangeVec ranges;
+	if ((isGet || isHead) && getStatus() == HTTPResponse::HTTP_OK)
+	{
+		if (notModified(etag, dateTime))
+		{
+			setStatusAndReason(HTTPResponse::HTTP_NOT_MODIFIED);
+			setChunkedTransferEncoding(false);
+			send();
+			return;
+		}
+		if (isGet && !parseRanges(etag, lastModified, length, ranges))
+		{
+			setStatusAndReason(HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+			set("Content-Range", "bytes */" + NumberFormatter::format(length));
+			setContentLength(0);
+			setChunkedTransferEncoding(false);
+			send();
+			return;
+		}
+	}
+	set("Accept-Ranges", "bytes");
+	setChunkedTransferEncoding(false);
+
+	std::string boundary;
+	Poco::UInt64 contentLength = length;
+	if (ranges.size() == 1)
+	{
+		setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+		set("Content-Range", contentRange(ranges[0], length));
+		contentLength = ranges[0].second - ranges[0].first + 1;
+		setContentType(mediaType);
+	}
+	else if (ranges.size() > 1)
+	{
+		setStatusAndReason(HTTPResponse::HTTP_PARTIAL_CONTENT);
+		boundary = MultipartWriter::createBoundary();
+		contentLength = 0;
+		for (RangeVec::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+		{
+			contentLength += partHeader(boundary, mediaType, *it, length).size() + it->second - it->first + 1;
+		}
+		contentLength += partTrailer(boundary).size();
+		setContentType("multipart/byteranges; boundary=" + boundary);
+	}
+	else setContentType(mediaType);
+#if defined(POCO_HAVE_INT64)
+	setContentLength64(contentLength);
 #else
-	setContentLength(static_cast<int>(length));
+	setContentLength(static_cast<int>(contentLength));
 #endif
-	setContentType(mediaType);
-	setChunkedTransferEncoding(false);
 
-	Poco::FileInputStream istr(path);
-	if (istr.good())
+	_pStream = new HTTPHeaderOutputStream(_session);
+	write(*_pStream);
+	if (isGet)
 	{
-		_pStream = new HTTPHeaderOutputStream(_session);
-		write(*_pStream);
-		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+		if (ranges.empty())
 		{
-			StreamCopier::copyStream(istr, *_pStream);
+			sendFileRange(istr, path, 0, length);
+		}
+		else if (ranges.size() == 1)
+		{
+			sendFileRange(istr, path, ranges[0].first, contentLength);
+		}
+		else
+		{
+			for (RangeVec::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+			{
+				*_pStream << partHeader(boundary, mediaType, *it, length);
+				sendFileRange(istr, path, it->first, it->second - it->first + 1);
+			}
+			*_pStream << partTrailer(boundary);
 		}
 	}
-	else throw OpenFileException(path);
 }
 
 
@@ -178,4 +249,145 @@ void HTTPServerResponseImpl::requireAuthentication(const std::string& realm)
 }
 
 
+void HTTPServerResponseImpl::sendFileRange(Poco::FileInputStream& istr, const std::string& path, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	// the header (and any previous output) must be on the
+	// wire before the file content is sent to the socket
+	_pStream->flush();
+	_session.flush();
+	if (count > 0)
+	{
+		Poco::Int64 n = _session.socket().sendFile(istr, offset, count);
+		if (n < 0 || static_cast<Poco::UInt64>(n) != count)
+			throw Poco::ReadFileException("File truncated while sending", path);
+	}
+}
+
+
+bool HTTPServerResponseImpl::notModified(const std::string& etag, const Poco::Timestamp& lastModified) const
+{
+	const std::string& ifNoneMatch = _pRequest->get("If-None-Match", "");
+	if (!ifNoneMatch.empty())
+	{
+		// weak comparison, as specified for If-None-Match
+		StringTokenizer tok(ifNoneMatch, ",", StringTokenizer::TOK_TRIM | StringTokenizer::TOK_IGNORE_EMPTY);
+		for (StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+		{
+			if (*it == "*" || *it == etag || *it == "W/" + etag) return true;
+		}
+		return false;
+	}
+
+	const std::string& ifModifiedSince = _pRequest->get("If-Modified-Since", "");
+	if (!ifModifiedSince.empty())
+	{
+		Poco::DateTime dateTime;
+		int tzd;
+		if (DateTimeParser::tryParse(ifModifiedSince, dateTime, tzd))
+		{
+			// HTTP dates have a resolution of one second
+			return lastModified.epochTime() <= dateTime.timestamp().epochTime();
+		}
+	}
+	return false;
+}
+
+
+bool HTTPServerResponseImpl::parseRanges(const std::string& etag, const std::string& lastModified, Poco::UInt64 length, RangeVec& ranges) const
+{
+	const std::string& range = _pRequest->get("Range", "");
+	if (range.compare(0, 6, "bytes=") != 0) return true;
+
+	// If-Range requires a strong validator match, otherwise
+	// the complete file is sent
+	const std::string& ifRange = _pRequest->get("If-Range", "");
+	if (!ifRange.empty() && ifRange != etag && ifRange != lastModified) return true;
+
+	StringTokenizer tok(range.substr(6), ",", StringTokenizer::TOK_TRIM | StringTokenizer::TOK_IGNORE_EMPTY);
+	if (tok.count() == 0 || tok.count() > MAX_RANGES) return true;
+	RangeVec result;
+	for (StringTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+	{
+		std::string::size_type pos = it->find('-');
+		if (pos == std::string::npos) return true;
+		std::string first = it->substr(0, pos);
+		std::string last  = it->substr(pos + 1);
+		Poco::UInt64 firstPos;
+		Poco::UInt64 lastPos;
+		if (first.empty())
+		{
+			// suffix range: the last N bytes
+			Poco::UInt64 suffix;
+			if (!NumberParser::tryParseUnsigned64(last, suffix)) return true;
+			if (suffix == 0 || length == 0) continue;
+			firstPos = suffix < length ? length - suffix : 0;
+			lastPos  = length - 1;
+		}
+		else
+		{
+			if (!NumberParser::tryParseUnsigned64(first, firstPos)) return true;
+			if (last.empty())
+			{
+				lastPos = length - 1;
+			}
+			else
+			{
+				if (!NumberParser::tryParseUnsigned64(last, lastPos) || lastPos < firstPos) return true;
+				if (lastPos >= length) lastPos = length - 1;
+			}
+			if (firstPos >= length) continue;
+		}
+		result.push_back(Range(firstPos, lastPos));
+	}
+	if (result.empty()) return false;
+	ranges.swap(result);
+	return true;
+}
+
+
+std::string HTTPServerResponseImpl::entityTag(const Poco::Timestamp& lastModified, Poco::UInt64 length)
+{
+	std::string etag("\"");
+	NumberFormatter::appendHex(etag, static_cast<Poco::UInt64>(lastModified.epochMicroseconds()));
+	etag += '-';
+	NumberFormatter::appendHex(etag, length);
+	etag += '"';
+	return etag;
+}
+
+
+std::string HTTPServerResponseImpl::contentRange(const Range& range, Poco::UInt64 length)
+{
+	std::string result("bytes ");
+	NumberFormatter::append(result, range.first);
+	result += '-';
+	NumberFormatter::append(result, range.second);
+	result += '/';
+	NumberFormatter::append(result, length);
+	return result;
+}
+
+
+std::string HTTPServerResponseImpl::partHeader(const std::string& boundary, const std::string& mediaType, const Range& range, Poco::UInt64 length)
+{
+	std::string result("\r\n--");
+	result += boundary;
+	result += "\r\nContent-Type: ";
+	result += mediaType;
+	result += "\r\nContent-Range: ";
+	result += contentRange(range, length);
+	result += "\r\n\r\n";
+	return result;
+}
+
+
+std::string HTTPServerResponseImpl::partTrailer(const std::string& boundary)
+{
+	std::string result("\r\n--");
+	result += boundary;
+	result += "--\r\n";
+	return result;
+}
+
+
 } } // namespace Poco::Net
@@ -13,6 +13,7 @@
 
 
 #include "Poco/Net/HTTPServerSession.h"
+#include "Poco/Net/NetException.h"
 
 
 namespace Poco {
@@ -28,11 +29,19 @@ HTTPServerSession::HTTPServerSession(const StreamSocket& socket, HTTPServerParam
 	setTimeout(pParams->getTimeout());
 	this->socket().setReceiveTimeout(pParams->getTimeout());
 	this->socket().setSendTimeout(pParams->getTimeout());
+	setWriteBatching(pParams->getResponseBatching());
 }
 
 
 HTTPServerSession::~HTTPServerSession()
 {
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+	}
 }
 
 
@@ -50,12 +59,46 @@ bool HTTPServerSession::hasMoreRequests()
 	{
 		if (_maxKeepAliveRequests > 0)
 			--_maxKeepAliveRequests;
-		return buffered() > 0 || socket().poll(_keepAliveTimeout, Socket::SELECT_READ);
+		if (buffered() > 0) return true;
+		flush();
+		return socket().poll(_keepAliveTimeout, Socket::SELECT_READ);
 	}
 	else return false;
 }
 
 
+bool HTTPServerSession::readRequestHeader(HTTPHeaderParser& parser)
+{
+	if (buffered() == 0)
+	{
+		try
+		{
+			refill();
+		}
+		catch (Poco::Exception&)
+		{
+			// like reading the header from the session's stream, which
+			// reports a peer reset or timeout as end of input; the
+			// exception is still available from networkException()
+			throw NoMessageException();
+		}
+		if (buffered() == 0) throw NoMessageException();
+	}
+
+	try
+	{
+		std::size_t length = parser.parseRequest(buffer(), buffer() + buffered());
+		if (length == 0) return false;
+		consume(static_cast<int>(length));
+		return true;
+	}
+	catch (MessageException&)
+	{
+		return false;
+	}
+}
+
+
 SocketAddress HTTPServerSession::clientAddress()
 {
 	return socket().peerAddress();
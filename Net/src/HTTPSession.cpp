@@ -33,7 +33,9 @@ HTTPSession::HTTPSession():
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
 	_sendTimeout(HTTP_DEFAULT_TIMEOUT),
-	_pException(0)
+	_pException(0),
+	_primedPos(0),
+	_writeBatching(false)
 {
 }
 
@@ -47,7 +49,9 @@ HTTPSession::HTTPSession(const StreamSocket& socket):
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
 	_sendTimeout(HTTP_DEFAULT_TIMEOUT),
-	_pException(0)
+	_pException(0),
+	_primedPos(0),
+	_writeBatching(false)
 {
 }
 
@@ -61,7 +65,9 @@ HTTPSession::HTTPSession(const StreamSocket& socket, bool keepAlive):
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
 	_sendTimeout(HTTP_DEFAULT_TIMEOUT),
-	_pException(0)
+	_pException(0),
+	_primedPos(0),
+	_writeBatching(false)
 {
 }
 
@@ -148,6 +154,15 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 {
 	try
 	{
+		if (_writeBatching && _pCurrent < _pEnd && _batch.size() + static_cast<std::size_t>(length) <= HTTP_MAX_BATCH_SIZE)
+		{
+			_batch.append(buffer, static_cast<std::size_t>(length));
+			return static_cast<int>(length);
+		}
+		else if (!_batch.empty())
+		{
+			return sendBatch(buffer, length);
+		}
 		return _socket.sendBytes(buffer, (int) length);
 	}
 	catch (Poco::Exception& exc)
@@ -160,8 +175,22 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 
 int HTTPSession::receive(char* buffer, int length)
 {
+	if (_primedPos < _primed.size())
+	{
+		std::size_t n = _primed.size() - _primedPos;
+		if (n > static_cast<std::size_t>(length)) n = static_cast<std::size_t>(length);
+		std::memcpy(buffer, _primed.data() + _primedPos, n);
+		_primedPos += n;
+		if (_primedPos == _primed.size())
+		{
+			_primed.clear();
+			_primedPos = 0;
+		}
+		return static_cast<int>(n);
+	}
 	try
 	{
+		if (!_batch.empty()) sendBatch(0, 0);
 		return _socket.receiveBytes(buffer, length);
 	}
 	catch (Poco::Exception& exc)
@@ -172,6 +201,72 @@ int HTTPSession::receive(char* buffer, int length)
 }
 
 
+void HTTPSession::flush()
+{
+	if (!_batch.empty())
+	{
+		try
+		{
+			sendBatch(0, 0);
+		}
+		catch (Poco::Exception& exc)
+		{
+			setException(exc);
+			throw;
+		}
+	}
+}
+
+
+int HTTPSession::sendBatch(const char* buffer, std::streamsize length)
+{
+	std::string batch;
+	batch.swap(_batch);
+	const std::size_t batchSize = batch.size();
+	std::size_t sent = 0;
+	if (length > 0 && _socket.secure())
+	{
+		// no vectored I/O through the TLS layer
+		batch.append(buffer, static_cast<std::size_t>(length));
+		buffer = batch.data() + batchSize;
+	}
+	else if (length > 0)
+	{
+		SocketBufVec buffers(2);
+		buffers[0] = Socket::makeBuffer(const_cast<char*>(batch.data()), batchSize);
+		buffers[1] = Socket::makeBuffer(const_cast<char*>(buffer), static_cast<std::size_t>(length));
+		int n = _socket.sendBytes(buffers);
+		if (n > 0) sent = static_cast<std::size_t>(n);
+	}
+
+	// the held back data has already been reported as
+	// written, so it must be sent before the given data
+	while (sent < batchSize)
+	{
+		int n = _socket.sendBytes(batch.data() + sent, static_cast<int>(batch.size() - sent));
+		if (n <= 0)
+		{
+			_batch.assign(batch, sent, batchSize - sent);
+			return 0;
+		}
+		sent += static_cast<std::size_t>(n);
+	}
+	sent -= batchSize;
+	if (sent < static_cast<std::size_t>(length))
+	{
+		int n = _socket.sendBytes(buffer + sent, static_cast<int>(length - sent));
+		if (n > 0) sent += static_cast<std::size_t>(n);
+	}
+	return static_cast<int>(sent);
+}
+
+
+void HTTPSession::setWriteBatching(bool batching)
+{
+	_writeBatching = batching;
+}
+
+
 void HTTPSession::refill()
 {
 	if (!_pBuffer)
@@ -211,6 +306,7 @@ void HTTPSession::connect(const SocketAddress& targetAddress, const SocketAddres
 
 void HTTPSession::abort()
 {
+	_batch.clear();
 	_socket.shutdown();
 	close();
 }
@@ -238,6 +334,7 @@ void HTTPSession::clearException()
 
 StreamSocket HTTPSession::detachSocket()
 {
+	flush();
 	StreamSocket oldSocket(_socket);
 	StreamSocket newSocket;
 	_socket = newSocket;
@@ -261,6 +358,23 @@ void HTTPSession::drainBuffer(Poco::Buffer<char>& buffer)
 {
 	buffer.assign(_pCurrent, static_cast<std::size_t>(_pEnd - _pCurrent));
 	_pCurrent = _pEnd;
+	if (_primedPos < _primed.size())
+	{
+		buffer.append(_primed.data() + _primedPos, _primed.size() - _primedPos);
+	}
+	_primed.clear();
+	_primedPos = 0;
+}
+
+
+void HTTPSession::primeBuffer(const char* buffer, std::size_t length)
+{
+	if (_primedPos > 0)
+	{
+		_primed.erase(0, _primedPos);
+		_primedPos = 0;
+	}
+	_primed.append(buffer, length);
 }
 
 
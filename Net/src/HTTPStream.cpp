@@ -109,7 +109,7 @@ HTTPStreamBuf* HTTPIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
+Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream), 0, 0, true);
 
 
 HTTPInputStream::HTTPInputStream(HTTPSession& session):
@@ -148,7 +148,7 @@ void HTTPInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
+Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream), 0, 0, true);
 
 
 HTTPOutputStream::HTTPOutputStream(HTTPSession& session):
@@ -14,6 +14,7 @@
 
 #include "Poco/Net/HTTPStreamFactory.h"
 #include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
 #include "Poco/Net/HTTPIOStream.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/HTTPResponse.h"
@@ -38,14 +39,16 @@ namespace Net {
 
 
 HTTPStreamFactory::HTTPStreamFactory():
-	_proxyPort(HTTPSession::HTTP_PORT)
+	_proxyPort(HTTPSession::HTTP_PORT),
+	_pPool(&HTTPClientSessionPool::defaultPool())
 {
 }
 
 
 HTTPStreamFactory::HTTPStreamFactory(const std::string& proxyHost, Poco::UInt16 proxyPort):
 	_proxyHost(proxyHost),
-	_proxyPort(proxyPort)
+	_proxyPort(proxyPort),
+	_pPool(&HTTPClientSessionPool::defaultPool())
 {
 }
 
@@ -54,7 +57,8 @@ HTTPStreamFactory::HTTPStreamFactory(const std::string& proxyHost, Poco::UInt16
 	_proxyHost(proxyHost),
 	_proxyPort(proxyPort),
 	_proxyUsername(proxyUsername),
-	_proxyPassword(proxyPassword)
+	_proxyPassword(proxyPassword),
+	_pPool(&HTTPClientSessionPool::defaultPool())
 {
 }
 
@@ -83,18 +87,25 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 		{
 			if (!pSession)
 			{
-				pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
-			
 				if (proxyUri.empty())
 				{
+					HTTPClientSession::ProxyConfig proxyConfig(HTTPClientSession::getGlobalProxyConfig());
 					if (!_proxyHost.empty())
 					{
-						pSession->setProxy(_proxyHost, _proxyPort);
-						pSession->setProxyCredentials(_proxyUsername, _proxyPassword);
+						proxyConfig.host = _proxyHost;
+						proxyConfig.port = _proxyPort;
+						proxyConfig.username = _proxyUsername;
+						proxyConfig.password = _proxyPassword;
 					}
+					if (_pPool)
+						pSession = _pPool->get(resolvedURI.getHost(), resolvedURI.getPort(), proxyConfig);
+					else
+						pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort(), proxyConfig);
 				}
 				else
 				{
+					// a proxy requested with 305 Use Proxy is only used for a single request
+					pSession = new HTTPClientSession(resolvedURI.getHost(), resolvedURI.getPort());
 					pSession->setProxy(proxyUri.getHost(), proxyUri.getPort());
 					if (!_proxyUsername.empty())
 					{
@@ -137,7 +148,7 @@ std::istream* HTTPStreamFactory::open(const URI& uri)
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_OK)
 			{
-				return new HTTPResponseStream(rs, pSession);
+				return new HTTPResponseStream(rs, pSession, proxyUri.empty() ? _pPool : 0);
 			}
 			else if (res.getStatus() == HTTPResponse::HTTP_USE_PROXY && !retry)
 			{
@@ -0,0 +1,488 @@
+//
+// IOUring.cpp
+//
+// Library: Net
+// Package: Sockets
+// Module:  IOUring
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/IOUring.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+
+
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#if defined(IORING_FEAT_EXT_ARG) && defined(IORING_FEAT_RSRC_TAGS) && defined(IORING_POLL_ADD_MULTI)
+#define POCO_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+
+#if defined(POCO_HAVE_IO_URING)
+#include <sys/mman.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_HAVE_IO_URING)
+
+
+namespace
+{
+	// IORING_FEAT_RSRC_TAGS was introduced in Linux 5.13, together
+	// with multishot poll, which has no feature flag of its own.
+	const unsigned REQUIRED_FEATURES = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS;
+
+	int ioUringSetup(unsigned entries, struct io_uring_params* pParams)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_setup, entries, pParams));
+	}
+
+	int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void* pArg, std::size_t argSize)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, pArg, argSize));
+	}
+
+	bool probe()
+	{
+		struct io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		int fd = ioUringSetup(2, &params);
+		if (fd < 0) return false;
+		::close(fd);
+		return (params.features & REQUIRED_FEATURES) == REQUIRED_FEATURES;
+	}
+}
+
+
+struct IOUring::Ring
+{
+	int                  fd;
+	void*                pRingMem;
+	std::size_t          ringSize;
+	struct io_uring_sqe* pSQEs;
+	std::size_t          sqesSize;
+	unsigned*            sqHead;
+	unsigned*            sqTail;
+	unsigned             sqMask;
+	unsigned             sqEntries;
+	unsigned*            cqHead;
+	unsigned*            cqTail;
+	unsigned             cqMask;
+	struct io_uring_cqe* pCQEs;
+
+	unsigned pending() const
+	{
+		return *sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+	}
+};
+
+
+IOUring::IOUring(unsigned entries):
+	_pRing(0)
+{
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	int fd = ioUringSetup(entries, &params);
+	if (fd < 0)
+	{
+		int err = errno;
+		if (err == ENOSYS || err == EPERM) throw Poco::NotImplementedException("io_uring is not available");
+		SocketImpl::error(err);
+	}
+	if ((params.features & REQUIRED_FEATURES) != REQUIRED_FEATURES)
+	{
+		::close(fd);
+		throw Poco::NotImplementedException("io_uring lacks required features");
+	}
+
+	std::size_t sqRingSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	std::size_t cqRingSize = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+	std::size_t ringSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+	void* pRingMem = ::mmap(0, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (pRingMem == MAP_FAILED)
+	{
+		int err = errno;
+		::close(fd);
+		SocketImpl::error(err);
+	}
+	std::size_t sqesSize = params.sq_entries*sizeof(struct io_uring_sqe);
+	void* pSQEs = ::mmap(0, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (pSQEs == MAP_FAILED)
+	{
+		int err = errno;
+		::munmap(pRingMem, ringSize);
+		::close(fd);
+		SocketImpl::error(err);
+	}
+
+	char* p = static_cast<char*>(pRingMem);
+	_pRing = new Ring;
+	_pRing->fd        = fd;
+	_pRing->pRingMem  = pRingMem;
+	_pRing->ringSize  = ringSize;
+	_pRing->pSQEs     = static_cast<struct io_uring_sqe*>(pSQEs);
+	_pRing->sqesSize  = sqesSize;
+	_pRing->sqHead    = reinterpret_cast<unsigned*>(p + params.sq_off.head);
+	_pRing->sqTail    = reinterpret_cast<unsigned*>(p + params.sq_off.tail);
+	_pRing->sqMask    = *reinterpret_cast<unsigned*>(p + params.sq_off.ring_mask);
+	_pRing->sqEntries = *reinterpret_cast<unsigned*>(p + params.sq_off.ring_entries);
+	_pRing->cqHead    = reinterpret_cast<unsigned*>(p + params.cq_off.head);
+	_pRing->cqTail    = reinterpret_cast<unsigned*>(p + params.cq_off.tail);
+	_pRing->cqMask    = *reinterpret_cast<unsigned*>(p + params.cq_off.ring_mask);
+	_pRing->pCQEs     = reinterpret_cast<struct io_uring_cqe*>(p + params.cq_off.cqes);
+
+	// submission queue entries are always used in order
+	unsigned* sqArray = reinterpret_cast<unsigned*>(p + params.sq_off.array);
+	for (unsigned i = 0; i < _pRing->sqEntries; ++i) sqArray[i] = i;
+}
+
+
+IOUring::~IOUring()
+{
+	::munmap(_pRing->pSQEs, _pRing->sqesSize);
+	::munmap(_pRing->pRingMem, _pRing->ringSize);
+	::close(_pRing->fd);
+	delete _pRing;
+}
+
+
+void IOUring::poll(poco_socket_t fd, int mode, Poco::UInt64 userData, bool multiShot)
+{
+	Poco::UInt32 events = 0;
+	if (mode & PollSet::POLL_READ)
+		events |= POLLIN;
+	if (mode & PollSet::POLL_WRITE)
+		events |= POLLOUT;
+	if (mode & PollSet::POLL_ERROR)
+		events |= POLLERR;
+#if defined(POCO_ARCH_BIG_ENDIAN)
+	events = (events << 16) | (events >> 16);
+#endif
+
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_POLL_ADD, fd, userData));
+	pSQE->poll32_events = events;
+	if (multiShot) pSQE->len = IORING_POLL_ADD_MULTI;
+	commit();
+}
+
+
+void IOUring::removePoll(Poco::UInt64 target, Poco::UInt64 userData)
+{
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_POLL_REMOVE, -1, userData));
+	pSQE->addr = target;
+	commit();
+}
+
+
+void IOUring::receive(const StreamSocket& socket, void* buffer, int length, Poco::UInt64 userData, int flags)
+{
+	poco_assert (length >= 0);
+
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_RECV, socket.impl()->sockfd(), userData));
+	pSQE->addr = reinterpret_cast<Poco::UInt64>(buffer);
+	pSQE->len = static_cast<Poco::UInt32>(length);
+	pSQE->msg_flags = static_cast<Poco::UInt32>(flags);
+	commit();
+}
+
+
+void IOUring::send(const StreamSocket& socket, const void* buffer, int length, Poco::UInt64 userData, int flags)
+{
+	poco_assert (length >= 0);
+
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_SEND, socket.impl()->sockfd(), userData));
+	pSQE->addr = reinterpret_cast<Poco::UInt64>(buffer);
+	pSQE->len = static_cast<Poco::UInt32>(length);
+	pSQE->msg_flags = static_cast<Poco::UInt32>(flags | MSG_NOSIGNAL);
+	commit();
+}
+
+
+void IOUring::accept(const ServerSocket& socket, Poco::UInt64 userData)
+{
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	prepare(IORING_OP_ACCEPT, socket.impl()->sockfd(), userData);
+	commit();
+}
+
+
+void IOUring::connect(const StreamSocket& socket, const SocketAddress& address, Poco::UInt64 userData)
+{
+	poco_socket_t fd = socket.impl()->sockfd();
+	if (fd == POCO_INVALID_SOCKET) throw InvalidSocketException("socket must be created before connecting");
+
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_CONNECT, fd, userData));
+	pSQE->addr = reinterpret_cast<Poco::UInt64>(address.addr());
+	pSQE->off = address.length();
+	commit();
+}
+
+
+void IOUring::cancel(Poco::UInt64 target, Poco::UInt64 userData)
+{
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	struct io_uring_sqe* pSQE = static_cast<struct io_uring_sqe*>(prepare(IORING_OP_ASYNC_CANCEL, -1, userData));
+	pSQE->addr = target;
+	commit();
+}
+
+
+int IOUring::submit()
+{
+	Poco::FastMutex::ScopedLock lock(_sqMutex);
+
+	unsigned pending = _pRing->pending();
+	submitImpl();
+	return static_cast<int>(pending - _pRing->pending());
+}
+
+
+int IOUring::wait(const Poco::Timespan& timeout, CompletionVec& completions)
+{
+	completions.clear();
+
+	Poco::Timespan remainingTime(timeout);
+	for (;;)
+	{
+		struct __kernel_timespec ts;
+		ts.tv_sec = static_cast<Poco::Int64>(remainingTime.totalSeconds());
+		ts.tv_nsec = static_cast<Poco::Int64>(remainingTime.useconds())*1000;
+		struct io_uring_getevents_arg arg;
+		std::memset(&arg, 0, sizeof(arg));
+		arg.ts = reinterpret_cast<Poco::UInt64>(&ts);
+
+		// Entries up to the published tail are complete, so they can
+		// be submitted without holding the submission queue mutex.
+		Poco::Timestamp start;
+		int rc = ioUringEnter(_pRing->fd, _pRing->pending(), 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+		if (rc >= 0) break;
+		int err = errno;
+		if (err == ETIME || err == EBUSY || err == EAGAIN) break;
+		if (err != EINTR) SocketImpl::error(err);
+
+		Poco::Timestamp end;
+		Poco::Timespan waited = end - start;
+		if (waited < remainingTime)
+			remainingTime -= waited;
+		else
+			remainingTime = 0;
+	}
+
+	Poco::FastMutex::ScopedLock lock(_cqMutex);
+
+	unsigned head = *_pRing->cqHead;
+	unsigned tail = __atomic_load_n(_pRing->cqTail, __ATOMIC_ACQUIRE);
+	for (; head != tail; ++head)
+	{
+		const struct io_uring_cqe& cqe = _pRing->pCQEs[head & _pRing->cqMask];
+		Completion completion;
+		completion.userData = cqe.user_data;
+		completion.result = cqe.res;
+		completion.flags = cqe.flags;
+		completions.push_back(completion);
+	}
+	__atomic_store_n(_pRing->cqHead, head, __ATOMIC_RELEASE);
+
+	return static_cast<int>(completions.size());
+}
+
+
+int IOUring::pollMode(int result)
+{
+	int mode = 0;
+	if (result < 0)
+		return PollSet::POLL_ERROR;
+	if (result & POLLIN)
+		mode |= PollSet::POLL_READ;
+	if (result & POLLOUT)
+		mode |= PollSet::POLL_WRITE;
+	if (result & POLLERR)
+		mode |= PollSet::POLL_ERROR;
+	return mode;
+}
+
+
+bool IOUring::available()
+{
+	static const bool avail = probe();
+	return avail;
+}
+
+
+void* IOUring::prepare(int opcode, int fd, Poco::UInt64 userData)
+{
+	if (*_pRing->sqTail - __atomic_load_n(_pRing->sqHead, __ATOMIC_ACQUIRE) == _pRing->sqEntries)
+	{
+		submitImpl();
+		if (_pRing->pending() == _pRing->sqEntries)
+			throw Poco::IOException("io_uring submission queue is full");
+	}
+	struct io_uring_sqe* pSQE = &_pRing->pSQEs[*_pRing->sqTail & _pRing->sqMask];
+	std::memset(pSQE, 0, sizeof(struct io_uring_sqe));
+	pSQE->opcode = static_cast<Poco::UInt8>(opcode);
+	pSQE->fd = fd;
+	pSQE->user_data = userData;
+	return pSQE;
+}
+
+
+void IOUring::commit()
+{
+	// publish the entry returned by prepare() to the kernel
+	__atomic_store_n(_pRing->sqTail, *_pRing->sqTail + 1, __ATOMIC_RELEASE);
+}
+
+
+void IOUring::submitImpl()
+{
+	unsigned pending = _pRing->pending();
+	while (pending > 0)
+	{
+		int rc = ioUringEnter(_pRing->fd, pending, 0, 0, 0, 0);
+		if (rc >= 0) break;
+		int err = errno;
+		// the completion queue is full; submission must be retried after
+		// completions have been collected by wait()
+		if (err == EBUSY || err == EAGAIN) break;
+		if (err != EINTR) SocketImpl::error(err);
+		pending = _pRing->pending();
+	}
+}
+
+
+#else
+
+
+IOUring::IOUring(unsigned):
+	_pRing(0)
+{
+	throw Poco::NotImplementedException("io_uring is not available");
+}
+
+
+IOUring::~IOUring()
+{
+}
+
+
+void IOUring::poll(poco_socket_t, int, Poco::UInt64, bool)
+{
+	throw Poco::NotImplementedException("IOUring::poll()");
+}
+
+
+void IOUring::removePoll(Poco::UInt64, Poco::UInt64)
+{
+	throw Poco::NotImplementedException("IOUring::removePoll()");
+}
+
+
+void IOUring::receive(const StreamSocket&, void*, int, Poco::UInt64, int)
+{
+	throw Poco::NotImplementedException("IOUring::receive()");
+}
+
+
+void IOUring::send(const StreamSocket&, const void*, int, Poco::UInt64, int)
+{
+	throw Poco::NotImplementedException("IOUring::send()");
+}
+
+
+void IOUring::accept(const ServerSocket&, Poco::UInt64)
+{
+	throw Poco::NotImplementedException("IOUring::accept()");
+}
+
+
+void IOUring::connect(const StreamSocket&, const SocketAddress&, Poco::UInt64)
+{
+	throw Poco::NotImplementedException("IOUring::connect()");
+}
+
+
+void IOUring::cancel(Poco::UInt64, Poco::UInt64)
+{
+	throw Poco::NotImplementedException("IOUring::cancel()");
+}
+
+
+int IOUring::submit()
+{
+	throw Poco::NotImplementedException("IOUring::submit()");
+}
+
+
+int IOUring::wait(const Poco::Timespan&, CompletionVec&)
+{
+	throw Poco::NotImplementedException("IOUring::wait()");
+}
+
+
+int IOUring::pollMode(int)
+{
+	throw Poco::NotImplementedException("IOUring::pollMode()");
+}
+
+
+bool IOUring::available()
+{
+	return false;
+}
+
+
+void* IOUring::prepare(int, int, Poco::UInt64)
+{
+	return 0;
+}
+
+
+void IOUring::commit()
+{
+}
+
+
+void IOUring::submitImpl()
+{
+}
+
+
+#endif // POCO_HAVE_IO_URING
+
+
+} } // namespace Poco::Net
@@ -17,6 +17,7 @@
 #endif
 #include "Poco/Net/PollSet.h"
 #include "Poco/Net/SocketImpl.h"
+#include "Poco/Net/IOUring.h"
 #include "Poco/Mutex.h"
 #include <set>
 
@@ -49,12 +50,34 @@ namespace Net {
 
 
 //
-// Linux implementation using epoll
+// On Linux, the implementation (epoll or io_uring) is selected at runtime
 //
 class PollSetImpl
 {
 public:
-	PollSetImpl():
+	virtual ~PollSetImpl()
+	{
+	}
+
+	virtual void add(const Socket& socket, int mode) = 0;
+	virtual void remove(const Socket& socket) = 0;
+	virtual bool has(const Socket& socket) const = 0;
+	virtual bool empty() const = 0;
+	virtual void update(const Socket& socket, int mode) = 0;
+	virtual void clear() = 0;
+	virtual PollSet::SocketModeMap poll(const Poco::Timespan& timeout) = 0;
+	virtual int poll(const Poco::Timespan& timeout, PollSet::EventVec& events) = 0;
+	virtual PollSet::Backend backend() const = 0;
+};
+
+
+//
+// Linux implementation using epoll
+//
+class EPollSetImpl: public PollSetImpl
+{
+public:
+	EPollSetImpl():
 		_epollfd(-1),
 		_events(1024)
 	{
@@ -65,7 +88,7 @@ public:
 		}
 	}
 
-	~PollSetImpl()
+	~EPollSetImpl()
 	{
 		if (_epollfd >= 0)
 			::close(_epollfd);
@@ -75,17 +98,10 @@ public:
 	{
 		Poco::FastMutex::ScopedLock lock(_mutex);
 
-		SocketImpl* sockImpl = socket.impl();
-		poco_socket_t fd = sockImpl->sockfd();
+		poco_socket_t fd = socket.impl()->sockfd();
 		struct epoll_event ev;
-		ev.events = 0;
-		if (mode & PollSet::POLL_READ)
-			ev.events |= EPOLLIN;
-		if (mode & PollSet::POLL_WRITE)
-			ev.events |= EPOLLOUT;
-		if (mode & PollSet::POLL_ERROR)
-			ev.events |= EPOLLERR;
-		ev.data.ptr = socket.impl();
+		ev.events = epollEvents(mode);
+		ev.data.fd = fd;
 		int err = epoll_ctl(_epollfd, EPOLL_CTL_ADD, fd, &ev);
 
 		if (err)
@@ -94,8 +110,8 @@ public:
 			else SocketImpl::error();
 		}
 
-		if (_socketMap.find(sockImpl) == _socketMap.end())
-			_socketMap[sockImpl] = socket;
+		if (_socketMap.find(fd) == _socketMap.end())
+			_socketMap[fd] = socket;
 	}
 
 	void remove(const Socket& socket)
@@ -109,7 +125,7 @@ public:
 		int err = epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
 		if (err) SocketImpl::error();
 
-		_socketMap.erase(socket.impl());
+		_socketMap.erase(fd);
 	}
 
 	bool has(const Socket& socket) const
@@ -117,7 +133,7 @@ public:
 		Poco::FastMutex::ScopedLock lock(_mutex);
 		SocketImpl* sockImpl = socket.impl();
 		return sockImpl &&
-			(_socketMap.find(sockImpl) != _socketMap.end());
+			(_socketMap.find(sockImpl->sockfd()) != _socketMap.end());
 	}
 
 	bool empty() const
@@ -130,14 +146,8 @@ public:
 	{
 		poco_socket_t fd = socket.impl()->sockfd();
 		struct epoll_event ev;
-		ev.events = 0;
-		if (mode & PollSet::POLL_READ)
-			ev.events |= EPOLLIN;
-		if (mode & PollSet::POLL_WRITE)
-			ev.events |= EPOLLOUT;
-		if (mode & PollSet::POLL_ERROR)
-			ev.events |= EPOLLERR;
-		ev.data.ptr = socket.impl();
+		ev.events = epollEvents(mode);
+		ev.data.fd = fd;
 		int err = epoll_ctl(_epollfd, EPOLL_CTL_MOD, fd, &ev);
 		if (err)
 		{
@@ -162,9 +172,51 @@ public:
 	{
 		PollSet::SocketModeMap result;
 
+		int rc = wait(timeout);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (int i = 0; i < rc; i++)
+		{
+			std::map<poco_socket_t, Socket>::iterator it = _socketMap.find(_events[i].data.fd);
+			if (it != _socketMap.end())
+			{
+				int mode = pollMode(_events[i].events);
+				if (mode) result[it->second] |= mode;
+			}
+		}
+
+		return result;
+	}
+
+	int poll(const Poco::Timespan& timeout, PollSet::EventVec& events)
+	{
+		events.clear();
+
+		int rc = wait(timeout);
+
+		for (int i = 0; i < rc; i++)
+		{
+			PollSet::Event ev;
+			ev.fd = _events[i].data.fd;
+			ev.mode = pollMode(_events[i].events);
+			if (ev.mode) events.push_back(ev);
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+	PollSet::Backend backend() const
+	{
+		return PollSet::BACKEND_NATIVE;
+	}
+
+private:
+	int wait(const Poco::Timespan& timeout)
+	{
 		{
 			Poco::FastMutex::ScopedLock lock(_mutex);
-			if(_socketMap.empty()) return result;
+			if (_socketMap.empty()) return 0;
 		}
 
 		Poco::Timespan remainingTime(timeout);
@@ -185,34 +237,315 @@ public:
 		}
 		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
 		if (rc < 0) SocketImpl::error();
+		return rc;
+	}
 
+	static Poco::UInt32 epollEvents(int mode)
+	{
+		Poco::UInt32 events = 0;
+		if (mode & PollSet::POLL_READ)
+			events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			events |= EPOLLERR;
+		if (mode & PollSet::POLL_EDGE)
+			events |= EPOLLET;
+		if (mode & PollSet::POLL_ONESHOT)
+			events |= EPOLLONESHOT;
+		return events;
+	}
+
+	static int pollMode(Poco::UInt32 events)
+	{
+		int mode = 0;
+		if (events & EPOLLIN)
+			mode |= PollSet::POLL_READ;
+		if (events & EPOLLOUT)
+			mode |= PollSet::POLL_WRITE;
+		if (events & EPOLLERR)
+			mode |= PollSet::POLL_ERROR;
+		return mode;
+	}
+
+	mutable Poco::FastMutex         _mutex;
+	int                             _epollfd;
+	std::map<poco_socket_t, Socket> _socketMap;
+	std::vector<struct epoll_event> _events;
+};
+
+
+//
+// Linux implementation using io_uring
+//
+class IOUringPollSetImpl: public PollSetImpl
+{
+public:
+	IOUringPollSetImpl():
+		_ring(RING_ENTRIES),
+		_generation(0),
+		_cycle(0)
+	{
+	}
+
+	~IOUringPollSetImpl()
+	{
+	}
+
+	void add(const Socket& socket, int mode)
+	{
 		Poco::FastMutex::ScopedLock lock(_mutex);
 
-		for (int i = 0; i < rc; i++)
+		poco_socket_t fd = socket.impl()->sockfd();
+		EntryMap::iterator it = _entryMap.find(fd);
+		if (it == _entryMap.end())
 		{
-			std::map<void*, Socket>::iterator it = _socketMap.find(_events[i].data.ptr);
-			if (it != _socketMap.end())
+			it = _entryMap.insert(EntryMap::value_type(fd, Entry())).first;
+			it->second.socket = socket;
+		}
+		arm(fd, it->second, mode);
+		_ring.submit();
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		poco_socket_t fd = socket.impl()->sockfd();
+		EntryMap::iterator it = _entryMap.find(fd);
+		if (it != _entryMap.end())
+		{
+			disarm(fd, it->second);
+			_entryMap.erase(it);
+			_ring.submit();
+		}
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		SocketImpl* sockImpl = socket.impl();
+		return sockImpl &&
+			(_entryMap.find(sockImpl->sockfd()) != _entryMap.end());
+	}
+
+	bool empty() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		return _entryMap.empty();
+	}
+
+	void update(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		poco_socket_t fd = socket.impl()->sockfd();
+		EntryMap::iterator it = _entryMap.find(fd);
+		if (it == _entryMap.end()) SocketImpl::error(ENOENT);
+		arm(fd, it->second, mode);
+		_ring.submit();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (EntryMap::iterator it = _entryMap.begin(); it != _entryMap.end(); ++it)
+		{
+			disarm(it->first, it->second);
+		}
+		_entryMap.clear();
+		_rearmList.clear();
+		_ring.submit();
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		PollSet::EventVec events;
+
+		poll(timeout, events);
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (PollSet::EventVec::const_iterator it = events.begin(); it != events.end(); ++it)
+		{
+			EntryMap::const_iterator itEntry = _entryMap.find(it->fd);
+			if (itEntry != _entryMap.end())
+				result[itEntry->second.socket] |= it->mode;
+		}
+
+		return result;
+	}
+
+	int poll(const Poco::Timespan& timeout, PollSet::EventVec& events)
+	{
+		events.clear();
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_entryMap.empty()) return 0;
+
+			// Level-triggered sockets are re-armed only now, after the
+			// events of the previous poll() have been handled. If they
+			// were re-armed earlier, a socket that has been drained by
+			// its event handler would still be reported as readable.
+			for (std::vector<poco_socket_t>::const_iterator it = _rearmList.begin(); it != _rearmList.end(); ++it)
 			{
-				if (_events[i].events & EPOLLIN)
-					result[it->second] |= PollSet::POLL_READ;
-				if (_events[i].events & EPOLLOUT)
-					result[it->second] |= PollSet::POLL_WRITE;
-				if (_events[i].events & EPOLLERR)
-					result[it->second] |= PollSet::POLL_ERROR;
+				EntryMap::iterator itEntry = _entryMap.find(*it);
+				if (itEntry != _entryMap.end() && itEntry->second.rearm)
+					arm(itEntry->first, itEntry->second, itEntry->second.mode);
 			}
+			_rearmList.clear();
 		}
 
-		return result;
+		// the re-arm requests are submitted together with the wait
+		Poco::Timespan remainingTime(timeout);
+		for (;;)
+		{
+			Poco::Timestamp start;
+			if (_ring.wait(remainingTime, _completions) == 0) break;
+			handleCompletions(events);
+			if (!events.empty()) break;
+
+			// only completions of removed poll requests; keep waiting
+			Poco::Timestamp end;
+			Poco::Timespan waited = end - start;
+			if (waited < remainingTime)
+				remainingTime -= waited;
+			else
+				break;
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+	PollSet::Backend backend() const
+	{
+		return PollSet::BACKEND_IO_URING;
 	}
 
 private:
-	mutable Poco::FastMutex         _mutex;
-	int                             _epollfd;
-	std::map<void*, Socket>         _socketMap;
-	std::vector<struct epoll_event> _events;
+	enum
+	{
+		RING_ENTRIES = 1024
+	};
+
+	struct Entry
+	{
+		Entry():
+			mode(0),
+			generation(0),
+			armed(false),
+			rearm(false),
+			cycle(0),
+			eventIndex(0)
+		{
+		}
+
+		Socket       socket;
+		int          mode;
+		Poco::UInt32 generation; /// identifies the current poll request, 0 is not used
+		bool         armed;      /// a poll request is active
+		bool         rearm;      /// the socket is in the re-arm list
+		Poco::UInt32 cycle;      /// the last poll() cycle an event was reported in
+		std::size_t  eventIndex; /// the index of that event
+	};
+
+	typedef std::map<poco_socket_t, Entry> EntryMap;
+
+	void arm(poco_socket_t fd, Entry& entry, int mode)
+	{
+		disarm(fd, entry);
+		if (++_generation == 0) ++_generation;
+		entry.mode = mode;
+		entry.generation = _generation;
+		entry.armed = true;
+		entry.rearm = false;
+		bool multiShot = (mode & PollSet::POLL_EDGE) && !(mode & PollSet::POLL_ONESHOT);
+		_ring.poll(fd, mode, userData(fd, entry.generation), multiShot);
+	}
+
+	void disarm(poco_socket_t fd, Entry& entry)
+	{
+		if (entry.armed)
+		{
+			_ring.removePoll(userData(fd, entry.generation), 0);
+			entry.armed = false;
+		}
+		entry.rearm = false;
+	}
+
+	void handleCompletions(PollSet::EventVec& events)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		++_cycle;
+		for (IOUring::CompletionVec::const_iterator it = _completions.begin(); it != _completions.end(); ++it)
+		{
+			// completions of poll removals, and of poll requests that have
+			// been replaced or removed in the meantime, are ignored
+			if (it->userData == 0) continue;
+			poco_socket_t fd = static_cast<poco_socket_t>(it->userData & 0xFFFFFFFF);
+			EntryMap::iterator itEntry = _entryMap.find(fd);
+			if (itEntry == _entryMap.end() || itEntry->second.generation != static_cast<Poco::UInt32>(it->userData >> 32)) continue;
+
+			Entry& entry = itEntry->second;
+			if (!(it->flags & IOUring::MORE))
+			{
+				entry.armed = false;
+				if (it->result == -ECANCELED) continue;
+				if (!(entry.mode & PollSet::POLL_ONESHOT))
+				{
+					entry.rearm = true;
+					_rearmList.push_back(fd);
+				}
+			}
+
+			int mode = IOUring::pollMode(it->result);
+			if (mode == 0) continue;
+			if (entry.cycle == _cycle)
+			{
+				// multishot poll requests may complete more than once
+				events[entry.eventIndex].mode |= mode;
+			}
+			else
+			{
+				PollSet::Event ev;
+				ev.fd = fd;
+				ev.mode = mode;
+				entry.cycle = _cycle;
+				entry.eventIndex = events.size();
+				events.push_back(ev);
+			}
+		}
+	}
+
+	static Poco::UInt64 userData(poco_socket_t fd, Poco::UInt32 generation)
+	{
+		return (static_cast<Poco::UInt64>(generation) << 32) | static_cast<Poco::UInt32>(fd);
+	}
+
+	mutable Poco::FastMutex    _mutex;
+	IOUring                    _ring;
+	EntryMap                   _entryMap;
+	std::vector<poco_socket_t> _rearmList;
+	IOUring::CompletionVec     _completions;
+	Poco::UInt32               _generation;
+	Poco::UInt32               _cycle;
 };
 
 
+PollSetImpl* createPollSetImpl(PollSet::Backend backend)
+{
+	if (backend == PollSet::BACKEND_IO_URING && IOUring::available())
+		return new IOUringPollSetImpl;
+	else
+		return new EPollSetImpl;
+}
+
+
 #elif defined(POCO_HAVE_FD_POLL)
 
 
@@ -287,6 +620,63 @@ public:
 	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
 	{
 		PollSet::SocketModeMap result;
+
+		if (wait(timeout) <= 0) return result;
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (!_socketMap.empty())
+			{
+				for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
+				{
+					std::map<poco_socket_t, Socket>::const_iterator its = _socketMap.find(it->fd);
+					if (its != _socketMap.end())
+					{
+						int mode = pollMode(it->revents);
+						if (mode) result[its->second] |= mode;
+					}
+					it->revents = 0;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	int poll(const Poco::Timespan& timeout, PollSet::EventVec& events)
+	{
+		events.clear();
+
+		if (wait(timeout) <= 0) return 0;
+
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
+			{
+				if (_socketMap.find(it->fd) != _socketMap.end())
+				{
+					PollSet::Event ev;
+					ev.fd = it->fd;
+					ev.mode = pollMode(it->revents);
+					if (ev.mode) events.push_back(ev);
+				}
+				it->revents = 0;
+			}
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+	PollSet::Backend backend() const
+	{
+		return PollSet::BACKEND_NATIVE;
+	}
+
+private:
+	int wait(const Poco::Timespan& timeout)
+	{
 		{
 			Poco::FastMutex::ScopedLock lock(_mutex);
 
@@ -320,7 +710,7 @@ public:
 			_addMap.clear();
 		}
 
-		if (_pollfds.empty()) return result;
+		if (_pollfds.empty()) return 0;
 
 		Poco::Timespan remainingTime(timeout);
 		int rc;
@@ -344,37 +734,25 @@ public:
 		}
 		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
 		if (rc < 0) SocketImpl::error();
+		return rc;
+	}
 
-		{
-			Poco::FastMutex::ScopedLock lock(_mutex);
-
-			if (!_socketMap.empty())
-			{
-				for (std::vector<pollfd>::iterator it = _pollfds.begin(); it != _pollfds.end(); ++it)
-				{
-					std::map<poco_socket_t, Socket>::const_iterator its = _socketMap.find(it->fd);
-					if (its != _socketMap.end())
-					{
-						if (it->revents & POLLIN)
-							result[its->second] |= PollSet::POLL_READ;
-						if (it->revents & POLLOUT)
-							result[its->second] |= PollSet::POLL_WRITE;
-						if (it->revents & POLLERR)
-							result[its->second] |= PollSet::POLL_ERROR;
+	static int pollMode(short revents)
+	{
+		int mode = 0;
+		if (revents & POLLIN)
+			mode |= PollSet::POLL_READ;
+		if (revents & POLLOUT)
+			mode |= PollSet::POLL_WRITE;
+		if (revents & POLLERR)
+			mode |= PollSet::POLL_ERROR;
 #ifdef _WIN32
-						if (it->revents & POLLHUP)
-							result[its->second] |= PollSet::POLL_READ;
+		if (revents & POLLHUP)
+			mode |= PollSet::POLL_READ;
 #endif
-					}
-					it->revents = 0;
-				}
-			}
-		}
-
-		return result;
+		return mode;
 	}
 
-private:
 	mutable Poco::FastMutex         _mutex;
 	std::map<poco_socket_t, Socket> _socketMap;
 	std::map<poco_socket_t, int>    _addMap;
@@ -517,6 +895,27 @@ public:
 		return result;
 	}
 
+	int poll(const Poco::Timespan& timeout, PollSet::EventVec& events)
+	{
+		events.clear();
+
+		PollSet::SocketModeMap result = poll(timeout);
+		for (PollSet::SocketModeMap::const_iterator it = result.begin(); it != result.end(); ++it)
+		{
+			PollSet::Event ev;
+			ev.fd = it->first.impl()->sockfd();
+			ev.mode = it->second;
+			events.push_back(ev);
+		}
+
+		return static_cast<int>(events.size());
+	}
+
+	PollSet::Backend backend() const
+	{
+		return PollSet::BACKEND_NATIVE;
+	}
+
 private:
 	mutable Poco::FastMutex _mutex;
 	PollSet::SocketModeMap  _map;
@@ -526,8 +925,29 @@ private:
 #endif
 
 
+#if !defined(POCO_HAVE_FD_EPOLL)
+
+
+PollSetImpl* createPollSetImpl(PollSet::Backend)
+{
+	return new PollSetImpl;
+}
+
+
+#endif
+
+
+PollSet::Backend PollSet::_defaultBackend(PollSet::BACKEND_NATIVE);
+
+
 PollSet::PollSet():
-	_pImpl(new PollSetImpl)
+	_pImpl(createPollSetImpl(_defaultBackend))
+{
+}
+
+
+PollSet::PollSet(Backend backend):
+	_pImpl(createPollSetImpl(backend))
 {
 }
 
@@ -580,4 +1000,28 @@ PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
 }
 
 
+int PollSet::poll(const Poco::Timespan& timeout, EventVec& events)
+{
+	return _pImpl->poll(timeout, events);
+}
+
+
+PollSet::Backend PollSet::backend() const
+{
+	return _pImpl->backend();
+}
+
+
+void PollSet::setDefaultBackend(Backend backend)
+{
+	_defaultBackend = backend;
+}
+
+
+PollSet::Backend PollSet::getDefaultBackend()
+{
+	return _defaultBackend;
+}
+
+
 } } // namespace Poco::Net
@@ -17,6 +17,9 @@
 #include "Poco/Net/StreamSocketImpl.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
+#include "Poco/FileStream.h"
+#include "Poco/Buffer.h"
+#include <algorithm>
 #include <string.h> // FD_SET needs memset on some platforms, so we can't use <cstring>
 
 
@@ -51,6 +54,16 @@
 #endif
 
 
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/sendfile.h>
+#endif
+#endif
+
+
 using Poco::IOException;
 using Poco::TimeoutException;
 using Poco::InvalidArgumentException;
@@ -62,6 +75,28 @@ namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	inline char* bufferData(const SocketBuf& buf)
+	{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		return buf.buf;
+#else
+		return static_cast<char*>(buf.iov_base);
+#endif
+	}
+
+	inline int bufferLength(const SocketBuf& buf)
+	{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		return static_cast<int>(buf.len);
+#else
+		return static_cast<int>(buf.iov_len);
+#endif
+	}
+}
+
+
 bool checkIsBrokenTimeout()
 {
 #if defined(POCO_BROKEN_TIMEOUTS)
@@ -362,6 +397,119 @@ int SocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
 }
 
 
+Poco::Int64 SocketImpl::sendFile(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+
+#if POCO_OS == POCO_OS_LINUX
+	if (!secure())
+	{
+		int fd = fileInputStream.nativeHandle();
+		if (fd == -1) throw InvalidArgumentException("File is not open");
+
+		Poco::UInt64 sent = 0;
+		while (sent < count)
+		{
+			checkBrokenTimeout(SELECT_WRITE);
+
+			off_t pos = static_cast<off_t>(offset + sent);
+			std::size_t length = static_cast<std::size_t>(std::min<Poco::UInt64>(count - sent, SENDFILE_CHUNK_SIZE));
+			ssize_t rc = ::sendfile(_sockfd, fd, &pos, length);
+			if (rc < 0)
+			{
+				int err = lastError();
+				if (err == POCO_EINTR && _blocking)
+					continue;
+				else if (err == POCO_EAGAIN && !_blocking)
+					break;
+				else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+					throw TimeoutException(err);
+				else
+					error(err);
+			}
+			if (rc == 0) break; // end of file
+			sent += rc;
+		}
+		return static_cast<Poco::Int64>(sent);
+	}
+#endif
+
+	return sendFileMapped(fileInputStream, offset, count);
+}
+
+
+Poco::Int64 SocketImpl::sendFileMapped(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count)
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	int fd = fileInputStream.nativeHandle();
+	if (fd == -1) throw InvalidArgumentException("File is not open");
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+		return sendFileBuffered(fileInputStream, offset, count);
+
+	// never map beyond the end of the file, as accessing
+	// such pages raises SIGBUS
+	Poco::UInt64 size = static_cast<Poco::UInt64>(st.st_size);
+	if (offset >= size) return 0;
+	count = std::min(count, size - offset);
+
+	static const Poco::UInt64 pageSize = static_cast<Poco::UInt64>(::sysconf(_SC_PAGESIZE));
+	Poco::UInt64 sent = 0;
+	while (sent < count)
+	{
+		Poco::UInt64 pos = offset + sent;
+		Poco::UInt64 mapOffset = pos - pos % pageSize;
+		std::size_t length = static_cast<std::size_t>(std::min<Poco::UInt64>(count - sent, SENDFILE_CHUNK_SIZE));
+		std::size_t mapLength = static_cast<std::size_t>(pos - mapOffset) + length;
+		void* pMap = ::mmap(0, mapLength, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(mapOffset));
+		if (pMap == MAP_FAILED)
+			return static_cast<Poco::Int64>(sent) + sendFileBuffered(fileInputStream, pos, count - sent);
+
+		int rc;
+		try
+		{
+			rc = sendBytes(static_cast<const char*>(pMap) + (pos - mapOffset), static_cast<int>(length));
+		}
+		catch (...)
+		{
+			::munmap(pMap, mapLength);
+			throw;
+		}
+		::munmap(pMap, mapLength);
+		if (rc <= 0) break;
+		sent += rc;
+		if (static_cast<std::size_t>(rc) < length) break;
+	}
+	return static_cast<Poco::Int64>(sent);
+#else
+	return sendFileBuffered(fileInputStream, offset, count);
+#endif
+}
+
+
+Poco::Int64 SocketImpl::sendFileBuffered(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	fileInputStream.clear();
+	fileInputStream.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+	Poco::Buffer<char> buffer(static_cast<std::size_t>(std::min<Poco::UInt64>(count, 65536)));
+	Poco::UInt64 sent = 0;
+	while (sent < count && fileInputStream.good())
+	{
+		std::streamsize length = static_cast<std::streamsize>(std::min<Poco::UInt64>(count - sent, buffer.size()));
+		fileInputStream.read(buffer.begin(), length);
+		int n = static_cast<int>(fileInputStream.gcount());
+		if (n <= 0) break;
+		int rc = sendBytes(buffer.begin(), n);
+		if (rc <= 0) break;
+		sent += rc;
+		if (rc < n) break;
+	}
+	return static_cast<Poco::Int64>(sent);
+}
+
+
 int SocketImpl::receiveBytes(void* buffer, int length, int flags)
 {
 	checkBrokenTimeout(SELECT_READ);
@@ -501,6 +649,131 @@ int SocketImpl::sendTo(const SocketBufVec& buffers, const SocketAddress& address
 }
 
 
+int SocketImpl::sendBatch(const SocketBufVec& datagrams, const SocketAddress& address, int flags)
+{
+	return sendBatchImpl(datagrams, &address, false, flags);
+}
+
+
+int SocketImpl::sendBatch(const SocketBufVec& datagrams, const std::vector<SocketAddress>& addresses, int flags)
+{
+	if (addresses.size() != datagrams.size()) throw InvalidArgumentException("Number of addresses and datagrams differ");
+	if (datagrams.empty()) return 0;
+
+	return sendBatchImpl(datagrams, &addresses[0], true, flags);
+}
+
+
+int SocketImpl::sendBatchImpl(const SocketBufVec& datagrams, const SocketAddress* pAddresses, bool addressPerDatagram, int flags)
+{
+	if (datagrams.empty()) return 0;
+	if (_sockfd == POCO_INVALID_SOCKET) init(pAddresses[0].af());
+
+	std::size_t sent = 0;
+#if POCO_OS == POCO_OS_LINUX
+	struct mmsghdr msgs[MAX_DATAGRAM_BATCH];
+	while (sent < datagrams.size())
+	{
+		unsigned n = static_cast<unsigned>(std::min<std::size_t>(datagrams.size() - sent, MAX_DATAGRAM_BATCH));
+		for (unsigned i = 0; i < n; ++i)
+		{
+			const SocketAddress& address = pAddresses[addressPerDatagram ? sent + i : 0];
+			struct msghdr& msgHdr = msgs[i].msg_hdr;
+			msgHdr.msg_name = const_cast<sockaddr*>(address.addr());
+			msgHdr.msg_namelen = address.length();
+			msgHdr.msg_iov = const_cast<iovec*>(&datagrams[sent + i]);
+			msgHdr.msg_iovlen = 1;
+			msgHdr.msg_control = 0;
+			msgHdr.msg_controllen = 0;
+			msgHdr.msg_flags = 0;
+			msgs[i].msg_len = 0;
+		}
+		int rc;
+		do
+		{
+			rc = ::sendmmsg(_sockfd, msgs, n, flags);
+		}
+		while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+		if (rc < 0)
+		{
+			if (sent > 0) break;
+			error();
+		}
+		sent += rc;
+		if (static_cast<unsigned>(rc) < n && !_blocking) break;
+	}
+#else
+	for (; sent < datagrams.size(); ++sent)
+	{
+		const SocketAddress& address = pAddresses[addressPerDatagram ? sent : 0];
+		try
+		{
+			sendTo(bufferData(datagrams[sent]), bufferLength(datagrams[sent]), address, flags);
+		}
+		catch (Poco::Exception&)
+		{
+			if (sent > 0) break;
+			throw;
+		}
+	}
+#endif
+	return static_cast<int>(sent);
+}
+
+
+int SocketImpl::receiveBatch(SocketBufVec& datagrams, int* lengths, struct sockaddr** ppSA, poco_socklen_t** ppSALen, int flags)
+{
+	if (datagrams.empty()) return 0;
+
+#if POCO_OS == POCO_OS_LINUX
+	checkBrokenTimeout(SELECT_READ);
+
+	struct mmsghdr msgs[MAX_DATAGRAM_BATCH];
+	unsigned n = static_cast<unsigned>(std::min<std::size_t>(datagrams.size(), MAX_DATAGRAM_BATCH));
+	for (unsigned i = 0; i < n; ++i)
+	{
+		struct msghdr& msgHdr = msgs[i].msg_hdr;
+		msgHdr.msg_name = ppSA[i];
+		msgHdr.msg_namelen = *ppSALen[i];
+		msgHdr.msg_iov = &datagrams[i];
+		msgHdr.msg_iovlen = 1;
+		msgHdr.msg_control = 0;
+		msgHdr.msg_controllen = 0;
+		msgHdr.msg_flags = 0;
+		msgs[i].msg_len = 0;
+	}
+	int rc;
+	do
+	{
+		if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
+		rc = ::recvmmsg(_sockfd, msgs, n, flags | MSG_WAITFORONE, 0);
+	}
+	while (_blocking && rc < 0 && lastError() == POCO_EINTR);
+	if (rc < 0)
+	{
+		int err = lastError();
+		if (err == POCO_EAGAIN && !_blocking)
+			;
+		else if (err == POCO_EAGAIN || err == POCO_ETIMEDOUT)
+			throw TimeoutException(err);
+		else
+			error(err);
+	}
+	for (int i = 0; i < rc; ++i)
+	{
+		lengths[i] = static_cast<int>(msgs[i].msg_len);
+		*ppSALen[i] = msgs[i].msg_hdr.msg_namelen;
+	}
+	return rc;
+#else
+	int rc = receiveFrom(bufferData(datagrams[0]), bufferLength(datagrams[0]), &ppSA[0], &ppSALen[0], flags);
+	if (rc < 0) return rc;
+	lengths[0] = rc;
+	return 1;
+#endif
+}
+
+
 int SocketImpl::receiveFrom(void* buffer, int length, SocketAddress& address, int flags)
 {
 	sockaddr_storage abuffer;
@@ -80,6 +80,17 @@ TimeoutNotification::~TimeoutNotification()
 }
 
 
+SocketTimeoutNotification::SocketTimeoutNotification(SocketReactor* pReactor):
+	SocketNotification(pReactor)
+{
+}
+
+
+SocketTimeoutNotification::~SocketTimeoutNotification()
+{
+}
+
+
 IdleNotification::IdleNotification(SocketReactor* pReactor):
 	SocketNotification(pReactor)
 {
@@ -22,7 +22,8 @@ namespace Net {
 
 
 SocketNotifier::SocketNotifier(const Socket& socket):
-	_socket(socket)
+	_socket(socket),
+	_timer(this)
 {
 }
 
@@ -17,6 +17,7 @@
 #include "Poco/Net/SocketNotifier.h"
 #include "Poco/ErrorHandler.h"
 #include "Poco/Thread.h"
+#include "Poco/Clock.h"
 #include "Poco/Exception.h"
 #ifdef max
 #undef max
@@ -33,10 +34,12 @@ namespace Net {
 SocketReactor::SocketReactor():
 	_stop(false),
 	_timeout(DEFAULT_TIMEOUT),
+	_pollMode(0),
 	_pReadableNotification(new ReadableNotification(this)),
 	_pWritableNotification(new WritableNotification(this)),
 	_pErrorNotification(new ErrorNotification(this)),
 	_pTimeoutNotification(new TimeoutNotification(this)),
+	_pSocketTimeoutNotification(new SocketTimeoutNotification(this)),
 	_pIdleNotification(new IdleNotification(this)),
 	_pShutdownNotification(new ShutdownNotification(this)),
 	_pThread(0)
@@ -47,10 +50,12 @@ SocketReactor::SocketReactor():
 SocketReactor::SocketReactor(const Poco::Timespan& timeout):
 	_stop(false),
 	_timeout(timeout),
+	_pollMode(0),
 	_pReadableNotification(new ReadableNotification(this)),
 	_pWritableNotification(new WritableNotification(this)),
 	_pErrorNotification(new ErrorNotification(this)),
 	_pTimeoutNotification(new TimeoutNotification(this)),
+	_pSocketTimeoutNotification(new SocketTimeoutNotification(this)),
 	_pIdleNotification(new IdleNotification(this)),
 	_pShutdownNotification(new ShutdownNotification(this)),
 	_pThread(0)
@@ -66,6 +71,7 @@ SocketReactor::~SocketReactor()
 void SocketReactor::run()
 {
 	_pThread = Thread::current();
+	Poco::Clock idleSince;
 	while (!_stop)
 	{
 		try
@@ -73,31 +79,48 @@ void SocketReactor::run()
 			if (!hasSocketHandlers())
 			{
 				onIdle();
-				Timespan::TimeDiff ms = _timeout.totalMilliseconds();
+				Timespan::TimeDiff ms = waitTime(_timeout).totalMilliseconds();
 				poco_assert_dbg(ms <= std::numeric_limits<long>::max());
 				Thread::trySleep(static_cast<long>(ms));
+				expireTimeouts();
+				idleSince.update();
 			}
 			else
 			{
 				bool readable = false;
-				PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
-				if (sm.size() > 0)
+				// Waits may be shortened by pending socket timeouts, so the
+				// reactor timeout is measured from the last readable event.
+				Poco::Timespan idle(idleSince.elapsed());
+				Poco::Timespan timeout = waitTime(idle < _timeout ? _timeout - idle : Poco::Timespan());
+				if (_pollSet.poll(timeout, _events) > 0)
 				{
 					onBusy();
-					PollSet::SocketModeMap::iterator it = sm.begin();
-					PollSet::SocketModeMap::iterator end = sm.end();
+					PollSet::EventVec::const_iterator it = _events.begin();
+					PollSet::EventVec::const_iterator end = _events.end();
 					for (; it != end; ++it)
 					{
-						if (it->second & PollSet::POLL_READ)
+						NotifierPtr pNotifier = getNotifier(it->fd);
+						if (!pNotifier) continue;
+						if (it->mode & PollSet::POLL_READ)
 						{
-							dispatch(it->first, _pReadableNotification);
+							dispatch(pNotifier, _pReadableNotification);
 							readable = true;
 						}
-						if (it->second & PollSet::POLL_WRITE) dispatch(it->first, _pWritableNotification);
-						if (it->second & PollSet::POLL_ERROR) dispatch(it->first, _pErrorNotification);
+						if (it->mode & PollSet::POLL_WRITE) dispatch(pNotifier, _pWritableNotification);
+						if (it->mode & PollSet::POLL_ERROR) dispatch(pNotifier, _pErrorNotification);
+						if (_pollMode & PollSet::POLL_ONESHOT) rearm(pNotifier);
 					}
 				}
-				if (!readable) onTimeout();
+				expireTimeouts();
+				if (readable)
+				{
+					idleSince.update();
+				}
+				else if (idleSince.elapsed() >= _timeout.totalMicroseconds())
+				{
+					onTimeout();
+					idleSince.update();
+				}
 			}
 		}
 		catch (Exception& exc)
@@ -158,16 +181,27 @@ const Poco::Timespan& SocketReactor::getTimeout() const
 }
 
 
+void SocketReactor::setPollMode(int mode)
+{
+	poco_assert ((mode & ~(PollSet::POLL_EDGE | PollSet::POLL_ONESHOT)) == 0);
+
+	_pollMode = mode;
+}
+
+
+int SocketReactor::getPollMode() const
+{
+	return _pollMode;
+}
+
+
 void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
 	NotifierPtr pNotifier = getNotifier(socket, true);
 
 	if (!pNotifier->hasObserver(observer)) pNotifier->addObserver(this, observer);
 
-	int mode = 0;
-	if (pNotifier->accepts(_pReadableNotification)) mode |= PollSet::POLL_READ;
-	if (pNotifier->accepts(_pWritableNotification)) mode |= PollSet::POLL_WRITE;
-	if (pNotifier->accepts(_pErrorNotification))    mode |= PollSet::POLL_ERROR;
+	int mode = pollMode(pNotifier);
 	if (mode) _pollSet.add(socket, mode);
 }
 
@@ -187,12 +221,80 @@ SocketReactor::NotifierPtr SocketReactor::getNotifier(const Socket& socket, bool
 
 	EventHandlerMap::iterator it = _handlers.find(socket);
 	if (it != _handlers.end()) return it->second;
-	else if (makeNew) return (_handlers[socket] = new SocketNotifier(socket));
+	else if (makeNew)
+	{
+		NotifierPtr pNotifier = new SocketNotifier(socket);
+		_handlers[socket] = pNotifier;
+		poco_socket_t fd = socket.impl()->sockfd();
+		if (fd != POCO_INVALID_SOCKET)
+		{
+			std::size_t slot = static_cast<std::size_t>(fd);
+			if (slot >= _slots.size()) _slots.resize(slot + 1);
+			_slots[slot] = pNotifier;
+		}
+		return pNotifier;
+	}
 
 	return 0;
 }
 
 
+SocketReactor::NotifierPtr SocketReactor::getNotifier(poco_socket_t fd)
+{
+	ScopedLock lock(_mutex);
+
+	std::size_t slot = static_cast<std::size_t>(fd);
+	if (fd != POCO_INVALID_SOCKET && slot < _slots.size()) return _slots[slot];
+
+	return 0;
+}
+
+
+void SocketReactor::clearSlot(const Socket& socket, const NotifierPtr& pNotifier)
+{
+	poco_socket_t fd = socket.impl()->sockfd();
+	std::size_t slot = static_cast<std::size_t>(fd);
+	if (fd != POCO_INVALID_SOCKET && slot < _slots.size() && _slots[slot] == pNotifier)
+	{
+		_slots[slot].reset();
+	}
+	else
+	{
+		// socket has already been closed; find the slot by notifier
+		for (NotifierSlots::iterator it = _slots.begin(); it != _slots.end(); ++it)
+		{
+			if (*it == pNotifier)
+			{
+				it->reset();
+				break;
+			}
+		}
+	}
+}
+
+
+int SocketReactor::pollMode(NotifierPtr& pNotifier)
+{
+	int mode = 0;
+	if (pNotifier->accepts(_pReadableNotification)) mode |= PollSet::POLL_READ;
+	if (pNotifier->accepts(_pWritableNotification)) mode |= PollSet::POLL_WRITE;
+	if (pNotifier->accepts(_pErrorNotification))    mode |= PollSet::POLL_ERROR;
+	if (mode) mode |= _pollMode;
+	return mode;
+}
+
+
+void SocketReactor::rearm(NotifierPtr& pNotifier)
+{
+	const Socket& socket = pNotifier->socket();
+	if (socket.impl()->sockfd() == POCO_INVALID_SOCKET) return;
+	if (getNotifier(socket) != pNotifier) return;
+
+	int mode = pollMode(pNotifier);
+	if (mode && _pollSet.has(socket)) _pollSet.update(socket, mode);
+}
+
+
 void SocketReactor::removeEventHandler(const Socket& socket, const Poco::AbstractObserver& observer)
 {
 	NotifierPtr pNotifier = getNotifier(socket);
@@ -203,10 +305,23 @@ void SocketReactor::removeEventHandler(const Socket& socket, const Poco::Abstrac
 			{
 				ScopedLock lock(_mutex);
 				_handlers.erase(socket);
+				clearSlot(socket, pNotifier);
+				_timerWheel.cancel(pNotifier->timer());
+			}
+			if (_pollSet.has(socket)) _pollSet.remove(socket);
+			pNotifier->removeObserver(this, observer);
+		}
+		else
+		{
+			pNotifier->removeObserver(this, observer);
+			// stop polling for events no remaining observer is interested in
+			if (socket.impl()->sockfd() != POCO_INVALID_SOCKET && _pollSet.has(socket))
+			{
+				int mode = pollMode(pNotifier);
+				if (mode) _pollSet.update(socket, mode);
+				else _pollSet.remove(socket);
 			}
-			_pollSet.remove(socket);
 		}
-		pNotifier->removeObserver(this, observer);
 	}
 }
 
@@ -217,6 +332,55 @@ bool SocketReactor::has(const Socket& socket) const
 }
 
 
+bool SocketReactor::scheduleTimeout(const Socket& socket, const Poco::Timespan& timeout)
+{
+	ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it == _handlers.end()) return false;
+	_timerWheel.schedule(it->second->timer(), timeout);
+	return true;
+}
+
+
+void SocketReactor::cancelTimeout(const Socket& socket)
+{
+	ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it != _handlers.end()) _timerWheel.cancel(it->second->timer());
+}
+
+
+Poco::Timespan SocketReactor::waitTime(const Poco::Timespan& timeout)
+{
+	ScopedLock lock(_mutex);
+
+	return _timerWheel.nextTimeout(timeout);
+}
+
+
+void SocketReactor::expireTimeouts()
+{
+	{
+		ScopedLock lock(_mutex);
+
+		if (_timerWheel.empty()) return;
+		_timerWheel.advance(_expiredTimers);
+		for (TimerWheel::TimerVec::iterator it = _expiredTimers.begin(); it != _expiredTimers.end(); ++it)
+		{
+			_expiredNotifiers.push_back(NotifierPtr(static_cast<SocketNotifier*>((*it)->context()), true));
+		}
+		_expiredTimers.clear();
+	}
+	for (std::vector<NotifierPtr>::iterator it = _expiredNotifiers.begin(); it != _expiredNotifiers.end(); ++it)
+	{
+		dispatch(*it, _pSocketTimeoutNotification);
+	}
+	_expiredNotifiers.clear();
+}
+
+
 void SocketReactor::onTimeout()
 {
 	dispatch(_pTimeoutNotification);
@@ -127,6 +127,12 @@ int StreamSocket::sendBytes(const SocketBufVec& buffers, int flags)
 }
 
 
+Poco::Int64 StreamSocket::sendFile(Poco::FileInputStream& fileInputStream, Poco::UInt64 offset, Poco::UInt64 count)
+{
+	return impl()->sendFile(fileInputStream, offset, count);
+}
+
+
 int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 {
 	ScopedLock<Mutex> l(fifoBuf.mutex());
@@ -17,6 +17,7 @@
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/WorkStealingExecutor.h"
 #include <memory>
 
 
@@ -61,7 +62,8 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_refusedConnections(0),
 	_stopped(false),
 	_pConnectionFactory(pFactory),
-	_threadPool(threadPool)
+	_pThreadPool(&threadPool),
+	_pExecutor(0)
 {
 	poco_check_ptr (pFactory);
 
@@ -73,6 +75,29 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 }
 
 
+TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Poco::WorkStealingExecutor& executor, TCPServerParams::Ptr pParams):
+	_rc(1),
+	_pParams(pParams),
+	_currentThreads(0),
+	_totalConnections(0),
+	_currentConnections(0),
+	_maxConcurrentConnections(0),
+	_refusedConnections(0),
+	_stopped(false),
+	_pConnectionFactory(pFactory),
+	_pThreadPool(0),
+	_pExecutor(&executor)
+{
+	poco_check_ptr (pFactory);
+
+	if (!_pParams)
+		_pParams = new TCPServerParams;
+
+	if (_pParams->getMaxThreads() == 0)
+		_pParams->setMaxThreads(executor.capacity());
+}
+
+
 TCPServerDispatcher::~TCPServerDispatcher()
 {
 }
@@ -94,6 +119,36 @@ void TCPServerDispatcher::run()
 {
 	AutoPtr<TCPServerDispatcher> guard(this, false); // ensure _rc is decreased when function exits
 
+	if (_pExecutor)
+	{
+		// never wait for connections on an executor thread
+		for (;;)
+		{
+			AutoPtr<Notification> pNf = _queue.dequeueNotification();
+			if (pNf)
+			{
+				try
+				{
+					handleConnection(pNf);
+				}
+				catch (Poco::Exception &exc) { ErrorHandler::handle(exc); }
+				catch (std::exception &exc)  { ErrorHandler::handle(exc); }
+				catch (...)                  { ErrorHandler::handle();    }
+			}
+			else
+			{
+				FastMutex::ScopedLock lock(_mutex);
+				// enqueue() may have queued a connection after the queue was found empty
+				if (_queue.empty())
+				{
+					--_currentThreads;
+					break;
+				}
+			}
+		}
+		return;
+	}
+
 	int idleTime = (int) _pParams->getThreadIdleTime().totalMilliseconds();
 
 	for (;;)
@@ -103,18 +158,7 @@ void TCPServerDispatcher::run()
 			try
 			{
 				AutoPtr<Notification> pNf = _queue.waitDequeueNotification(idleTime);
-				if (pNf)
-				{
-					TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf.get());
-					if (pCNf)
-					{
-						std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
-						poco_check_ptr(pConnection.get());
-						beginConnection();
-						pConnection->start();
-						endConnection();
-					}
-				}
+				if (pNf) handleConnection(pNf);
 			}
 			catch (Poco::Exception &exc) { ErrorHandler::handle(exc); }
 			catch (std::exception &exc)  { ErrorHandler::handle(exc); }
@@ -125,6 +169,20 @@ void TCPServerDispatcher::run()
 }
 
 
+void TCPServerDispatcher::handleConnection(Notification* pNf)
+{
+	TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf);
+	if (pCNf)
+	{
+		std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
+		poco_check_ptr(pConnection.get());
+		beginConnection();
+		pConnection->start();
+		endConnection();
+	}
+}
+
+
 namespace
 {
 	static const std::string threadName("TCPServerConnection");
@@ -142,7 +200,15 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 		{
 			try
 			{
-				_threadPool.startWithPriority(_pParams->getThreadPriority(), *this, threadName);
+				if (_pExecutor)
+				{
+					// the executor never fails to start a task
+					duplicate();
+					++_currentThreads;
+					_pExecutor->start(*this);
+					return;
+				}
+				_pThreadPool->startWithPriority(_pParams->getThreadPriority(), *this, threadName);
 				++_currentThreads;
 				// Ensure this object lives at least until run() starts
 				// Small chance of leaking if threadpool is stopped before this
@@ -180,7 +246,7 @@ int TCPServerDispatcher::maxThreads() const
 {
 	FastMutex::ScopedLock lock(_mutex);
 	
-	return _threadPool.capacity();
+	return _pExecutor ? _pExecutor->capacity() : _pThreadPool->capacity();
 }
 
 
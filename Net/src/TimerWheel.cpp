@@ -0,0 +1,266 @@
+//
+// TimerWheel.cpp
+//
+// Library: Net
+// Package: Reactor
+// Module:  TimerWheel
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/TimerWheel.h"
+#include "Poco/Bugcheck.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+//
+// TimerWheel::Timer
+//
+
+
+TimerWheel::Timer::Timer(void* pContext):
+	_pContext(pContext),
+	_pPrev(this),
+	_pNext(this),
+	_expiry(0),
+	_level(0),
+	_pWheel(0)
+{
+}
+
+
+TimerWheel::Timer::~Timer()
+{
+	if (_pWheel) _pWheel->cancel(*this);
+}
+
+
+void TimerWheel::Timer::link(Timer& head)
+{
+	_pPrev = head._pPrev;
+	_pNext = &head;
+	head._pPrev->_pNext = this;
+	head._pPrev = this;
+}
+
+
+void TimerWheel::Timer::unlink()
+{
+	_pPrev->_pNext = _pNext;
+	_pNext->_pPrev = _pPrev;
+	_pPrev = this;
+	_pNext = this;
+}
+
+
+//
+// TimerWheel
+//
+
+
+TimerWheel::TimerWheel():
+	_resolution(DEFAULT_RESOLUTION),
+	_tick(0),
+	_size(0),
+	_level0Size(0)
+{
+}
+
+
+TimerWheel::TimerWheel(const Poco::Timespan& resolution):
+	_resolution(resolution),
+	_tick(0),
+	_size(0),
+	_level0Size(0)
+{
+	poco_assert (resolution.totalMilliseconds() >= 1);
+}
+
+
+TimerWheel::~TimerWheel()
+{
+	for (int i = 0; i < SLOTS; ++i)
+	{
+		Timer& head = _slots[i];
+		while (head._pNext != &head)
+		{
+			Timer* pTimer = head._pNext;
+			pTimer->unlink();
+			pTimer->_pWheel = 0;
+		}
+	}
+}
+
+
+void TimerWheel::schedule(Timer& timer, const Poco::Timespan& delay)
+{
+	poco_assert (timer._pWheel == 0 || timer._pWheel == this);
+
+	cancel(timer);
+
+	Poco::Clock now;
+	if (_size == 0)
+	{
+		// the wheel has not been advanced while it was empty
+		Poco::UInt64 tick = currentTick(now);
+		if (tick > _tick) _tick = tick;
+	}
+	Poco::Clock::ClockDiff due = (now - _origin) + delay.totalMicroseconds();
+	if (due < 0) due = 0;
+	Poco::UInt64 resolution = static_cast<Poco::UInt64>(_resolution.totalMicroseconds());
+	// round up, so that the timer never expires early
+	Poco::UInt64 expiry = (static_cast<Poco::UInt64>(due) + resolution - 1)/resolution;
+	timer._expiry = expiry < _tick ? _tick : expiry;
+	timer._pWheel = this;
+	insert(timer);
+	++_size;
+}
+
+
+void TimerWheel::cancel(Timer& timer)
+{
+	if (timer._pWheel != this) return;
+
+	timer.unlink();
+	timer._pWheel = 0;
+	if (timer._level == 0) --_level0Size;
+	--_size;
+}
+
+
+std::size_t TimerWheel::advance(TimerVec& expired)
+{
+	Poco::UInt64 target = currentTick(Poco::Clock());
+	std::size_t n = 0;
+	while (_tick <= target)
+	{
+		if (_size == 0)
+		{
+			// nothing to do for the remaining ticks
+			_tick = target + 1;
+			break;
+		}
+
+		int index = static_cast<int>(_tick & (LEVEL0_SIZE - 1));
+		if (index == 0)
+		{
+			for (int level = 1; level < LEVELS; ++level)
+			{
+				cascade(level);
+				if (((_tick >> (LEVEL0_BITS + (level - 1)*LEVEL_BITS)) & (LEVEL_SIZE - 1)) != 0) break;
+			}
+		}
+
+		Timer& head = _slots[index];
+		while (head._pNext != &head)
+		{
+			Timer* pTimer = head._pNext;
+			pTimer->unlink();
+			pTimer->_pWheel = 0;
+			--_level0Size;
+			--_size;
+			expired.push_back(pTimer);
+			++n;
+		}
+		++_tick;
+	}
+	return n;
+}
+
+
+Poco::Timespan TimerWheel::nextTimeout(const Poco::Timespan& maxTimeout) const
+{
+	if (_size == 0) return maxTimeout;
+
+	// Within one rotation of the first wheel, there is either a timer
+	// in the first wheel, or timers must be moved from a coarser wheel.
+	Poco::UInt64 tick = _tick;
+	Poco::UInt64 end = _tick + LEVEL0_SIZE;
+	for (; tick < end; ++tick)
+	{
+		int index = static_cast<int>(tick & (LEVEL0_SIZE - 1));
+		if (index == 0 && _size > _level0Size) break;
+		if (_level0Size > 0 && _slots[index]._pNext != &_slots[index]) break;
+	}
+
+	Poco::Clock now;
+	Poco::Clock::ClockDiff timeout = static_cast<Poco::Clock::ClockDiff>(tick)*_resolution.totalMicroseconds() - (now - _origin);
+	if (timeout < 0) timeout = 0;
+	if (timeout < maxTimeout.totalMicroseconds())
+		return Poco::Timespan(timeout);
+	else
+		return maxTimeout;
+}
+
+
+void TimerWheel::insert(Timer& timer)
+{
+	Poco::UInt64 expiry = timer._expiry;
+	Poco::UInt64 delta = expiry - _tick;
+	int slot;
+	if (delta < LEVEL0_SIZE)
+	{
+		timer._level = 0;
+		slot = static_cast<int>(expiry & (LEVEL0_SIZE - 1));
+		++_level0Size;
+	}
+	else
+	{
+		if (delta >= (Poco::UInt64(1) << MAX_BITS))
+		{
+			// too far in the future; the timer will be moved back to
+			// the last wheel when its slot comes up
+			expiry = _tick + (Poco::UInt64(1) << MAX_BITS) - 1;
+			delta = expiry - _tick;
+		}
+		int level = 1;
+		int shift = LEVEL0_BITS;
+		while (delta >= (Poco::UInt64(1) << (shift + LEVEL_BITS)))
+		{
+			++level;
+			shift += LEVEL_BITS;
+		}
+		timer._level = level;
+		slot = LEVEL0_SIZE + (level - 1)*LEVEL_SIZE + static_cast<int>((expiry >> shift) & (LEVEL_SIZE - 1));
+	}
+	timer.link(_slots[slot]);
+}
+
+
+void TimerWheel::cascade(int level)
+{
+	int shift = LEVEL0_BITS + (level - 1)*LEVEL_BITS;
+	int slot = LEVEL0_SIZE + (level - 1)*LEVEL_SIZE + static_cast<int>((_tick >> shift) & (LEVEL_SIZE - 1));
+	Timer& head = _slots[slot];
+	if (head._pNext == &head) return;
+
+	// detach the list first, as timers may be inserted into the same slot again
+	Timer* pTimer = head._pNext;
+	head._pPrev->_pNext = 0;
+	head._pPrev = &head;
+	head._pNext = &head;
+	while (pTimer)
+	{
+		Timer* pNext = pTimer->_pNext;
+		insert(*pTimer);
+		pTimer = pNext;
+	}
+}
+
+
+Poco::UInt64 TimerWheel::currentTick(const Poco::Clock& now) const
+{
+	Poco::Clock::ClockDiff elapsed = now - _origin;
+	if (elapsed < 0) elapsed = 0;
+	return static_cast<Poco::UInt64>(elapsed)/static_cast<Poco::UInt64>(_resolution.totalMicroseconds());
+}
+
+
+} } // namespace Poco::Net
@@ -24,13 +24,16 @@ UDPServerParams::UDPServerParams(const Poco::Net::SocketAddress& sa,
 	Poco::Timespan timeout,
 	std::size_t handlerBufListSize,
 	bool notifySender,
-	int  backlogThreshold): _sa(sa),
+	int  backlogThreshold,
+	int  receiveBatchSize): _sa(sa),
 		_nSockets(nSockets),
 		_timeout(timeout),
 		_handlerBufListSize(handlerBufListSize),
 		_notifySender(notifySender),
-		_backlogThreshold(backlogThreshold)
+		_backlogThreshold(backlogThreshold),
+		_receiveBatchSize(receiveBatchSize)
 {
+	poco_assert (receiveBatchSize > 0);
 }
 
 
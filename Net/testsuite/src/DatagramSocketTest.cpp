@@ -25,6 +25,7 @@
 using Poco::Net::Socket;
 using Poco::Net::DatagramSocket;
 using Poco::Net::SocketAddress;
+using Poco::Net::SocketBufVec;
 using Poco::Net::IPAddress;
 #ifdef POCO_NET_HAS_INTERFACE
 	using Poco::Net::NetworkInterface;
@@ -98,6 +99,48 @@ void DatagramSocketTest::testSendToReceiveFrom()
 }
 
 
+void DatagramSocketTest::testSendReceiveBatch()
+{
+	DatagramSocket receiver(SocketAddress("127.0.0.1", 0));
+	DatagramSocket sender(SocketAddress::IPv4);
+
+	std::vector<std::string> strings;
+	strings.push_back("hello");
+	strings.push_back("batched");
+	strings.push_back("world");
+	SocketBufVec out = Socket::makeBufVec(strings);
+	int n = sender.sendBatch(out, receiver.address());
+	assertTrue (n == 3);
+
+	SocketBufVec in = Socket::makeBufVec(4, 64);
+	std::vector<int> lengths;
+	std::vector<SocketAddress> addresses;
+	int received = 0;
+	std::string data;
+	while (received < 3 && receiver.poll(Timespan(2, 0), Socket::SELECT_READ))
+	{
+		n = receiver.receiveBatch(in, lengths, addresses);
+		assertTrue (n > 0 && n <= 4);
+		assertTrue (lengths.size() == static_cast<std::size_t>(n));
+		assertTrue (addresses.size() == static_cast<std::size_t>(n));
+		for (int i = 0; i < n; ++i)
+		{
+			assertTrue (addresses[i].port() == sender.address().port());
+#if defined(POCO_OS_FAMILY_WINDOWS)
+			data.append(in[i].buf, lengths[i]);
+#else
+			data.append(reinterpret_cast<char*>(in[i].iov_base), lengths[i]);
+#endif
+			data.append(1, ' ');
+		}
+		received += n;
+	}
+	assertTrue (received == 3);
+	assertTrue (data == "hello batched world ");
+	Socket::destroyBufVec(in);
+}
+
+
 void DatagramSocketTest::testUnbound()
 {
 	UDPEchoServer echoServer;
@@ -609,6 +652,7 @@ CppUnit::Test* DatagramSocketTest::suite()
 	CppUnit_addTest(pSuite, DatagramSocketTest, testEcho);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testEchoBuffer);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testSendToReceiveFrom);
+	CppUnit_addTest(pSuite, DatagramSocketTest, testSendReceiveBatch);
 	CppUnit_addTest(pSuite, DatagramSocketTest, testUnbound);
 #if (POCO_OS != POCO_OS_FREE_BSD) // works only with local net bcast and very randomly
 	CppUnit_addTest(pSuite, DatagramSocketTest, testBroadcast);
@@ -0,0 +1,333 @@
+//
+// HTTPClientSessionPoolTest.cpp
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPClientSessionPoolTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPClientSessionPool.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPStreamFactory.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Thread.h"
+#include "Poco/URI.h"
+#include <sstream>
+#include <memory>
+
+
+using Poco::Net::HTTPClientSessionPool;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPStreamFactory;
+using Poco::Net::HTTPSessionFactory;
+using Poco::Net::HTTPServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::StreamCopier;
+using Poco::Timespan;
+using Poco::URI;
+
+
+namespace
+{
+	class ClientAddressRequestHandler: public HTTPRequestHandler
+		/// Returns the address of the client connection,
+		/// which identifies the connection used for the request.
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string body = request.clientAddress().toString();
+			if (request.getURI() == "/close") response.setKeepAlive(false);
+			response.setContentType("text/plain");
+			response.setContentLength(static_cast<int>(body.size()));
+			response.send() << body;
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			return new ClientAddressRequestHandler;
+		}
+	};
+
+	std::string request(HTTPClientSession& session, const std::string& path = "/")
+	{
+		HTTPRequest req(HTTPRequest::HTTP_GET, path, HTTPMessage::HTTP_1_1);
+		session.sendRequest(req);
+		HTTPResponse res;
+		std::istream& rs = session.receiveResponse(res);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		return ostr.str();
+	}
+
+	HTTPServerParams* createParams()
+	{
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		return pParams;
+	}
+}
+
+
+HTTPClientSessionPoolTest::HTTPClientSessionPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPClientSessionPoolTest::~HTTPClientSessionPoolTest()
+{
+}
+
+
+void HTTPClientSessionPoolTest::testReuse()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(10, 0));
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	std::string client1 = request(*pSession);
+	assertTrue (!client1.empty());
+	pool.release(pSession);
+	assertTrue (pool.idle() == 1);
+
+	URI uri("http://127.0.0.1/");
+	uri.setPort(svs.address().port());
+	assertTrue (pool.idle(uri) == 1);
+	uri.setPort(svs.address().port() + 1);
+	assertTrue (pool.idle(uri) == 0);
+
+	HTTPClientSession* pSession2 = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	assertTrue (pSession2 == pSession);
+	assertTrue (pool.idle() == 0);
+	std::string client2 = request(*pSession2);
+	assertTrue (client2 == client1);
+
+	HTTPClientSession* pSession3 = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	assertTrue (pSession3 != pSession2);
+	std::string client3 = request(*pSession3);
+	assertTrue (client3 != client2);
+
+	pool.release(pSession2);
+	pool.release(pSession3);
+	assertTrue (pool.idle() == 2);
+
+	pool.clear();
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testNoKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(10, 0));
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	pSession->setKeepAlive(false);
+	request(*pSession);
+	pool.release(pSession);
+	assertTrue (pool.idle() == 0);
+
+	// a session that has never been connected is not kept either
+	pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	pool.release(pSession);
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testConnectionClose()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(10, 0));
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	request(*pSession, "/close");
+	pool.release(pSession);
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testMaxIdle()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 1, Timespan(10, 0));
+	HTTPClientSession* pSession1 = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	HTTPClientSession* pSession2 = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	request(*pSession1);
+	std::string client2 = request(*pSession2);
+	pool.release(pSession1);
+	pool.release(pSession2);
+	assertTrue (pool.idle() == 1);
+
+	// the most recently released session is kept
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	assertTrue (request(*pSession) == client2);
+	pool.release(pSession);
+
+	pool.setMaxIdle(0);
+	pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	request(*pSession);
+	pool.release(pSession);
+	assertTrue (pool.idle() == 0);
+}
+
+
+void HTTPClientSessionPoolTest::testIdleTimeout()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(0, 200000));
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	request(*pSession);
+	pool.release(pSession);
+	assertTrue (pool.idle() == 1);
+	pool.evict();
+	assertTrue (pool.idle() == 1);
+
+	Poco::Thread::sleep(400);
+	pool.evict();
+	assertTrue (pool.idle() == 0);
+
+	pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	std::string client1 = request(*pSession);
+	pool.release(pSession);
+	Poco::Thread::sleep(400);
+
+	// expired sessions are not handed out
+	pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	assertTrue (pool.idle() == 0);
+	assertTrue (request(*pSession) != client1);
+	pool.release(pSession);
+}
+
+
+void HTTPClientSessionPoolTest::testServerClosed()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = createParams();
+	pParams->setKeepAliveTimeout(Timespan(0, 100000));
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(10, 0));
+	HTTPClientSession* pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	std::string client1 = request(*pSession);
+	pool.release(pSession);
+	assertTrue (pool.idle() == 1);
+
+	// the server closes the idle connection
+	Poco::Thread::sleep(1000);
+
+	pSession = pool.get("127.0.0.1", svs.address().port(), HTTPClientSession::ProxyConfig());
+	assertTrue (pool.idle() == 0);
+	assertTrue (!pSession->connected());
+	std::string client2 = request(*pSession);
+	assertTrue (!client2.empty());
+	assertTrue (client2 != client1);
+	pool.release(pSession);
+}
+
+
+void HTTPClientSessionPoolTest::testStreamFactory()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, createParams());
+	srv.start();
+
+	HTTPClientSessionPool pool(HTTPSessionFactory::defaultFactory(), 4, Timespan(10, 0));
+	HTTPStreamFactory factory;
+	factory.setSessionPool(&pool);
+	assertTrue (factory.getSessionPool() == &pool);
+
+	URI uri("http://127.0.0.1/");
+	uri.setPort(svs.address().port());
+
+	std::unique_ptr<std::istream> pStr(factory.open(uri));
+	std::ostringstream ostr1;
+	StreamCopier::copyStream(*pStr, ostr1);
+	pStr.reset();
+	assertTrue (pool.idle() == 1);
+
+	pStr.reset(factory.open(uri));
+	assertTrue (pool.idle() == 0);
+	std::ostringstream ostr2;
+	StreamCopier::copyStream(*pStr, ostr2);
+	pStr.reset();
+	assertTrue (ostr2.str() == ostr1.str());
+	assertTrue (pool.idle() == 1);
+
+	// a stream that has not been read completely does not give back its session
+	pStr.reset(factory.open(uri));
+	pStr.reset();
+	assertTrue (pool.idle() == 0);
+
+	factory.setSessionPool(0);
+	pStr.reset(factory.open(uri));
+	std::ostringstream ostr3;
+	StreamCopier::copyStream(*pStr, ostr3);
+	pStr.reset();
+	assertTrue (pool.idle() == 0);
+	assertTrue (ostr3.str() != ostr1.str());
+}
+
+
+void HTTPClientSessionPoolTest::setUp()
+{
+}
+
+
+void HTTPClientSessionPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPClientSessionPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPClientSessionPoolTest");
+
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testReuse);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testNoKeepAlive);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testConnectionClose);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testMaxIdle);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testIdleTimeout);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testServerClosed);
+	CppUnit_addTest(pSuite, HTTPClientSessionPoolTest, testStreamFactory);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// HTTPClientSessionPoolTest.h
+//
+// Definition of the HTTPClientSessionPoolTest class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef HTTPClientSessionPoolTest_INCLUDED
+#define HTTPClientSessionPoolTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class HTTPClientSessionPoolTest: public CppUnit::TestCase
+{
+public:
+	HTTPClientSessionPoolTest(const std::string& name);
+	~HTTPClientSessionPoolTest();
+
+	void testReuse();
+	void testNoKeepAlive();
+	void testConnectionClose();
+	void testMaxIdle();
+	void testIdleTimeout();
+	void testServerClosed();
+	void testStreamFactory();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // HTTPClientSessionPoolTest_INCLUDED
@@ -0,0 +1,282 @@
+//
+// HTTPHeaderParserTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPHeaderParserTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPHeaderParser.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/MonotonicArena.h"
+#include <sstream>
+
+
+using Poco::Net::HTTPHeaderParser;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPMessage;
+using Poco::Net::MessageHeader;
+using Poco::Net::MessageException;
+
+
+namespace
+{
+	std::size_t parseRequest(HTTPHeaderParser& parser, const std::string& s)
+	{
+		return parser.parseRequest(s.data(), s.data() + s.size());
+	}
+}
+
+
+HTTPHeaderParserTest::HTTPHeaderParserTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPHeaderParserTest::~HTTPHeaderParserTest()
+{
+}
+
+
+void HTTPHeaderParserTest::testParseRequest()
+{
+	std::string s("GET /index.html HTTP/1.1\r\nHost: localhost\r\nContent-Length:  42 \r\nConnection: Keep-Alive\r\n\r\nbody");
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, s) == s.size() - 4);
+	assertTrue (parser.method().equals("GET"));
+	assertTrue (parser.uri().equals("/index.html"));
+	assertTrue (parser.version().equals("HTTP/1.1"));
+	assertTrue (parser.fields().size() == 3);
+	assertTrue (parser.fields()[0].name.equals("Host"));
+	assertTrue (parser.fields()[0].value() == "localhost");
+	assertTrue (parser.fields()[1].rawValue.equals("42"));
+
+	const HTTPHeaderParser::Field* pField = parser.find("content-length");
+	assertTrue (pField != 0);
+	assertTrue (pField->value() == "42");
+	assertTrue (pField->rawValue.data() >= s.data() && pField->rawValue.data() < s.data() + s.size());
+	assertTrue (parser.find("connection")->rawValue.iequals("keep-alive"));
+	assertTrue (parser.find("Accept") == 0);
+
+	// leading empty lines are skipped
+	std::string s2("\r\n\r\nPOST /form HTTP/1.0\r\n\r\n");
+	assertTrue (parseRequest(parser, s2) == s2.size());
+	assertTrue (parser.method().equals("POST"));
+	assertTrue (parser.fields().empty());
+}
+
+
+void HTTPHeaderParserTest::testParseRequestLF()
+{
+	std::string s("HEAD / HTTP/1.1\nHost: localhost\nAccept: */*\n\n");
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, s) == s.size());
+	assertTrue (parser.method().equals("HEAD"));
+	assertTrue (parser.version().equals("HTTP/1.1"));
+	assertTrue (parser.fields().size() == 2);
+	assertTrue (parser.find("Accept")->value() == "*/*");
+}
+
+
+void HTTPHeaderParserTest::testIncomplete()
+{
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, "") == 0);
+	assertTrue (parseRequest(parser, "GET / HT") == 0);
+	assertTrue (parseRequest(parser, "GET / HTTP/1.1\r\nHost: local") == 0);
+	assertTrue (parseRequest(parser, "GET / HTTP/1.1\r\nHost: localhost\r\n") == 0);
+	assertTrue (parseRequest(parser, "GET / HTTP/1.1\r\nHost: localhost\r\n\r") == 0);
+	assertTrue (parser.fields().empty());
+	assertTrue (parser.method().empty());
+}
+
+
+void HTTPHeaderParserTest::testFolding()
+{
+	std::string s("GET / HTTP/1.1\r\nX-Folded: first\r\n  second\r\n\tthird  \r\nX-Plain: plain\r\n\r\n");
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, s) == s.size());
+	assertTrue (parser.fields().size() == 2);
+	assertTrue (parser.fields()[0].folded);
+	assertTrue (parser.fields()[0].value() == "first  second\tthird");
+	assertTrue (!parser.fields()[1].folded);
+	assertTrue (parser.fields()[1].value() == "plain");
+
+	std::istringstream istr(s.substr(16));
+	MessageHeader mh;
+	mh.read(istr);
+	assertTrue (mh.get("X-Folded") == parser.fields()[0].value());
+}
+
+
+void HTTPHeaderParserTest::testInvalidLines()
+{
+	std::string s("GET / HTTP/1.1\r\nHost: localhost\r\nthis is not a field\r\nAccept: */*\r\n\r\n");
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, s) == s.size());
+	assertTrue (parser.fields().size() == 2);
+	assertTrue (parser.fields()[1].name.equals("Accept"));
+}
+
+
+void HTTPHeaderParserTest::testLimits()
+{
+	HTTPHeaderParser parser(2);
+	try
+	{
+		parseRequest(parser, "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n");
+		fail("too many fields - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+	parser.setFieldLimit(0);
+	assertTrue (parseRequest(parser, "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n") > 0);
+
+	std::string longName(300, 'n');
+	try
+	{
+		parseRequest(parser, "GET / HTTP/1.1\r\n" + longName + ": value\r\n\r\n");
+		fail("name too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+
+	std::string longValue(9000, 'v');
+	try
+	{
+		parseRequest(parser, "GET / HTTP/1.1\r\nName: " + longValue + "\r\n\r\n");
+		fail("value too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void HTTPHeaderParserTest::testBadRequestLine()
+{
+	HTTPHeaderParser parser;
+	try
+	{
+		parseRequest(parser, "GET\r\n\r\n");
+		fail("no URI - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+
+	try
+	{
+		parseRequest(parser, std::string(40, 'G') + " / HTTP/1.1\r\n\r\n");
+		fail("method too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+
+	try
+	{
+		parseRequest(parser, "GET / HTTP/1.1.1.1.1\r\n\r\n");
+		fail("version too long - must throw");
+	}
+	catch (MessageException&)
+	{
+	}
+}
+
+
+void HTTPHeaderParserTest::testParseHeader()
+{
+	std::string s("Content-Type: text/plain\r\nContent-Length: 10\r\n\r\n0123456789");
+	HTTPHeaderParser parser;
+	assertTrue (parser.parseHeader(s.data(), s.data() + s.size()) == s.size() - 10);
+	assertTrue (parser.fields().size() == 2);
+	assertTrue (parser.find("Content-Type")->value() == "text/plain");
+
+	std::string empty("\r\n");
+	assertTrue (parser.parseHeader(empty.data(), empty.data() + empty.size()) == 2);
+	assertTrue (parser.fields().empty());
+}
+
+
+void HTTPHeaderParserTest::testFill()
+{
+	std::string s("POST /form?x=1 HTTP/1.1\r\nHost: localhost\r\nX-Test: a\r\nX-Test: b\r\nX-Encoded: =?ISO-8859-1?q?Hello_World?=\r\nContent-Length: 5\r\n\r\n");
+	HTTPHeaderParser parser;
+	assertTrue (parseRequest(parser, s) == s.size());
+
+	HTTPRequest request;
+	parser.fill(request);
+	assertTrue (request.getMethod() == HTTPRequest::HTTP_POST);
+	assertTrue (request.getURI() == "/form?x=1");
+	assertTrue (request.getVersion() == HTTPMessage::HTTP_1_1);
+	assertTrue (request.getHost() == "localhost");
+	assertTrue (request.getContentLength() == 5);
+	assertTrue (request.size() == 5);
+
+	HTTPRequest streamRequest;
+	std::istringstream istr(s);
+	streamRequest.read(istr);
+	assertTrue (streamRequest.getMethod() == request.getMethod());
+	assertTrue (streamRequest.getURI() == request.getURI());
+	assertTrue (streamRequest.getVersion() == request.getVersion());
+	assertTrue (streamRequest.size() == request.size());
+	assertTrue (streamRequest.get("X-Encoded") == request.get("X-Encoded"));
+	assertTrue (request.get("X-Encoded") == "Hello World");
+}
+
+
+void HTTPHeaderParserTest::testArena()
+{
+	Poco::MonotonicArena arena;
+	HTTPHeaderParser parser(0, arena);
+	std::string s("GET / HTTP/1.1\r\n");
+	for (int i = 0; i < 50; ++i) s += "X-Field: value\r\n";
+	s += "\r\n";
+	assertTrue (parseRequest(parser, s) == s.size());
+	assertTrue (parser.fields().size() == 50);
+	assertTrue (parser.fields().get_allocator().arena() == &arena);
+	assertTrue (arena.allocated() >= 50*sizeof(HTTPHeaderParser::Field));
+
+	HTTPRequest request;
+	parser.fill(request);
+	assertTrue (request.getMethod() == "GET");
+	assertTrue (request.size() == 50);
+}
+
+
+void HTTPHeaderParserTest::setUp()
+{
+}
+
+
+void HTTPHeaderParserTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPHeaderParserTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPHeaderParserTest");
+
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testParseRequest);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testParseRequestLF);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testIncomplete);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testFolding);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testInvalidLines);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testLimits);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testBadRequestLine);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testParseHeader);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testFill);
+	CppUnit_addTest(pSuite, HTTPHeaderParserTest, testArena);
+
+	return pSuite;
+}
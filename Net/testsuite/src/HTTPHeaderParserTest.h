@@ -0,0 +1,47 @@
+//
+// HTTPHeaderParserTest.h
+//
+// Definition of the HTTPHeaderParserTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef HTTPHeaderParserTest_INCLUDED
+#define HTTPHeaderParserTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class HTTPHeaderParserTest: public CppUnit::TestCase
+{
+public:
+	HTTPHeaderParserTest(const std::string& name);
+	~HTTPHeaderParserTest();
+
+	void testParseRequest();
+	void testParseRequestLF();
+	void testIncomplete();
+	void testFolding();
+	void testInvalidLines();
+	void testLimits();
+	void testBadRequestLine();
+	void testParseHeader();
+	void testFill();
+	void testArena();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // HTTPHeaderParserTest_INCLUDED
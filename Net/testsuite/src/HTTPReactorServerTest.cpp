@@ -0,0 +1,478 @@
+//
+// HTTPReactorServerTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "HTTPReactorServerTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/HTTPReactorServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
+#include <sstream>
+
+
+using Poco::Net::HTTPReactorServer;
+using Poco::Net::HTTPServerParams;
+using Poco::Net::HTTPRequestHandler;
+using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::HTTPClientSession;
+using Poco::Net::HTTPRequest;
+using Poco::Net::HTTPServerRequest;
+using Poco::Net::HTTPResponse;
+using Poco::Net::HTTPServerResponse;
+using Poco::Net::HTTPMessage;
+using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::StreamCopier;
+using Poco::ThreadPool;
+
+
+namespace
+{
+	class EchoBodyRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			if (request.getChunkedTransferEncoding())
+				response.setChunkedTransferEncoding(true);
+			else if (request.getContentLength() != HTTPMessage::UNKNOWN_CONTENT_LENGTH)
+				response.setContentLength(request.getContentLength());
+
+			response.setContentType(request.getContentType());
+
+			std::istream& istr = request.stream();
+			std::ostream& ostr = response.send();
+			StreamCopier::copyStream(istr, ostr);
+		}
+	};
+
+	class BufferRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			std::string data("xxxxxxxxxx");
+			response.sendBuffer(data.data(), data.length());
+		}
+	};
+
+	std::string receiveAll(StreamSocket& ss)
+	{
+		char buffer[1024];
+		ss.setReceiveTimeout(Poco::Timespan(5, 0));
+		std::string response;
+		int n;
+		while ((n = ss.receiveBytes(buffer, sizeof(buffer))) > 0)
+		{
+			response.append(buffer, n);
+		}
+		return response;
+	}
+
+	class SlowRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			Poco::Thread::sleep(500);
+			std::string data("xxxxxxxxxx");
+			response.sendBuffer(data.data(), data.length());
+		}
+	};
+
+	class RequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			if (request.getURI() == "/echoBody")
+				return new EchoBodyRequestHandler;
+			else if (request.getURI() == "/buffer")
+				return new BufferRequestHandler;
+			else if (request.getURI() == "/slow")
+				return new SlowRequestHandler;
+			else
+				return 0;
+		}
+	};
+}
+
+
+HTTPReactorServerTest::HTTPReactorServerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+HTTPReactorServerTest::~HTTPReactorServerTest()
+{
+}
+
+
+void HTTPReactorServerTest::testIdentityRequest()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	pParams->setMaxThreads(2);
+	int defaultPoolUsed = Poco::ThreadPool::defaultPool().used();
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+	assertTrue (srv.workerThreads() == 2);
+	// the workers do not occupy the default thread pool
+	assertTrue (Poco::ThreadPool::defaultPool().used() <= defaultPoolUsed);
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody");
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getContentLength() == body.size());
+	assertTrue (response.getContentType() == "text/plain");
+	assertTrue (rbody == body);
+	assertTrue (srv.totalConnections() == 1);
+	assertTrue (srv.totalRequests() == 1);
+}
+
+
+void HTTPReactorServerTest::testChunkedRequest()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody");
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	cs.sendRequest(request) << body;
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getContentLength() == HTTPMessage::UNKNOWN_CONTENT_LENGTH);
+	assertTrue (response.getContentType() == "text/plain");
+	assertTrue (response.getChunkedTransferEncoding());
+	assertTrue (rbody == body);
+}
+
+
+void HTTPReactorServerTest::testIdentityRequestKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	cs.setKeepAlive(true);
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentLength((int) body.length());
+	request.setContentType("text/plain");
+	for (int i = 0; i < 5; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getContentLength() == body.size());
+		assertTrue (response.getContentType() == "text/plain");
+		assertTrue (response.getKeepAlive());
+		assertTrue (rbody == body);
+	}
+	assertTrue (srv.totalConnections() == 1);
+	assertTrue (srv.totalRequests() == 5);
+}
+
+
+void HTTPReactorServerTest::testChunkedRequestKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	cs.setKeepAlive(true);
+	std::string body(5000, 'x');
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	for (int i = 0; i < 5; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getChunkedTransferEncoding());
+		assertTrue (response.getKeepAlive());
+		assertTrue (rbody == body);
+	}
+	assertTrue (srv.totalConnections() == 1);
+}
+
+
+void HTTPReactorServerTest::testMaxKeepAlive()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxKeepAliveRequests(4);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("POST", "/echoBody", HTTPMessage::HTTP_1_1);
+	request.setContentType("text/plain");
+	request.setChunkedTransferEncoding(true);
+	std::string body(5000, 'x');
+	for (int i = 0; i < 3; ++i)
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getKeepAlive());
+		assertTrue (rbody == body);
+	}
+
+	{
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (!response.getKeepAlive());
+		assertTrue (rbody == body);
+	}
+}
+
+
+void HTTPReactorServerTest::test100Continue()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", srv.port()));
+	std::string header("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\nExpect: 100-continue\r\n\r\n");
+	ss.sendBytes(header.data(), (int) header.size());
+
+	char buffer[1024];
+	ss.setReceiveTimeout(Poco::Timespan(5, 0));
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	std::string cont(buffer, n);
+	assertTrue (cont == "HTTP/1.1 100 Continue\r\n\r\n");
+
+	ss.sendBytes("hello", 5);
+	std::string response;
+	while ((n = ss.receiveBytes(buffer, sizeof(buffer))) > 0)
+	{
+		response.append(buffer, n);
+	}
+	assertTrue (response.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+	assertTrue (response.find("100 Continue") == std::string::npos);
+	assertTrue (response.substr(response.size() - 5) == "hello");
+}
+
+
+void HTTPReactorServerTest::testPipelinedRequests()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", srv.port()));
+	std::string requests(
+		"GET /buffer HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		"POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nhello"
+		"GET /buffer HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+	ss.sendBytes(requests.data(), (int) requests.size());
+
+	char buffer[1024];
+	ss.setReceiveTimeout(Poco::Timespan(5, 0));
+	std::string response;
+	int n;
+	while ((n = ss.receiveBytes(buffer, sizeof(buffer))) > 0)
+	{
+		response.append(buffer, n);
+	}
+	std::string::size_type first = response.find("\r\n\r\nxxxxxxxxxx");
+	std::string::size_type second = response.find("\r\n\r\nhello", first);
+	std::string::size_type third = response.find("\r\n\r\nxxxxxxxxxx", second);
+	assertTrue (first != std::string::npos);
+	assertTrue (second != std::string::npos);
+	assertTrue (third != std::string::npos);
+	assertTrue (srv.totalConnections() == 1);
+	assertTrue (srv.totalRequests() == 3);
+}
+
+
+void HTTPReactorServerTest::testNotImpl()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", srv.port());
+	HTTPRequest request("GET", "/notImpl");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	cs.receiveResponse(response) >> rbody;
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_NOT_IMPLEMENTED);
+	assertTrue (rbody.empty());
+}
+
+
+void HTTPReactorServerTest::testRequestTooLarge()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setMaxThreads(2);
+	pParams->setMaxHeaderSize(1024);
+	pParams->setMaxBodySize(1000);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	{
+		// rejected as soon as the header has been received
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", srv.port()));
+		std::string request("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Length: 1001\r\n\r\n");
+		ss.sendBytes(request.data(), (int) request.size());
+		std::string response = receiveAll(ss);
+		assertTrue (response.find("HTTP/1.1 413") == 0);
+	}
+	{
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", srv.port()));
+		std::string request("POST /echoBody HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n"
+			"100\r\n");
+		request.append(256, 'x');
+		request.append("\r\n400\r\n");
+		ss.sendBytes(request.data(), (int) request.size());
+		std::string response = receiveAll(ss);
+		assertTrue (response.find("HTTP/1.1 413") == 0);
+	}
+	{
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", srv.port()));
+		std::string request("GET /buffer HTTP/1.1\r\nHost: localhost\r\nX-Large: ");
+		request.append(2000, 'x');
+		ss.sendBytes(request.data(), (int) request.size());
+		std::string response = receiveAll(ss);
+		assertTrue (response.find("HTTP/1.1 431") == 0);
+	}
+	{
+		HTTPClientSession cs("127.0.0.1", srv.port());
+		std::string body(1000, 'x');
+		HTTPRequest request("POST", "/echoBody");
+		request.setChunkedTransferEncoding(true);
+		cs.sendRequest(request) << body;
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+		assertTrue (rbody == body);
+	}
+	assertTrue (srv.totalRequests() == 1);
+}
+
+
+void HTTPReactorServerTest::testStopWithRequestInProgress()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setMaxThreads(2);
+	HTTPReactorServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", srv.port()));
+	std::string request("GET /slow HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	ss.sendBytes(request.data(), (int) request.size());
+	Poco::Thread::sleep(200);
+
+	Poco::RunnableAdapter<HTTPReactorServer> stopper(srv, &HTTPReactorServer::stop);
+	Poco::Thread thread;
+	thread.start(stopper);
+	std::string response = receiveAll(ss);
+	thread.join();
+
+	assertTrue (response.find("HTTP/1.1 200") == 0);
+	assertTrue (response.substr(response.size() - 10) == "xxxxxxxxxx");
+	assertTrue (srv.currentConnections() == 0);
+}
+
+
+void HTTPReactorServerTest::setUp()
+{
+}
+
+
+void HTTPReactorServerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* HTTPReactorServerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("HTTPReactorServerTest");
+
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testIdentityRequest);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testChunkedRequest);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testIdentityRequestKeepAlive);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testChunkedRequestKeepAlive);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testMaxKeepAlive);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, test100Continue);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testPipelinedRequests);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testNotImpl);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testRequestTooLarge);
+	CppUnit_addTest(pSuite, HTTPReactorServerTest, testStopWithRequestInProgress);
+
+	return pSuite;
+}
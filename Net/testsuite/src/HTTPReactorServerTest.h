@@ -0,0 +1,47 @@
+//
+// HTTPReactorServerTest.h
+//
+// Definition of the HTTPReactorServerTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef HTTPReactorServerTest_INCLUDED
+#define HTTPReactorServerTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class HTTPReactorServerTest: public CppUnit::TestCase
+{
+public:
+	HTTPReactorServerTest(const std::string& name);
+	~HTTPReactorServerTest();
+
+	void testIdentityRequest();
+	void testChunkedRequest();
+	void testIdentityRequestKeepAlive();
+	void testChunkedRequestKeepAlive();
+	void testMaxKeepAlive();
+	void test100Continue();
+	void testPipelinedRequests();
+	void testNotImpl();
+	void testRequestTooLarge();
+	void testStopWithRequestInProgress();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // HTTPReactorServerTest_INCLUDED
@@ -21,7 +21,13 @@
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Thread.h"
 #include <sstream>
 
 
@@ -37,11 +43,47 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPServerResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::ServerSocket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
 using Poco::StreamCopier;
+using Poco::TemporaryFile;
+using Poco::ErrorHandler;
 
 
 namespace
 {
+	class CountingErrorHandler: public ErrorHandler
+	{
+	public:
+		CountingErrorHandler():
+			_count(0)
+		{
+		}
+
+		void exception(const Poco::Exception&)
+		{
+			++_count;
+		}
+
+		void exception(const std::exception&)
+		{
+			++_count;
+		}
+
+		void exception()
+		{
+			++_count;
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		int _count;
+	};
+
 	class EchoBodyRequestHandler: public HTTPRequestHandler
 	{
 	public:
@@ -104,6 +146,53 @@ namespace
 		}
 	};
 	
+	class FileRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		FileRequestHandler(const std::string& path):
+			_path(path)
+		{
+		}
+
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			response.sendFile(_path, "text/plain");
+		}
+
+	private:
+		std::string _path;
+	};
+
+	class FileRequestHandlerFactory: public HTTPRequestHandlerFactory
+	{
+	public:
+		FileRequestHandlerFactory(const std::string& path):
+			_path(path)
+		{
+		}
+
+		HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request)
+		{
+			return new FileRequestHandler(_path);
+		}
+
+	private:
+		std::string _path;
+	};
+
+	std::string createFile(TemporaryFile& file, std::size_t size)
+	{
+		std::string content;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			content += static_cast<char>('a' + i % 26);
+		}
+		Poco::FileOutputStream ostr(file.path());
+		ostr << content;
+		ostr.close();
+		return content;
+	}
+
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
@@ -516,6 +605,310 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testPipelining()
+{
+	std::string requests(
+		"GET /buffer HTTP/1.1\r\nHost: localhost\r\n\r\n"
+		"POST /echoBody HTTP/1.1\r\nHost: localhost\r\nContent-Type: text/plain\r\nContent-Length: 5\r\n\r\nhello"
+		"GET /buffer HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+
+	for (int batching = 0; batching < 2; ++batching)
+	{
+		ServerSocket svs(0);
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		pParams->setResponseBatching(batching != 0);
+		HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+		srv.start();
+
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", svs.address().port()));
+		ss.sendBytes(requests.data(), (int) requests.size());
+		ss.setReceiveTimeout(Poco::Timespan(10, 0));
+
+		std::string response;
+		char buffer[1024];
+		int n;
+		while ((n = ss.receiveBytes(buffer, sizeof(buffer))) > 0)
+		{
+			response.append(buffer, n);
+		}
+		std::string::size_type first = response.find("\r\n\r\nxxxxxxxxxx");
+		assertTrue (first != std::string::npos);
+		std::string::size_type second = response.find("\r\n\r\nhello", first);
+		assertTrue (second != std::string::npos);
+		std::string::size_type third = response.find("\r\n\r\nxxxxxxxxxx", second);
+		assertTrue (third != std::string::npos);
+		assertTrue (response.size() == third + 14);
+	}
+}
+
+
+void HTTPServerTest::testConnectionReset()
+{
+	CountingErrorHandler errorHandler;
+	ErrorHandler* pOldErrorHandler = ErrorHandler::set(&errorHandler);
+	try
+	{
+		ServerSocket svs(0);
+		HTTPServerParams* pParams = new HTTPServerParams;
+		pParams->setKeepAlive(true);
+		HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+		srv.start();
+
+		StreamSocket ss;
+		ss.connect(SocketAddress("127.0.0.1", svs.address().port()));
+		std::string request("GET /buffer HTTP/1.1\r\nHost: localhost\r\n\r\n");
+		ss.sendBytes(request.data(), (int) request.size());
+		ss.setReceiveTimeout(Poco::Timespan(10, 0));
+
+		std::string response;
+		char buffer[1024];
+		while (response.find("xxxxxxxxxx") == std::string::npos)
+		{
+			int n = ss.receiveBytes(buffer, sizeof(buffer));
+			assertTrue (n > 0);
+			response.append(buffer, n);
+		}
+
+		// a reset between requests on a persistent connection is not an error
+		ss.setLinger(true, 0);
+		ss.close();
+		Poco::Thread::sleep(200);
+		srv.stop();
+	}
+	catch (...)
+	{
+		ErrorHandler::set(pOldErrorHandler);
+		throw;
+	}
+	ErrorHandler::set(pOldErrorHandler);
+	assertTrue (errorHandler.count() == 0);
+}
+
+
+void HTTPServerTest::testFile()
+{
+	TemporaryFile file;
+	std::string content = createFile(file, 100000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new FileRequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	for (int i = 0; i < 2; ++i)
+	{
+		HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = cs.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+		assertTrue (response.getContentLength() == 100000);
+		assertTrue (response.get("Accept-Ranges") == "bytes");
+		assertTrue (response.has("ETag"));
+		assertTrue (response.has("Last-Modified"));
+		assertTrue (ostr.str() == content);
+	}
+
+	HTTPRequest request("HEAD", "/file", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (response.getContentLength() == 100000);
+	assertTrue (ostr.str().empty());
+}
+
+
+void HTTPServerTest::testFileRange()
+{
+	TemporaryFile file;
+	std::string content = createFile(file, 10000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new FileRequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+
+	static const struct
+	{
+		const char* range;
+		const char* contentRange;
+		std::size_t first;
+		std::size_t length;
+	}
+	tests[] =
+	{
+		{ "bytes=0-99",       "bytes 0-99/10000",       0,    100 },
+		{ "bytes=9000-",      "bytes 9000-9999/10000",  9000, 1000 },
+		{ "bytes=-500",       "bytes 9500-9999/10000",  9500, 500 },
+		{ "bytes=5000-20000", "bytes 5000-9999/10000",  5000, 5000 },
+		{ "bytes=-20000",     "bytes 0-9999/10000",     0,    10000 }
+	};
+	for (std::size_t i = 0; i < sizeof(tests)/sizeof(tests[0]); ++i)
+	{
+		HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+		request.set("Range", tests[i].range);
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::istream& rs = cs.receiveResponse(response);
+		std::ostringstream ostr;
+		StreamCopier::copyStream(rs, ostr);
+		assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+		assertTrue (response.get("Content-Range") == tests[i].contentRange);
+		assertTrue (response.getContentLength() == tests[i].length);
+		assertTrue (ostr.str() == content.substr(tests[i].first, tests[i].length));
+	}
+
+	// invalid ranges are ignored
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	request.set("Range", "bytes=100-50");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (ostr.str() == content);
+
+	// unsatisfiable ranges
+	request.set("Range", "bytes=10000-");
+	cs.sendRequest(request);
+	std::istream& rs2 = cs.receiveResponse(response);
+	std::ostringstream ostr2;
+	StreamCopier::copyStream(rs2, ostr2);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+	assertTrue (response.get("Content-Range") == "bytes */10000");
+	assertTrue (ostr2.str().empty());
+}
+
+
+void HTTPServerTest::testFileMultiRange()
+{
+	TemporaryFile file;
+	std::string content = createFile(file, 10000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new FileRequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	request.set("Range", "bytes=0-9, 20000-, -5");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (response.getContentType().compare(0, 31, "multipart/byteranges; boundary=") == 0);
+	assertTrue (ostr.str().size() == response.getContentLength());
+
+	std::string boundary = response.getContentType().substr(31);
+	std::string expected;
+	expected += "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\nContent-Range: bytes 0-9/10000\r\n\r\n";
+	expected += content.substr(0, 10);
+	expected += "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\nContent-Range: bytes 9995-9999/10000\r\n\r\n";
+	expected += content.substr(9995);
+	expected += "\r\n--" + boundary + "--\r\n";
+	assertTrue (ostr.str() == expected);
+
+	// the connection is still usable
+	request.erase("Range");
+	cs.sendRequest(request);
+	std::istream& rs2 = cs.receiveResponse(response);
+	std::ostringstream ostr2;
+	StreamCopier::copyStream(rs2, ostr2);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (ostr2.str() == content);
+}
+
+
+void HTTPServerTest::testFileConditional()
+{
+	TemporaryFile file;
+	std::string content = createFile(file, 1000);
+
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(true);
+	HTTPServer srv(new FileRequestHandlerFactory(file.path()), svs, pParams);
+	srv.start();
+
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	cs.setKeepAlive(true);
+	HTTPRequest request("GET", "/file", HTTPMessage::HTTP_1_1);
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::istream& rs = cs.receiveResponse(response);
+	std::ostringstream ostr;
+	StreamCopier::copyStream(rs, ostr);
+	std::string etag = response.get("ETag");
+	std::string lastModified = response.get("Last-Modified");
+
+	request.set("If-None-Match", "\"other\", " + etag);
+	cs.sendRequest(request);
+	std::istream& rs2 = cs.receiveResponse(response);
+	std::ostringstream ostr2;
+	StreamCopier::copyStream(rs2, ostr2);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_NOT_MODIFIED);
+	assertTrue (response.get("ETag") == etag);
+	assertTrue (ostr2.str().empty());
+
+	request.erase("If-None-Match");
+	request.set("If-Modified-Since", lastModified);
+	cs.sendRequest(request);
+	std::istream& rs3 = cs.receiveResponse(response);
+	std::ostringstream ostr3;
+	StreamCopier::copyStream(rs3, ostr3);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_NOT_MODIFIED);
+	assertTrue (ostr3.str().empty());
+
+	request.set("If-Modified-Since", "Thu, 01 Jan 1970 00:00:00 GMT");
+	cs.sendRequest(request);
+	std::istream& rs4 = cs.receiveResponse(response);
+	std::ostringstream ostr4;
+	StreamCopier::copyStream(rs4, ostr4);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (ostr4.str() == content);
+
+	// If-Range with a matching validator honors the range
+	request.erase("If-Modified-Since");
+	request.set("Range", "bytes=0-9");
+	request.set("If-Range", etag);
+	cs.sendRequest(request);
+	std::istream& rs5 = cs.receiveResponse(response);
+	std::ostringstream ostr5;
+	StreamCopier::copyStream(rs5, ostr5);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_PARTIAL_CONTENT);
+	assertTrue (ostr5.str() == content.substr(0, 10));
+
+	// otherwise, the complete file is sent
+	request.set("If-Range", "\"other\"");
+	cs.sendRequest(request);
+	std::istream& rs6 = cs.receiveResponse(response);
+	std::ostringstream ostr6;
+	StreamCopier::copyStream(rs6, ostr6);
+	assertTrue (response.getStatus() == HTTPResponse::HTTP_OK);
+	assertTrue (ostr6.str() == content);
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -544,6 +937,12 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testPipelining);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFile);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileRange);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileMultiRange);
+	CppUnit_addTest(pSuite, HTTPServerTest, testFileConditional);
+	CppUnit_addTest(pSuite, HTTPServerTest, testConnectionReset);
 
 	return pSuite;
 }
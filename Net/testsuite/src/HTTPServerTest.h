@@ -38,6 +38,12 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testPipelining();
+	void testFile();
+	void testFileRange();
+	void testFileMultiRange();
+	void testFileConditional();
+	void testConnectionReset();
 
 	void setUp();
 	void tearDown();
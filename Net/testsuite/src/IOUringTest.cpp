@@ -0,0 +1,226 @@
+//
+// IOUringTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "IOUringTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/IOUring.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/StreamSocketImpl.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Timespan.h"
+#include <iostream>
+#include <cerrno>
+
+
+using Poco::Net::IOUring;
+using Poco::Net::PollSet;
+using Poco::Net::StreamSocket;
+using Poco::Net::StreamSocketImpl;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+using Poco::Timespan;
+
+
+namespace
+{
+	bool waitFor(IOUring& ring, Poco::UInt64 userData, IOUring::Completion& result, IOUring::CompletionVec& others)
+		/// Waits (for at most a few seconds) for the completion with
+		/// the given user data. Other completions are collected in others.
+	{
+		IOUring::CompletionVec completions;
+		for (int i = 0; i < 50; ++i)
+		{
+			ring.wait(Timespan(100000), completions);
+			bool found = false;
+			for (IOUring::CompletionVec::const_iterator it = completions.begin(); it != completions.end(); ++it)
+			{
+				if (it->userData == userData && !found)
+				{
+					result = *it;
+					found = true;
+				}
+				else others.push_back(*it);
+			}
+			if (found) return true;
+		}
+		return false;
+	}
+
+	bool skip()
+	{
+		if (IOUring::available()) return false;
+		std::cout << "io_uring not available, skipping" << std::endl;
+		return true;
+	}
+}
+
+
+IOUringTest::IOUringTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+IOUringTest::~IOUringTest()
+{
+}
+
+
+void IOUringTest::testConnectSendReceive()
+{
+	if (skip()) return;
+
+	EchoServer echoServer;
+	IOUring ring;
+	IOUring::Completion completion;
+	IOUring::CompletionVec others;
+
+	StreamSocket ss(SocketAddress::IPv4);
+	SocketAddress address("127.0.0.1", echoServer.port());
+	ring.connect(ss, address, 1);
+	assertTrue (waitFor(ring, 1, completion, others));
+	assertTrue (completion.result == 0);
+	assertTrue (ss.peerAddress().port() == echoServer.port());
+
+	// send and receive are submitted together
+	char buffer[256];
+	ring.send(ss, "hello", 5, 2);
+	ring.receive(ss, buffer, sizeof(buffer), 3);
+	assertTrue (waitFor(ring, 3, completion, others));
+	assertTrue (completion.result == 5);
+	assertTrue (std::string(buffer, completion.result) == "hello");
+	assertTrue (others.size() == 1);
+	assertTrue (others[0].userData == 2);
+	assertTrue (others[0].result == 5);
+
+	ss.close();
+}
+
+
+void IOUringTest::testAccept()
+{
+	if (skip()) return;
+
+	ServerSocket serverSocket(SocketAddress("127.0.0.1", 0));
+	IOUring ring;
+	IOUring::Completion completion;
+	IOUring::CompletionVec others;
+
+	ring.accept(serverSocket, 1);
+	assertTrue (ring.submit() == 1);
+
+	StreamSocket client;
+	client.connect(SocketAddress("127.0.0.1", serverSocket.address().port()));
+	assertTrue (waitFor(ring, 1, completion, others));
+	assertTrue (completion.result >= 0);
+
+	StreamSocket connection(new StreamSocketImpl(completion.result));
+	client.sendBytes("hello", 5);
+	char buffer[256];
+	int n = connection.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+	assertTrue (std::string(buffer, n) == "hello");
+	assertTrue (connection.peerAddress() == client.address());
+
+	client.close();
+	connection.close();
+}
+
+
+void IOUringTest::testPoll()
+{
+	if (skip()) return;
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	IOUring ring;
+	IOUring::CompletionVec completions;
+
+	// one-shot
+	ring.poll(ss.impl()->sockfd(), PollSet::POLL_READ, 1);
+	assertTrue (ring.wait(Timespan(100000), completions) == 0);
+	ss.sendBytes("hello", 5);
+	IOUring::Completion completion;
+	IOUring::CompletionVec others;
+	assertTrue (waitFor(ring, 1, completion, others));
+	assertTrue (IOUring::pollMode(completion.result) == PollSet::POLL_READ);
+	assertTrue ((completion.flags & IOUring::MORE) == 0);
+	char buffer[256];
+	assertTrue (ss.receiveBytes(buffer, sizeof(buffer)) == 5);
+
+	// multishot
+	ring.poll(ss.impl()->sockfd(), PollSet::POLL_READ, 2, true);
+	ss.sendBytes("hello", 5);
+	assertTrue (waitFor(ring, 2, completion, others));
+	assertTrue (IOUring::pollMode(completion.result) == PollSet::POLL_READ);
+	assertTrue ((completion.flags & IOUring::MORE) != 0);
+	assertTrue (ss.receiveBytes(buffer, sizeof(buffer)) == 5);
+	ss.sendBytes("hello", 5);
+	assertTrue (waitFor(ring, 2, completion, others));
+	assertTrue ((completion.flags & IOUring::MORE) != 0);
+	assertTrue (ss.receiveBytes(buffer, sizeof(buffer)) == 5);
+
+	ring.removePoll(2, 3);
+	assertTrue (waitFor(ring, 2, completion, others));
+	assertTrue (completion.result == -ECANCELED);
+	assertTrue ((completion.flags & IOUring::MORE) == 0);
+
+	ss.close();
+}
+
+
+void IOUringTest::testCancel()
+{
+	if (skip()) return;
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	IOUring ring;
+	IOUring::CompletionVec completions;
+
+	char buffer[256];
+	ring.receive(ss, buffer, sizeof(buffer), 1);
+	assertTrue (ring.wait(Timespan(100000), completions) == 0);
+	ring.cancel(1, 2);
+	IOUring::Completion completion;
+	IOUring::CompletionVec others;
+	assertTrue (waitFor(ring, 1, completion, others));
+	assertTrue (completion.result == -ECANCELED);
+
+	ss.close();
+}
+
+
+void IOUringTest::setUp()
+{
+}
+
+
+void IOUringTest::tearDown()
+{
+}
+
+
+CppUnit::Test* IOUringTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("IOUringTest");
+
+	CppUnit_addTest(pSuite, IOUringTest, testConnectSendReceive);
+	CppUnit_addTest(pSuite, IOUringTest, testAccept);
+	CppUnit_addTest(pSuite, IOUringTest, testPoll);
+	CppUnit_addTest(pSuite, IOUringTest, testCancel);
+
+	return pSuite;
+}
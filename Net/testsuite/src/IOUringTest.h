@@ -0,0 +1,41 @@
+//
+// IOUringTest.h
+//
+// Definition of the IOUringTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef IOUringTest_INCLUDED
+#define IOUringTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class IOUringTest: public CppUnit::TestCase
+{
+public:
+	IOUringTest(const std::string& name);
+	~IOUringTest();
+
+	void testConnectSendReceive();
+	void testAccept();
+	void testPoll();
+	void testCancel();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // IOUringTest_INCLUDED
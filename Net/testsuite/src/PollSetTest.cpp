@@ -17,7 +17,9 @@
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/NetException.h"
 #include "Poco/Net/PollSet.h"
+#include "Poco/Net/IOUring.h"
 #include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using Poco::Net::Socket;
@@ -26,6 +28,7 @@ using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Net::ConnectionRefusedException;
 using Poco::Net::PollSet;
+using Poco::Net::IOUring;
 using Poco::Timespan;
 using Poco::Stopwatch;
 
@@ -41,6 +44,31 @@ PollSetTest::~PollSetTest()
 
 
 void PollSetTest::testPoll()
+{
+	poll(PollSet::BACKEND_NATIVE);
+}
+
+
+void PollSetTest::testPollEvents()
+{
+	pollEvents(PollSet::BACKEND_NATIVE);
+}
+
+
+void PollSetTest::testPollIOUring()
+{
+	if (!IOUring::available())
+	{
+		std::cout << "io_uring not available, skipping" << std::endl;
+		return;
+	}
+	poll(PollSet::BACKEND_IO_URING);
+	pollEvents(PollSet::BACKEND_IO_URING);
+	assertTrue (PollSet(PollSet::BACKEND_IO_URING).backend() == PollSet::BACKEND_IO_URING);
+}
+
+
+void PollSetTest::poll(PollSet::Backend backend)
 {
 	EchoServer echoServer1;
 	EchoServer echoServer2;
@@ -50,7 +78,7 @@ void PollSetTest::testPoll()
 	ss1.connect(SocketAddress("127.0.0.1", echoServer1.port()));
 	ss2.connect(SocketAddress("127.0.0.1", echoServer2.port()));
 
-	PollSet ps;
+	PollSet ps(backend);
 	assertTrue(ps.empty());
 	ps.add(ss1, PollSet::POLL_READ);
 	assertTrue(!ps.empty());
@@ -125,6 +153,76 @@ void PollSetTest::testPoll()
 }
 
 
+void PollSetTest::pollEvents(PollSet::Backend backend)
+{
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1;
+	StreamSocket ss2;
+
+	ss1.connect(SocketAddress("127.0.0.1", echoServer1.port()));
+	ss2.connect(SocketAddress("127.0.0.1", echoServer2.port()));
+
+	PollSet ps(backend);
+	PollSet::EventVec events;
+	assertTrue (ps.poll(Timespan(1000), events) == 0);
+	assertTrue (events.empty());
+
+	ps.add(ss1, PollSet::POLL_READ);
+	ps.add(ss2, PollSet::POLL_READ);
+
+	// nothing readable
+	Timespan timeout(1000000);
+	Stopwatch sw;
+	sw.start();
+	assertTrue (ps.poll(timeout, events) == 0);
+	assertTrue (events.empty());
+	assertTrue (sw.elapsed() >= 900000);
+
+	ss2.sendBytes("HELLO", 5);
+	sw.restart();
+	assertTrue (ps.poll(timeout, events) == 1);
+	assertTrue (events.size() == 1);
+	assertTrue (events[0].fd == ss2.impl()->sockfd());
+	assertTrue (events[0].mode == PollSet::POLL_READ);
+	assertTrue (sw.elapsed() < 100000);
+
+	char buffer[256];
+	int n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+	assertTrue (std::string(buffer, n) == "HELLO");
+
+	// ss1 must be writable, if polled for
+	ps.update(ss1, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	assertTrue (ps.poll(timeout, events) == 1);
+	assertTrue (events[0].fd == ss1.impl()->sockfd());
+	assertTrue (events[0].mode == PollSet::POLL_WRITE);
+
+#if defined(POCO_HAVE_FD_EPOLL)
+	// one-shot: reported once, then disabled until re-armed
+	ps.update(ss1, PollSet::POLL_WRITE | PollSet::POLL_ONESHOT);
+	assertTrue (ps.poll(timeout, events) == 1);
+	assertTrue (events[0].fd == ss1.impl()->sockfd());
+	assertTrue (ps.poll(Timespan(100000), events) == 0);
+	ps.update(ss1, PollSet::POLL_WRITE | PollSet::POLL_ONESHOT);
+	assertTrue (ps.poll(timeout, events) == 1);
+
+	// edge-triggered: reported once per state change
+	ps.update(ss1, PollSet::POLL_READ);
+	ps.update(ss2, PollSet::POLL_READ | PollSet::POLL_EDGE);
+	ss2.sendBytes("HELLO", 5);
+	assertTrue (ps.poll(timeout, events) == 1);
+	assertTrue (events[0].fd == ss2.impl()->sockfd());
+	assertTrue (ps.poll(Timespan(100000), events) == 0);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n == 5);
+#endif
+
+	ss1.close();
+	ss2.close();
+}
+
+
 void PollSetTest::setUp()
 {
 }
@@ -140,6 +238,8 @@ CppUnit::Test* PollSetTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
 
 	CppUnit_addTest(pSuite, PollSetTest, testPoll);
+	CppUnit_addTest(pSuite, PollSetTest, testPollEvents);
+	CppUnit_addTest(pSuite, PollSetTest, testPollIOUring);
 
 	return pSuite;
 }
@@ -15,6 +15,7 @@
 
 
 #include "Poco/Net/Net.h"
+#include "Poco/Net/PollSet.h"
 #include "Poco/CppUnit/TestCase.h"
 
 
@@ -25,11 +26,17 @@ public:
 	~PollSetTest();
 
 	void testPoll();
+	void testPollEvents();
+	void testPollIOUring();
 
 	void setUp();
 	void tearDown();
 
 	static CppUnit::Test* suite();
+
+private:
+	void poll(Poco::Net::PollSet::Backend backend);
+	void pollEvents(Poco::Net::PollSet::Backend backend);
 };
 
 
@@ -16,26 +16,34 @@
 #include "Poco/Net/SocketConnector.h"
 #include "Poco/Net/SocketAcceptor.h"
 #include "Poco/Net/ParallelSocketAcceptor.h"
+#include "Poco/Net/ReusePortServer.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/IOUring.h"
 #include "Poco/Observer.h"
 #include "Poco/Exception.h"
 #include "Poco/Thread.h"
 #include <sstream>
+#include <iostream>
 
 
 using Poco::Net::SocketReactor;
 using Poco::Net::SocketConnector;
 using Poco::Net::SocketAcceptor;
 using Poco::Net::ParallelSocketAcceptor;
+using Poco::Net::ReusePortServer;
 using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
+using Poco::Net::IOUring;
 using Poco::Net::SocketNotification;
 using Poco::Net::ReadableNotification;
 using Poco::Net::WritableNotification;
 using Poco::Net::TimeoutNotification;
+using Poco::Net::SocketTimeoutNotification;
 using Poco::Net::ShutdownNotification;
 using Poco::Observer;
 using Poco::IllegalStateException;
@@ -362,6 +370,66 @@ namespace
 	};
 
 	DataServiceHandler::Data DataServiceHandler::_data;
+
+	class TimeoutServiceHandler
+	{
+	public:
+		TimeoutServiceHandler(const StreamSocket& socket, SocketReactor& reactor, const Poco::Timespan& interval = Poco::Timespan()):
+			_socket(socket),
+			_reactor(reactor),
+			_interval(interval),
+			_timeouts(0),
+			_reactorTimeouts(0)
+		{
+			_reactor.addEventHandler(_socket, Observer<TimeoutServiceHandler, ReadableNotification>(*this, &TimeoutServiceHandler::onReadable));
+			_reactor.addEventHandler(_socket, Observer<TimeoutServiceHandler, SocketTimeoutNotification>(*this, &TimeoutServiceHandler::onTimeout));
+			_reactor.addEventHandler(_socket, Observer<TimeoutServiceHandler, TimeoutNotification>(*this, &TimeoutServiceHandler::onReactorTimeout));
+		}
+
+		~TimeoutServiceHandler()
+		{
+			_reactor.removeEventHandler(_socket, Observer<TimeoutServiceHandler, ReadableNotification>(*this, &TimeoutServiceHandler::onReadable));
+			_reactor.removeEventHandler(_socket, Observer<TimeoutServiceHandler, SocketTimeoutNotification>(*this, &TimeoutServiceHandler::onTimeout));
+			_reactor.removeEventHandler(_socket, Observer<TimeoutServiceHandler, TimeoutNotification>(*this, &TimeoutServiceHandler::onReactorTimeout));
+		}
+
+		void onReadable(ReadableNotification* pNf)
+		{
+			pNf->release();
+			char buffer[64];
+			_socket.receiveBytes(buffer, sizeof(buffer));
+		}
+
+		void onTimeout(SocketTimeoutNotification* pNf)
+		{
+			pNf->release();
+			++_timeouts;
+			if (_interval > 0) _reactor.scheduleTimeout(_socket, _interval);
+		}
+
+		void onReactorTimeout(TimeoutNotification* pNf)
+		{
+			pNf->release();
+			++_reactorTimeouts;
+		}
+
+		int timeouts() const
+		{
+			return _timeouts;
+		}
+
+		int reactorTimeouts() const
+		{
+			return _reactorTimeouts;
+		}
+
+	private:
+		StreamSocket   _socket;
+		SocketReactor& _reactor;
+		Poco::Timespan _interval;
+		int            _timeouts;
+		int            _reactorTimeouts;
+	};
 }
 
 
@@ -414,6 +482,107 @@ void SocketReactorTest::testSetSocketReactor()
 }
 
 
+void SocketReactorTest::testSocketReactorOneShot()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketReactor reactor;
+	reactor.setPollMode(PollSet::POLL_ONESHOT);
+	assertTrue (reactor.getPollMode() == PollSet::POLL_ONESHOT);
+	SocketAcceptor<EchoServiceHandler> acceptor(ss, reactor);
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	SocketConnector<ClientServiceHandler> connector(sa, reactor);
+	ClientServiceHandler::setOnce(true);
+	ClientServiceHandler::resetData();
+	reactor.run();
+	std::string data(ClientServiceHandler::data());
+	assertTrue (data.size() == 1024);
+	assertTrue (!ClientServiceHandler::readableError());
+	assertTrue (!ClientServiceHandler::writableError());
+	assertTrue (!ClientServiceHandler::timeoutError());
+}
+
+
+void SocketReactorTest::testSocketReactorIOUring()
+{
+	if (!IOUring::available())
+	{
+		std::cout << "io_uring not available, skipping" << std::endl;
+		return;
+	}
+
+	struct DefaultBackendGuard
+	{
+		DefaultBackendGuard() { PollSet::setDefaultBackend(PollSet::BACKEND_IO_URING); }
+		~DefaultBackendGuard() { PollSet::setDefaultBackend(PollSet::BACKEND_NATIVE); }
+	} guard;
+
+	testSocketReactor();
+	testSocketReactorOneShot();
+	testParallelSocketReactor();
+}
+
+
+void SocketReactorTest::testSocketTimeout()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	StreamSocket c1(sa);
+	StreamSocket s1 = ss.acceptConnection();
+	StreamSocket c2(sa);
+	StreamSocket s2 = ss.acceptConnection();
+
+	SocketReactor reactor(Poco::Timespan(1, 0));
+	TimeoutServiceHandler h1(s1, reactor);
+	TimeoutServiceHandler h2(s2, reactor);
+	TimeoutServiceHandler h3(c1, reactor);
+	assertTrue (reactor.scheduleTimeout(s1, Poco::Timespan(0, 100000)));
+	assertTrue (reactor.scheduleTimeout(s2, Poco::Timespan(0, 100000)));
+	assertTrue (reactor.scheduleTimeout(c1, Poco::Timespan(0, 100000)));
+	assertTrue (!reactor.scheduleTimeout(c2, Poco::Timespan(0, 100000)));
+	reactor.cancelTimeout(s2);
+	// rescheduling replaces the pending timeout
+	assertTrue (reactor.scheduleTimeout(c1, Poco::Timespan(10, 0)));
+
+	Thread thread;
+	thread.start(reactor);
+	Thread::sleep(500);
+	reactor.stop();
+	thread.join();
+
+	assertTrue (h1.timeouts() == 1);
+	assertTrue (h2.timeouts() == 0);
+	assertTrue (h3.timeouts() == 0);
+}
+
+
+void SocketReactorTest::testSocketTimeoutWithReactorTimeout()
+{
+	SocketAddress ssa;
+	ServerSocket ss(ssa);
+	SocketAddress sa("127.0.0.1", ss.address().port());
+	StreamSocket c1(sa);
+	StreamSocket s1 = ss.acceptConnection();
+
+	// the socket timeout, rescheduled every 50 ms, shortens every
+	// wait, but must not suppress the reactor timeout
+	SocketReactor reactor(Poco::Timespan(0, 200000));
+	TimeoutServiceHandler h1(s1, reactor, Poco::Timespan(0, 50000));
+	assertTrue (reactor.scheduleTimeout(s1, Poco::Timespan(0, 50000)));
+
+	Thread thread;
+	thread.start(reactor);
+	Thread::sleep(1100);
+	reactor.stop();
+	thread.join();
+
+	assertTrue (h1.timeouts() >= 10);
+	assertTrue (h1.reactorTimeouts() >= 3);
+	assertTrue (h1.reactorTimeouts() <= 6);
+}
+
+
 void SocketReactorTest::testParallelSocketReactor()
 {
 	SocketAddress ssa;
@@ -440,6 +609,41 @@ void SocketReactorTest::testParallelSocketReactor()
 }
 
 
+void SocketReactorTest::testReusePortServer()
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	ReusePortServer<EchoServiceHandler> server(SocketAddress("127.0.0.1", 0), 4);
+	assertTrue (server.shards() == 4);
+	assertTrue (server.port() != 0);
+	for (std::size_t i = 0; i < server.shards(); ++i)
+	{
+		assertTrue (server.socket(i).address().port() == server.port());
+	}
+
+	SocketAddress sa("127.0.0.1", server.port());
+	std::vector<StreamSocket> sockets;
+	for (int i = 0; i < 16; ++i)
+	{
+		sockets.push_back(StreamSocket(sa));
+	}
+	for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+	{
+		it->sendBytes("hello", 5);
+		char buffer[8];
+		int n = it->receiveBytes(buffer, sizeof(buffer));
+		assertTrue (n == 5);
+		assertTrue (std::string(buffer, n) == "hello");
+	}
+	for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+	{
+		it->close();
+	}
+	server.stop();
+	assertTrue (server.shards() == 0);
+#endif
+}
+
+
 void SocketReactorTest::testSocketConnectorFail()
 {
 	SocketReactor reactor;
@@ -574,7 +778,12 @@ CppUnit::Test* SocketReactorTest::suite()
 
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactor);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSetSocketReactor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorOneShot);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketReactorIOUring);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketTimeout);
+	CppUnit_addTest(pSuite, SocketReactorTest, testSocketTimeoutWithReactorTimeout);
 	CppUnit_addTest(pSuite, SocketReactorTest, testParallelSocketReactor);
+	CppUnit_addTest(pSuite, SocketReactorTest, testReusePortServer);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorFail);
 	CppUnit_addTest(pSuite, SocketReactorTest, testSocketConnectorTimeout);
 	CppUnit_addTest(pSuite, SocketReactorTest, testDataCollection);
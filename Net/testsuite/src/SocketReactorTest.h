@@ -26,7 +26,12 @@ public:
 
 	void testSocketReactor();
 	void testSetSocketReactor();
+	void testSocketReactorOneShot();
+	void testSocketReactorIOUring();
+	void testSocketTimeout();
+	void testSocketTimeoutWithReactorTimeout();
 	void testParallelSocketReactor();
+	void testReusePortServer();
 	void testSocketConnectorFail();
 	void testSocketConnectorTimeout();
 	void testDataCollection();
@@ -22,6 +22,8 @@
 #include "Poco/FIFOBuffer.h"
 #include "Poco/Delegate.h"
 #include "Poco/File.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
 #include <iostream>
 
 
@@ -64,6 +66,46 @@ void SocketTest::testEcho()
 }
 
 
+void SocketTest::testSendFile()
+{
+	Poco::TemporaryFile file;
+	std::string content;
+	for (int i = 0; i < 10000; ++i) content += static_cast<char>('a' + i % 26);
+	Poco::FileOutputStream ostr(file.path());
+	ostr << content;
+	ostr.close();
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	Poco::FileInputStream istr(file.path());
+	Poco::Int64 n = ss.sendFile(istr, 1000, 3000);
+	assertTrue (n == 3000);
+	std::string received;
+	char buffer[1024];
+	while (received.size() < 3000)
+	{
+		int rc = ss.receiveBytes(buffer, sizeof(buffer));
+		assertTrue (rc > 0);
+		received.append(buffer, rc);
+	}
+	assertTrue (received == content.substr(1000, 3000));
+
+	// the file ends before offset + count
+	n = ss.sendFile(istr, 9500, 1000);
+	assertTrue (n == 500);
+	received.clear();
+	while (received.size() < 500)
+	{
+		int rc = ss.receiveBytes(buffer, sizeof(buffer));
+		assertTrue (rc > 0);
+		received.append(buffer, rc);
+	}
+	assertTrue (received == content.substr(9500));
+	ss.close();
+}
+
+
 void SocketTest::testPoll()
 {
 	EchoServer echoServer;
@@ -576,6 +618,7 @@ CppUnit::Test* SocketTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SocketTest");
 
 	CppUnit_addTest(pSuite, SocketTest, testEcho);
+	CppUnit_addTest(pSuite, SocketTest, testSendFile);
 	CppUnit_addTest(pSuite, SocketTest, testPoll);
 	CppUnit_addTest(pSuite, SocketTest, testAvailable);
 	CppUnit_addTest(pSuite, SocketTest, testFIFOBuffer);
@@ -18,6 +18,7 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/WorkStealingExecutor.h"
 #include <iostream>
 
 
@@ -31,6 +32,7 @@ using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Thread;
+using Poco::WorkStealingExecutor;
 
 
 namespace
@@ -277,6 +279,51 @@ void TCPServerTest::testFilter()
 }
 
 
+void TCPServerTest::testExecutor()
+{
+	WorkStealingExecutor executor(2);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), executor, ServerSocket(0));
+	srv.start();
+	assertTrue (srv.maxThreads() == 2);
+	assertTrue (srv.currentThreads() == 0);
+
+	SocketAddress sa("127.0.0.1", srv.socket().address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+	assertTrue (srv.currentConnections() == 2);
+	assertTrue (srv.currentThreads() == 2);
+
+	// the third connection is queued until a worker becomes available
+	StreamSocket ss3(sa);
+	ss3.sendBytes(data.data(), (int) data.size());
+	Thread::sleep(300);
+	assertTrue (srv.queuedConnections() == 1);
+	ss1.close();
+	n = ss3.receiveBytes(buffer, sizeof(buffer));
+	assertTrue (n > 0);
+	assertTrue (std::string(buffer, n) == data);
+	assertTrue (srv.totalConnections() == 3);
+
+	ss2.close();
+	ss3.close();
+	Thread::sleep(1000);
+	assertTrue (srv.currentConnections() == 0);
+	// no worker thread waits for new connections
+	assertTrue (srv.currentThreads() == 0);
+	srv.stop();
+}
+
+
 void TCPServerTest::setUp()
 {
 }
@@ -296,6 +343,7 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testThreadCapacity);
 	CppUnit_addTest(pSuite, TCPServerTest, testFilter);
+	CppUnit_addTest(pSuite, TCPServerTest, testExecutor);
 
 	return pSuite;
 }
@@ -29,6 +29,7 @@ public:
 	void testMultiConnections();
 	void testThreadCapacity();
 	void testFilter();
+	void testExecutor();
 
 	void setUp();
 	void tearDown();
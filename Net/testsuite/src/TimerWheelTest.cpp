@@ -0,0 +1,199 @@
+//
+// TimerWheelTest.cpp
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "TimerWheelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Net/TimerWheel.h"
+#include "Poco/Thread.h"
+
+
+using Poco::Net::TimerWheel;
+using Poco::Timespan;
+using Poco::Thread;
+
+
+TimerWheelTest::TimerWheelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+TimerWheelTest::~TimerWheelTest()
+{
+}
+
+
+void TimerWheelTest::testSchedule()
+{
+	TimerWheel wheel(Timespan(0, 1000));
+	assertTrue (wheel.empty());
+	assertTrue (wheel.resolution() == Timespan(0, 1000));
+
+	int c1 = 1;
+	int c2 = 2;
+	int c3 = 3;
+	TimerWheel::Timer t1(&c1);
+	TimerWheel::Timer t2(&c2);
+	TimerWheel::Timer t3(&c3);
+	assertTrue (t1.context() == &c1);
+	assertTrue (!t1.scheduled());
+
+	wheel.schedule(t1, Timespan(0, 60000));
+	wheel.schedule(t2, Timespan(0, 20000));
+	wheel.schedule(t3, Timespan(0, 40000));
+	assertTrue (wheel.size() == 3);
+	assertTrue (t1.scheduled() && t2.scheduled() && t3.scheduled());
+
+	TimerWheel::TimerVec expired;
+	assertTrue (wheel.advance(expired) == 0);
+	assertTrue (expired.empty());
+
+	Thread::sleep(100);
+	assertTrue (wheel.advance(expired) == 3);
+	assertTrue (expired.size() == 3);
+	assertTrue (expired[0] == &t2);
+	assertTrue (expired[1] == &t3);
+	assertTrue (expired[2] == &t1);
+	assertTrue (*static_cast<int*>(expired[2]->context()) == 1);
+	assertTrue (wheel.empty());
+	assertTrue (!t1.scheduled() && !t2.scheduled() && !t3.scheduled());
+}
+
+
+void TimerWheelTest::testCancel()
+{
+	TimerWheel wheel(Timespan(0, 1000));
+	TimerWheel::Timer t1;
+	TimerWheel::Timer t2;
+	wheel.schedule(t1, Timespan(0, 20000));
+	wheel.schedule(t2, Timespan(0, 20000));
+	{
+		TimerWheel::Timer t3;
+		wheel.schedule(t3, Timespan(0, 20000));
+		assertTrue (wheel.size() == 3);
+	}
+	assertTrue (wheel.size() == 2);
+
+	wheel.cancel(t1);
+	assertTrue (!t1.scheduled());
+	assertTrue (wheel.size() == 1);
+	wheel.cancel(t1);
+	assertTrue (wheel.size() == 1);
+
+	Thread::sleep(50);
+	TimerWheel::TimerVec expired;
+	assertTrue (wheel.advance(expired) == 1);
+	assertTrue (expired[0] == &t2);
+	assertTrue (wheel.empty());
+}
+
+
+void TimerWheelTest::testReschedule()
+{
+	TimerWheel wheel(Timespan(0, 1000));
+	TimerWheel::Timer t1;
+	TimerWheel::Timer t2;
+	wheel.schedule(t1, Timespan(0, 20000));
+	wheel.schedule(t2, Timespan(0, 20000));
+	wheel.schedule(t1, Timespan(10, 0));
+	assertTrue (wheel.size() == 2);
+
+	Thread::sleep(50);
+	TimerWheel::TimerVec expired;
+	assertTrue (wheel.advance(expired) == 1);
+	assertTrue (expired[0] == &t2);
+	assertTrue (t1.scheduled());
+	assertTrue (wheel.size() == 1);
+
+	wheel.schedule(t1, Timespan(0, 0));
+	expired.clear();
+	Thread::sleep(5);
+	assertTrue (wheel.advance(expired) == 1);
+	assertTrue (expired[0] == &t1);
+}
+
+
+void TimerWheelTest::testCascade()
+{
+	// with a resolution of 1 ms, timers due in more
+	// than 256 ms are kept in the second wheel
+	TimerWheel wheel(Timespan(0, 1000));
+	TimerWheel::Timer t1;
+	TimerWheel::Timer t2;
+	TimerWheel::Timer t3;
+	wheel.schedule(t1, Timespan(0, 300000));
+	wheel.schedule(t2, Timespan(0, 100000));
+	wheel.schedule(t3, Timespan(1, 0));
+
+	TimerWheel::TimerVec expired;
+	Thread::sleep(150);
+	assertTrue (wheel.advance(expired) == 1);
+	assertTrue (expired[0] == &t2);
+
+	expired.clear();
+	Thread::sleep(100);
+	assertTrue (wheel.advance(expired) == 0);
+
+	Thread::sleep(100);
+	assertTrue (wheel.advance(expired) == 1);
+	assertTrue (expired[0] == &t1);
+	assertTrue (wheel.size() == 1);
+	assertTrue (t3.scheduled());
+}
+
+
+void TimerWheelTest::testNextTimeout()
+{
+	TimerWheel wheel(Timespan(0, 1000));
+	Timespan max(1, 0);
+	assertTrue (wheel.nextTimeout(max) == max);
+
+	TimerWheel::Timer t1;
+	wheel.schedule(t1, Timespan(0, 50000));
+	Timespan next = wheel.nextTimeout(max);
+	assertTrue (next > 0 && next <= Timespan(0, 51000));
+	assertTrue (wheel.nextTimeout(Timespan(0, 10000)) == Timespan(0, 10000));
+
+	// far timers require the wheel to be advanced when they
+	// are moved to the first wheel
+	TimerWheel::Timer t2;
+	wheel.cancel(t1);
+	wheel.schedule(t2, Timespan(10, 0));
+	next = wheel.nextTimeout(Timespan(20, 0));
+	assertTrue (next <= Timespan(0, 257000));
+
+	Thread::sleep(60);
+	wheel.schedule(t1, Timespan(0, 0));
+	assertTrue (wheel.nextTimeout(max) < Timespan(0, 2000));
+}
+
+
+void TimerWheelTest::setUp()
+{
+}
+
+
+void TimerWheelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimerWheelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimerWheelTest");
+
+	CppUnit_addTest(pSuite, TimerWheelTest, testSchedule);
+	CppUnit_addTest(pSuite, TimerWheelTest, testCancel);
+	CppUnit_addTest(pSuite, TimerWheelTest, testReschedule);
+	CppUnit_addTest(pSuite, TimerWheelTest, testCascade);
+	CppUnit_addTest(pSuite, TimerWheelTest, testNextTimeout);
+
+	return pSuite;
+}
@@ -0,0 +1,42 @@
+//
+// TimerWheelTest.h
+//
+// Definition of the TimerWheelTest class.
+//
+// Copyright (c) 2005-2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef TimerWheelTest_INCLUDED
+#define TimerWheelTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class TimerWheelTest: public CppUnit::TestCase
+{
+public:
+	TimerWheelTest(const std::string& name);
+	~TimerWheelTest();
+
+	void testSchedule();
+	void testCancel();
+	void testReschedule();
+	void testCascade();
+	void testNextTimeout();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // TimerWheelTest_INCLUDED
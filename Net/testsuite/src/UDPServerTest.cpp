@@ -79,13 +79,14 @@ namespace
 	AtomicCounter TestUDPHandler::errors;
 
 	template<typename S>
-	bool server(int handlerCount, int reps, int port = 0)
+	bool server(int handlerCount, int reps, int port = 0, int batchSize = 1)
 	{
 		Poco::Net::UDPHandler::List handlers;
 		for (int i = 0; i < handlerCount; ++i)
 			handlers.push_back(new TestUDPHandler());
 
-		S server(handlers, Poco::Net::SocketAddress("127.0.0.1", port));
+		Poco::Net::UDPServerParams params(Poco::Net::SocketAddress("127.0.0.1", port), 10, 250000, 1000, false, 10, batchSize);
+		S server(handlers, params);
 		Poco::Thread::sleep(100);
 
 		Poco::Net::UDPClient client("127.0.0.1", server.port(), true);
@@ -159,6 +160,15 @@ void UDPServerTest::testServer()
 }
 
 
+void UDPServerTest::testServerBatch()
+{
+	int msgs = 10000;
+	assertTrue (server<Poco::Net::UDPServer>(1, msgs, 0, 16));
+	assertTrue (server<Poco::Net::UDPMultiServer>(1, msgs, 22081, 16));
+	assertTrue (TestUDPHandler::errors == 0);
+}
+
+
 void UDPServerTest::setUp()
 {
 }
@@ -174,6 +184,7 @@ CppUnit::Test* UDPServerTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("UDPServerTest");
 
 	CppUnit_addTest(pSuite, UDPServerTest, testServer);
+	CppUnit_addTest(pSuite, UDPServerTest, testServerBatch);
 
 	return pSuite;
 }
@@ -65,7 +65,7 @@ public:
 		/// Opens a connection to the database.
 
 	void close();
-		/// Closes the connection.
+		/// Closes the connection and all cached prepared statements.
 
 	void reset();
 		/// Reset connection with dababase and clears session state, but without disconnecting
@@ -120,6 +120,28 @@ public:
 	Poco::Any getInsertId(const std::string&) const;
 		/// Get insert id
 
+	void setPrefetchRows(const std::string&, const Poco::Any& value);
+		/// Sets the number of rows fetched from the server at once
+		/// by a query.
+		///
+		/// By default (0), the rows of a query are fetched from the
+		/// server one at a time while they are extracted, and the
+		/// session can not be used for other statements until all
+		/// rows have been extracted. Any other value makes queries use
+		/// a read-only server-side cursor, from which the given number
+		/// of rows are fetched at once, and allows using the session
+		/// for other statements in the meantime.
+		///
+		/// Either way, a limit() on the statement keeps memory use
+		/// bounded for results of any size.
+		///
+		/// The value can be given as any integer type, or as a string.
+		/// Throws a RangeException if it is negative, and a
+		/// BadCastException if it has any other type.
+
+	Poco::Any getPrefetchRows(const std::string&) const;
+		/// Returns the number of rows fetched from the server at once.
+
 	SessionHandle& handle();
 		// Get handle
 
@@ -160,6 +182,7 @@ private:
 	bool                    _connected;
 	bool                    _inTransaction;
 	std::size_t             _timeout;
+	std::size_t             _prefetchRows;
 	Poco::FastMutex         _mutex;
 };
 
@@ -184,6 +207,12 @@ inline Poco::Any SessionImpl::getInsertId(const std::string&) const
 }
 
 
+inline Poco::Any SessionImpl::getPrefetchRows(const std::string&) const
+{
+	return _prefetchRows;
+}
+
+
 inline SessionHandle& SessionImpl::handle()
 {
 	return _handle;
@@ -19,6 +19,7 @@
 
 #include <mysql.h>
 #include "Poco/SQL/MySQL/MySQLException.h"
+#include "Poco/SQL/StatementCache.h"
 
 namespace Poco {
 namespace SQL {
@@ -35,8 +36,12 @@ public:
 		STMT_EXECUTED
 	};
 
-	explicit StatementExecutor(MYSQL* mysql);
+	explicit StatementExecutor(MYSQL* mysql, StatementCache* pStatementCache = 0);
 		/// Creates the StatementExecutor.
+		///
+		/// If a StatementCache is given, prepared statements are
+		/// taken from the cache if possible, and returned to it
+		/// instead of being closed.
 
 	~StatementExecutor();
 		/// Destroys the StatementExecutor.
@@ -53,6 +58,11 @@ public:
 	void bindResult(MYSQL_BIND* result);
 		/// Binds result.
 
+	void setPrefetchRows(std::size_t rows);
+		/// Sets the number of rows fetched from the server at once
+		/// through a read-only cursor. Zero (the default) disables the
+		/// cursor, and rows are fetched one at a time.
+
 	void execute();
 		/// Executes the statement.
 
@@ -73,11 +83,14 @@ private:
 	StatementExecutor& operator=(const StatementExecutor&);
 
 private:
-	MYSQL*      _pSessionHandle;
-	MYSQL_STMT* _pHandle;
-	int         _state;
-	int         _affectedRowCount;
-	std::string _query;
+	MYSQL*                    _pSessionHandle;
+	MYSQL_STMT*               _pHandle;
+	int                       _state;
+	int                       _affectedRowCount;
+	std::string               _query;
+	StatementCache*           _pStatementCache;
+	StatementCache::HandlePtr _pCachedStatement;
+	std::size_t               _prefetchRows;
 };
 
 
@@ -85,6 +98,12 @@ private:
 // inlines
 //
 
+inline void StatementExecutor::setPrefetchRows(std::size_t rows)
+{
+	_prefetchRows = rows;
+}
+
+
 inline StatementExecutor::operator MYSQL_STMT* ()
 {
 	return _pHandle;
@@ -21,7 +21,7 @@ namespace MySQL {
 
 MySQLStatementImpl::MySQLStatementImpl(SessionImpl& h) :
 	Poco::SQL::StatementImpl(h),
-	_stmt(h.handle()),
+	_stmt(h.handle(), &h.statementCache()),
 	_pBinder(new Binder),
 	_pExtractor(new Extractor(_stmt, _metadata)),
 	_hasNext(NEXT_DONTKNOW)
@@ -142,6 +142,7 @@ void MySQLStatementImpl::bindImpl()
 	}
 
 	_stmt.bindParams(_pBinder->getBindArray(), _pBinder->size());
+	_stmt.setPrefetchRows(Poco::AnyCast<std::size_t>(session().getProperty("prefetchRows")));
 	_stmt.execute();
 	_hasNext = NEXT_DONTKNOW;
 }
@@ -16,6 +16,7 @@
 #include "Poco/SQL/MySQL/MySQLStatementImpl.h"
 #include "Poco/SQL/Session.h"
 #include "Poco/NumberParser.h"
+#include "Poco/Dynamic/Var.h"
 #include "Poco/String.h"
 
 
@@ -30,6 +31,17 @@ namespace
 
 		return std::string(from, to);
 	}
+
+	template <typename T>
+	bool convertRows(const Poco::Any& value, std::size_t& rows)
+		/// Converts the value to a number of rows if it holds a T.
+		/// Throws a RangeException if the value is negative.
+	{
+		if (value.type() != typeid(T)) return false;
+
+		rows = Poco::Dynamic::Var(Poco::AnyCast<T>(value)).convert<std::size_t>();
+		return true;
+	}
 }
 
 
@@ -49,9 +61,11 @@ SessionImpl::SessionImpl(const std::string& connectionString, std::size_t loginT
 	_connector("MySQL"),
 	_handle(0),
 	_connected(false),
-	_inTransaction(false)
+	_inTransaction(false),
+	_prefetchRows(0)
 {
 	addProperty("insertId", &SessionImpl::setInsertId, &SessionImpl::getInsertId);
+	addProperty("prefetchRows", &SessionImpl::setPrefetchRows, &SessionImpl::getPrefetchRows);
 	setProperty("handle", static_cast<MYSQL*>(_handle));
 	open();
 }
@@ -259,6 +273,9 @@ bool SessionImpl::hasTransactionIsolation(Poco::UInt32 ti) const
 
 void SessionImpl::close()
 {
+	// cached statements must be closed before the connection
+	statementCache().clear();
+
 	if (_connected)
 	{
 		_handle.close();
@@ -267,6 +284,27 @@ void SessionImpl::close()
 }
 
 
+void SessionImpl::setPrefetchRows(const std::string&, const Poco::Any& value)
+{
+	std::size_t rows = 0;
+	if (value.type() == typeid(std::size_t))
+	{
+		rows = Poco::RefAnyCast<std::size_t>(value);
+	}
+	else if (!convertRows<Poco::Int32>(value, rows) &&
+		!convertRows<Poco::UInt32>(value, rows) &&
+		!convertRows<Poco::Int64>(value, rows) &&
+		!convertRows<Poco::UInt64>(value, rows) &&
+		!convertRows<Poco::Int16>(value, rows) &&
+		!convertRows<Poco::UInt16>(value, rows) &&
+		!convertRows<std::string>(value, rows))
+	{
+		throw Poco::BadCastException("prefetchRows must be an integer");
+	}
+	_prefetchRows = rows;
+}
+
+
 void SessionImpl::reset()
 {
 	if (_connected)
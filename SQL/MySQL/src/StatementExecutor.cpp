@@ -22,9 +22,39 @@ namespace SQL {
 namespace MySQL {
 
 
-StatementExecutor::StatementExecutor(MYSQL* mysql)
+namespace
+{
+	class CachedStatement: public StatementCache::Handle
+		/// A prepared statement in the session's StatementCache.
+	{
+	public:
+		CachedStatement(const StatementCache& cache, const std::string& query, MYSQL_STMT* pHandle):
+			StatementCache::Handle(cache, query),
+			_pHandle(pHandle)
+		{
+		}
+
+		~CachedStatement()
+		{
+			mysql_stmt_close(_pHandle);
+		}
+
+		MYSQL_STMT* handle() const
+		{
+			return _pHandle;
+		}
+
+	private:
+		MYSQL_STMT* _pHandle;
+	};
+}
+
+
+StatementExecutor::StatementExecutor(MYSQL* mysql, StatementCache* pStatementCache)
 	: _pSessionHandle(mysql)
 	, _affectedRowCount(0)
+	, _pStatementCache(pStatementCache)
+	, _prefetchRows(0)
 {
 	if ((_pHandle = mysql_stmt_init(mysql)) == 0)
 		throw StatementException("mysql_stmt_init error");
@@ -35,7 +65,22 @@ StatementExecutor::StatementExecutor(MYSQL* mysql)
 
 StatementExecutor::~StatementExecutor()
 {
-	mysql_stmt_close(_pHandle);
+	if (_pCachedStatement)
+	{
+		// the statement handle is owned by the cached statement;
+		// a statement that cannot be reset (e.g., after the client
+		// has reconnected) is discarded
+		mysql_stmt_free_result(_pHandle);
+		if (mysql_stmt_reset(_pHandle) == 0)
+		{
+			try
+			{
+				_pStatementCache->release(_pCachedStatement);
+			}
+			catch (...) { }
+		}
+	}
+	else mysql_stmt_close(_pHandle);
 }
 
 
@@ -53,6 +98,20 @@ void StatementExecutor::prepare(const std::string& query)
 		return;
 	}
 	
+	if (_pStatementCache)
+	{
+		StatementCache::HandlePtr pCachedStatement = _pStatementCache->acquire(query);
+		if (pCachedStatement)
+		{
+			mysql_stmt_close(_pHandle);
+			_pHandle = pCachedStatement.cast<CachedStatement>()->handle();
+			_pCachedStatement = pCachedStatement;
+			_query = query;
+			_state = STMT_COMPILED;
+			return;
+		}
+	}
+
 	int rc = mysql_stmt_prepare(_pHandle, query.c_str(), static_cast<unsigned int>(query.length()));
 	if (rc != 0)
 	{
@@ -65,6 +124,11 @@ void StatementExecutor::prepare(const std::string& query)
 	}
 	if (rc != 0) throw StatementException("mysql_stmt_prepare error", _pHandle, query);
 
+	if (_pStatementCache)
+	{
+		_pCachedStatement = new CachedStatement(*_pStatementCache, query, _pHandle);
+	}
+
 	_query = query;
 	_state = STMT_COMPILED;
 }
@@ -100,6 +164,20 @@ void StatementExecutor::execute()
 	if (_state < STMT_COMPILED)
 		throw StatementException("Statement is not compiled yet");
 
+	if (mysql_stmt_field_count(_pHandle) > 0)
+	{
+		unsigned long cursorType = _prefetchRows > 0 ? CURSOR_TYPE_READ_ONLY : CURSOR_TYPE_NO_CURSOR;
+		if (mysql_stmt_attr_set(_pHandle, STMT_ATTR_CURSOR_TYPE, &cursorType) != 0)
+			throw StatementException("mysql_stmt_attr_set error", _pHandle, _query);
+
+		if (_prefetchRows > 0)
+		{
+			unsigned long prefetchRows = static_cast<unsigned long>(_prefetchRows);
+			if (mysql_stmt_attr_set(_pHandle, STMT_ATTR_PREFETCH_ROWS, &prefetchRows) != 0)
+				throw StatementException("mysql_stmt_attr_set error", _pHandle, _query);
+		}
+	}
+
 	if (mysql_stmt_execute(_pHandle) != 0)
 		throw StatementException("mysql_stmt_execute error", _pHandle, _query);
 
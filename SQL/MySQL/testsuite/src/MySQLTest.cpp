@@ -630,6 +630,63 @@ void MySQLTest::testReconnect()
 }
 
 
+void MySQLTest::testPrefetchRows()
+{
+	if (!_pSession) fail ("Test not available.");
+
+	recreateIntsTable();
+
+	std::vector<int> data;
+	for (int i = 0; i < 100; ++i) data.push_back(i);
+	*_pSession << "INSERT INTO Ints VALUES (?)", use(data), now;
+
+	// any integral type is accepted
+	_pSession->setProperty("prefetchRows", 10);
+	assertTrue (Poco::AnyCast<std::size_t>(_pSession->getProperty("prefetchRows")) == 10);
+	_pSession->setProperty("prefetchRows", Poco::UInt64(20));
+	assertTrue (Poco::AnyCast<std::size_t>(_pSession->getProperty("prefetchRows")) == 20);
+
+	try
+	{
+		_pSession->setProperty("prefetchRows", -1);
+		fail ("negative number of rows - must throw");
+	}
+	catch (Poco::RangeException&) { }
+	try
+	{
+		_pSession->setProperty("prefetchRows", 1.5);
+		fail ("not an integer - must throw");
+	}
+	catch (Poco::BadCastException&) { }
+	assertTrue (Poco::AnyCast<std::size_t>(_pSession->getProperty("prefetchRows")) == 20);
+
+	try
+	{
+		std::vector<int> ints;
+		Statement stmt = (*_pSession << "SELECT str FROM Ints ORDER BY str", into(ints), limit(30));
+		std::size_t steps = 0;
+		while (!stmt.done())
+		{
+			stmt.execute();
+			++steps;
+		}
+		assertTrue (steps >= 4);
+		assertTrue (ints.size() == 100);
+		for (int i = 0; i < 100; ++i)
+		{
+			assertTrue (ints[i] == i);
+		}
+	}
+	catch (...)
+	{
+		_pSession->setProperty("prefetchRows", 0);
+		throw;
+	}
+	_pSession->setProperty("prefetchRows", 0);
+	assertTrue (Poco::AnyCast<std::size_t>(_pSession->getProperty("prefetchRows")) == 0);
+}
+
+
 void MySQLTest::testNullableInt()
 {
 	if (!_pSession) fail ("Test not available.");
@@ -1018,6 +1075,7 @@ CppUnit::Test* MySQLTest::suite()
 	CppUnit_addTest(pSuite, MySQLTest, testSessionTransaction);
 	CppUnit_addTest(pSuite, MySQLTest, testTransaction);
 	CppUnit_addTest(pSuite, MySQLTest, testReconnect);
+	CppUnit_addTest(pSuite, MySQLTest, testPrefetchRows);
 
 	return pSuite;
 }
@@ -108,6 +108,8 @@ public:
 
 	void testReconnect();
 
+	void testPrefetchRows();
+
 	void setUp();
 	void tearDown();
 
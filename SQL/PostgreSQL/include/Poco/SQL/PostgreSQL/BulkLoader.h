@@ -0,0 +1,322 @@
+//
+// BulkLoader.h
+//
+// Library: SQL/PostgreSQL
+// Package: PostgreSQL
+// Module:  BulkLoader
+//
+// Definition of the BulkLoader class.
+//
+// Copyright (c) 2015, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SQL_PostgreSQL_BulkLoader_INCLUDED
+#define SQL_PostgreSQL_BulkLoader_INCLUDED
+
+
+#include "Poco/SQL/PostgreSQL/PostgreSQL.h"
+#include "Poco/SQL/PostgreSQL/SessionHandle.h"
+#include "Poco/SQL/Session.h"
+#include "Poco/SQL/Column.h"
+#include "Poco/SQL/LOB.h"
+#include "Poco/SQL/Date.h"
+#include "Poco/SQL/Time.h"
+#include "Poco/DateTime.h"
+#include "Poco/UUID.h"
+#include "Poco/Nullable.h"
+#include "Poco/Exception.h"
+#include "Poco/Types.h"
+#include <string>
+
+
+namespace Poco {
+namespace SQL {
+namespace PostgreSQL {
+
+
+class PostgreSQL_API BulkLoader
+	/// BulkLoader loads rows into a table with COPY ... FROM STDIN
+	/// in binary format, which is much faster than executing an
+	/// INSERT statement for every row.
+	///
+	/// Rows are encoded into a buffer, which is sent to the server
+	/// whenever it exceeds the buffer size given to the constructor,
+	/// so that memory use stays bounded regardless of the number of
+	/// rows. Sending blocks while the connection can't take more data,
+	/// which throttles the producer to the speed of the server.
+	///
+	/// Rows are added either value by value, with append() or
+	/// operator << followed by endRow(), in one call with appendRow(),
+	/// or from columns of values with appendColumns(), which takes
+	/// the containers used for bulk binding and extraction as well
+	/// as the Columns of a RecordSet.
+	///
+	/// Values are sent in the binary format of the PostgreSQL type
+	/// corresponding to their C++ type, which must match the type
+	/// of the column exactly:
+	///
+	///     bool                     boolean
+	///     Poco::Int16              smallint
+	///     Poco::Int32              integer
+	///     Poco::Int64              bigint
+	///     float                    real
+	///     double                   double precision
+	///     std::string, CLOB        text, varchar, char
+	///     BLOB                     bytea
+	///     Date                     date
+	///     Time                     time
+	///     Poco::DateTime           timestamp
+	///     Poco::UUID               uuid
+	///
+	/// Null values are loaded with appendNull() or from Nullable values.
+	///
+	/// The rows are committed by finish(). If the BulkLoader is destroyed
+	/// without calling finish(), or if an error occurs, no rows are loaded.
+	/// While the BulkLoader is open, the session must not be used for
+	/// anything else.
+	///
+	/// Usage example:
+	///
+	///     BulkLoader loader(session, "Person", "LastName, FirstName, Age");
+	///     loader.appendRow(std::string("Simpson"), std::string("Bart"), 10);
+	///     loader << std::string("Simpson") << std::string("Lisa") << 8;
+	///     loader.endRow();
+	///     loader.appendColumns(lastNames, firstNames, ages);
+	///     Poco::UInt64 rows = loader.finish();
+{
+public:
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 65536
+	};
+
+	BulkLoader(Poco::SQL::Session& session,
+		const std::string& table,
+		const std::string& columns = std::string(),
+		std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the BulkLoader for the given PostgreSQL session, and
+		/// starts copying into the given comma-separated columns of the
+		/// given table, or into all of its columns if none are given.
+		///
+		/// Throws a StatementException if the COPY can't be started.
+
+	~BulkLoader();
+		/// Aborts the COPY, unless finish() has been called.
+
+	void append(bool value);
+		/// Appends a boolean value to the current row.
+
+	void append(Poco::Int16 value);
+		/// Appends a smallint value to the current row.
+
+	void append(Poco::Int32 value);
+		/// Appends an integer value to the current row.
+
+	void append(Poco::Int64 value);
+		/// Appends a bigint value to the current row.
+
+	void append(float value);
+		/// Appends a real value to the current row.
+
+	void append(double value);
+		/// Appends a double precision value to the current row.
+
+	void append(const std::string& value);
+		/// Appends a text value to the current row.
+
+	void append(const char* value);
+		/// Appends a text value to the current row.
+
+	void append(const CLOB& value);
+		/// Appends a text value to the current row.
+
+	void append(const BLOB& value);
+		/// Appends a bytea value to the current row.
+
+	void append(const Date& value);
+		/// Appends a date value to the current row.
+
+	void append(const Time& value);
+		/// Appends a time value to the current row.
+
+	void append(const Poco::DateTime& value);
+		/// Appends a timestamp value to the current row.
+
+	void append(const Poco::UUID& value);
+		/// Appends a uuid value to the current row.
+
+	template <typename T>
+	void append(const Poco::Nullable<T>& value)
+		/// Appends the given value, or null, to the current row.
+	{
+		if (value.isNull()) appendNull();
+		else append(value.value());
+	}
+
+	void appendNull();
+		/// Appends a null value to the current row.
+
+	template <typename T>
+	BulkLoader& operator << (const T& value)
+		/// Appends the given value to the current row.
+	{
+		append(value);
+		return *this;
+	}
+
+	void endRow();
+		/// Completes the current row.
+		///
+		/// Throws an InvalidAccessException if the number of values
+		/// in the row differs from the number of copied columns.
+
+	template <typename... T>
+	void appendRow(const T&... values)
+		/// Appends a row with the given values.
+	{
+		appendValues(values...);
+		endRow();
+	}
+
+	template <typename C, typename... R>
+	void appendColumns(const C& column, const R&... columns)
+		/// Appends a row for every value of the given columns. A column is
+		/// a std::vector, std::deque or std::list, or a Column of a RecordSet.
+		///
+		/// Throws an InvalidArgumentException if the columns differ in size.
+	{
+		std::size_t rows = columnSize(column);
+		checkColumnSize(rows, columns...);
+		appendColumnRows(rows, column.begin(), columns.begin()...);
+	}
+
+	void flush();
+		/// Sends the buffered rows to the server.
+
+	Poco::UInt64 finish();
+		/// Sends the remaining rows, completes the COPY and returns
+		/// the number of rows loaded.
+		///
+		/// Throws a StatementException if the server rejects the rows,
+		/// in which case none of them are loaded.
+
+	void abort(const std::string& reason = "aborted by client");
+		/// Aborts the COPY, discarding all rows.
+
+	Poco::UInt64 rowCount() const;
+		/// Returns the number of rows appended so far.
+
+	std::size_t columnCount() const;
+		/// Returns the number of copied columns.
+
+	bool isOpen() const;
+		/// Returns true unless the COPY has been finished or aborted.
+
+private:
+	BulkLoader(const BulkLoader&);
+	BulkLoader& operator = (const BulkLoader&);
+
+	void beginField(Poco::Int32 length);
+	void appendBytes(const char* pData, std::size_t length);
+	void writeInt16(Poco::Int16 value);
+	void writeInt32(Poco::Int32 value);
+	void writeInt64(Poco::Int64 value);
+	void checkOpen() const;
+	void throwConnectionError();
+
+	void appendValues()
+	{
+	}
+
+	template <typename T, typename... R>
+	void appendValues(const T& value, const R&... values)
+	{
+		append(value);
+		appendValues(values...);
+	}
+
+	template <typename C>
+	static std::size_t columnSize(const C& column)
+	{
+		return column.size();
+	}
+
+	template <typename C>
+	static std::size_t columnSize(const Column<C>& column)
+	{
+		return column.rowCount();
+	}
+
+	static void checkColumnSize(std::size_t)
+	{
+	}
+
+	template <typename C, typename... R>
+	static void checkColumnSize(std::size_t rows, const C& column, const R&... columns)
+	{
+		if (columnSize(column) != rows)
+			throw Poco::InvalidArgumentException("Columns differ in size");
+		checkColumnSize(rows, columns...);
+	}
+
+	template <typename... I>
+	void appendColumnRows(std::size_t rows, I... iterators)
+	{
+		for (std::size_t row = 0; row < rows; ++row)
+		{
+			appendFields(iterators...);
+			endRow();
+		}
+	}
+
+	void appendFields()
+	{
+	}
+
+	template <typename I, typename... R>
+	void appendFields(I& iterator, R&... iterators)
+	{
+		append(*iterator);
+		++iterator;
+		appendFields(iterators...);
+	}
+
+	SessionHandle& _sessionHandle;
+	std::string    _buffer;
+	std::size_t    _bufferSize;
+	std::size_t    _columnCount;
+	std::size_t    _fieldCount;
+	Poco::UInt64   _rowCount;
+	bool           _open;
+};
+
+
+//
+// inlines
+//
+inline Poco::UInt64 BulkLoader::rowCount() const
+{
+	return _rowCount;
+}
+
+
+inline std::size_t BulkLoader::columnCount() const
+{
+	return _columnCount;
+}
+
+
+inline bool BulkLoader::isOpen() const
+{
+	return _open;
+}
+
+
+} } } // namespace Poco::SQL::PostgreSQL
+
+
+#endif // SQL_PostgreSQL_BulkLoader_INCLUDED
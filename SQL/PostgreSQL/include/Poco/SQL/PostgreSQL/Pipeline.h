@@ -0,0 +1,284 @@
+//
+// Pipeline.h
+//
+// Library: SQL/PostgreSQL
+// Package: PostgreSQL
+// Module:  Pipeline
+//
+// Definition of the Pipeline class.
+//
+// Copyright (c) 2015, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SQL_PostgreSQL_Pipeline_INCLUDED
+#define SQL_PostgreSQL_Pipeline_INCLUDED
+
+
+#include "Poco/SQL/PostgreSQL/PostgreSQL.h"
+#include "Poco/SQL/PostgreSQL/SessionHandle.h"
+#include "Poco/SQL/Session.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Nullable.h"
+#include "Poco/Types.h"
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <libpq-fe.h>
+
+
+#ifdef LIBPQ_HAS_PIPELINING
+
+
+namespace Poco {
+namespace SQL {
+namespace PostgreSQL {
+
+
+class PostgreSQL_API Pipeline
+	/// Pipeline executes statements using the libpq pipeline mode.
+	///
+	/// Statements added to a Pipeline are sent to the server without
+	/// waiting for the results of previously added statements, so that
+	/// a batch of statements costs a single network round trip instead
+	/// of one per statement. The results are retrieved in the order in
+	/// which the statements have been added, either blocking with next(),
+	/// or without blocking with poll() and next().
+	///
+	/// Every distinct SQL text is prepared once per Pipeline; the
+	/// prepared statements are deallocated when the Pipeline is closed.
+	/// Parameters are passed in text format, with $1, $2, etc. as
+	/// placeholders, and results are returned in text format.
+	///
+	/// Statements added between two calls to sync() form a unit: if one
+	/// of them fails, the remaining ones are not executed and their
+	/// results report isAborted(). Unless an explicit transaction has
+	/// been started with a BEGIN statement, the statements of a unit are
+	/// executed in an implicit transaction, which is committed by sync().
+	///
+	/// While the Pipeline is open, the connection is in nonblocking mode,
+	/// so that add(), sync() and poll() never wait for the server; data
+	/// that can't be sent immediately is buffered by libpq. next() and
+	/// close() wait until the data has been sent and the results have
+	/// arrived.
+	///
+	/// For integration with an event loop, socket() returns the socket
+	/// of the connection. When it becomes readable, or writable while
+	/// isFlushPending() returns true, poll() sends the buffered data and
+	/// reads the available results without blocking.
+	///
+	/// While a Pipeline is open, the session must not be used for
+	/// anything else.
+	///
+	/// Usage example:
+	///
+	///     Pipeline pipeline(session);
+	///     for (int i = 0; i < 1000; ++i)
+	///     {
+	///         Pipeline::Parameters params;
+	///         params.push_back(NumberFormatter::format(i));
+	///         pipeline.add("INSERT INTO Ints VALUES ($1)", params);
+	///     }
+	///     pipeline.sync();
+	///     while (pipeline.pending() > 0)
+	///     {
+	///         Pipeline::Result result = pipeline.next();
+	///         if (result.isError()) ...
+	///     }
+	///     pipeline.close();
+	///
+	/// Requires libpq 14 or newer.
+{
+public:
+	typedef std::vector<Poco::Nullable<std::string> > Parameters;
+
+	class PostgreSQL_API Result
+		/// The result of a statement executed in a Pipeline.
+	{
+	public:
+		Result();
+			/// Creates an empty Result.
+
+		~Result();
+			/// Destroys the Result.
+
+		Poco::UInt64 id() const;
+			/// Returns the ID returned by Pipeline::add() for the statement.
+
+		bool isError() const;
+			/// Returns true if the statement failed or has not been
+			/// executed due to an earlier failure.
+
+		bool isAborted() const;
+			/// Returns true if the statement has not been executed,
+			/// due to the failure of an earlier statement since the
+			/// last sync().
+
+		std::string errorMessage() const;
+			/// Returns the error message, if the statement failed.
+
+		std::size_t affectedRowCount() const;
+			/// Returns the number of rows affected by an INSERT,
+			/// UPDATE or DELETE statement, or the number of rows
+			/// returned by a query.
+
+		std::size_t rowCount() const;
+			/// Returns the number of rows returned by a query.
+
+		std::size_t columnCount() const;
+			/// Returns the number of columns returned by a query.
+
+		std::string columnName(std::size_t col) const;
+			/// Returns the name of the given column.
+
+		bool isNull(std::size_t row, std::size_t col) const;
+			/// Returns true if the given value is NULL.
+
+		std::string value(std::size_t row, std::size_t col) const;
+			/// Returns the given value in text format.
+
+	private:
+		struct ResultReleasePolicy
+		{
+			static void release(PGresult* pResult)
+			{
+				PQclear(pResult);
+			}
+		};
+
+		typedef Poco::SharedPtr<PGresult, Poco::ReferenceCounter, ResultReleasePolicy> ResultPtr;
+
+		Result(Poco::UInt64 id, PGresult* pResult);
+
+		void checkPosition(std::size_t row, std::size_t col) const;
+
+		Poco::UInt64 _id;
+		ResultPtr    _pResult;
+
+		friend class Pipeline;
+	};
+
+	explicit Pipeline(Poco::SQL::Session& session);
+		/// Creates the Pipeline for the given PostgreSQL session, and
+		/// switches the connection into pipeline mode.
+
+	~Pipeline();
+		/// Closes the Pipeline, discarding all results not yet retrieved.
+
+	Poco::UInt64 add(const std::string& sql, const Parameters& params = Parameters());
+		/// Sends the given statement to the server, and returns
+		/// the ID of its Result.
+
+	void sync();
+		/// Marks the end of a unit of statements. See the class
+		/// description for details.
+
+	std::size_t pending() const;
+		/// Returns the number of statements whose results have not
+		/// been retrieved with next() yet.
+
+	bool poll();
+		/// Sends as much of the buffered data as possible and reads the
+		/// results available from the server, both without blocking.
+		/// Returns true if next() can return a result without blocking.
+
+	bool isFlushPending() const;
+		/// Returns true if the last call to poll() could not send
+		/// all buffered data, because the socket was not writable.
+
+	Result next();
+		/// Returns the result of the next statement, waiting for it
+		/// if necessary.
+		///
+		/// Throws an InvalidAccessException if there are no pending
+		/// statements.
+
+	int socket() const;
+		/// Returns the native socket of the connection.
+
+	void close();
+		/// Waits for all pending results and discards them, deallocates
+		/// the prepared statements and switches the connection back
+		/// from pipeline mode and nonblocking mode.
+
+	bool isOpen() const;
+		/// Returns true unless the Pipeline has been closed.
+
+private:
+	struct Command
+	{
+		enum Type
+		{
+			COMMAND_PREPARE,
+			COMMAND_QUERY,
+			COMMAND_SYNC
+		};
+
+		Type         type;
+		Poco::UInt64 id;
+		std::string  sql;
+	};
+
+	Pipeline(const Pipeline&);
+	Pipeline& operator = (const Pipeline&);
+
+	void checkOpen() const;
+	bool requestFlush();
+	void readResult();
+	void handleResult(const Command& command, PGresult* pResult);
+	void throwConnectionError();
+
+	SessionHandle&                     _sessionHandle;
+	std::deque<Command>                _commands;
+	std::deque<Result>                 _results;
+	std::map<std::string, std::string> _statements;
+	PGresult*                          _pCurrentResult;
+	PGresult*                          _pPrepareError;
+	Poco::UInt64                       _nextId;
+	std::size_t                        _pending;
+	bool                               _wasNonblocking;
+	bool                               _flushed;
+	bool                               _flushPending;
+	bool                               _synced;
+	bool                               _open;
+};
+
+
+//
+// inlines
+//
+inline Poco::UInt64 Pipeline::Result::id() const
+{
+	return _id;
+}
+
+
+inline std::size_t Pipeline::pending() const
+{
+	return _pending;
+}
+
+
+inline bool Pipeline::isFlushPending() const
+{
+	return _flushPending;
+}
+
+
+inline bool Pipeline::isOpen() const
+{
+	return _open;
+}
+
+
+} } } // namespace Poco::SQL::PostgreSQL
+
+
+#endif // LIBPQ_HAS_PIPELINING
+
+
+#endif // SQL_PostgreSQL_Pipeline_INCLUDED
@@ -60,7 +60,8 @@ public:
 		/// Opens a connection to the database.
 
 	void close();
-		/// Closes the connection.
+		/// Closes the connection and discards all cached
+		/// prepared statements.
 
 	void reset();
 		/// Do nothing
@@ -112,6 +113,25 @@ public:
 	bool isAsynchronousCommit(const std::string& aName = std::string()) const;
 		/// is the connection in Asynchronous commit mode?
 
+	void setStreamResults(const std::string&, bool aValue);
+		/// Sets the streamResults feature for the session.
+		///
+		/// If enabled, the rows returned by a query are retrieved from
+		/// the server one at a time while they are extracted, instead of
+		/// all at once when the statement is executed. Together with a
+		/// limit() on the statement, this keeps memory use bounded for
+		/// results of any size. While the rows of a query are being
+		/// retrieved, the session can not be used for other statements.
+		///
+		/// If a statement is reset or destroyed before all rows have
+		/// been retrieved, the query is cancelled, unless it has been
+		/// executed inside a transaction block (started with begin()
+		/// or a BEGIN statement), which cancelling would abort. In that
+		/// case, the remaining rows are read and discarded.
+
+	bool isStreamResults(const std::string& aName = std::string()) const;
+		/// Returns the value of the streamResults feature.
+
 	SessionHandle& handle();
 		/// Get handle
 
@@ -122,6 +142,7 @@ private:
 	std::string	          _connectorName;
 	mutable SessionHandle _sessionHandle;
 	std::size_t           _timeout;
+	bool                  _streamResults;
 };
 
 
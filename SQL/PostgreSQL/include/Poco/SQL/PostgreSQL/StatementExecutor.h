@@ -21,6 +21,7 @@
 #include "Poco/SQL/PostgreSQL/PostgreSQLTypes.h"
 #include "Poco/SQL/PostgreSQL/SessionHandle.h"
 #include "Poco/SQL/MetaColumn.h"
+#include "Poco/SQL/StatementCache.h"
 
 #include <libpq-fe.h>
 
@@ -43,8 +44,12 @@ public:
 		STMT_EXECUTED
 	};
 
-	explicit StatementExecutor(SessionHandle& aSessionHandle);
+	explicit StatementExecutor(SessionHandle& aSessionHandle, StatementCache* aStatementCachePtr = 0);
 		/// Creates the StatementExecutor.
+		///
+		/// If a StatementCache is given, prepared statements are
+		/// taken from the cache if possible, and returned to it
+		/// instead of being deallocated.
 
 	~StatementExecutor();
 		/// Destroys the StatementExecutor.
@@ -63,6 +68,18 @@ public:
 		/// Binds the params ONLY for COPY IN feature of PostgreSQL
 		/// Pointer and list elements must stay valid for the lifetime of the StatementExecutor!
 
+	void setStreamResults(bool aStreamResults);
+		/// Sets whether the rows returned by a query are retrieved
+		/// from the server one at a time (libpq single-row mode)
+		/// while being fetched, instead of all at once by execute().
+		///
+		/// While the rows of a streamed result are being fetched, the
+		/// connection can not be used for anything else. Abandoning
+		/// a streamed result outside of a transaction cancels the query.
+
+	bool isStreamResults() const;
+		/// Returns true if rows are retrieved one at a time.
+
 	void execute();
 		/// Executes the statement.
 
@@ -87,6 +104,8 @@ public:
 private:
 	
 	void clearResults();
+	bool fetchRow();
+	void finishStreaming();
 	
 	StatementExecutor(const StatementExecutor&);
 	StatementExecutor& operator= (const StatementExecutor&);
@@ -94,7 +113,9 @@ private:
 private:
 	typedef std::vector<MetaColumn> ColVec;
 
-	SessionHandle& _sessionHandle;
+	SessionHandle&            _sessionHandle;
+	StatementCache*           _pStatementCache;
+	StatementCache::HandlePtr _pCachedStatement;
 	State          _state;
 	PGresult*      _pResultHandle;
 	std::string    _SQLStatement;
@@ -108,6 +129,10 @@ private:
 	OutputParameterVector _outputParameterVector;
 	std::size_t           _currentRow;			// current row of the result
 	std::size_t           _affectedRowCount;
+	bool                  _streamResults;
+	bool                  _streaming;			// rows of the result are still arriving
+	bool                  _cancelStreaming;		// the query can be cancelled without aborting a transaction
+	bool                  _rowPending;			// the current row has not been fetched yet
 };
 
 
@@ -115,6 +140,18 @@ private:
 // inlines
 //
 
+inline void StatementExecutor::setStreamResults(bool aStreamResults)
+{
+	_streamResults = aStreamResults;
+}
+
+
+inline bool StatementExecutor::isStreamResults() const
+{
+	return _streamResults;
+}
+
+
 inline StatementExecutor::operator PGresult* ()
 {
 	return _pResultHandle;
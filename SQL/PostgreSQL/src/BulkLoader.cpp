@@ -0,0 +1,353 @@
+//
+// BulkLoader.cpp
+//
+// Library: SQL/PostgreSQL
+// Package: PostgreSQL
+// Module:  BulkLoader
+//
+// Copyright (c) 2015, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SQL/PostgreSQL/BulkLoader.h"
+#include "Poco/SQL/PostgreSQL/PostgreSQLException.h"
+#include "Poco/SQL/PostgreSQL/PostgreSQLTypes.h"
+#include "Poco/SQL/PostgreSQL/Utility.h"
+#include "Poco/SQL/SQLException.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Timespan.h"
+#include <cstring>
+
+
+namespace
+{
+	// the signature, flags and header extension length of the binary COPY format
+	const char COPY_HEADER[] = "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0";
+	const std::size_t COPY_HEADER_SIZE = 19;
+
+	// PostgreSQL dates and timestamps count from 2000-01-01
+	const Poco::DateTime POSTGRES_EPOCH(2000, 1, 1);
+}
+
+
+namespace Poco {
+namespace SQL {
+namespace PostgreSQL {
+
+
+BulkLoader::BulkLoader(Poco::SQL::Session& session, const std::string& table, const std::string& columns, std::size_t bufferSize):
+	_sessionHandle(*Utility::handle(session)),
+	_bufferSize(bufferSize),
+	_columnCount(0),
+	_fieldCount(0),
+	_rowCount(0),
+	_open(false)
+{
+	std::string sql("COPY ");
+	sql.append(table);
+	if (!columns.empty())
+	{
+		sql.append(" (").append(columns).append(")");
+	}
+	sql.append(" FROM STDIN (FORMAT binary)");
+
+	{
+		Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+		if (!_sessionHandle || PQstatus(_sessionHandle) != CONNECTION_OK) throw NotConnectedException();
+
+		PGresult* pResult = PQexec(_sessionHandle, sql.c_str());
+		PQResultClear resultClearer(pResult);
+
+		if (!pResult || PQresultStatus(pResult) != PGRES_COPY_IN)
+		{
+			throw StatementException(std::string("postgresql COPY error: ")
+				+ (pResult ? PQresultErrorMessage(pResult) : PQerrorMessage(_sessionHandle)));
+		}
+		_columnCount = static_cast<std::size_t>(PQnfields(pResult));
+	}
+
+	_buffer.reserve(_bufferSize + COPY_HEADER_SIZE);
+	_buffer.append(COPY_HEADER, COPY_HEADER_SIZE);
+	_open = true;
+}
+
+
+BulkLoader::~BulkLoader()
+{
+	try
+	{
+		abort();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void BulkLoader::append(bool value)
+{
+	beginField(1);
+	_buffer.push_back(value ? 1 : 0);
+}
+
+
+void BulkLoader::append(Poco::Int16 value)
+{
+	beginField(2);
+	writeInt16(value);
+}
+
+
+void BulkLoader::append(Poco::Int32 value)
+{
+	beginField(4);
+	writeInt32(value);
+}
+
+
+void BulkLoader::append(Poco::Int64 value)
+{
+	beginField(8);
+	writeInt64(value);
+}
+
+
+void BulkLoader::append(float value)
+{
+	Poco::Int32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	beginField(4);
+	writeInt32(bits);
+}
+
+
+void BulkLoader::append(double value)
+{
+	Poco::Int64 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	beginField(8);
+	writeInt64(bits);
+}
+
+
+void BulkLoader::append(const std::string& value)
+{
+	appendBytes(value.data(), value.size());
+}
+
+
+void BulkLoader::append(const char* value)
+{
+	poco_check_ptr (value);
+
+	appendBytes(value, std::strlen(value));
+}
+
+
+void BulkLoader::append(const CLOB& value)
+{
+	appendBytes(value.rawContent(), value.size());
+}
+
+
+void BulkLoader::append(const BLOB& value)
+{
+	appendBytes(reinterpret_cast<const char*>(value.rawContent()), value.size());
+}
+
+
+void BulkLoader::append(const Date& value)
+{
+	Poco::Timespan span = Poco::DateTime(value.year(), value.month(), value.day()) - POSTGRES_EPOCH;
+	beginField(4);
+	writeInt32(span.days());
+}
+
+
+void BulkLoader::append(const Time& value)
+{
+	Poco::Timespan span(0, value.hour(), value.minute(), value.second(), 0);
+	beginField(8);
+	writeInt64(span.totalMicroseconds());
+}
+
+
+void BulkLoader::append(const Poco::DateTime& value)
+{
+	Poco::Timespan span = value - POSTGRES_EPOCH;
+	beginField(8);
+	writeInt64(span.totalMicroseconds());
+}
+
+
+void BulkLoader::append(const Poco::UUID& value)
+{
+	char bytes[16];
+	value.copyTo(bytes);
+	appendBytes(bytes, sizeof(bytes));
+}
+
+
+void BulkLoader::appendNull()
+{
+	beginField(-1);
+}
+
+
+void BulkLoader::endRow()
+{
+	checkOpen();
+
+	if (_fieldCount != _columnCount)
+	{
+		throw InvalidAccessException("Number of values in row differs from number of columns");
+	}
+	_fieldCount = 0;
+	++_rowCount;
+
+	if (_buffer.size() >= _bufferSize) flush();
+}
+
+
+void BulkLoader::flush()
+{
+	checkOpen();
+
+	if (_buffer.empty()) return;
+
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	// blocks until libpq can take the data
+	if (PQputCopyData(_sessionHandle, _buffer.data(), static_cast<int>(_buffer.size())) != 1)
+	{
+		throwConnectionError();
+	}
+	_buffer.clear();
+}
+
+
+Poco::UInt64 BulkLoader::finish()
+{
+	checkOpen();
+
+	if (_fieldCount != 0) throw InvalidAccessException("Incomplete row");
+
+	writeInt16(-1);
+	flush();
+
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	// if this fails, the destructor still aborts the COPY
+	if (PQputCopyEnd(_sessionHandle, 0) != 1)
+	{
+		throwConnectionError();
+	}
+	_open = false;
+
+	PGresult* pResult = PQgetResult(_sessionHandle);
+	PQResultClear resultClearer(pResult);
+
+	PGresult* pNextResult = 0;
+	while ((pNextResult = PQgetResult(_sessionHandle)) != 0)
+	{
+		PQclear(pNextResult);
+	}
+
+	if (!pResult || PQresultStatus(pResult) != PGRES_COMMAND_OK)
+	{
+		throw StatementException(std::string("postgresql COPY error: ")
+			+ (pResult ? PQresultErrorMessage(pResult) : PQerrorMessage(_sessionHandle)));
+	}
+
+	Poco::UInt64 count = 0;
+	Poco::NumberParser::tryParseUnsigned64(PQcmdTuples(pResult), count);
+	return count;
+}
+
+
+void BulkLoader::abort(const std::string& reason)
+{
+	if (!_open) return;
+
+	_open = false;
+	_buffer.clear();
+	_fieldCount = 0;
+
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	if (PQputCopyEnd(_sessionHandle, reason.c_str()) != 1)
+	{
+		throwConnectionError();
+	}
+
+	PGresult* pResult = 0;
+	while ((pResult = PQgetResult(_sessionHandle)) != 0)
+	{
+		PQclear(pResult);
+	}
+}
+
+
+void BulkLoader::beginField(Poco::Int32 length)
+{
+	checkOpen();
+
+	if (_fieldCount == _columnCount)
+	{
+		throw InvalidAccessException("More values in row than columns");
+	}
+	if (_fieldCount == 0)
+	{
+		writeInt16(static_cast<Poco::Int16>(_columnCount));
+	}
+	writeInt32(length);
+	++_fieldCount;
+}
+
+
+void BulkLoader::appendBytes(const char* pData, std::size_t length)
+{
+	beginField(static_cast<Poco::Int32>(length));
+	_buffer.append(pData, length);
+}
+
+
+void BulkLoader::writeInt16(Poco::Int16 value)
+{
+	value = Poco::ByteOrder::toNetwork(value);
+	_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+void BulkLoader::writeInt32(Poco::Int32 value)
+{
+	value = Poco::ByteOrder::toNetwork(value);
+	_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+void BulkLoader::writeInt64(Poco::Int64 value)
+{
+	value = Poco::ByteOrder::toNetwork(value);
+	_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+void BulkLoader::checkOpen() const
+{
+	if (!_open) throw InvalidAccessException("BulkLoader is closed");
+}
+
+
+void BulkLoader::throwConnectionError()
+{
+	throw StatementException(std::string("postgresql COPY error: ") + PQerrorMessage(_sessionHandle));
+}
+
+
+} } } // namespace Poco::SQL::PostgreSQL
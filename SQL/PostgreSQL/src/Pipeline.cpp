@@ -0,0 +1,463 @@
+//
+// Pipeline.cpp
+//
+// Library: SQL/PostgreSQL
+// Package: PostgreSQL
+// Module:  Pipeline
+//
+// Copyright (c) 2015, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SQL/PostgreSQL/Pipeline.h"
+
+
+#ifdef LIBPQ_HAS_PIPELINING
+
+
+#include "Poco/SQL/PostgreSQL/PostgreSQLException.h"
+#include "Poco/SQL/PostgreSQL/Utility.h"
+#include "Poco/SQL/SQLException.h"
+#include "Poco/UUID.h"
+#include "Poco/UUIDGenerator.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+
+
+namespace Poco {
+namespace SQL {
+namespace PostgreSQL {
+
+
+//
+// Pipeline::Result
+//
+
+
+Pipeline::Result::Result():
+	_id(0)
+{
+}
+
+
+Pipeline::Result::Result(Poco::UInt64 id, PGresult* pResult):
+	_id(id),
+	_pResult(pResult)
+{
+}
+
+
+Pipeline::Result::~Result()
+{
+}
+
+
+bool Pipeline::Result::isError() const
+{
+	if (!_pResult) return true;
+
+	ExecStatusType status = PQresultStatus(_pResult.get());
+	return status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK;
+}
+
+
+bool Pipeline::Result::isAborted() const
+{
+	return _pResult && PQresultStatus(_pResult.get()) == PGRES_PIPELINE_ABORTED;
+}
+
+
+std::string Pipeline::Result::errorMessage() const
+{
+	if (!_pResult) return std::string();
+
+	std::string message(PQresultErrorMessage(_pResult.get()));
+	if (message.empty() && isAborted())
+	{
+		message = "statement not executed due to an earlier error";
+	}
+	return message;
+}
+
+
+std::size_t Pipeline::Result::affectedRowCount() const
+{
+	if (!_pResult) return 0;
+
+	if (PQresultStatus(_pResult.get()) == PGRES_TUPLES_OK)
+	{
+		return rowCount();
+	}
+
+	unsigned count = 0;
+	Poco::NumberParser::tryParseUnsigned(PQcmdTuples(const_cast<PGresult*>(_pResult.get())), count);
+	return count;
+}
+
+
+std::size_t Pipeline::Result::rowCount() const
+{
+	return _pResult ? static_cast<std::size_t>(PQntuples(_pResult.get())) : 0;
+}
+
+
+std::size_t Pipeline::Result::columnCount() const
+{
+	return _pResult ? static_cast<std::size_t>(PQnfields(_pResult.get())) : 0;
+}
+
+
+std::string Pipeline::Result::columnName(std::size_t col) const
+{
+	if (col >= columnCount()) throw RangeException("Invalid column index");
+
+	return PQfname(_pResult.get(), static_cast<int>(col));
+}
+
+
+bool Pipeline::Result::isNull(std::size_t row, std::size_t col) const
+{
+	checkPosition(row, col);
+
+	return PQgetisnull(_pResult.get(), static_cast<int>(row), static_cast<int>(col)) == 1;
+}
+
+
+std::string Pipeline::Result::value(std::size_t row, std::size_t col) const
+{
+	checkPosition(row, col);
+
+	return std::string(PQgetvalue(_pResult.get(), static_cast<int>(row), static_cast<int>(col)),
+		PQgetlength(_pResult.get(), static_cast<int>(row), static_cast<int>(col)));
+}
+
+
+void Pipeline::Result::checkPosition(std::size_t row, std::size_t col) const
+{
+	if (row >= rowCount()) throw RangeException("Invalid row index");
+	if (col >= columnCount()) throw RangeException("Invalid column index");
+}
+
+
+//
+// Pipeline
+//
+
+
+Pipeline::Pipeline(Poco::SQL::Session& session):
+	_sessionHandle(*Utility::handle(session)),
+	_pCurrentResult(0),
+	_pPrepareError(0),
+	_nextId(0),
+	_pending(0),
+	_wasNonblocking(false),
+	_flushed(true),
+	_flushPending(false),
+	_synced(true),
+	_open(false)
+{
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	if (!_sessionHandle || PQstatus(_sessionHandle) != CONNECTION_OK) throw NotConnectedException();
+
+	_wasNonblocking = PQisnonblocking(_sessionHandle) == 1;
+	if (!_wasNonblocking && PQsetnonblocking(_sessionHandle, 1) != 0)
+	{
+		throw StatementException(std::string("cannot enter nonblocking mode: ") + PQerrorMessage(_sessionHandle));
+	}
+	if (PQenterPipelineMode(_sessionHandle) != 1)
+	{
+		std::string message(PQerrorMessage(_sessionHandle));
+		if (!_wasNonblocking) PQsetnonblocking(_sessionHandle, 0);
+		throw StatementException("cannot enter pipeline mode: " + message);
+	}
+	_open = true;
+}
+
+
+Pipeline::~Pipeline()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+Poco::UInt64 Pipeline::add(const std::string& sql, const Parameters& params)
+{
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	checkOpen();
+
+	std::map<std::string, std::string>::const_iterator it = _statements.find(sql);
+	if (it == _statements.end())
+	{
+		Poco::UUIDGenerator& generator = Poco::UUIDGenerator::defaultGenerator();
+		std::string statementName = generator.createRandom().toString();
+		statementName.insert(0, 1, 'p'); // prepared statement names can't start with a number
+		std::replace(statementName.begin(), statementName.end(), '-', 'p');  // PostgreSQL doesn't like dashes in prepared statement names
+
+		if (PQsendPrepare(_sessionHandle, statementName.c_str(), sql.c_str(), 0, 0) != 1)
+		{
+			throwConnectionError();
+		}
+
+		Command command = { Command::COMMAND_PREPARE, 0, sql };
+		_commands.push_back(command);
+		it = _statements.insert(std::make_pair(sql, statementName)).first;
+	}
+
+	std::vector<const char*> values;
+	values.reserve(params.size());
+	for (Parameters::const_iterator itParam = params.begin(); itParam != params.end(); ++itParam)
+	{
+		values.push_back(itParam->isNull() ? 0 : itParam->value().c_str());
+	}
+
+	if (PQsendQueryPrepared(_sessionHandle, it->second.c_str(), static_cast<int>(values.size()),
+		values.empty() ? 0 : &values[0], 0, 0, 0) != 1)
+	{
+		throwConnectionError();
+	}
+
+	Command command = { Command::COMMAND_QUERY, ++_nextId, std::string() };
+	_commands.push_back(command);
+	++_pending;
+	_flushed = false;
+	_synced = false;
+
+	return command.id;
+}
+
+
+void Pipeline::sync()
+{
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	checkOpen();
+
+	if (PQpipelineSync(_sessionHandle) != 1)
+	{
+		throwConnectionError();
+	}
+
+	Command command = { Command::COMMAND_SYNC, 0, std::string() };
+	_commands.push_back(command);
+	_flushed = true;
+	_synced = true;
+}
+
+
+bool Pipeline::poll()
+{
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	checkOpen();
+
+	if (!_commands.empty())
+	{
+		_flushPending = !requestFlush();
+		if (PQconsumeInput(_sessionHandle) != 1)
+		{
+			throwConnectionError();
+		}
+		while (!_commands.empty() && !PQisBusy(_sessionHandle))
+		{
+			readResult();
+		}
+	}
+	return !_results.empty();
+}
+
+
+Pipeline::Result Pipeline::next()
+{
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	checkOpen();
+
+	if (_pending == 0) throw InvalidAccessException("No pending statements");
+
+	if (_results.empty())
+	{
+		// PQgetResult() waits until the rest of the data has been sent
+		requestFlush();
+		_flushPending = false;
+		while (_results.empty())
+		{
+			readResult();
+		}
+	}
+
+	Result result = _results.front();
+	_results.pop_front();
+	--_pending;
+	return result;
+}
+
+
+int Pipeline::socket() const
+{
+	return PQsocket(_sessionHandle);
+}
+
+
+void Pipeline::close()
+{
+	std::map<std::string, std::string> statements;
+	{
+		Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+		if (!_open) return;
+
+		if (PQstatus(_sessionHandle) == CONNECTION_OK)
+		{
+			// an open unit would leave an implicit transaction behind
+			if (!_synced)
+			{
+				if (PQpipelineSync(_sessionHandle) != 1) throwConnectionError();
+
+				Command command = { Command::COMMAND_SYNC, 0, std::string() };
+				_commands.push_back(command);
+				_synced = true;
+			}
+			while (!_commands.empty())
+			{
+				readResult();
+			}
+			if (PQexitPipelineMode(_sessionHandle) != 1)
+			{
+				throwConnectionError();
+			}
+			statements.swap(_statements);
+		}
+		if (!_wasNonblocking) PQsetnonblocking(_sessionHandle, 0);
+
+		_commands.clear();
+		_results.clear();
+		_statements.clear();
+		_pending = 0;
+		_flushPending = false;
+		PQclear(_pCurrentResult);
+		_pCurrentResult = 0;
+		PQclear(_pPrepareError);
+		_pPrepareError = 0;
+		_open = false;
+	}
+
+	for (std::map<std::string, std::string>::const_iterator it = statements.begin(); it != statements.end(); ++it)
+	{
+		_sessionHandle.deallocatePreparedStatement(it->second);
+	}
+}
+
+
+void Pipeline::checkOpen() const
+{
+	if (!_open) throw InvalidAccessException("Pipeline is closed");
+}
+
+
+bool Pipeline::requestFlush()
+{
+	// without a sync or flush request, the server
+	// holds back the results of the last statements
+	if (!_flushed)
+	{
+		if (PQsendFlushRequest(_sessionHandle) != 1)
+		{
+			throwConnectionError();
+		}
+		_flushed = true;
+	}
+	// in nonblocking mode, 1 means that data remains to be sent
+	int rc = PQflush(_sessionHandle);
+	if (rc < 0)
+	{
+		throwConnectionError();
+	}
+	return rc == 0;
+}
+
+
+void Pipeline::readResult()
+{
+	const Command& command = _commands.front();
+	PGresult* pResult = PQgetResult(_sessionHandle);
+
+	if (command.type == Command::COMMAND_SYNC)
+	{
+		if (!pResult) throwConnectionError();
+
+		PQclear(pResult);
+		PQclear(_pPrepareError);
+		_pPrepareError = 0;
+		_commands.pop_front();
+	}
+	else if (pResult)
+	{
+		// the result is complete when followed by a null pointer
+		PQclear(_pCurrentResult);
+		_pCurrentResult = pResult;
+	}
+	else
+	{
+		if (!_pCurrentResult) throwConnectionError();
+
+		pResult = _pCurrentResult;
+		_pCurrentResult = 0;
+		handleResult(command, pResult);
+		_commands.pop_front();
+	}
+}
+
+
+void Pipeline::handleResult(const Command& command, PGresult* pResult)
+{
+	ExecStatusType status = PQresultStatus(pResult);
+
+	if (command.type == Command::COMMAND_PREPARE)
+	{
+		if (status != PGRES_COMMAND_OK)
+		{
+			_statements.erase(command.sql);
+		}
+		if (status == PGRES_FATAL_ERROR)
+		{
+			// reported for the statement, which is aborted
+			PQclear(_pPrepareError);
+			_pPrepareError = pResult;
+		}
+		else PQclear(pResult);
+	}
+	else
+	{
+		if (status == PGRES_PIPELINE_ABORTED && _pPrepareError)
+		{
+			PQclear(pResult);
+			pResult = _pPrepareError;
+			_pPrepareError = 0;
+		}
+		_results.push_back(Result(command.id, pResult));
+	}
+}
+
+
+void Pipeline::throwConnectionError()
+{
+	throw StatementException(std::string("postgresql pipeline error: ") + PQerrorMessage(_sessionHandle));
+}
+
+
+} } } // namespace Poco::SQL::PostgreSQL
+
+
+#endif // LIBPQ_HAS_PIPELINING
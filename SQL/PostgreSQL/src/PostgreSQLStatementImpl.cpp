@@ -20,7 +20,7 @@ namespace PostgreSQL {
 
 
 PostgreSQLStatementImpl::PostgreSQLStatementImpl(SessionImpl& aSessionImpl): Poco::SQL::StatementImpl(aSessionImpl),
-	_statementExecutor(aSessionImpl.handle()),
+	_statementExecutor(aSessionImpl.handle(), &aSessionImpl.statementCache()),
 	_pBinder(new Binder),
 	_pBulkBinder(new Binder),
 	_pExtractor(new Extractor (_statementExecutor)),
@@ -155,6 +155,7 @@ void PostgreSQLStatementImpl::bindImpl()
 	_statementExecutor.bindParams(_pBinder->bindVector());
 	_statementExecutor.bindBulkParams(_pBulkBinder->bindVector());
 
+	_statementExecutor.setStreamResults(session().getFeature("streamResults"));
 	_statementExecutor.execute();
 
 	_hasNext = NEXT_DONTKNOW;
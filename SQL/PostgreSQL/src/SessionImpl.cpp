@@ -57,8 +57,13 @@ namespace PostgreSQL {
 
 
 SessionImpl::SessionImpl(const std::string& aConnectionString, std::size_t aLoginTimeout):
-	Poco::SQL::AbstractSessionImpl<SessionImpl>(aConnectionString, aLoginTimeout)
+	Poco::SQL::AbstractSessionImpl<SessionImpl>(aConnectionString, aLoginTimeout),
+	_streamResults(false)
 {
+	addFeature("streamResults",
+		&SessionImpl::setStreamResults,
+		&SessionImpl::isStreamResults);
+
 	setFeature("bulk", true);
 	setProperty("handle", static_cast<SessionHandle*>(&_sessionHandle));
 	setConnectionTimeout(CONNECTION_TIMEOUT_DEFAULT);
@@ -149,6 +154,9 @@ void SessionImpl::close()
 	{
 		_sessionHandle.disconnect();
 	}
+
+	// prepared statements do not survive the connection
+	statementCache().clear();
 }
 
 void SessionImpl::reset()
@@ -224,6 +232,18 @@ bool SessionImpl::isAsynchronousCommit(const std::string&) const
 }
 
 
+void SessionImpl::setStreamResults(const std::string&, bool aValue)
+{
+	_streamResults = aValue;
+}
+
+
+bool SessionImpl::isStreamResults(const std::string&) const
+{
+	return _streamResults;
+}
+
+
 void SessionImpl::setTransactionIsolation(Poco::UInt32 aTI)
 {
 	return _sessionHandle.setTransactionIsolation(aTI);
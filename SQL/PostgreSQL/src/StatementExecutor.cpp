@@ -86,6 +86,77 @@ namespace
 */
 	return placeholderSet.size();
 	}
+
+	void throwExecuteError(PGresult* ptrPGResult)
+	{
+		Poco::SQL::PostgreSQL::PQResultClear resultClearer(ptrPGResult);
+
+		const char* pSeverity	= PQresultErrorField(ptrPGResult, PG_DIAG_SEVERITY);
+		const char* pSQLState	= PQresultErrorField(ptrPGResult, PG_DIAG_SQLSTATE);
+		const char* pDetail		= PQresultErrorField(ptrPGResult, PG_DIAG_MESSAGE_DETAIL);
+		const char* pHint		= PQresultErrorField(ptrPGResult, PG_DIAG_MESSAGE_HINT);
+		const char* pConstraint	= PQresultErrorField(ptrPGResult, PG_DIAG_CONSTRAINT_NAME);
+
+		throw Poco::SQL::PostgreSQL::StatementException(std::string("postgresql_stmt_execute error: ")
+			+ PQresultErrorMessage (ptrPGResult)
+			+ " Severity: " + (pSeverity   ? pSeverity   : "N/A")
+			+ " State: " + (pSQLState   ? pSQLState   : "N/A")
+			+ " Detail: " + (pDetail ? pDetail : "N/A")
+			+ " Hint: " + (pHint   ? pHint   : "N/A")
+			+ " Constraint: " + (pConstraint ? pConstraint : "N/A"));
+	}
+
+	class CachedStatement: public Poco::SQL::StatementCache::Handle
+		/// A prepared statement in the session's StatementCache.
+	{
+	public:
+		CachedStatement(const Poco::SQL::StatementCache& aStatementCache,
+			const std::string& aSQLStatement,
+			Poco::SQL::PostgreSQL::SessionHandle& aSessionHandle,
+			const std::string& aPreparedStatementName,
+			std::size_t aCountPlaceholders,
+			const std::vector<Poco::SQL::MetaColumn>& aResultColumns):
+				Poco::SQL::StatementCache::Handle(aStatementCache, aSQLStatement),
+				_sessionHandle(aSessionHandle),
+				_preparedStatementName(aPreparedStatementName),
+				_countPlaceholders(aCountPlaceholders),
+				_resultColumns(aResultColumns)
+		{
+		}
+
+		~CachedStatement()
+		{
+			try
+			{
+				if (_sessionHandle.isConnected())
+				{
+					_sessionHandle.deallocatePreparedStatement(_preparedStatementName);
+				}
+			}
+			catch (...) { }
+		}
+
+		const std::string& preparedStatementName() const
+		{
+			return _preparedStatementName;
+		}
+
+		std::size_t countPlaceholders() const
+		{
+			return _countPlaceholders;
+		}
+
+		const std::vector<Poco::SQL::MetaColumn>& resultColumns() const
+		{
+			return _resultColumns;
+		}
+
+	private:
+		Poco::SQL::PostgreSQL::SessionHandle& _sessionHandle;
+		std::string                           _preparedStatementName;
+		std::size_t                           _countPlaceholders;
+		std::vector<Poco::SQL::MetaColumn>    _resultColumns;
+	};
 } // namespace
 
 
@@ -94,12 +165,17 @@ namespace SQL {
 namespace PostgreSQL {
 
 
-StatementExecutor::StatementExecutor(SessionHandle& sessionHandle):_sessionHandle(sessionHandle),
+StatementExecutor::StatementExecutor(SessionHandle& sessionHandle, StatementCache* aStatementCachePtr):_sessionHandle(sessionHandle),
+	_pStatementCache(aStatementCachePtr),
 	_state(STMT_INITED),
 	_pResultHandle(0),
 	_countPlaceholdersInSQLStatement(0),
 	_currentRow(0),
-	_affectedRowCount(0)
+	_affectedRowCount(0),
+	_streamResults(false),
+	_streaming(false),
+	_cancelStreaming(false),
+	_rowPending(false)
 {
 }
 
@@ -108,13 +184,19 @@ StatementExecutor::~StatementExecutor()
 {
 	try
 	{
-		// remove the prepared statement from the session
-		if(_sessionHandle.isConnected() && _state >= STMT_COMPILED)
+		finishStreaming();
+
+		PQResultClear resultClearer(_pResultHandle);
+
+		// return the prepared statement to the cache, or remove it from the session
+		if (_pCachedStatement)
+		{
+			_pStatementCache->release(_pCachedStatement);
+		}
+		else if(_sessionHandle.isConnected() && _state >= STMT_COMPILED)
 		{
 			_sessionHandle.deallocatePreparedStatement(_preparedStatementName);
 		}
-
-		PQResultClear resultClearer(_pResultHandle);
 	}
 	catch (...) { }
 }
@@ -140,6 +222,29 @@ void StatementExecutor::prepare(const std::string& aSQLStatement)
 	// clear out any result data.  One way or another it is now obsolete.
 	clearResults();
 
+	if (_pStatementCache)
+	{
+		// return the previously prepared statement to the cache
+		if (_pCachedStatement)
+		{
+			_pStatementCache->release(_pCachedStatement);
+			_pCachedStatement = 0;
+		}
+
+		_pCachedStatement = _pStatementCache->acquire(aSQLStatement);
+		if (_pCachedStatement)
+		{
+			const CachedStatement& cachedStatement = *_pCachedStatement.cast<CachedStatement>();
+
+			_SQLStatement = aSQLStatement;
+			_preparedStatementName = cachedStatement.preparedStatementName();
+			_countPlaceholdersInSQLStatement = cachedStatement.countPlaceholders();
+			_resultColumns = cachedStatement.resultColumns();
+			_state = STMT_COMPILED;  // must be last
+			return;
+		}
+	}
+
 	// prepare parameters for the call to PQprepare
 	const char* ptrCSQLStatement = aSQLStatement.c_str();
 	std::size_t countPlaceholdersInSQLStatement = countOfPlaceHoldersInSQLStatement(aSQLStatement);
@@ -198,6 +303,13 @@ void StatementExecutor::prepare(const std::string& aSQLStatement)
 	_SQLStatement = aSQLStatement;
 	_preparedStatementName = statementName;
 	_countPlaceholdersInSQLStatement = countPlaceholdersInSQLStatement;
+
+	if (_pStatementCache)
+	{
+		_pCachedStatement = new CachedStatement(*_pStatementCache, aSQLStatement, _sessionHandle,
+			statementName, countPlaceholdersInSQLStatement, _resultColumns);
+	}
+
 	_state = STMT_COMPILED;  // must be last
 }
 
@@ -274,6 +386,33 @@ void StatementExecutor::execute()
 	// clear out any result data.  One way or another it is now obsolete.
 	clearResults();
 
+	if (_streamResults && columnsReturned() > 0 && _inputBulkParameterVector.empty())
+	{
+		{
+			Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+			// while the query runs, the status is PQTRANS_ACTIVE, so a
+			// transaction block must be detected before it is sent
+			_cancelStreaming = PQtransactionStatus(_sessionHandle) == PQTRANS_IDLE;
+
+			if (PQsendQueryPrepared(_sessionHandle,
+				_preparedStatementName.c_str(), (int)_countPlaceholdersInSQLStatement,
+				_inputParameterVector.size() != 0 ? &pParameterVector[ 0 ] : 0,
+				_inputParameterVector.size() != 0 ? &parameterLengthVector[ 0 ] : 0,
+				_inputParameterVector.size() != 0 ? &parameterFormatVector[ 0 ] : 0, 0) != 1)
+			{
+				throw StatementException(std::string("postgresql_stmt_execute error: ") + PQerrorMessage(_sessionHandle));
+			}
+			PQsetSingleRowMode(_sessionHandle);
+		}
+		_streaming = true;
+
+		// errors are reported with the first row
+		_rowPending = fetchRow();
+		_state = STMT_EXECUTED;
+		return;
+	}
+
 	PGresult* ptrPGResult = 0;
 	{
 		Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
@@ -312,21 +451,7 @@ void StatementExecutor::execute()
 		PQresultStatus(ptrPGResult) != PGRES_TUPLES_OK &&
 		PQresultStatus(ptrPGResult) != PGRES_COPY_IN))
 	{
-		PQResultClear resultClearer(ptrPGResult);
-
-		const char* pSeverity	= PQresultErrorField(ptrPGResult, PG_DIAG_SEVERITY);
-		const char* pSQLState	= PQresultErrorField(ptrPGResult, PG_DIAG_SQLSTATE);
-		const char* pDetail		= PQresultErrorField(ptrPGResult, PG_DIAG_MESSAGE_DETAIL);
-		const char* pHint		= PQresultErrorField(ptrPGResult, PG_DIAG_MESSAGE_HINT);
-		const char* pConstraint	= PQresultErrorField(ptrPGResult, PG_DIAG_CONSTRAINT_NAME);
-
-		throw StatementException(std::string("postgresql_stmt_execute error: ")
-			+ PQresultErrorMessage (ptrPGResult)
-			+ " Severity: " + (pSeverity   ? pSeverity   : "N/A")
-			+ " State: " + (pSQLState   ? pSQLState   : "N/A")
-			+ " Detail: " + (pDetail ? pDetail : "N/A")
-			+ " Hint: " + (pHint   ? pHint   : "N/A")
-			+ " Constraint: " + (pConstraint ? pConstraint : "N/A"));
+		throwExecuteError(ptrPGResult);
 	}
 
 	_pResultHandle = ptrPGResult;
@@ -385,29 +510,45 @@ bool StatementExecutor::fetch()
 		_outputParameterVector.resize(countColumns);
 	}
 
-	// already retrieved last row?
-	if (_currentRow == getAffectedRowCount())
+	std::size_t row = _currentRow;  // the row within the result
+
+	if (_streaming || _rowPending)
 	{
-		return false;
+		// every result holds a single row
+		if (0 == countColumns || (!_rowPending && !fetchRow()))
+		{
+			return false;
+		}
+		_rowPending = false;
+		row = 0;
+		++_affectedRowCount;
 	}
-
-	if	(0 == countColumns || PGRES_TUPLES_OK != PQresultStatus(_pResultHandle))
+	else
 	{
-		return false;
+		// already retrieved last row?
+		if (_currentRow == getAffectedRowCount())
+		{
+			return false;
+		}
+
+		if	(0 == countColumns || PGRES_TUPLES_OK != PQresultStatus(_pResultHandle))
+		{
+			return false;
+		}
 	}
 
 	for (int i = 0; i < countColumns; ++i)
 	{
-		int fieldLength = PQgetlength(_pResultHandle, static_cast<int> (_currentRow), static_cast<int> (i));
+		int fieldLength = PQgetlength(_pResultHandle, static_cast<int> (row), static_cast<int> (i));
 		
 		Oid columnInternalDataType = PQftype(_pResultHandle, i);  // Oid of column
 
 		_outputParameterVector.at(i).setValues(oidToColumnDataType(columnInternalDataType), // Poco::SQL::MetaData version of the Column Data Type
 			columnInternalDataType, // Postgres Version
-			_currentRow, // the row number of the result
-			PQgetvalue(_pResultHandle, (int)_currentRow, i), // a pointer to the data
+			row, // the row number of the result
+			PQgetvalue(_pResultHandle, (int)row, i), // a pointer to the data
 			(-1 == fieldLength ? 0 : fieldLength), // the length of the data returned
-			PQgetisnull(_pResultHandle, (int)_currentRow, i) == 1 ? true : false); // is the column value null?
+			PQgetisnull(_pResultHandle, (int)row, i) == 1 ? true : false); // is the column value null?
 	}
 
 	++_currentRow;
@@ -451,6 +592,8 @@ const OutputParameter& StatementExecutor::resultColumn(std::size_t aPosition) co
 
 void StatementExecutor::clearResults()
 {
+	finishStreaming();
+
 	// clear out any old result first
 	{
 		PQResultClear resultClearer(_pResultHandle);
@@ -459,6 +602,70 @@ void StatementExecutor::clearResults()
 	_outputParameterVector.clear();
 	_affectedRowCount	= 0;
 	_currentRow			= 0;
+	_rowPending			= false;
+}
+
+
+bool StatementExecutor::fetchRow()
+{
+	{
+		PQResultClear resultClearer(_pResultHandle);
+	}
+	_pResultHandle = 0;
+
+	PGresult* ptrPGResult = 0;
+	{
+		Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+		ptrPGResult = PQgetResult(_sessionHandle);
+	}
+
+	if (ptrPGResult && PQresultStatus(ptrPGResult) == PGRES_SINGLE_TUPLE)
+	{
+		_pResultHandle = ptrPGResult;
+		return true;
+	}
+
+	// the result is complete, or the query failed
+	finishStreaming();
+
+	if (ptrPGResult && PQresultStatus(ptrPGResult) != PGRES_TUPLES_OK)
+	{
+		throwExecuteError(ptrPGResult);
+	}
+
+	PQResultClear resultClearer(ptrPGResult);
+	return false;
+}
+
+
+void StatementExecutor::finishStreaming()
+{
+	if (!_streaming) return;
+
+	_streaming = false;
+
+	// don't read the remaining rows of an abandoned result;
+	// cancelling the query would abort a running transaction, though,
+	// including one started with a plain BEGIN statement
+	if (_pResultHandle && _cancelStreaming)
+	{
+		try
+		{
+			_sessionHandle.cancel();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	Poco::FastMutex::ScopedLock mutexLocker(_sessionHandle.mutex());
+
+	PGresult* ptrPGResult = 0;
+	while ((ptrPGResult = PQgetResult(_sessionHandle)) != 0)
+	{
+		PQclear(ptrPGResult);
+	}
 }
 
 
@@ -14,6 +14,8 @@
 #include "Poco/Environment.h"
 #include "Poco/String.h"
 #include "Poco/Format.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
 #include "Poco/Tuple.h"
 #include "Poco/NamedTuple.h"
 #include "Poco/Exception.h"
@@ -22,15 +24,22 @@
 #include "Poco/SQL/PostgreSQL/Connector.h"
 #include "Poco/SQL/PostgreSQL/Utility.h"
 #include "Poco/SQL/PostgreSQL/PostgreSQLException.h"
+#include "Poco/SQL/PostgreSQL/Pipeline.h"
+#include "Poco/SQL/PostgreSQL/BulkLoader.h"
 #include "Poco/Nullable.h"
 #include "Poco/SQL/SQLException.h"
 #include <iostream>
+#include <list>
 
 using namespace Poco::SQL;
 using namespace Poco::SQL::Keywords;
 using Poco::SQL::PostgreSQL::ConnectionException;
 using Poco::SQL::PostgreSQL::Utility;
 using Poco::SQL::PostgreSQL::StatementException;
+using Poco::SQL::PostgreSQL::BulkLoader;
+#ifdef LIBPQ_HAS_PIPELINING
+using Poco::SQL::PostgreSQL::Pipeline;
+#endif
 using Poco::format;
 using Poco::NotFoundException;
 using Poco::Int32;
@@ -776,6 +785,223 @@ void PostgreSQLTest::testReconnect()
 }
 
 
+void PostgreSQLTest::testPipeline()
+{
+	if (!_pSession) fail ("Test not available.");
+
+#ifdef LIBPQ_HAS_PIPELINING
+	recreateIntsTable();
+
+	{
+		Pipeline pipeline(*_pSession);
+		for (int i = 0; i < 100; ++i)
+		{
+			Pipeline::Parameters params;
+			params.push_back(Poco::NumberFormatter::format(i));
+			assertTrue (pipeline.add("INSERT INTO Strings VALUES ($1)", params) == Poco::UInt64(i + 1));
+		}
+		pipeline.add("SELECT COUNT(*), SUM(str) FROM Strings");
+		pipeline.sync();
+		assertTrue (pipeline.pending() == 101);
+
+		for (int i = 0; i < 100; ++i)
+		{
+			Pipeline::Result result = pipeline.next();
+			assertTrue (result.id() == Poco::UInt64(i + 1));
+			assertTrue (!result.isError());
+			assertTrue (result.affectedRowCount() == 1);
+		}
+		Pipeline::Result result = pipeline.next();
+		assertTrue (!result.isError());
+		assertTrue (result.rowCount() == 1);
+		assertTrue (result.columnCount() == 2);
+		assertTrue (result.value(0, 0) == "100");
+		assertTrue (result.value(0, 1) == "4950");
+		assertTrue (pipeline.pending() == 0);
+
+		try
+		{
+			pipeline.next();
+			fail ("must fail");
+		}
+		catch (Poco::InvalidAccessException&) { }
+
+		// a failing statement aborts the rest of the unit
+		Pipeline::Parameters params;
+		params.push_back(Nullable<std::string>());
+		pipeline.add("INSERT INTO Strings VALUES ($1)", params);
+		pipeline.add("SELECT * FROM NoSuchTable");
+		pipeline.add("SELECT COUNT(*) FROM Strings");
+		pipeline.sync();
+		pipeline.add("SELECT COUNT(*) FROM Strings WHERE str IS NULL");
+
+		result = pipeline.next();
+		assertTrue (!result.isError());
+		result = pipeline.next();
+		assertTrue (result.isError() && !result.isAborted());
+		assertTrue (!result.errorMessage().empty());
+		result = pipeline.next();
+		assertTrue (result.isError() && result.isAborted());
+
+		// the implicit transaction of the failed unit has been rolled back
+		while (!pipeline.poll()) Poco::Thread::sleep(10);
+		result = pipeline.next();
+		assertTrue (result.value(0, 0) == "0");
+
+		pipeline.close();
+		assertTrue (!pipeline.isOpen());
+	}
+
+	int count = 0;
+	*_pSession << "SELECT COUNT(*) FROM Strings", into(count), now;
+	assertTrue (count == 100);
+#endif
+}
+
+
+void PostgreSQLTest::testStreamResults()
+{
+	if (!_pSession) fail ("Test not available.");
+
+	recreateIntsTable();
+
+	std::vector<int> data;
+	for (int i = 0; i < 100; ++i) data.push_back(i);
+	*_pSession << "INSERT INTO Strings VALUES ($1)", use(data), now;
+
+	assertTrue (!_pSession->getFeature("streamResults"));
+	_pSession->setFeature("streamResults", true);
+	try
+	{
+		std::vector<int> ints;
+		Statement stmt = (*_pSession << "SELECT str FROM Strings ORDER BY str", into(ints), limit(10));
+		std::size_t steps = 0;
+		while (!stmt.done())
+		{
+			ints.clear();
+			assertTrue (stmt.execute() <= 10);
+			for (std::vector<int>::const_iterator it = ints.begin(); it != ints.end(); ++it)
+			{
+				assertTrue (*it == static_cast<int>(steps * 10 + (it - ints.begin())));
+			}
+			++steps;
+		}
+		assertTrue (steps >= 10);
+
+		// abandoning a partially fetched result frees the connection
+		{
+			Statement partial = (*_pSession << "SELECT str FROM Strings ORDER BY str", into(ints), limit(5));
+			partial.execute();
+		}
+
+		int count = 0;
+		*_pSession << "SELECT COUNT(*) FROM Strings", into(count), now;
+		assertTrue (count == 100);
+
+		// abandoning a result inside a transaction started
+		// with a plain BEGIN statement must not abort it
+		*_pSession << "BEGIN", now;
+		*_pSession << "DELETE FROM Strings WHERE str < 50", now;
+		{
+			Statement partial = (*_pSession << "SELECT str FROM Strings ORDER BY str", into(ints), limit(5));
+			partial.execute();
+		}
+		*_pSession << "COMMIT", now;
+		*_pSession << "SELECT COUNT(*) FROM Strings", into(count), now;
+		assertTrue (count == 50);
+	}
+	catch (...)
+	{
+		_pSession->setFeature("streamResults", false);
+		throw;
+	}
+	_pSession->setFeature("streamResults", false);
+}
+
+
+void PostgreSQLTest::testBulkLoader()
+{
+	if (!_pSession) fail ("Test not available.");
+
+	recreatePersonTable();
+
+	std::vector<std::string> lastNames;
+	std::list<std::string> firstNames;
+	std::vector<Nullable<Int32> > ages;
+	for (int i = 0; i < 1000; ++i)
+	{
+		lastNames.push_back("LN" + Poco::NumberFormatter::format(i));
+		firstNames.push_back("FN" + Poco::NumberFormatter::format(i));
+		if (i % 10) ages.push_back(Nullable<Int32>(i));
+		else ages.push_back(Nullable<Int32>());
+	}
+
+	{
+		BulkLoader loader(*_pSession, "Person", "LastName, FirstName, Age", 1024);
+		assertTrue (loader.columnCount() == 3);
+
+		loader.appendRow(std::string("Simpson"), "Bart", 10);
+		loader << std::string("Simpson") << std::string("Lisa");
+		try
+		{
+			loader.endRow();
+			fail ("must fail");
+		}
+		catch (Poco::InvalidAccessException&) { }
+		loader << 8;
+		loader.endRow();
+
+		loader.appendColumns(lastNames, firstNames, ages);
+		try
+		{
+			std::vector<Int32> tooShort(1);
+			loader.appendColumns(lastNames, firstNames, tooShort);
+			fail ("must fail");
+		}
+		catch (Poco::InvalidArgumentException&) { }
+		assertTrue (loader.rowCount() == 1002);
+		assertTrue (loader.finish() == 1002);
+		assertTrue (!loader.isOpen());
+	}
+
+	int count = 0;
+	*_pSession << "SELECT COUNT(*) FROM Person", into(count), now;
+	assertTrue (count == 1002);
+	*_pSession << "SELECT COUNT(*) FROM Person WHERE Age IS NULL", into(count), now;
+	assertTrue (count == 100);
+	int age = 0;
+	*_pSession << "SELECT Age FROM Person WHERE FirstName = 'Lisa'", into(age), now;
+	assertTrue (age == 8);
+
+	// an abandoned loader loads nothing
+	{
+		BulkLoader loader(*_pSession, "Person");
+		loader.appendRow(std::string("Simpson"), std::string("Homer"), std::string("Springfield"), 42);
+	}
+	*_pSession << "SELECT COUNT(*) FROM Person", into(count), now;
+	assertTrue (count == 1002);
+
+	// a type mismatch is reported by finish()
+	{
+		BulkLoader loader(*_pSession, "Person", "Age");
+		loader.appendRow(Poco::Int64(42));
+		try
+		{
+			loader.finish();
+			fail ("must fail");
+		}
+		catch (StatementException&) { }
+	}
+
+	try
+	{
+		BulkLoader loader(*_pSession, "NoSuchTable");
+		fail ("must fail");
+	}
+	catch (StatementException&) { }
+}
+
+
 void PostgreSQLTest::testNullableInt()
 {
 	if (!_pSession) fail ("Test not available.");
@@ -1147,6 +1373,9 @@ CppUnit::Test* PostgreSQLTest::suite()
 	CppUnit_addTest(pSuite, PostgreSQLTest, testSessionTransaction);
 	CppUnit_addTest(pSuite, PostgreSQLTest, testTransaction);
 	CppUnit_addTest(pSuite, PostgreSQLTest, testReconnect);
+	CppUnit_addTest(pSuite, PostgreSQLTest, testPipeline);
+	CppUnit_addTest(pSuite, PostgreSQLTest, testStreamResults);
+	CppUnit_addTest(pSuite, PostgreSQLTest, testBulkLoader);
 
 	return pSuite;
 }
@@ -103,6 +103,9 @@ public:
 	void testTransaction();
 
 	void testReconnect();
+	void testPipeline();
+	void testStreamResults();
+	void testBulkLoader();
 
 	void setUp();
 	void tearDown();
@@ -22,6 +22,7 @@
 #include "Poco/SQL/SQLite/Binder.h"
 #include "Poco/SQL/SQLite/Extractor.h"
 #include "Poco/SQL/StatementImpl.h"
+#include "Poco/SQL/StatementCache.h"
 #include "Poco/SQL/MetaColumn.h"
 #include "Poco/SharedPtr.h"
 
@@ -81,6 +82,10 @@ protected:
 		/// one at a time and returning a pointer to the next one.
 		/// The remainder of the statement is kept in a string
 		/// buffer pointed to by _pLeftover member.
+		///
+		/// A statement that is not part of a batch is taken from
+		/// the session's StatementCache if possible, and returned
+		/// to it when the statement is cleared.
 
 	void bindImpl();
 		/// Binds parameters
@@ -93,7 +98,8 @@ protected:
 
 private:
 	void clear();
-		/// Removes the _pStmt
+		/// Removes the _pStmt, returning it to the
+		/// statement cache if it has been cached.
 
 	typedef Poco::SharedPtr<Binder>             BinderPtr;
 	typedef Poco::SharedPtr<Extractor>          ExtractorPtr;
@@ -103,9 +109,11 @@ private:
 	typedef std::vector<MetaColumnVec>          MetaColumnVecVec;
 	typedef Poco::SharedPtr<std::string>        StrPtr;
 	typedef Bindings::iterator                  BindIt;
+	typedef Poco::SQL::StatementCache::HandlePtr HandlePtr;
 
 	sqlite3*         _pDB;
 	sqlite3_stmt*    _pStmt;
+	HandlePtr        _pHandle;
 	bool             _stepCalled;
 	int              _nextResponse;
 	BinderPtr        _pBinder;
@@ -67,7 +67,8 @@ public:
 		/// in the future.
 
 	void close();
-		/// Closes the session.
+		/// Closes the session and discards all cached
+		/// prepared statements.
 
 	void reset();
 		/// Do nothing
@@ -25,6 +25,34 @@
 #endif
 
 
+namespace
+{
+	class StatementHandle: public Poco::SQL::StatementCache::Handle
+		/// A prepared statement in the session's StatementCache.
+	{
+	public:
+		StatementHandle(const Poco::SQL::StatementCache& cache, const std::string& sql, sqlite3_stmt* pStmt):
+			Poco::SQL::StatementCache::Handle(cache, sql),
+			_pStmt(pStmt)
+		{
+		}
+
+		~StatementHandle()
+		{
+			sqlite3_finalize(_pStmt);
+		}
+
+		sqlite3_stmt* statement() const
+		{
+			return _pStmt;
+		}
+
+	private:
+		sqlite3_stmt* _pStmt;
+	};
+}
+
+
 namespace Poco {
 namespace SQL {
 namespace SQLite {
@@ -76,49 +104,73 @@ void SQLiteStatementImpl::compileImpl()
 	if (0 == std::strlen(pSql))
 		throw InvalidSQLStatementException("Empty statements are illegal");
 
-	int rc = SQLITE_OK;
-	const char* pLeftover = 0;
-	bool queryFound = false;
+	StatementCache& cache = session().statementCache();
+	HandlePtr pHandle;
+	if (!_pLeftover)
+	{
+		// release the previous statement first, as it
+		// is likely to be the one acquired here
+		clear();
+		pHandle = cache.acquire(statement);
+	}
 
-	do
+	if (pHandle)
 	{
-		rc = sqlite3_prepare_v2(_pDB, pSql, -1, &pStmt, &pLeftover);
-		if (rc != SQLITE_OK)
-		{
-			if (pStmt) sqlite3_finalize(pStmt);
-			pStmt = 0;
-			std::string errMsg = sqlite3_errmsg(_pDB);
-			Utility::throwException(_pDB, rc, errMsg);
-		}
-		else if (rc == SQLITE_OK && pStmt)
-		{
-			queryFound = true;
-		}
-		else if (rc == SQLITE_OK && !pStmt) // comment/whitespace ignore
+		pStmt = pHandle.cast<StatementHandle>()->statement();
+		_canCompile = false;
+	}
+	else
+	{
+		int rc = SQLITE_OK;
+		const char* pLeftover = 0;
+		bool queryFound = false;
+
+		do
 		{
-			pSql = pLeftover;
-			if (std::strlen(pSql) == 0)
+			rc = sqlite3_prepare_v2(_pDB, pSql, -1, &pStmt, &pLeftover);
+			if (rc != SQLITE_OK)
+			{
+				if (pStmt) sqlite3_finalize(pStmt);
+				pStmt = 0;
+				std::string errMsg = sqlite3_errmsg(_pDB);
+				Utility::throwException(_pDB, rc, errMsg);
+			}
+			else if (rc == SQLITE_OK && pStmt)
 			{
-				// empty statement or an conditional statement! like CREATE IF NOT EXISTS
-				// this is valid
 				queryFound = true;
 			}
+			else if (rc == SQLITE_OK && !pStmt) // comment/whitespace ignore
+			{
+				pSql = pLeftover;
+				if (std::strlen(pSql) == 0)
+				{
+					// empty statement or an conditional statement! like CREATE IF NOT EXISTS
+					// this is valid
+					queryFound = true;
+				}
+			}
+		} while (rc == SQLITE_OK && !pStmt && !queryFound);
+
+		//Finalization call in clear() invalidates the pointer, so the value is remembered here.
+		//For last statement in a batch (or a single statement), pLeftover == "", so the next call
+		// to compileImpl() shall return false immediately when there are no more statements left.
+		std::string leftOver(pLeftover);
+		trimInPlace(leftOver);
+
+		// only statements that are not part of a batch are cached
+		if (pStmt && !_pLeftover && leftOver.empty())
+			pHandle = new StatementHandle(cache, statement, pStmt);
+
+		clear();
+		if (!leftOver.empty())
+		{
+			_pLeftover = new std::string(leftOver);
+			_canCompile = true;
 		}
-	} while (rc == SQLITE_OK && !pStmt && !queryFound);
-
-	//Finalization call in clear() invalidates the pointer, so the value is remembered here.
-	//For last statement in a batch (or a single statement), pLeftover == "", so the next call
-	// to compileImpl() shall return false immediately when there are no more statements left.
-	std::string leftOver(pLeftover);
-	trimInPlace(leftOver);
-	clear();
-	_pStmt = pStmt;
-	if (!leftOver.empty())
-	{
-		_pLeftover = new std::string(leftOver);
-		_canCompile = true;
+		else _canCompile = false;
 	}
-	else _canCompile = false;
+	_pStmt = pStmt;
+	_pHandle = pHandle;
 
 	_pBinder = new Binder(_pStmt);
 	_pExtractor = new Extractor(_pStmt);
@@ -222,11 +274,18 @@ void SQLiteStatementImpl::clear()
 	_columns[currentDataSet()].clear();
 	_affectedRowCount = POCO_SQLITE_INV_ROW_CNT;
 
-	if (_pStmt)
+	if (_pHandle)
+	{
+		sqlite3_reset(_pStmt);
+		sqlite3_clear_bindings(_pStmt);
+		session().statementCache().release(_pHandle);
+		_pHandle = 0;
+	}
+	else if (_pStmt)
 	{
 		sqlite3_finalize(_pStmt);
-		_pStmt=0;
 	}
+	_pStmt = 0;
 	_pLeftover = 0;
 }
 
@@ -186,6 +186,9 @@ void SessionImpl::open(const std::string& connect)
 
 void SessionImpl::close()
 {
+	// cached statements would keep the database open
+	statementCache().clear();
+
 	if (_pDB)
 	{
 		int result = 0;
@@ -20,6 +20,8 @@
 #include "Poco/SQL/JSONRowFormatter.h"
 #include "Poco/SQL/SQLChannel.h"
 #include "Poco/SQL/SessionFactory.h"
+#include "Poco/SQL/SessionPool.h"
+#include "Poco/SQL/StatementCache.h"
 #include "Poco/SQL/SQLite/Connector.h"
 #include "Poco/SQL/SQLite/Utility.h"
 #include "Poco/SQL/SQLite/Notifier.h"
@@ -52,8 +54,11 @@ using Poco::SQL::RecordSet;
 using Poco::SQL::RowFilter;
 using Poco::SQL::JSONRowFormatter;
 using Poco::SQL::Column;
+using Poco::SQL::ColumnView;
 using Poco::SQL::Row;
 using Poco::SQL::SQLChannel;
+using Poco::SQL::SessionPool;
+using Poco::SQL::StatementCache;
 using Poco::SQL::LimitException;
 using Poco::SQL::ConnectionFailedException;
 using Poco::SQL::CLOB;
@@ -87,6 +92,7 @@ using Poco::SQL::SQLite::ConstraintViolationException;
 using Poco::SQL::SQLite::ParameterCountMismatchException;
 using Poco::Int32;
 using Poco::Int64;
+using Poco::UInt64;
 using Poco::Dynamic::Var;
 using Poco::SQL::SQLite::Utility;
 using Poco::delegate;
@@ -2845,6 +2851,133 @@ void SQLiteTest::testReconnect()
 }
 
 
+void SQLiteTest::testStatementCache()
+{
+	Session session (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
+	assertTrue (AnyCast<std::size_t>(session.getProperty("statementCacheSize")) == StatementCache::DEFAULT_CAPACITY);
+	assertTrue (StatementCache::DEFAULT_CAPACITY == 0);
+	session.setProperty("statementCacheSize", std::size_t(16));
+
+	session << "DROP TABLE IF EXISTS Ints", now;
+	session << "CREATE TABLE Ints (I INTEGER)", now;
+
+	UInt64 hits = AnyCast<UInt64>(session.getProperty("statementCacheHits"));
+	UInt64 misses = AnyCast<UInt64>(session.getProperty("statementCacheMisses"));
+	for (int i = 0; i < 10; ++i)
+	{
+		session << "INSERT INTO Ints VALUES (?)", use(i), now;
+	}
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheHits")) == hits + 9);
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheMisses")) == misses + 1);
+
+	int count = 0;
+	int sum = 0;
+	for (int i = 0; i < 2; ++i)
+	{
+		session << "SELECT COUNT(*), SUM(I) FROM Ints", into(count), into(sum), now;
+		assertTrue (count == 10);
+		assertTrue (sum == 45);
+	}
+
+	// batches are not cached
+	hits = AnyCast<UInt64>(session.getProperty("statementCacheHits"));
+	for (int i = 0; i < 2; ++i)
+	{
+		session << "DELETE FROM Ints WHERE I = 0; DELETE FROM Ints WHERE I = 1", now;
+	}
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheHits")) == hits);
+
+	// reconnecting discards the cached statements
+	session.close();
+	session.open();
+	misses = AnyCast<UInt64>(session.getProperty("statementCacheMisses"));
+	session << "SELECT COUNT(*), SUM(I) FROM Ints", into(count), into(sum), now;
+	assertTrue (count == 8);
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheHits")) == hits);
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheMisses")) == misses + 1);
+
+	session.setProperty("statementCacheSize", std::size_t(0));
+	session << "SELECT COUNT(*), SUM(I) FROM Ints", into(count), into(sum), now;
+	session << "SELECT COUNT(*), SUM(I) FROM Ints", into(count), into(sum), now;
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheHits")) == hits);
+	assertTrue (AnyCast<UInt64>(session.getProperty("statementCacheMisses")) == misses + 1);
+
+	// the cache survives returning a session to the pool
+	SessionPool pool(Poco::SQL::SQLite::Connector::KEY, "dummy.db", 1, 1);
+	{
+		Session pooled(pool.get());
+		pooled.setProperty("statementCacheSize", std::size_t(16));
+		pooled << "SELECT COUNT(*) FROM Ints", into(count), now;
+	}
+	Session pooled(pool.get());
+	hits = AnyCast<UInt64>(pooled.getProperty("statementCacheHits"));
+	pooled << "SELECT COUNT(*) FROM Ints", into(count), now;
+	assertTrue (count == 8);
+	assertTrue (AnyCast<UInt64>(pooled.getProperty("statementCacheHits")) == hits + 1);
+}
+
+
+void SQLiteTest::testColumnView()
+{
+	Session tmp (Poco::SQL::SQLite::Connector::KEY, "dummy.db");
+	tmp << "DROP TABLE IF EXISTS ColumnView", now;
+	tmp << "CREATE TABLE ColumnView (i INTEGER, r REAL, v VARCHAR)", now;
+	tmp << "INSERT INTO ColumnView VALUES (1, 1.5, 'a')", now;
+	tmp << "INSERT INTO ColumnView VALUES (NULL, NULL, NULL)", now;
+	tmp << "INSERT INTO ColumnView VALUES (3, 3.5, 'c')", now;
+
+	Statement stmt = (tmp << "SELECT * FROM ColumnView ORDER BY rowid");
+	stmt.setStorage("vector");
+	stmt.execute();
+	RecordSet rs(stmt);
+
+	ColumnView<Int64> i = rs.columnView<Int64>("i");
+	ColumnView<double> r = rs.columnView<double>(1);
+	ColumnView<std::string> v = rs.columnView<std::string>("V");
+
+	assertTrue (i.size() == 3);
+	assertTrue (r.size() == 3);
+	assertTrue (v.size() == 3);
+	assertTrue (i.position() == 0);
+	assertTrue (r.name() == "r");
+
+	assertTrue (!i.isNull(0) && i.isNull(1) && !i.isNull(2));
+	assertTrue (!r.isNull(0) && r.isNull(1) && !r.isNull(2));
+	assertTrue (!v.isNull(0) && v.isNull(1) && !v.isNull(2));
+	assertTrue (i[0] == 1 && i[2] == 3);
+	assertTrue (r.data()[0] == 1.5 && r.data()[2] == 3.5);
+	assertTrue (v[0] == "a" && v[2] == "c");
+
+	// the views refer to the record set storage
+	assertTrue (&i[2] == &rs.value<Int64>(0, 2));
+
+	try
+	{
+		rs.columnView<Int32>(0);
+		fail ("must fail");
+	}
+	catch (BadCastException&) { }
+
+	try
+	{
+		rs.columnView<Int32>("i");
+		fail ("must fail");
+	}
+	catch (NotFoundException&) { }
+
+	Statement dequeStmt = (tmp << "SELECT * FROM ColumnView");
+	dequeStmt.setStorage("deque");
+	dequeStmt.execute();
+	RecordSet dequeRs(dequeStmt);
+	try
+	{
+		dequeRs.columnView<Int64>(0);
+		fail ("must fail");
+	}
+	catch (BadCastException&) { }
+}
+
+
 void SQLiteTest::testThreadModes()
 {
 	using namespace Poco::SQL::SQLite;
@@ -3822,6 +3955,8 @@ CppUnit::Test* SQLiteTest::suite()
 	CppUnit_addTest(pSuite, SQLiteTest, testMultipleResults);
 	CppUnit_addTest(pSuite, SQLiteTest, testPair);
 	CppUnit_addTest(pSuite, SQLiteTest, testReconnect);
+	CppUnit_addTest(pSuite, SQLiteTest, testStatementCache);
+	CppUnit_addTest(pSuite, SQLiteTest, testColumnView);
 	CppUnit_addTest(pSuite, SQLiteTest, testThreadModes);
 	CppUnit_addTest(pSuite, SQLiteTest, testUpdateCallback);
 	CppUnit_addTest(pSuite, SQLiteTest, testCommitCallback);
@@ -123,6 +123,9 @@ public:
 
 	void testReconnect();
 
+	void testStatementCache();
+	void testColumnView();
+
 	void testThreadModes();
 
 	void testUpdateCallback();
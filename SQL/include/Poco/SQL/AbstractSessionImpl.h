@@ -88,6 +88,14 @@ public:
 		/// While these features can not both be true at the same time, they can both be false,
 		/// resulting in default underlying database behavior.
 		///
+		/// Adds "statementCacheSize" property, the maximum number of prepared
+		/// statements kept in the session's StatementCache (zero, the default,
+		/// disables the cache; see StatementCache for the caveats of enabling it;
+		/// setting the property discards all cached statements), and the read-only "statementCacheHits" and
+		/// "statementCacheMisses" properties, reporting how often a prepared
+		/// statement has been found in the cache. Connectors not supporting
+		/// the cache report no hits and no misses.
+		///
 	{
 		addProperty("storage",
 			&AbstractSessionImpl<C>::setStorage,
@@ -108,6 +116,15 @@ public:
 		addFeature("forceEmptyString",
 			&AbstractSessionImpl<C>::setForceEmptyString,
 			&AbstractSessionImpl<C>::getForceEmptyString);
+		addProperty("statementCacheSize",
+			&AbstractSessionImpl<C>::setStatementCacheSize,
+			&AbstractSessionImpl<C>::getStatementCacheSize);
+		addProperty("statementCacheHits",
+			0,
+			&AbstractSessionImpl<C>::getStatementCacheHits);
+		addProperty("statementCacheMisses",
+			0,
+			&AbstractSessionImpl<C>::getStatementCacheMisses);
 	}
 
 	~AbstractSessionImpl()
@@ -258,6 +275,34 @@ public:
 		return _forceEmptyString;
 	}
 
+	void setStatementCacheSize(const std::string& /*name*/, const Poco::Any& value)
+		/// Sets the maximum number of prepared statements
+		/// kept in the statement cache.
+	{
+		statementCache().setCapacity(Poco::RefAnyCast<std::size_t>(value));
+	}
+
+	Poco::Any getStatementCacheSize(const std::string& /*name*/ = "") const
+		/// Returns the maximum number of prepared statements
+		/// kept in the statement cache.
+	{
+		return statementCache().capacity();
+	}
+
+	Poco::Any getStatementCacheHits(const std::string& /*name*/ = "") const
+		/// Returns the number of prepared statements found
+		/// in the statement cache.
+	{
+		return statementCache().hits();
+	}
+
+	Poco::Any getStatementCacheMisses(const std::string& /*name*/ = "") const
+		/// Returns the number of prepared statements not found
+		/// in the statement cache.
+	{
+		return statementCache().misses();
+	}
+
 protected:
 	void addFeature(const std::string& name, FeatureSetter setter, FeatureGetter getter)
 		/// Adds a feature to the map of supported features.
@@ -99,6 +99,7 @@ public:
 		TypeHandler<C>::extract(col, _rResult, _default, pExt);
 		typename C::iterator it = _rResult.begin();
 		typename C::iterator end = _rResult.end();
+		_nulls.clear();
 		for (int row = 0; it !=end; ++it, ++row)
 		{
 			_nulls.push_back(isValueNull(*it, pExt->isNull(col, row)));
@@ -126,10 +127,15 @@ protected:
 		return _rResult;
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 private:
-	C&               _rResult;
-	CValType         _default;
-	std::deque<bool> _nulls;
+	C&                _rResult;
+	CValType          _default;
+	std::vector<bool> _nulls;
 };
 
 
@@ -195,6 +201,11 @@ public:
 		return *_pColumn;
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return BulkExtraction<C>::nulls();
+	}
+
 private:
 	InternalBulkExtraction();
 	InternalBulkExtraction(const InternalBulkExtraction&);
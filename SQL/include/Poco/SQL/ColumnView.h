@@ -0,0 +1,156 @@
+//
+// ColumnView.h
+//
+// Library: SQL
+// Package: SQLCore
+// Module:  ColumnView
+//
+// Definition of the ColumnView class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SQL_ColumnView_INCLUDED
+#define SQL_ColumnView_INCLUDED
+
+
+#include "Poco/SQL/SQL.h"
+#include "Poco/SQL/Column.h"
+#include "Poco/Exception.h"
+#include <vector>
+
+
+namespace Poco {
+namespace SQL {
+
+
+template <class T>
+class ColumnView
+	/// ColumnView provides typed, read-only access to the data
+	/// of a column extracted into a std::vector, together with
+	/// the null flags of the column's values.
+	///
+	/// A ColumnView does not copy any data, and values are
+	/// accessed directly, without conversion to Poco::Dynamic::Var.
+	/// For all types except bool, the values are stored contiguously
+	/// and can be accessed as an array through data(). Values of a
+	/// bool column are returned by value, as std::vector<bool> does
+	/// not store them as individual bool objects.
+	///
+	/// A ColumnView is obtained from a RecordSet with vector storage
+	/// (see RecordSet::columnView()). It refers to the storage of
+	/// the RecordSet, and must not be used after the RecordSet has
+	/// been destroyed, reset or executed again.
+{
+public:
+	typedef std::vector<T>                     Container;
+	typedef std::vector<bool>                  NullContainer;
+	typedef typename Container::const_iterator  Iterator;
+	typedef typename Container::const_reference ConstReference;
+	typedef typename Container::size_type       Size;
+	typedef T                                   Type;
+
+	ColumnView(const Column<Container>& column, const NullContainer& nulls):
+		_pColumn(&column),
+		_pData(&column.data()),
+		_pNulls(&nulls)
+		/// Creates the ColumnView for the given column and null flags.
+	{
+	}
+
+	Size size() const
+		/// Returns the number of values.
+	{
+		return _pData->size();
+	}
+
+	bool empty() const
+		/// Returns true if the column contains no values.
+	{
+		return _pData->empty();
+	}
+
+	ConstReference operator [] (std::size_t row) const
+		/// Returns the value in the specified row, without range check.
+	{
+		return (*_pData)[row];
+	}
+
+	ConstReference value(std::size_t row) const
+		/// Returns the value in the specified row.
+		/// Throws a RangeException if the row does not exist.
+	{
+		if (row >= _pData->size())
+			throw RangeException("Invalid row index");
+		return (*_pData)[row];
+	}
+
+	bool isNull(std::size_t row) const
+		/// Returns true if the value in the specified row is null.
+		/// Throws a RangeException if the row does not exist.
+	{
+		if (row >= _pNulls->size())
+			throw RangeException("Invalid row index");
+		return (*_pNulls)[row];
+	}
+
+	const NullContainer& nulls() const
+		/// Returns the null flags of the values.
+	{
+		return *_pNulls;
+	}
+
+	const T* data() const
+		/// Returns a pointer to the contiguous values.
+		/// Not available for bool columns.
+	{
+		return _pData->data();
+	}
+
+	Iterator begin() const
+		/// Returns an iterator pointing to the first value.
+	{
+		return _pData->begin();
+	}
+
+	Iterator end() const
+		/// Returns an iterator pointing past the last value.
+	{
+		return _pData->end();
+	}
+
+	const std::string& name() const
+		/// Returns the column name.
+	{
+		return _pColumn->name();
+	}
+
+	std::size_t position() const
+		/// Returns the column position.
+	{
+		return _pColumn->position();
+	}
+
+	MetaColumn::ColumnDataType type() const
+		/// Returns the column type.
+	{
+		return _pColumn->type();
+	}
+
+private:
+	ColumnView();
+
+	const Column<Container>* _pColumn;
+	const Container*         _pData;
+	const NullContainer*     _pNulls;
+};
+
+
+} } // namespace Poco::SQL
+
+
+#endif // SQL_ColumnView_INCLUDED
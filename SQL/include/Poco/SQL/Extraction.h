@@ -250,10 +250,15 @@ protected:
 		return _rResult;
 	}
 
+	const std::vector<bool>& nulls() const
+	{
+		return _nulls;
+	}
+
 private:
-	std::vector<T>&  _rResult;
-	T                _default;
-	std::deque<bool> _nulls;
+	std::vector<T>&   _rResult;
+	T                 _default;
+	std::vector<bool> _nulls;
 };
 
 
@@ -589,6 +594,12 @@ public:
 		return *_pColumn;
 	}
 
+	const std::vector<bool>& nulls() const
+		/// Returns the null flags. Only available for std::vector.
+	{
+		return Extraction<C>::nulls();
+	}
+
 private:
 	InternalExtraction();
 	InternalExtraction(const InternalExtraction&);
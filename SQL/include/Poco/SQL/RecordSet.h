@@ -22,6 +22,7 @@
 #include "Poco/SQL/Session.h"
 #include "Poco/SQL/Extraction.h"
 #include "Poco/SQL/BulkExtraction.h"
+#include "Poco/SQL/ColumnView.h"
 #include "Poco/SQL/Statement.h"
 #include "Poco/SQL/RowIterator.h"
 #include "Poco/SQL/RowFilter.h"
@@ -63,6 +64,24 @@ class Poco_SQL_API RecordSet: private Statement
 	///
 	/// The number of rows in the RecordSet can be limited by specifying
 	/// a limit for the Statement.
+	///
+	/// For processing large results, the data can be accessed column by
+	/// column, without converting the values to Poco::Dynamic::Var and
+	/// without creating Row objects. To do so, the Statement or Session
+	/// storage must be set to "vector", so that every column is extracted
+	/// into a contiguous std::vector, and the columns are accessed through
+	/// typed views:
+	///
+	///     Statement select(session);
+	///     select << "SELECT Name, Age FROM Person";
+	///     select.setStorage("vector");
+	///     select.execute();
+	///     RecordSet rs(select);
+	///     ColumnView<Int32> ages = rs.columnView<Int32>("Age");
+	///     for (std::size_t row = 0; row < ages.size(); ++row)
+	///     {
+	///         if (!ages.isNull(row)) total += ages[row];
+	///     }
 {
 public:
 	typedef std::map<std::size_t, Row*> RowMap;
@@ -161,6 +180,50 @@ public:
 		}
 	}
 
+	template <class T>
+	ColumnView<T> columnView(const std::string& name) const
+		/// Returns a typed view of the first column with the specified name.
+		/// Throws a NotFoundException if there is no such column extracted
+		/// into a std::vector<T>. See columnView(std::size_t) for details.
+	{
+		typedef std::vector<T> C;
+		if (isBulkExtraction())
+		{
+			typedef InternalBulkExtraction<C> E;
+			return columnViewImpl<T,E>(columnPosition<C,E>(name));
+		}
+		else
+		{
+			typedef InternalExtraction<C> E;
+			return columnViewImpl<T,E>(columnPosition<C,E>(name));
+		}
+	}
+
+	template <class T>
+	ColumnView<T> columnView(std::size_t pos) const
+		/// Returns a typed view of the column at the specified position.
+		///
+		/// The column must have been extracted into a std::vector<T>,
+		/// i.e., the storage must be "vector" (or bulk extraction into
+		/// std::vector must be used), and T must match the column type.
+		/// Otherwise, a BadCastException is thrown.
+		///
+		/// The view covers all extracted rows; the RowFilter is not
+		/// applied.
+	{
+		typedef std::vector<T> C;
+		if (isBulkExtraction())
+		{
+			typedef InternalBulkExtraction<C> E;
+			return columnViewImpl<T,E>(pos);
+		}
+		else
+		{
+			typedef InternalExtraction<C> E;
+			return columnViewImpl<T,E>(pos);
+		}
+	}
+
 	Row& row(std::size_t pos);
 		/// Returns reference to row at position pos.
 		/// Rows are lazy-created and cached.
@@ -454,6 +517,15 @@ private:
 		}
 	}
 
+	template <class T, class E>
+	ColumnView<T> columnViewImpl(std::size_t pos) const
+		/// Returns a typed view of the column at specified position.
+	{
+		const Column<std::vector<T> >& col = columnImpl<std::vector<T>,E>(pos);
+		const E* pExtraction = static_cast<const E*>(extractions()[pos].get());
+		return ColumnView<T>(col, pExtraction->nulls());
+	}
+
 	size_t storageRowCount() const;
 
 	bool isAllowed(std::size_t row) const;
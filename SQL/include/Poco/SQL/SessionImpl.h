@@ -19,6 +19,7 @@
 
 
 #include "Poco/SQL/SQL.h"
+#include "Poco/SQL/StatementCache.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/SharedPtr.h"
@@ -177,6 +178,13 @@ public:
 		/// owning pool available session list.
 		/// Defaults to no-op.
 
+	StatementCache& statementCache();
+		/// Returns the cache of prepared statement handles,
+		/// which is used by connectors supporting it.
+
+	const StatementCache& statementCache() const;
+		/// Returns the cache of prepared statement handles.
+
 protected:
 	void setConnectionString(const std::string& connectionString);
 		/// Sets the connection string. Should only be called on
@@ -188,8 +196,9 @@ private:
 	SessionImpl(const SessionImpl&);
 	SessionImpl& operator = (const SessionImpl&);
 
-	std::string _connectionString;
-	std::size_t _loginTimeout;
+	std::string    _connectionString;
+	std::size_t    _loginTimeout;
+	StatementCache _statementCache;
 };
 
 
@@ -232,6 +241,18 @@ inline void SessionImpl::putBack()
 }
 
 
+inline StatementCache& SessionImpl::statementCache()
+{
+	return _statementCache;
+}
+
+
+inline const StatementCache& SessionImpl::statementCache() const
+{
+	return _statementCache;
+}
+
+
 } } // namespace Poco::SQL
 
 
@@ -0,0 +1,172 @@
+//
+// StatementCache.h
+//
+// Library: SQL
+// Package: SQLCore
+// Module:  StatementCache
+//
+// Definition of the StatementCache class.
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SQL_StatementCache_INCLUDED
+#define SQL_StatementCache_INCLUDED
+
+
+#include "Poco/SQL/SQL.h"
+#include "Poco/LRUCache.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include <string>
+
+
+namespace Poco {
+namespace SQL {
+
+
+class Poco_SQL_API StatementCache
+	/// A bounded cache of prepared statement handles, keyed by
+	/// SQL text. When the cache is full, the least recently used
+	/// handle is discarded.
+	///
+	/// Every SessionImpl owns a StatementCache. A connector
+	/// supporting it acquires the handle for the SQL text of a
+	/// statement from the cache before preparing the statement,
+	/// and releases the handle to the cache instead of discarding
+	/// it when the statement is destroyed or recompiled. Only the
+	/// statement that acquired a handle uses it; the handle is not
+	/// in the cache until it has been released.
+	///
+	/// Since the cache belongs to the connector's SessionImpl, it
+	/// survives returning a pooled session to its SessionPool.
+	/// Connectors clear the cache when the session is closed, and
+	/// therefore on reconnect. A handle acquired before the cache
+	/// has been cleared is discarded when it is released.
+	///
+	/// The cache of a session is disabled by default, and is enabled
+	/// by setting the session's "statementCacheSize" property. Cached
+	/// statements, and the result column metadata cached with them, are
+	/// not invalidated by schema changes: after changing a table used
+	/// by a cached statement, the cache must be cleared (setting the
+	/// capacity again does that), or the database may reject the cached
+	/// statement or return results not matching the cached metadata.
+	///
+	/// The cache counts hits and misses of acquire().
+	/// All operations are thread-safe.
+{
+public:
+	class Poco_SQL_API Handle
+		/// The base class for connector-specific prepared
+		/// statement handles. The destructor of a subclass must
+		/// release the native statement handle.
+	{
+	public:
+		virtual ~Handle();
+			/// Destroys the Handle.
+
+		const std::string& sql() const;
+			/// Returns the SQL text of the statement.
+
+	protected:
+		Handle(const StatementCache& cache, const std::string& sql);
+			/// Creates the Handle for a statement that has been
+			/// prepared on the current connection of the session
+			/// owning the given cache.
+
+	private:
+		Handle();
+		Handle(const Handle&);
+		Handle& operator = (const Handle&);
+
+		std::string  _sql;
+		Poco::UInt32 _generation;
+
+		friend class StatementCache;
+	};
+
+	typedef SharedPtr<Handle> HandlePtr;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 0
+	};
+
+	explicit StatementCache(std::size_t capacity = DEFAULT_CAPACITY);
+		/// Creates the StatementCache, holding at most the given
+		/// number of handles. A capacity of zero (the default)
+		/// disables the cache.
+
+	~StatementCache();
+		/// Destroys the StatementCache and all cached handles.
+
+	HandlePtr acquire(const std::string& sql);
+		/// Removes the handle for the given SQL text from the cache
+		/// and returns it, or returns a null pointer if no such
+		/// handle is cached.
+
+	void release(const HandlePtr& pHandle);
+		/// Returns the given handle to the cache, replacing a cached
+		/// handle for the same SQL text. The handle is discarded
+		/// if the cache is disabled, or if it has been cleared since
+		/// the handle has been created.
+
+	void clear();
+		/// Discards all cached handles, as well as all handles
+		/// acquired before and released later.
+
+	void setCapacity(std::size_t capacity);
+		/// Sets the maximum number of cached handles.
+		/// A capacity of zero disables the cache.
+		/// Changing the capacity discards all cached handles, as well
+		/// as all handles acquired before and released later.
+
+	std::size_t capacity() const;
+		/// Returns the maximum number of cached handles.
+
+	std::size_t size() const;
+		/// Returns the number of cached handles.
+
+	Poco::UInt64 hits() const;
+		/// Returns the number of calls to acquire() that
+		/// returned a cached handle.
+
+	Poco::UInt64 misses() const;
+		/// Returns the number of calls to acquire() that did
+		/// not find a cached handle, while the cache was enabled.
+
+	void resetStatistics();
+		/// Sets the hit and miss counts to zero.
+
+private:
+	typedef Poco::LRUCache<std::string, Handle, Poco::NullMutex, Poco::NullMutex> Cache;
+
+	StatementCache(const StatementCache&);
+	StatementCache& operator = (const StatementCache&);
+
+	Cache*            _pCache;
+	std::size_t       _capacity;
+	Poco::UInt32      _generation;
+	Poco::UInt64      _hits;
+	Poco::UInt64      _misses;
+	mutable FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& StatementCache::Handle::sql() const
+{
+	return _sql;
+}
+
+
+} } // namespace Poco::SQL
+
+
+#endif // SQL_StatementCache_INCLUDED
@@ -0,0 +1,154 @@
+//
+// StatementCache.cpp
+//
+// Library: SQL
+// Package: SQLCore
+// Module:  StatementCache
+//
+// Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SQL/StatementCache.h"
+
+
+namespace Poco {
+namespace SQL {
+
+
+StatementCache::Handle::Handle(const StatementCache& cache, const std::string& rSQL):
+	_sql(rSQL)
+{
+	FastMutex::ScopedLock lock(cache._mutex);
+	_generation = cache._generation;
+}
+
+
+StatementCache::Handle::~Handle()
+{
+}
+
+
+StatementCache::StatementCache(std::size_t capacity):
+	_pCache(capacity > 0 ? new Cache(capacity) : 0),
+	_capacity(capacity),
+	_generation(0),
+	_hits(0),
+	_misses(0)
+{
+}
+
+
+StatementCache::~StatementCache()
+{
+	delete _pCache;
+}
+
+
+StatementCache::HandlePtr StatementCache::acquire(const std::string& sql)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_pCache) return HandlePtr();
+
+	HandlePtr pHandle = _pCache->get(sql);
+	if (pHandle)
+	{
+		_pCache->remove(sql);
+		++_hits;
+	}
+	else ++_misses;
+	return pHandle;
+}
+
+
+void StatementCache::release(const HandlePtr& pHandle)
+{
+	poco_check_ptr (pHandle);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_pCache && pHandle->_generation == _generation)
+	{
+		_pCache->add(pHandle->sql(), pHandle);
+	}
+}
+
+
+void StatementCache::clear()
+{
+	Cache* pCache = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		++_generation;
+		if (_pCache)
+		{
+			pCache = _pCache;
+			_pCache = new Cache(_capacity);
+		}
+	}
+	delete pCache;
+}
+
+
+void StatementCache::setCapacity(std::size_t capacity)
+{
+	Cache* pCache = 0;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		++_generation;
+		pCache = _pCache;
+		_pCache = capacity > 0 ? new Cache(capacity) : 0;
+		_capacity = capacity;
+	}
+	delete pCache;
+}
+
+
+std::size_t StatementCache::capacity() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _capacity;
+}
+
+
+std::size_t StatementCache::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _pCache ? _pCache->size() : 0;
+}
+
+
+Poco::UInt64 StatementCache::hits() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _hits;
+}
+
+
+Poco::UInt64 StatementCache::misses() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _misses;
+}
+
+
+void StatementCache::resetStatistics()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_hits = 0;
+	_misses = 0;
+}
+
+
+} } // namespace Poco::SQL
@@ -17,11 +17,13 @@
 #include "Poco/SQL/LOBStream.h"
 #include "Poco/SQL/MetaColumn.h"
 #include "Poco/SQL/Column.h"
+#include "Poco/SQL/ColumnView.h"
 #include "Poco/SQL/Date.h"
 #include "Poco/SQL/Time.h"
 #include "Poco/SQL/SimpleRowFormatter.h"
 #include "Poco/SQL/JSONRowFormatter.h"
 #include "Poco/SQL/SQLException.h"
+#include "Poco/SQL/StatementCache.h"
 #include "Connector.h"
 #include "Poco/BinaryReader.h"
 #include "Poco/BinaryWriter.h"
@@ -43,6 +45,7 @@ using namespace Poco::SQL::Keywords;
 
 using Poco::BinaryReader;
 using Poco::BinaryWriter;
+using Poco::Int32;
 using Poco::UInt32;
 using Poco::Int64;
 using Poco::UInt64;
@@ -63,6 +66,7 @@ using Poco::SQL::CLOBInputStream;
 using Poco::SQL::CLOBOutputStream;
 using Poco::SQL::MetaColumn;
 using Poco::SQL::Column;
+using Poco::SQL::ColumnView;
 using Poco::SQL::Row;
 using Poco::SQL::RowFormatter;
 using Poco::SQL::SimpleRowFormatter;
@@ -75,6 +79,29 @@ using Poco::SQL::AbstractExtractionVecVec;
 using Poco::SQL::AbstractBinding;
 using Poco::SQL::AbstractBindingVec;
 using Poco::SQL::NotConnectedException;
+using Poco::SQL::StatementCache;
+
+
+namespace
+{
+	class TestHandle: public StatementCache::Handle
+	{
+	public:
+		TestHandle(const StatementCache& cache, const std::string& sql, int& destroyed):
+			StatementCache::Handle(cache, sql),
+			_destroyed(destroyed)
+		{
+		}
+
+		~TestHandle()
+		{
+			++_destroyed;
+		}
+
+	private:
+		int& _destroyed;
+	};
+}
 
 
 SQLTest::SQLTest(const std::string& name): CppUnit::TestCase(name)
@@ -645,6 +672,87 @@ void SQLTest::testColumnVectorBool()
 }
 
 
+void SQLTest::testColumnView()
+{
+	MetaColumn mc(1, "mc", MetaColumn::FDT_INT32, 4, 0, true);
+
+	std::vector<Int32>* pData = new std::vector<Int32>;
+	pData->push_back(1);
+	pData->push_back(0);
+	pData->push_back(3);
+
+	std::vector<bool> nulls;
+	nulls.push_back(false);
+	nulls.push_back(true);
+	nulls.push_back(false);
+
+	Column<std::vector<Int32> > c(mc, pData);
+	ColumnView<Int32> v(c, nulls);
+
+	assertTrue (v.size() == 3);
+	assertTrue (!v.empty());
+	assertTrue (v.name() == "mc");
+	assertTrue (v.position() == 1);
+	assertTrue (v.type() == MetaColumn::FDT_INT32);
+
+	assertTrue (v[0] == 1);
+	assertTrue (v.value(2) == 3);
+	assertTrue (!v.isNull(0));
+	assertTrue (v.isNull(1));
+	assertTrue (!v.isNull(2));
+
+	// the view refers to the column data
+	assertTrue (v.data() == &c.data()[0]);
+	c.data()[2] = 4;
+	assertTrue (v[2] == 4);
+
+	Int32 sum = 0;
+	for (ColumnView<Int32>::Iterator it = v.begin(); it != v.end(); ++it) sum += *it;
+	assertTrue (sum == 5);
+
+	try
+	{
+		v.value(3);
+		fail ("must fail");
+	}
+	catch (RangeException&) { }
+
+	try
+	{
+		v.isNull(3);
+		fail ("must fail");
+	}
+	catch (RangeException&) { }
+
+	// bool values are returned by value
+	MetaColumn mcBool(2, "mcBool", MetaColumn::FDT_BOOL, 1, 0, true);
+	std::vector<bool>* pBools = new std::vector<bool>;
+	pBools->push_back(true);
+	pBools->push_back(false);
+	pBools->push_back(true);
+	Column<std::vector<bool> > cBool(mcBool, pBools);
+	ColumnView<bool> vBool(cBool, nulls);
+
+	assertTrue (vBool.size() == 3);
+	bool b0 = vBool[0];
+	bool b1 = vBool.value(1);
+	assertTrue (b0 && !b1);
+	assertTrue (vBool.value(2));
+	int count = 0;
+	for (ColumnView<bool>::Iterator it = vBool.begin(); it != vBool.end(); ++it)
+	{
+		if (*it) ++count;
+	}
+	assertTrue (count == 2);
+	try
+	{
+		vBool.value(3);
+		fail ("must fail");
+	}
+	catch (RangeException&) { }
+}
+
+
 void SQLTest::testColumnDeque()
 {
 	typedef std::deque<int> ContainerType;
@@ -1412,6 +1520,88 @@ void SQLTest::testStdTuple()
 }
 
 
+void SQLTest::testStatementCache()
+{
+	int destroyed = 0;
+	StatementCache cache(2);
+	assertTrue (cache.capacity() == 2);
+	assertTrue (cache.acquire("SELECT 1").isNull());
+	assertTrue (cache.misses() == 1);
+
+	StatementCache::HandlePtr pHandle1 = new TestHandle(cache, "SELECT 1", destroyed);
+	cache.release(pHandle1);
+	assertTrue (cache.size() == 1);
+	StatementCache::HandlePtr pHandle = cache.acquire("SELECT 1");
+	assertTrue (pHandle.get() == pHandle1.get());
+	assertTrue (pHandle->sql() == "SELECT 1");
+	assertTrue (cache.hits() == 1);
+	assertTrue (cache.size() == 0);
+	cache.release(pHandle);
+	pHandle = 0;
+	pHandle1 = 0;
+	assertTrue (destroyed == 0);
+
+	// the least recently used handle is discarded
+	pHandle = new TestHandle(cache, "SELECT 2", destroyed);
+	cache.release(pHandle);
+	pHandle = new TestHandle(cache, "SELECT 3", destroyed);
+	cache.release(pHandle);
+	pHandle = 0;
+	assertTrue (cache.size() == 2);
+	assertTrue (destroyed == 1);
+	assertTrue (cache.acquire("SELECT 1").isNull());
+
+	// handles acquired before the cache is cleared are discarded
+	pHandle = cache.acquire("SELECT 2");
+	assertTrue (!pHandle.isNull());
+	cache.clear();
+	assertTrue (cache.size() == 0);
+	assertTrue (destroyed == 2);
+	cache.release(pHandle);
+	assertTrue (cache.size() == 0);
+	pHandle = 0;
+	assertTrue (destroyed == 3);
+
+	// handles acquired before the capacity is changed are discarded
+	pHandle = new TestHandle(cache, "SELECT 4", destroyed);
+	cache.release(pHandle);
+	pHandle = cache.acquire("SELECT 4");
+	assertTrue (!pHandle.isNull());
+	cache.setCapacity(3);
+	assertTrue (cache.capacity() == 3);
+	cache.release(pHandle);
+	assertTrue (cache.size() == 0);
+	pHandle = 0;
+	assertTrue (destroyed == 4);
+
+	cache.setCapacity(0);
+	pHandle = new TestHandle(cache, "SELECT 1", destroyed);
+	cache.release(pHandle);
+	assertTrue (cache.size() == 0);
+	assertTrue (cache.acquire("SELECT 1").isNull());
+	assertTrue (cache.hits() == 3);
+	assertTrue (cache.misses() == 2);
+	cache.resetStatistics();
+	assertTrue (cache.hits() == 0);
+	assertTrue (cache.misses() == 0);
+
+	Session sess(SessionFactory::instance().create("test", "cs"));
+	assertTrue (Poco::AnyCast<std::size_t>(sess.getProperty("statementCacheSize")) == StatementCache::DEFAULT_CAPACITY);
+	sess.setProperty("statementCacheSize", std::size_t(10));
+	assertTrue (Poco::AnyCast<std::size_t>(sess.getProperty("statementCacheSize")) == 10);
+	assertTrue (Poco::AnyCast<UInt64>(sess.getProperty("statementCacheHits")) == 0);
+	assertTrue (Poco::AnyCast<UInt64>(sess.getProperty("statementCacheMisses")) == 0);
+	try
+	{
+		sess.setProperty("statementCacheHits", UInt64(1));
+		fail ("read-only property - must throw");
+	}
+	catch (NotImplementedException&)
+	{
+	}
+}
+
+
 void SQLTest::setUp()
 {
 }
@@ -1435,6 +1625,7 @@ CppUnit::Test* SQLTest::suite()
 	CppUnit_addTest(pSuite, SQLTest, testCLOBStreams);
 	CppUnit_addTest(pSuite, SQLTest, testColumnVector);
 	CppUnit_addTest(pSuite, SQLTest, testColumnVectorBool);
+	CppUnit_addTest(pSuite, SQLTest, testColumnView);
 	CppUnit_addTest(pSuite, SQLTest, testColumnDeque);
 	CppUnit_addTest(pSuite, SQLTest, testColumnList);
 	CppUnit_addTest(pSuite, SQLTest, testRow);
@@ -1444,6 +1635,7 @@ CppUnit::Test* SQLTest::suite()
 	CppUnit_addTest(pSuite, SQLTest, testDateAndTime);
 	CppUnit_addTest(pSuite, SQLTest, testExternalBindingAndExtraction);
 	CppUnit_addTest(pSuite, SQLTest, testStdTuple);
+	CppUnit_addTest(pSuite, SQLTest, testStatementCache);
 
 
 	return pSuite;
@@ -36,6 +36,7 @@ public:
 	void testCLOBStreams();
 	void testColumnVector();
 	void testColumnVectorBool();
+	void testColumnView();
 	void testColumnDeque();
 	void testColumnList();
 	void testRow();
@@ -46,6 +47,7 @@ public:
 	void testExternalBindingAndExtraction();
 
 	void testStdTuple();
+	void testStatementCache();
 
 	void setUp();
 	void tearDown();